@@ -29,6 +29,7 @@
 
 #include <arvbuffer.h>
 #include <arvcamera.h>
+#include <arvcameragroup.h>
 #include <arvchunkparser.h>
 #include <arvdebug.h>
 #include <arvdevice.h>
@@ -53,6 +54,7 @@
 #include <arvfakeinterface.h>
 #include <arvfakestream.h>
 
+#include <arvfeaturehandle.h>
 #include <arvfeatures.h>
 
 #include <arvgc.h>
@@ -104,6 +106,7 @@
 #include <arvgentlstream.h>
 
 #include <arvinterface.h>
+#include <arvmetrics.h>
 #include <arvmisc.h>
 #include <arvnetwork.h>
 #include <arvrealtime.h>
@@ -117,6 +120,11 @@
 #include <arvuvstream.h>
 #endif
 
+#if ARAVIS_HAS_SHARED_MEMORY
+#include <arvstreampublisher.h>
+#include <arvstreamsubscriber.h>
+#endif
+
 #if ARAVIS_HAS_V4L2
 #include <arvv4l2interface.h>
 #include <arvv4l2device.h>
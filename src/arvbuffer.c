@@ -163,6 +163,36 @@ arv_buffer_get_data (ArvBuffer *buffer, size_t *size)
 	return buffer->priv->data;
 }
 
+static GBytes *
+_new_data_bytes (ArvBuffer *buffer, const void *data, size_t size)
+{
+	return g_bytes_new_with_free_func (data, size, g_object_unref, g_object_ref (buffer));
+}
+
+/**
+ * arv_buffer_get_data_bytes:
+ * @buffer: a #ArvBuffer
+ *
+ * Zero-copy variant of arv_buffer_get_data(), intended for language bindings, where the array returned by
+ * arv_buffer_get_data() is copied on each call. The returned #GBytes points to the buffer memory and holds a
+ * reference on @buffer, keeping the memory alive until it is released.
+ *
+ * <warning><para>The data is not copied: once @buffer is pushed back to a stream, its content will be overwritten by the
+ * next acquisition, even if the #GBytes is still alive.</para></warning>
+ *
+ * Returns: (transfer full): a #GBytes wrapping the buffer data.
+ *
+ * Since: 0.9.0
+ */
+
+GBytes *
+arv_buffer_get_data_bytes (ArvBuffer *buffer)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), NULL);
+
+	return _new_data_bytes (buffer, buffer->priv->data, buffer->priv->received_size);
+}
+
 typedef struct ARAVIS_PACKED_STRUCTURE {
 	guint32 id;
 	guint32 size;
@@ -559,6 +589,30 @@ arv_buffer_get_part_data (ArvBuffer *buffer, guint part_id, size_t *size)
         return buffer->priv->data + buffer->priv->parts[part_id].data_offset;
 }
 
+/**
+ * arv_buffer_get_part_data_bytes:
+ * @buffer: a #ArvBuffer
+ * @part_id: part id
+ *
+ * Zero-copy variant of arv_buffer_get_part_data(). See arv_buffer_get_data_bytes() for the lifetime of the
+ * returned data.
+ *
+ * Returns: (transfer full): a #GBytes wrapping the part data.
+ *
+ * Since: 0.9.0
+ */
+
+GBytes *
+arv_buffer_get_part_data_bytes (ArvBuffer *buffer, guint part_id)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), NULL);
+        g_return_val_if_fail (part_id < buffer->priv->n_parts, NULL);
+
+        return _new_data_bytes (buffer,
+                                buffer->priv->data + buffer->priv->parts[part_id].data_offset,
+                                buffer->priv->parts[part_id].size);
+}
+
 /**
  * arv_buffer_get_part_component_id:
  * @buffer: a #ArvBuffer
@@ -786,6 +840,24 @@ arv_buffer_get_image_data (ArvBuffer *buffer, size_t *size)
         return arv_buffer_get_part_data (buffer, 0, size);
 }
 
+/**
+ * arv_buffer_get_image_data_bytes:
+ * @buffer: a #ArvBuffer
+ *
+ * Zero-copy variant of arv_buffer_get_image_data(). See arv_buffer_get_data_bytes() for the lifetime of the
+ * returned data.
+ *
+ * Returns: (transfer full): a #GBytes wrapping the image data.
+ *
+ * Since: 0.9.0
+ */
+
+GBytes *
+arv_buffer_get_image_data_bytes (ArvBuffer *buffer)
+{
+        return arv_buffer_get_part_data_bytes (buffer, 0);
+}
+
 /**
  * arv_buffer_get_image_pixel_format:
  * @buffer: a #ArvBuffer
@@ -129,10 +129,12 @@ ARV_API void			arv_buffer_set_system_timestamp	(ArvBuffer *buffer, guint64 times
 ARV_API void			arv_buffer_set_frame_id		(ArvBuffer *buffer, guint64 frame_id);
 ARV_API guint64 		arv_buffer_get_frame_id		(ArvBuffer *buffer);
 ARV_API const void *		arv_buffer_get_data		(ArvBuffer *buffer, size_t *size);
+ARV_API GBytes *		arv_buffer_get_data_bytes	(ArvBuffer *buffer);
 
 ARV_API guint                   arv_buffer_get_n_parts                  (ArvBuffer *buffer);
 ARV_API gint                    arv_buffer_find_component               (ArvBuffer *buffer, guint component_id);
 ARV_API const void *		arv_buffer_get_part_data		(ArvBuffer *buffer, guint part_id, size_t *size);
+ARV_API GBytes *		arv_buffer_get_part_data_bytes		(ArvBuffer *buffer, guint part_id);
 ARV_API guint   		arv_buffer_get_part_component_id	(ArvBuffer *buffer, guint part_id);
 ARV_API ArvBufferPartDataType	arv_buffer_get_part_data_type	        (ArvBuffer *buffer, guint part_id);
 ARV_API ArvPixelFormat		arv_buffer_get_part_pixel_format	(ArvBuffer *buffer, guint part_id);
@@ -147,6 +149,7 @@ ARV_API gint			arv_buffer_get_part_x		        (ArvBuffer *buffer, guint part_id)
 ARV_API gint			arv_buffer_get_part_y		        (ArvBuffer *buffer, guint part_id);
 
 ARV_API const void *		arv_buffer_get_image_data		(ArvBuffer *buffer, size_t *size);
+ARV_API GBytes *		arv_buffer_get_image_data_bytes		(ArvBuffer *buffer);
 ARV_API ArvPixelFormat		arv_buffer_get_image_pixel_format	(ArvBuffer *buffer);
 ARV_API void			arv_buffer_get_image_region		(ArvBuffer *buffer,
                                                                          gint *x, gint *y,
@@ -32,6 +32,7 @@
 #include <arvfeatures.h>
 #include <arvdebug.h>
 #include <arvcamera.h>
+#include <arvfeaturehandle.h>
 #include <arvsystem.h>
 #include <arvgvinterface.h>
 #include <arvgcboolean.h>
@@ -97,6 +98,15 @@ typedef enum {
 	ARV_CAMERA_SERIES_IMPERX_OTHER
 } ArvCameraSeries;
 
+/* Feature used by a camera convenience function, resolved once at camera construction. The handle is NULL if the
+ * feature is not implemented by the device. */
+
+typedef struct {
+	const char *name;
+	gboolean is_integer;
+	ArvFeatureHandle *handle;
+} ArvCameraFeature;
+
 typedef struct {
 	char *name;
 	ArvDevice *device;
@@ -122,6 +132,10 @@ typedef struct {
 
         gboolean has_region_offset;
 
+	ArvCameraFeature exposure_time;
+	ArvCameraFeature gain;
+	ArvCameraFeature frame_rate;
+
 	GError *init_error;
 } ArvCameraPrivate;
 
@@ -138,6 +152,42 @@ enum
 	PROP_CAMERA_DEVICE
 };
 
+static void
+_feature_init (ArvCameraFeature *feature, ArvDevice *device, const char *name, gboolean is_integer)
+{
+	feature->name = name;
+	feature->is_integer = is_integer;
+	feature->handle = arv_feature_handle_new (device, name, NULL);
+}
+
+static double
+_feature_get (ArvCameraFeature *feature, GError **error)
+{
+	if (feature->handle == NULL) {
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_FEATURE_NOT_FOUND, "[%s] Not found", feature->name);
+		return 0.0;
+	}
+
+	if (feature->is_integer)
+		return arv_feature_handle_get_integer (feature->handle, error);
+
+	return arv_feature_handle_get_float (feature->handle, error);
+}
+
+static void
+_feature_set (ArvCameraFeature *feature, double value, GError **error)
+{
+	if (feature->handle == NULL) {
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_FEATURE_NOT_FOUND, "[%s] Not found", feature->name);
+		return;
+	}
+
+	if (feature->is_integer)
+		arv_feature_handle_set_integer (feature->handle, value, error);
+	else
+		arv_feature_handle_set_float (feature->handle, value, error);
+}
+
 /**
  * arv_camera_create_stream: (skip)
  * @camera: a #ArvCamera
@@ -1181,8 +1231,6 @@ arv_camera_get_frame_rate (ArvCamera *camera, GError **error)
 	g_return_val_if_fail (ARV_IS_CAMERA (camera), 0);
 
 	switch (priv->vendor) {
-		case ARV_CAMERA_VENDOR_PROSILICA:
-			return arv_camera_get_float (camera, "AcquisitionFrameRateAbs", error);
 		case ARV_CAMERA_VENDOR_TIS:
 			{
 				feature = arv_device_get_feature (priv->device, "FPS");
@@ -1198,6 +1246,7 @@ arv_camera_get_frame_rate (ArvCamera *camera, GError **error)
 				} else
 					return arv_camera_get_float (camera, "FPS", error);
 			}
+		case ARV_CAMERA_VENDOR_PROSILICA:
 		case ARV_CAMERA_VENDOR_POINT_GREY_FLIR:
 		case ARV_CAMERA_VENDOR_DALSA:
 		case ARV_CAMERA_VENDOR_RICOH:
@@ -1206,10 +1255,7 @@ arv_camera_get_frame_rate (ArvCamera *camera, GError **error)
 		case ARV_CAMERA_VENDOR_MATRIX_VISION:
 		case ARV_CAMERA_VENDOR_IMPERX:
 		case ARV_CAMERA_VENDOR_UNKNOWN:
-			return arv_camera_get_float (camera,
-						     priv->has_acquisition_frame_rate ?
-						     "AcquisitionFrameRate": "AcquisitionFrameRateAbs",
-						     error);
+			return _feature_get (&priv->frame_rate, error);
 	}
 
 	return 0;
@@ -1657,24 +1703,17 @@ arv_camera_set_exposure_time (ArvCamera *camera, double exposure_time_us, GError
 			if (local_error == NULL)
 				arv_camera_set_integer (camera, "ExposureTimeRaw", 1, &local_error);
 			break;
-		case ARV_CAMERA_SERIES_RICOH:
-			arv_camera_set_integer (camera, "ExposureTimeRaw", exposure_time_us, &local_error);
-			break;
-		case ARV_CAMERA_SERIES_XIMEA:
-			arv_camera_set_integer (camera, "ExposureTime", exposure_time_us, &local_error);
-			break;
 		case ARV_CAMERA_SERIES_IMPERX_CHEETAH:
 		case ARV_CAMERA_SERIES_MATRIX_VISION:
 			arv_camera_set_string (camera, "ExposureMode", "Timed", &local_error);
 			if (local_error == NULL)
 				arv_camera_set_float (camera, "ExposureTime", exposure_time_us, &local_error);
 			break;
+		case ARV_CAMERA_SERIES_RICOH:
+		case ARV_CAMERA_SERIES_XIMEA:
 		case ARV_CAMERA_SERIES_BASLER_ACE:
 		default:
-			arv_camera_set_float (camera,
-					      priv->has_exposure_time ?
-					      "ExposureTime" :
-					      "ExposureTimeAbs", exposure_time_us, &local_error);
+			_feature_set (&priv->exposure_time, exposure_time_us, &local_error);
 			break;
 	}
 
@@ -1699,17 +1738,7 @@ arv_camera_get_exposure_time (ArvCamera *camera, GError **error)
 
 	g_return_val_if_fail (ARV_IS_CAMERA (camera), 0.0);
 
-	switch (priv->series) {
-		case ARV_CAMERA_SERIES_XIMEA:
-			return arv_camera_get_integer (camera,"ExposureTime", error);
-		case ARV_CAMERA_SERIES_RICOH:
-			return arv_camera_get_integer (camera,"ExposureTimeRaw", error);
-		default:
-			return arv_camera_get_float (camera,
-						     priv->has_exposure_time ?
-						     "ExposureTime" :
-						     "ExposureTimeAbs", error);
-	}
+	return _feature_get (&priv->exposure_time, error);
 }
 
 /**
@@ -1836,16 +1865,7 @@ arv_camera_set_gain (ArvCamera *camera, double gain, GError **error)
 	if (gain < 0)
 		return;
 
-	if (priv->has_gain)
-		arv_camera_set_float (camera, "Gain", gain, error);
-	else {
-		if (priv->gain_raw_as_float)
-			arv_camera_set_float (camera, "GainRaw", gain, error);
-		else if (priv->gain_abs_as_float)
-			arv_camera_set_float (camera, "GainAbs", gain, error);
-		else
-			arv_camera_set_integer (camera, "GainRaw", gain, error);
-	}
+	_feature_set (&priv->gain, gain, error);
 }
 
 /**
@@ -1865,14 +1885,7 @@ arv_camera_get_gain (ArvCamera *camera, GError **error)
 
 	g_return_val_if_fail (ARV_IS_CAMERA (camera), 0.0);
 
-	if (priv->has_gain)
-		return arv_camera_get_float (camera, "Gain", error);
-	else if (priv->gain_raw_as_float)
-		return arv_camera_get_float (camera, "GainRaw", error);
-	else if (priv->gain_abs_as_float)
-		return arv_camera_get_float (camera, "GainAbs", error);
-
-	return arv_camera_get_integer (camera, "GainRaw", error);
+	return _feature_get (&priv->gain, error);
 }
 
 /**
@@ -4194,6 +4207,114 @@ arv_camera_new_with_device (ArvDevice *device, GError **error)
 	return g_initable_new (ARV_TYPE_CAMERA, NULL, error, "device", device, NULL);
 }
 
+typedef struct {
+	const char *name;
+	ArvCamera *camera;
+	GError *error;
+} ArvCameraOpenJob;
+
+static gpointer
+_open_camera_thread (gpointer data)
+{
+	ArvCameraOpenJob *job = data;
+
+	job->camera = arv_camera_new (job->name, &job->error);
+
+	return NULL;
+}
+
+/**
+ * arv_camera_new_multiple:
+ * @names: (array zero-terminated=1) (allow-none): a %NULL terminated list of camera names
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Creates a set of #ArvCamera concurrently. The device discovery is run once, then each camera is opened, and its
+ * Genicam data downloaded and parsed, in its own thread. The startup time of a multi-camera setup is then close to
+ * the startup time of the slowest camera.
+ *
+ * If @names is %NULL, all the devices found by the discovery are opened. See arv_camera_new() for the supported
+ * name formats.
+ *
+ * If any camera fails to open, the other ones are released, and %NULL is returned.
+ *
+ * Returns: (transfer full) (element-type ArvCamera): an array of new #ArvCamera, in the order of @names.
+ *
+ * Since: 0.9.0
+ */
+
+GPtrArray *
+arv_camera_new_multiple (const char **names, GError **error)
+{
+	GPtrArray *cameras;
+	GPtrArray *device_ids = NULL;
+	ArvCameraOpenJob *jobs;
+	GThread **threads;
+	GError *local_error = NULL;
+	unsigned int n_cameras;
+	unsigned int i;
+
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	arv_update_device_list ();
+
+	if (names == NULL) {
+		unsigned int n_devices = arv_get_n_devices ();
+
+		/* The device ids are copied, as the device list may be updated concurrently */
+		device_ids = g_ptr_array_new_with_free_func (g_free);
+		for (i = 0; i < n_devices; i++) {
+			const char *device_id = arv_get_device_id (i);
+
+			if (device_id != NULL)
+				g_ptr_array_add (device_ids, g_strdup (device_id));
+		}
+		g_ptr_array_add (device_ids, NULL);
+
+		names = (const char **) device_ids->pdata;
+	}
+
+	n_cameras = g_strv_length ((char **) names);
+
+	jobs = g_new0 (ArvCameraOpenJob, n_cameras);
+	threads = g_new0 (GThread *, n_cameras);
+
+	for (i = 0; i < n_cameras; i++) {
+		jobs[i].name = names[i];
+		threads[i] = g_thread_new ("arv_camera_open", _open_camera_thread, &jobs[i]);
+	}
+
+	cameras = g_ptr_array_new_full (n_cameras, g_object_unref);
+
+	for (i = 0; i < n_cameras; i++) {
+		g_thread_join (threads[i]);
+
+		if (jobs[i].camera != NULL)
+			g_ptr_array_add (cameras, jobs[i].camera);
+
+		if (jobs[i].error != NULL) {
+			if (local_error == NULL)
+				local_error = g_error_copy (jobs[i].error);
+			g_clear_error (&jobs[i].error);
+		} else if (jobs[i].camera == NULL && local_error == NULL) {
+			local_error = g_error_new (ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_FOUND,
+						   "Camera '%s' not found", jobs[i].name);
+		}
+	}
+
+	g_free (threads);
+	g_free (jobs);
+	if (device_ids != NULL)
+		g_ptr_array_unref (device_ids);
+
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		g_ptr_array_unref (cameras);
+		return NULL;
+	}
+
+	return cameras;
+}
+
 static void
 arv_camera_init (ArvCamera *camera)
 {
@@ -4205,6 +4326,10 @@ arv_camera_finalize (GObject *object)
 	ArvCameraPrivate *priv = arv_camera_get_instance_private (ARV_CAMERA (object));
 
 	g_clear_pointer (&priv->name, g_free);
+	g_clear_object (&priv->exposure_time.handle);
+	g_clear_object (&priv->gain.handle);
+	g_clear_object (&priv->frame_rate.handle);
+
 	g_clear_object (&priv->device);
 	g_clear_error (&priv->init_error);
 
@@ -4313,6 +4438,35 @@ arv_camera_constructed (GObject *object)
 
         priv->has_region_offset = ARV_IS_GC_INTEGER(arv_device_get_feature(priv->device, "OffsetX")) &&
                 ARV_IS_GC_INTEGER(arv_device_get_feature(priv->device, "OffsetY"));
+
+	switch (series) {
+		case ARV_CAMERA_SERIES_XIMEA:
+			_feature_init (&priv->exposure_time, priv->device, "ExposureTime", TRUE);
+			break;
+		case ARV_CAMERA_SERIES_RICOH:
+			_feature_init (&priv->exposure_time, priv->device, "ExposureTimeRaw", TRUE);
+			break;
+		default:
+			_feature_init (&priv->exposure_time, priv->device,
+				       priv->has_exposure_time ? "ExposureTime" : "ExposureTimeAbs", FALSE);
+			break;
+	}
+
+	if (priv->has_gain)
+		_feature_init (&priv->gain, priv->device, "Gain", FALSE);
+	else if (priv->gain_raw_as_float)
+		_feature_init (&priv->gain, priv->device, "GainRaw", FALSE);
+	else if (priv->gain_abs_as_float)
+		_feature_init (&priv->gain, priv->device, "GainAbs", FALSE);
+	else
+		_feature_init (&priv->gain, priv->device, "GainRaw", TRUE);
+
+	if (vendor == ARV_CAMERA_VENDOR_PROSILICA)
+		_feature_init (&priv->frame_rate, priv->device, "AcquisitionFrameRateAbs", FALSE);
+	else
+		_feature_init (&priv->frame_rate, priv->device,
+			       priv->has_acquisition_frame_rate ? "AcquisitionFrameRate" : "AcquisitionFrameRateAbs",
+			       FALSE);
 }
 
 static void
@@ -0,0 +1,874 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/**
+ * ArvCameraGroup:
+ *
+ * [class@ArvCameraGroup] spreads the stream traffic of several cameras sharing a link: GigE Vision cameras behind a
+ * single host interface or a switch uplink, and USB3 Vision cameras connected to a same host controller.
+ *
+ * When the cameras are triggered at the same time, each of them sends its frame as a burst at its full line rate, and
+ * the sum of the bursts overflows the switch buffers or the host receive ring. The lost packets are then recovered
+ * by packet resends, if they are recovered at all. Knowing the capacity of the shared link, the group computes for
+ * each camera an inter packet delay (GevSCPD) limiting its rate to its share of the link, proportional to its
+ * bandwidth needs. Optionally, a frame transmission delay (GevSCFTD) serializes the frame bursts instead.
+ *
+ * ```c
+ * group = arv_camera_group_new (1000000000);
+ * for (i = 0; i < n_cameras; i++)
+ *	arv_camera_group_add_camera (group, cameras[i], streams[i]);
+ * arv_camera_group_balance (group, &error);
+ * ```
+ *
+ * [method@ArvCameraGroup.rebalance] may then be called periodically during the acquisition. It lowers the used
+ * fraction of the link capacity when packet resends are observed, and restores it once the streams stay clean.
+ *
+ * USB3 Vision cameras are grouped by host controller, using the bus number of their USB topology. The usable capacity
+ * of each controller is distributed between its cameras as throughput limits (DeviceLinkThroughputLimit), in
+ * proportion to their payload and frame rate, instead of letting each camera use the whole controller capacity and
+ * drop frames. [method@ArvCameraGroup.get_usb_controller_utilization] reports the resulting load of each
+ * controller.
+ *
+ * A camera group is not thread safe, and the camera settings it depends on (payload, packet size and frame rate) must
+ * be set before the balancing.
+ */
+
+#include <arvfeatures.h>
+#include <arvcameragroupprivate.h>
+#include <arvgvstream.h>
+#include <arvgvspprivate.h>
+#if ARAVIS_HAS_USB
+#include <arvuvdeviceprivate.h>
+#endif
+#include <arvdebugprivate.h>
+#include <math.h>
+
+/* Ethernet preamble, header, frame check sequence and interframe gap */
+#define ARV_CAMERA_GROUP_ETHERNET_OVERHEAD	(8 + 14 + 4 + 12)
+
+#define ARV_CAMERA_GROUP_LINK_USAGE_DEFAULT	0.9
+#define ARV_CAMERA_GROUP_LINK_USAGE_MIN		0.5
+#define ARV_CAMERA_GROUP_LINK_USAGE_DECREASE	0.9
+#define ARV_CAMERA_GROUP_LINK_USAGE_INCREASE	0.02
+#define ARV_CAMERA_GROUP_N_QUIET_CHECKS		10
+
+/* Practical throughput of a USB 3.0 SuperSpeed host controller, in bytes per second */
+#define ARV_CAMERA_GROUP_USB_CONTROLLER_CAPACITY_DEFAULT	400000000
+
+typedef struct {
+	ArvCamera *camera;
+	ArvStream *stream;
+
+	/* Host controller of USB3 Vision cameras, NULL for GigE Vision cameras */
+	char *controller;
+	gint64 throughput_limit;
+
+	guint64 n_resent_packets;
+
+	gint64 packet_delay_ns;
+	gint64 frame_transmission_delay_ns;
+	gboolean has_frame_transmission_delay;
+} ArvCameraGroupMember;
+
+typedef struct {
+	guint64 link_capacity;
+	double target_link_usage;
+	double link_usage;
+	gboolean frame_transmission_delay;
+
+	guint n_quiet_checks;
+
+	guint64 usb_controller_capacity;
+	GHashTable *usb_utilizations;
+
+	GArray *members;
+} ArvCameraGroupPrivate;
+
+struct _ArvCameraGroup {
+	GObject	object;
+
+	ArvCameraGroupPrivate *priv;
+};
+
+struct _ArvCameraGroupClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvCameraGroup, arv_camera_group, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvCameraGroup))
+
+/**
+ * arv_camera_group_new:
+ * @link_capacity: capacity of the link shared by the GigE Vision cameras, in bits per second, 0 if the group is only
+ * used for USB3 Vision cameras
+ *
+ * Returns: (transfer full): a new empty #ArvCameraGroup.
+ *
+ * Since: 0.9.0
+ */
+
+ArvCameraGroup *
+arv_camera_group_new (guint64 link_capacity)
+{
+	ArvCameraGroup *group;
+
+	group = g_object_new (ARV_TYPE_CAMERA_GROUP, NULL);
+	group->priv->link_capacity = link_capacity;
+
+	return group;
+}
+
+/**
+ * arv_camera_group_add_camera:
+ * @group: a #ArvCameraGroup
+ * @camera: a GigE Vision or USB3 Vision #ArvCamera
+ * @stream: (nullable): the stream of @camera, for the resend statistics used by arv_camera_group_rebalance()
+ *
+ * Adds @camera to the cameras sharing the link. The frame transmission delays are computed in the order of addition.
+ * GigE Vision cameras can only be added to a group created with a non null link capacity.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_camera_group_add_camera (ArvCameraGroup *group, ArvCamera *camera, ArvStream *stream)
+{
+	ArvCameraGroupMember member = {0};
+
+	g_return_if_fail (ARV_IS_CAMERA_GROUP (group));
+	g_return_if_fail ((arv_camera_is_gv_device (camera) && group->priv->link_capacity > 0) ||
+			  arv_camera_is_uv_device (camera));
+	g_return_if_fail (stream == NULL || ARV_IS_STREAM (stream));
+
+#if ARAVIS_HAS_USB
+	if (arv_camera_is_uv_device (camera)) {
+		ArvUvDevice *uv_device = ARV_UV_DEVICE (arv_camera_get_device (camera));
+		char *port_path;
+
+		member.controller = g_strdup_printf ("%u", arv_uv_device_get_bus_number (uv_device));
+
+		port_path = arv_uv_device_dup_port_path (uv_device);
+		arv_info_device ("[CameraGroup::add_camera] %s on USB controller %s (port %s)",
+				 arv_camera_get_device_id (camera, NULL), member.controller, port_path);
+		g_free (port_path);
+	}
+#endif
+
+	member.camera = g_object_ref (camera);
+	member.stream = stream != NULL ? g_object_ref (stream) : NULL;
+	if (ARV_IS_GV_STREAM (stream))
+		arv_gv_stream_get_statistics (ARV_GV_STREAM (stream), &member.n_resent_packets, NULL);
+
+	g_array_append_val (group->priv->members, member);
+}
+
+/**
+ * arv_camera_group_get_n_cameras:
+ * @group: a #ArvCameraGroup
+ *
+ * Returns: the number of cameras in @group.
+ *
+ * Since: 0.9.0
+ */
+
+guint
+arv_camera_group_get_n_cameras (ArvCameraGroup *group)
+{
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), 0);
+
+	return group->priv->members->len;
+}
+
+/**
+ * arv_camera_group_get_camera:
+ * @group: a #ArvCameraGroup
+ * @index: camera index, in addition order
+ *
+ * Returns: (transfer none): the camera at @index.
+ *
+ * Since: 0.9.0
+ */
+
+ArvCamera *
+arv_camera_group_get_camera (ArvCameraGroup *group, guint index)
+{
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), NULL);
+	g_return_val_if_fail (index < group->priv->members->len, NULL);
+
+	return g_array_index (group->priv->members, ArvCameraGroupMember, index).camera;
+}
+
+/**
+ * arv_camera_group_set_link_usage:
+ * @group: a #ArvCameraGroup
+ * @usage: fraction of the link capacity available to the streams, in the ]0,1] range
+ *
+ * Sets the fraction of the link capacity distributed between the cameras. The remainder is a margin for the other
+ * traffic and the timing jitter of the devices. The default is 0.9.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_camera_group_set_link_usage (ArvCameraGroup *group, double usage)
+{
+	g_return_if_fail (ARV_IS_CAMERA_GROUP (group));
+	g_return_if_fail (usage > 0.0 && usage <= 1.0);
+
+	group->priv->target_link_usage = usage;
+	group->priv->link_usage = usage;
+	group->priv->n_quiet_checks = 0;
+}
+
+/**
+ * arv_camera_group_get_link_usage:
+ * @group: a #ArvCameraGroup
+ *
+ * Returns: the fraction of the link capacity currently distributed between the cameras, which may be lower than the
+ * one set using arv_camera_group_set_link_usage() after packet resends.
+ *
+ * Since: 0.9.0
+ */
+
+double
+arv_camera_group_get_link_usage (ArvCameraGroup *group)
+{
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), 0.0);
+
+	return group->priv->link_usage;
+}
+
+/**
+ * arv_camera_group_set_frame_transmission_delay:
+ * @group: a #ArvCameraGroup
+ * @enable: whether to serialize the frame bursts
+ *
+ * By default, all the cameras send their frames at the same time, at a rate limited to their share of the link. When
+ * @enable is %TRUE, each camera sends at the rate of the whole usable link instead, after a frame transmission delay
+ * leaving the link to the cameras added before it. This reduces the frame latency, but only suits cameras triggered
+ * at the same time.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_camera_group_set_frame_transmission_delay (ArvCameraGroup *group, gboolean enable)
+{
+	g_return_if_fail (ARV_IS_CAMERA_GROUP (group));
+
+	group->priv->frame_transmission_delay = enable;
+}
+
+/**
+ * arv_camera_group_get_frame_transmission_delay:
+ * @group: a #ArvCameraGroup
+ *
+ * Returns: %TRUE if the frame bursts are serialized.
+ *
+ * Since: 0.9.0
+ */
+
+gboolean
+arv_camera_group_get_frame_transmission_delay (ArvCameraGroup *group)
+{
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), FALSE);
+
+	return group->priv->frame_transmission_delay;
+}
+
+/* Clamps delay_ns to the bounds of the feature, in timestamp ticks, and returns the delay in ticks */
+
+static gint64
+_delay_to_ticks (ArvCamera *camera, const char *feature, gint64 tick_frequency, gint64 *delay_ns, GError **error)
+{
+	GError *local_error = NULL;
+	gint64 min, max;
+	gint64 ticks;
+
+	arv_camera_get_integer_bounds (camera, feature, &min, &max, &local_error);
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return 0;
+	}
+
+	ticks = (gint64) ((double) *delay_ns * (double) tick_frequency / 1e9);
+	if (ticks < min || ticks > max) {
+		arv_info_device ("[CameraGroup::balance] %s %s clamped to [%" G_GINT64_FORMAT ", %" G_GINT64_FORMAT "]",
+				 arv_camera_get_device_id (camera, NULL), feature, min, max);
+		ticks = CLAMP (ticks, min, max);
+	}
+
+	*delay_ns = ticks * 1000000000LL / tick_frequency;
+
+	return ticks;
+}
+
+static void
+_apply_delays (ArvCameraGroupMember *member, gboolean frame_transmission_delay, GError **error)
+{
+	GError *local_error = NULL;
+	gint64 tick_frequency;
+	gint64 ticks = 0;
+
+	tick_frequency = arv_camera_get_integer (member->camera, "ArvGevTimestampTickFrequency", &local_error);
+	if (local_error == NULL && tick_frequency <= 0)
+		g_set_error (&local_error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_PROTOCOL_ERROR,
+			     "Device returned an invalid timestamp tick frequency");
+
+	/* The computed tick counts are written as is, as a conversion back from the rounded delay may fall one tick
+	 * below the clamped value */
+	if (local_error == NULL)
+		ticks = _delay_to_ticks (member->camera, "GevSCPD", tick_frequency, &member->packet_delay_ns,
+					 &local_error);
+	if (local_error == NULL)
+		arv_camera_set_integer (member->camera, "GevSCPD", ticks, &local_error);
+
+	/* The frame transmission delay is only reset if it was set by the group */
+	if (local_error == NULL && (frame_transmission_delay || member->has_frame_transmission_delay)) {
+		if (arv_camera_is_feature_available (member->camera, "GevSCFTD", NULL)) {
+			ticks = _delay_to_ticks (member->camera, "GevSCFTD", tick_frequency,
+						 &member->frame_transmission_delay_ns, &local_error);
+			if (local_error == NULL)
+				arv_camera_set_integer (member->camera, "GevSCFTD", ticks, &local_error);
+			member->has_frame_transmission_delay = frame_transmission_delay;
+		} else {
+			arv_warning_device ("[CameraGroup::balance] %s has no frame transmission delay support",
+					    arv_camera_get_device_id (member->camera, NULL));
+			member->frame_transmission_delay_ns = 0;
+		}
+	}
+
+	if (local_error != NULL)
+		g_propagate_error (error, local_error);
+}
+
+/**
+ * arv_camera_group_allocate_usb_bandwidth: (skip)
+ * @requests: throughput limit requests
+ * @n_requests: number of requests
+ * @controller_capacity: usable capacity of a host controller, in bytes per second
+ *
+ * Shares the capacity of each controller between its requests, in proportion to their demand, or evenly if any of
+ * the demands on the controller is unknown. The limits are clamped to the request bounds.
+ */
+
+void
+arv_camera_group_allocate_usb_bandwidth (ArvCameraGroupUsbRequest *requests, guint n_requests,
+					 double controller_capacity)
+{
+	guint i, j;
+
+	g_return_if_fail (requests != NULL || n_requests == 0);
+
+	for (i = 0; i < n_requests; i++) {
+		double total_demand = 0.0;
+		gboolean has_all_demands = TRUE;
+		guint n_cameras = 0;
+
+		/* Controllers are processed at their first request */
+		for (j = 0; j < i; j++)
+			if (g_strcmp0 (requests[j].controller, requests[i].controller) == 0)
+				break;
+		if (j < i)
+			continue;
+
+		for (j = i; j < n_requests; j++) {
+			if (g_strcmp0 (requests[j].controller, requests[i].controller) != 0)
+				continue;
+
+			n_cameras++;
+			if (requests[j].demand > 0.0)
+				total_demand += requests[j].demand;
+			else
+				has_all_demands = FALSE;
+		}
+
+		for (j = i; j < n_requests; j++) {
+			double limit;
+
+			if (g_strcmp0 (requests[j].controller, requests[i].controller) != 0)
+				continue;
+
+			limit = has_all_demands ?
+				controller_capacity * requests[j].demand / total_demand :
+				controller_capacity / n_cameras;
+
+			requests[j].limit = CLAMP ((gint64) limit, requests[j].min, requests[j].max);
+		}
+	}
+}
+
+static void
+_balance_usb (ArvCameraGroup *group, GError **error)
+{
+	ArvCameraGroupPrivate *priv = group->priv;
+	ArvCameraGroupUsbRequest *requests;
+	GError *local_error = NULL;
+	GArray *indexes;
+	double usable_capacity;
+	guint i;
+
+	g_hash_table_remove_all (priv->usb_utilizations);
+
+	indexes = g_array_new (FALSE, FALSE, sizeof (guint));
+	for (i = 0; i < priv->members->len; i++)
+		if (g_array_index (priv->members, ArvCameraGroupMember, i).controller != NULL)
+			g_array_append_val (indexes, i);
+
+	if (indexes->len == 0) {
+		g_array_unref (indexes);
+		return;
+	}
+
+	usable_capacity = priv->usb_controller_capacity * priv->link_usage;
+	requests = g_new0 (ArvCameraGroupUsbRequest, indexes->len);
+
+	for (i = 0; i < indexes->len && local_error == NULL; i++) {
+		ArvCameraGroupMember *member = &g_array_index (priv->members, ArvCameraGroupMember,
+							       g_array_index (indexes, guint, i));
+		double *utilization;
+		double frame_rate = 0.0;
+		guint payload = 0;
+
+		payload = arv_camera_get_payload (member->camera, &local_error);
+		if (local_error == NULL &&
+		    arv_camera_is_frame_rate_available (member->camera, NULL))
+			frame_rate = arv_camera_get_frame_rate (member->camera, NULL);
+		if (local_error == NULL)
+			arv_camera_get_integer_bounds (member->camera, "DeviceLinkThroughputLimit",
+						       &requests[i].min, &requests[i].max, &local_error);
+
+		requests[i].controller = member->controller;
+		requests[i].demand = (double) payload * frame_rate;
+
+		utilization = g_hash_table_lookup (priv->usb_utilizations, member->controller);
+		if (utilization == NULL) {
+			utilization = g_new0 (double, 1);
+			g_hash_table_insert (priv->usb_utilizations, g_strdup (member->controller), utilization);
+		}
+		*utilization += requests[i].demand / priv->usb_controller_capacity;
+	}
+
+	if (local_error == NULL)
+		arv_camera_group_allocate_usb_bandwidth (requests, indexes->len, usable_capacity);
+
+	for (i = 0; i < indexes->len && local_error == NULL; i++) {
+		ArvCameraGroupMember *member = &g_array_index (priv->members, ArvCameraGroupMember,
+							       g_array_index (indexes, guint, i));
+
+		member->throughput_limit = requests[i].limit;
+
+		/* DeviceLinkThroughputLimit is expressed in bytes per second by the SFNC */
+		arv_camera_uv_set_bandwidth (member->camera, (guint) member->throughput_limit, &local_error);
+
+		arv_info_device ("[CameraGroup::balance] %s: throughput limit %" G_GINT64_FORMAT " B/s on USB controller %s",
+				 arv_camera_get_device_id (member->camera, NULL), member->throughput_limit,
+				 member->controller);
+	}
+
+	g_free (requests);
+	g_array_unref (indexes);
+
+	if (local_error != NULL)
+		g_propagate_error (error, local_error);
+}
+
+static void
+_balance (ArvCameraGroup *group, GError **error)
+{
+	ArvCameraGroupPrivate *priv = group->priv;
+	GError *local_error = NULL;
+	double line_rate, usable_rate;
+	double total_demand = 0.0;
+	double frame_offset = 0.0;
+	double *packet_bytes;
+	double *frame_bytes;
+	double *demands;
+	gboolean has_all_demands = TRUE;
+	guint n_gv_cameras = 0;
+	guint i;
+
+	_balance_usb (group, &local_error);
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return;
+	}
+
+	for (i = 0; i < priv->members->len; i++)
+		if (g_array_index (priv->members, ArvCameraGroupMember, i).controller == NULL)
+			n_gv_cameras++;
+
+	if (n_gv_cameras == 0)
+		return;
+
+	/* Bytes per second */
+	line_rate = priv->link_capacity / 8.0;
+	usable_rate = line_rate * priv->link_usage;
+
+	packet_bytes = g_new0 (double, priv->members->len);
+	frame_bytes = g_new0 (double, priv->members->len);
+	demands = g_new0 (double, priv->members->len);
+
+	for (i = 0; i < priv->members->len && local_error == NULL; i++) {
+		ArvCameraGroupMember *member = &g_array_index (priv->members, ArvCameraGroupMember, i);
+		guint packet_size;
+		guint payload = 0;
+		double frame_rate = 0.0;
+		double n_packets;
+
+		if (member->controller != NULL)
+			continue;
+
+		packet_size = arv_camera_gv_get_packet_size (member->camera, &local_error);
+		if (local_error == NULL)
+			payload = arv_camera_get_payload (member->camera, &local_error);
+		if (local_error == NULL &&
+		    arv_camera_is_frame_rate_available (member->camera, NULL))
+			frame_rate = arv_camera_get_frame_rate (member->camera, NULL);
+		if (local_error != NULL)
+			break;
+
+		if (packet_size <= ARV_GVSP_PAYLOAD_PACKET_PROTOCOL_OVERHEAD (FALSE)) {
+			g_set_error (&local_error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_PROTOCOL_ERROR,
+				     "Invalid packet size (%u bytes)", packet_size);
+			break;
+		}
+
+		/* Data packets, plus leader and trailer */
+		n_packets = ceil ((double) payload /
+				  (packet_size - ARV_GVSP_PAYLOAD_PACKET_PROTOCOL_OVERHEAD (FALSE))) + 2;
+
+		packet_bytes[i] = packet_size + ARV_CAMERA_GROUP_ETHERNET_OVERHEAD;
+		frame_bytes[i] = n_packets * packet_bytes[i];
+		demands[i] = frame_bytes[i] * frame_rate;
+
+		if (demands[i] > 0.0)
+			total_demand += demands[i];
+		else
+			has_all_demands = FALSE;
+	}
+
+	if (local_error == NULL && has_all_demands && total_demand > usable_rate)
+		arv_warning_device ("[CameraGroup::balance] Bandwidth demand (%g MB/s) exceeds the usable link capacity "
+				    "(%g MB/s)", total_demand / 1e6, usable_rate / 1e6);
+
+	for (i = 0; i < priv->members->len && local_error == NULL; i++) {
+		ArvCameraGroupMember *member = &g_array_index (priv->members, ArvCameraGroupMember, i);
+		double rate;
+
+		if (member->controller != NULL)
+			continue;
+
+		if (priv->frame_transmission_delay) {
+			rate = usable_rate;
+			member->frame_transmission_delay_ns = (gint64) (frame_offset * 1e9);
+			frame_offset += frame_bytes[i] / usable_rate;
+		} else {
+			/* The share of the link is proportional to the bandwidth demand, which stretches all the frame
+			 * bursts to the same fraction of their frame period. Without known frame rates, the link is
+			 * shared evenly. */
+			rate = has_all_demands ?
+				usable_rate * demands[i] / total_demand :
+				usable_rate / n_gv_cameras;
+			member->frame_transmission_delay_ns = 0;
+		}
+
+		/* Time between the packet starts, minus the packet time on the wire */
+		member->packet_delay_ns = MAX (0, (gint64) ((packet_bytes[i] / rate - packet_bytes[i] / line_rate) * 1e9));
+
+		_apply_delays (member, priv->frame_transmission_delay, &local_error);
+
+		arv_info_device ("[CameraGroup::balance] %s: packet delay %" G_GINT64_FORMAT " ns, "
+				 "frame transmission delay %" G_GINT64_FORMAT " ns",
+				 arv_camera_get_device_id (member->camera, NULL),
+				 member->packet_delay_ns, member->frame_transmission_delay_ns);
+	}
+
+	g_free (packet_bytes);
+	g_free (frame_bytes);
+	g_free (demands);
+
+	if (local_error != NULL)
+		g_propagate_error (error, local_error);
+}
+
+/**
+ * arv_camera_group_balance:
+ * @group: a #ArvCameraGroup
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Computes the inter packet delay and, if enabled, the frame transmission delay of each camera, and configures the
+ * devices accordingly. The delays are clamped to the bounds supported by the devices.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_camera_group_balance (ArvCameraGroup *group, GError **error)
+{
+	g_return_if_fail (ARV_IS_CAMERA_GROUP (group));
+
+	_balance (group, error);
+}
+
+/**
+ * arv_camera_group_rebalance:
+ * @group: a #ArvCameraGroup
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Checks the packet resend counters of the streams given to arv_camera_group_add_camera() since the previous call.
+ * On new resends, the used fraction of the link capacity is lowered and the delays are recomputed. After a number of
+ * calls without resends, the link usage is progressively restored.
+ *
+ * Returns: %TRUE if the delays were recomputed.
+ *
+ * Since: 0.9.0
+ */
+
+gboolean
+arv_camera_group_rebalance (ArvCameraGroup *group, GError **error)
+{
+	ArvCameraGroupPrivate *priv;
+	guint64 n_new_resends = 0;
+	double link_usage;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), FALSE);
+
+	priv = group->priv;
+
+	for (i = 0; i < priv->members->len; i++) {
+		ArvCameraGroupMember *member = &g_array_index (priv->members, ArvCameraGroupMember, i);
+		guint64 n_resent_packets;
+
+		if (!ARV_IS_GV_STREAM (member->stream))
+			continue;
+
+		arv_gv_stream_get_statistics (ARV_GV_STREAM (member->stream), &n_resent_packets, NULL);
+		if (n_resent_packets > member->n_resent_packets)
+			n_new_resends += n_resent_packets - member->n_resent_packets;
+		member->n_resent_packets = n_resent_packets;
+	}
+
+	link_usage = priv->link_usage;
+
+	if (n_new_resends > 0) {
+		priv->n_quiet_checks = 0;
+		link_usage = MAX (ARV_CAMERA_GROUP_LINK_USAGE_MIN, link_usage * ARV_CAMERA_GROUP_LINK_USAGE_DECREASE);
+	} else if (link_usage < priv->target_link_usage) {
+		priv->n_quiet_checks++;
+		if (priv->n_quiet_checks >= ARV_CAMERA_GROUP_N_QUIET_CHECKS) {
+			priv->n_quiet_checks = 0;
+			link_usage = MIN (priv->target_link_usage, link_usage + ARV_CAMERA_GROUP_LINK_USAGE_INCREASE);
+		}
+	}
+
+	if (link_usage == priv->link_usage)
+		return FALSE;
+
+	arv_info_device ("[CameraGroup::rebalance] %" G_GUINT64_FORMAT " new resend(s), link usage %g -> %g",
+			 n_new_resends, priv->link_usage, link_usage);
+
+	priv->link_usage = link_usage;
+	_balance (group, error);
+
+	return TRUE;
+}
+
+/**
+ * arv_camera_group_get_delays:
+ * @group: a #ArvCameraGroup
+ * @index: camera index, in addition order
+ * @packet_delay_ns: (out) (optional): inter packet delay, in nanoseconds
+ * @frame_transmission_delay_ns: (out) (optional): frame transmission delay, in nanoseconds
+ *
+ * Gets the delays set by the last balancing for the camera at @index.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_camera_group_get_delays (ArvCameraGroup *group, guint index,
+			     gint64 *packet_delay_ns, gint64 *frame_transmission_delay_ns)
+{
+	ArvCameraGroupMember *member;
+
+	g_return_if_fail (ARV_IS_CAMERA_GROUP (group));
+	g_return_if_fail (index < group->priv->members->len);
+
+	member = &g_array_index (group->priv->members, ArvCameraGroupMember, index);
+
+	if (packet_delay_ns != NULL)
+		*packet_delay_ns = member->packet_delay_ns;
+	if (frame_transmission_delay_ns != NULL)
+		*frame_transmission_delay_ns = member->frame_transmission_delay_ns;
+}
+
+/**
+ * arv_camera_group_get_throughput_limit:
+ * @group: a #ArvCameraGroup
+ * @index: camera index, in addition order
+ *
+ * Returns: the throughput limit set by the last balancing for the USB3 Vision camera at @index, 0 for GigE Vision
+ * cameras.
+ *
+ * Since: 0.9.0
+ */
+
+gint64
+arv_camera_group_get_throughput_limit (ArvCameraGroup *group, guint index)
+{
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), 0);
+	g_return_val_if_fail (index < group->priv->members->len, 0);
+
+	return g_array_index (group->priv->members, ArvCameraGroupMember, index).throughput_limit;
+}
+
+/**
+ * arv_camera_group_set_usb_controller_capacity:
+ * @group: a #ArvCameraGroup
+ * @capacity: throughput of a host controller, in bytes per second
+ *
+ * Sets the throughput shared by the USB3 Vision cameras connected to a same host controller. The default, 400 MB/s,
+ * is the practical throughput of a USB 3.0 SuperSpeed controller. As for the GigE Vision link, only the fraction set
+ * by arv_camera_group_set_link_usage() is distributed.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_camera_group_set_usb_controller_capacity (ArvCameraGroup *group, guint64 capacity)
+{
+	g_return_if_fail (ARV_IS_CAMERA_GROUP (group));
+	g_return_if_fail (capacity > 0);
+
+	group->priv->usb_controller_capacity = capacity;
+}
+
+/**
+ * arv_camera_group_get_usb_controller_capacity:
+ * @group: a #ArvCameraGroup
+ *
+ * Returns: the throughput of a USB host controller, in bytes per second.
+ *
+ * Since: 0.9.0
+ */
+
+guint64
+arv_camera_group_get_usb_controller_capacity (ArvCameraGroup *group)
+{
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), 0);
+
+	return group->priv->usb_controller_capacity;
+}
+
+/**
+ * arv_camera_group_dup_usb_controllers:
+ * @group: a #ArvCameraGroup
+ *
+ * Returns: (transfer full) (array zero-terminated=1): the identifiers of the host controllers of the USB3 Vision
+ * cameras, as of the last balancing.
+ *
+ * Since: 0.9.0
+ */
+
+char **
+arv_camera_group_dup_usb_controllers (ArvCameraGroup *group)
+{
+	GHashTableIter iter;
+	GPtrArray *controllers;
+	gpointer key;
+
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), NULL);
+
+	controllers = g_ptr_array_new ();
+	g_hash_table_iter_init (&iter, group->priv->usb_utilizations);
+	while (g_hash_table_iter_next (&iter, &key, NULL))
+		g_ptr_array_add (controllers, g_strdup (key));
+	g_ptr_array_add (controllers, NULL);
+
+	return (char **) g_ptr_array_free (controllers, FALSE);
+}
+
+/**
+ * arv_camera_group_get_usb_controller_utilization:
+ * @group: a #ArvCameraGroup
+ * @controller: a host controller identifier
+ *
+ * Returns: the throughput needed by the cameras of @controller at their current payload and frame rate, as a fraction
+ * of the controller capacity, as of the last balancing. A value above 1.0 means the controller can not sustain the
+ * configured frame rates.
+ *
+ * Since: 0.9.0
+ */
+
+double
+arv_camera_group_get_usb_controller_utilization (ArvCameraGroup *group, const char *controller)
+{
+	double *utilization;
+
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), 0.0);
+	g_return_val_if_fail (controller != NULL, 0.0);
+
+	utilization = g_hash_table_lookup (group->priv->usb_utilizations, controller);
+
+	return utilization != NULL ? *utilization : 0.0;
+}
+
+static void
+_clear_member (ArvCameraGroupMember *member)
+{
+	g_clear_object (&member->camera);
+	g_clear_object (&member->stream);
+	g_clear_pointer (&member->controller, g_free);
+}
+
+static void
+arv_camera_group_init (ArvCameraGroup *group)
+{
+	group->priv = arv_camera_group_get_instance_private (group);
+
+	group->priv->target_link_usage = ARV_CAMERA_GROUP_LINK_USAGE_DEFAULT;
+	group->priv->link_usage = ARV_CAMERA_GROUP_LINK_USAGE_DEFAULT;
+	group->priv->usb_controller_capacity = ARV_CAMERA_GROUP_USB_CONTROLLER_CAPACITY_DEFAULT;
+	group->priv->usb_utilizations = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+	group->priv->members = g_array_new (FALSE, TRUE, sizeof (ArvCameraGroupMember));
+	g_array_set_clear_func (group->priv->members, (GDestroyNotify) _clear_member);
+}
+
+static void
+arv_camera_group_finalize (GObject *object)
+{
+	ArvCameraGroup *group = ARV_CAMERA_GROUP (object);
+
+	g_array_unref (group->priv->members);
+	g_hash_table_unref (group->priv->usb_utilizations);
+
+	G_OBJECT_CLASS (arv_camera_group_parent_class)->finalize (object);
+}
+
+static void
+arv_camera_group_class_init (ArvCameraGroupClass *this_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
+
+	object_class->finalize = arv_camera_group_finalize;
+}
@@ -0,0 +1,49 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_CAMERA_GROUP_PRIVATE_H
+#define ARV_CAMERA_GROUP_PRIVATE_H
+
+#include <arvapi.h>
+#include <arvcameragroup.h>
+
+G_BEGIN_DECLS
+
+/* Throughput limit request of a USB3 Vision camera. controller identifies the host controller the camera is connected
+ * to, demand is the needed throughput in bytes per second, 0 if unknown, and min and max are the bounds of the device
+ * limit. limit is set by arv_camera_group_allocate_usb_bandwidth. */
+
+typedef struct {
+	const char *controller;
+	double demand;
+	gint64 min;
+	gint64 max;
+
+	gint64 limit;
+} ArvCameraGroupUsbRequest;
+
+ARV_API void		arv_camera_group_allocate_usb_bandwidth		(ArvCameraGroupUsbRequest *requests,
+									 guint n_requests, double controller_capacity);
+
+G_END_DECLS
+
+#endif
@@ -4,6 +4,11 @@
 #include <stdlib.h>
 #include <signal.h>
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
+#ifndef G_OS_WIN32
+#include <sys/resource.h>
+#endif
 
 static char *arv_option_camera_name = NULL;
 static char *arv_option_debug_domains = NULL;
@@ -41,6 +46,11 @@ static char *arv_option_uv_usb_mode = NULL;
 static gboolean arv_option_show_version = FALSE;
 static gboolean arv_option_gv_allow_broadcast_discovery_ack = FALSE;
 static char *arv_option_gv_port_range = NULL;
+static gboolean arv_option_benchmark = FALSE;
+static int arv_option_warmup_s = 2;
+static char *arv_option_benchmark_output = NULL;
+static char *arv_option_benchmark_format = NULL;
+static int arv_option_histogram_bin_us = 100;
 
 /* clang-format off */
 static const GOptionEntry arv_option_entries[] =
@@ -217,6 +227,31 @@ static const GOptionEntry arv_option_entries[] =
 		&arv_option_gv_port_range,	        "GV port range",
 		"<min>-<max>"
 	},
+	{
+		"benchmark",				'\0', 0, G_OPTION_ARG_NONE,
+		&arv_option_benchmark,			"Benchmark mode, with a warm-up and a measurement window of --duration",
+		NULL
+	},
+	{
+		"warmup",				'\0', 0, G_OPTION_ARG_INT,
+		&arv_option_warmup_s,			"Benchmark warm-up duration (s)",
+		"<s>"
+	},
+	{
+		"benchmark-output",			'\0', 0, G_OPTION_ARG_FILENAME,
+		&arv_option_benchmark_output,		"Benchmark report file (default: standard output)",
+		"<filename>"
+	},
+	{
+		"benchmark-format",			'\0', 0, G_OPTION_ARG_STRING,
+		&arv_option_benchmark_format,		"Benchmark report format",
+		"{json|csv}"
+	},
+	{
+		"histogram-bin",			'\0', 0, G_OPTION_ARG_INT,
+		&arv_option_histogram_bin_us,		"Benchmark histogram bin width",
+		"<µs>"
+	},
 	{
 		"debug", 				'd', 0, G_OPTION_ARG_STRING,
 		&arv_option_debug_domains, 		"Debug output selection",
@@ -233,7 +268,24 @@ static const GOptionEntry arv_option_entries[] =
 
 static const char
 description_content[] =
-"This tool configures a camera and starts video streaming, infinitely unless a duration is given.";
+"This tool configures a camera and starts video streaming, infinitely unless a duration is given.\n"
+"\n"
+"In benchmark mode, the statistics are accumulated after a warm-up period, during a measurement window of\n"
+"--duration seconds (10 by default). The report contains the stream statistics, the CPU usage of the process,\n"
+"of the main thread and of the stream thread, the buffer delivery latency (from the buffer system timestamp to\n"
+"the buffer pop) and the inter-frame jitter (deviation of the interval between the system timestamps of\n"
+"consecutive successful frames from its mean), with their histograms. It is exported as JSON or CSV, the\n"
+"progress lines being printed on the standard error.";
+
+#define BENCHMARK_N_BINS	64
+
+typedef struct {
+	gint64 time_us;
+	double process_cpu_s;
+	double main_thread_cpu_s;
+	double stream_thread_cpu_s;
+	guint64 *infos;
+} BenchmarkSnapshot;
 
 typedef struct {
 	GMainLoop *main_loop;
@@ -246,6 +298,15 @@ typedef struct {
 	char **chunks;
 
         gint64 start_time;
+
+	ArvStream *stream;
+	gint measuring;
+	GArray *latencies;
+	GArray *intervals;
+	guint64 last_system_timestamp_ns;
+	GMutex usage_mutex;
+	double stream_thread_cpu_s;
+	BenchmarkSnapshot snapshots[2];
 } ApplicationData;
 
 static gboolean cancel = FALSE;
@@ -256,6 +317,47 @@ set_cancel (int signal)
 	cancel = TRUE;
 }
 
+static double
+_get_cpu_time_s (gboolean current_thread)
+{
+#ifndef G_OS_WIN32
+	struct rusage usage;
+
+#ifdef RUSAGE_THREAD
+	if (getrusage (current_thread ? RUSAGE_THREAD : RUSAGE_SELF, &usage) != 0)
+		return NAN;
+#else
+	if (current_thread || getrusage (RUSAGE_SELF, &usage) != 0)
+		return NAN;
+#endif
+
+	return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+		(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+#else
+	return NAN;
+#endif
+}
+
+static void
+benchmark_take_snapshot (ApplicationData *data, BenchmarkSnapshot *snapshot)
+{
+	unsigned int i;
+
+	snapshot->time_us = g_get_monotonic_time ();
+	snapshot->process_cpu_s = _get_cpu_time_s (FALSE);
+	snapshot->main_thread_cpu_s = _get_cpu_time_s (TRUE);
+
+	g_mutex_lock (&data->usage_mutex);
+	snapshot->stream_thread_cpu_s = data->stream_thread_cpu_s;
+	g_mutex_unlock (&data->usage_mutex);
+
+	g_free (snapshot->infos);
+	snapshot->infos = g_new0 (guint64, arv_stream_get_n_infos (data->stream));
+	for (i = 0; i < arv_stream_get_n_infos (data->stream); i++)
+		if (arv_stream_get_info_type (data->stream, i) == G_TYPE_UINT64)
+			snapshot->infos[i] = arv_stream_get_info_uint64 (data->stream, i);
+}
+
 static void
 new_buffer_cb (ArvStream *stream, ApplicationData *data)
 {
@@ -268,8 +370,26 @@ new_buffer_cb (ArvStream *stream, ApplicationData *data)
 			data->buffer_count++;
 			arv_buffer_get_data (buffer, &size);
 			data->transferred += size;
+
+			if (g_atomic_int_get (&data->measuring)) {
+				guint64 system_timestamp_ns = arv_buffer_get_system_timestamp (buffer);
+				gint64 now_ns = g_get_real_time () * 1000LL;
+				double latency_us = (now_ns - (gint64) system_timestamp_ns) / 1000.0;
+
+				g_array_append_val (data->latencies, latency_us);
+				if (data->last_system_timestamp_ns > 0) {
+					double interval_us =
+						((gint64) system_timestamp_ns -
+						 (gint64) data->last_system_timestamp_ns) / 1000.0;
+
+					g_array_append_val (data->intervals, interval_us);
+				}
+				data->last_system_timestamp_ns = system_timestamp_ns;
+			}
 		} else {
 			data->error_count++;
+			/* Jitter intervals are only measured between consecutive successful frames */
+			data->last_system_timestamp_ns = 0;
 		}
 
 		if (arv_buffer_has_chunks (buffer) && data->chunks != NULL) {
@@ -306,6 +426,18 @@ new_buffer_cb (ArvStream *stream, ApplicationData *data)
 static void
 stream_cb (void *user_data, ArvStreamCallbackType type, ArvBuffer *buffer)
 {
+	ApplicationData *data = user_data;
+
+	/* getrusage can only sample the calling thread, keep the stream thread CPU time up to date from here */
+	if (arv_option_benchmark &&
+	    (type == ARV_STREAM_CALLBACK_TYPE_INIT || type == ARV_STREAM_CALLBACK_TYPE_BUFFER_DONE)) {
+		double cpu_s = _get_cpu_time_s (TRUE);
+
+		g_mutex_lock (&data->usage_mutex);
+		data->stream_thread_cpu_s = cpu_s;
+		g_mutex_unlock (&data->usage_mutex);
+	}
+
 	if (type == ARV_STREAM_CALLBACK_TYPE_INIT) {
 		if (arv_option_realtime) {
 			if (!arv_make_thread_realtime (10))
@@ -321,21 +453,27 @@ static gboolean
 periodic_task_cb (void *abstract_data)
 {
 	ApplicationData *data = abstract_data;
+	/* Keep the standard output for the benchmark report */
+	FILE *output = arv_option_benchmark ? stderr : stdout;
 
-	printf ("%3d frame%s - %7.3g MiB/s",
-		data->buffer_count,
-		data->buffer_count > 1 ? "s/s" : "/s ",
-		(double) data->transferred / 1e6);
+	if (arv_option_benchmark && !g_atomic_int_get (&data->measuring))
+		fprintf (output, "[%s] ", data->snapshots[0].infos == NULL ? "warm-up" : "done");
+
+	fprintf (output, "%3d frame%s - %7.3g MiB/s",
+		 data->buffer_count,
+		 data->buffer_count > 1 ? "s/s" : "/s ",
+		 (double) data->transferred / 1e6);
 	if (data->error_count > 0)
-		printf (" - %d error%s\n", data->error_count, data->error_count > 1 ? "s" : "");
+		fprintf (output, " - %d error%s\n", data->error_count, data->error_count > 1 ? "s" : "");
 	else
-		printf ("\n");
+		fprintf (output, "\n");
 	data->buffer_count = 0;
 	data->error_count = 0;
 	data->transferred = 0;
 
 	if (cancel ||
-            (arv_option_duration_s > 0 &&
+	    (arv_option_benchmark && data->snapshots[1].infos != NULL) ||
+            (!arv_option_benchmark && arv_option_duration_s > 0 &&
              (g_get_monotonic_time() - data->start_time) > 1000000 * arv_option_duration_s)) {
 		g_main_loop_quit (data->main_loop);
 		return FALSE;
@@ -344,6 +482,233 @@ periodic_task_cb (void *abstract_data)
 	return TRUE;
 }
 
+static gboolean
+benchmark_start_cb (void *abstract_data)
+{
+	ApplicationData *data = abstract_data;
+
+	benchmark_take_snapshot (data, &data->snapshots[0]);
+	g_atomic_int_set (&data->measuring, TRUE);
+
+	return FALSE;
+}
+
+static gboolean
+benchmark_stop_cb (void *abstract_data)
+{
+	ApplicationData *data = abstract_data;
+
+	g_atomic_int_set (&data->measuring, FALSE);
+	benchmark_take_snapshot (data, &data->snapshots[1]);
+
+	return FALSE;
+}
+
+static int
+_compare_double (gconstpointer a, gconstpointer b)
+{
+	double value_a = *((double *) a);
+	double value_b = *((double *) b);
+
+	return value_a < value_b ? -1 : value_a > value_b ? 1 : 0;
+}
+
+typedef struct {
+	guint n_samples;
+	double mean;
+	double stddev;
+	double min;
+	double p50;
+	double p99;
+	double p999;
+	double max;
+	double bin_start;
+	guint64 bins[BENCHMARK_N_BINS];
+} BenchmarkDistribution;
+
+static double
+_get_percentile (GArray *sorted, double percentile)
+{
+	guint index;
+
+	index = (guint) (percentile * sorted->len);
+	if (index >= sorted->len)
+		index = sorted->len - 1;
+
+	return g_array_index (sorted, double, index);
+}
+
+/* Samples are sorted in place. The histogram has BENCHMARK_N_BINS bins of --histogram-bin width, starting at
+ * bin_start. Out of range samples are accounted in the first and last bins. */
+
+static void
+benchmark_compute_distribution (GArray *samples, gboolean centered, BenchmarkDistribution *distribution)
+{
+	double sum = 0.0, sum_squares = 0.0;
+	double bin_width = arv_option_histogram_bin_us > 0 ? arv_option_histogram_bin_us : 1;
+	guint i;
+
+	memset (distribution, 0, sizeof (BenchmarkDistribution));
+
+	if (samples->len == 0)
+		return;
+
+	for (i = 0; i < samples->len; i++) {
+		double value = g_array_index (samples, double, i);
+
+		sum += value;
+		sum_squares += value * value;
+	}
+
+	distribution->n_samples = samples->len;
+	distribution->mean = sum / samples->len;
+	distribution->stddev = sqrt (MAX (0.0, sum_squares / samples->len - distribution->mean * distribution->mean));
+
+	if (centered) {
+		/* Jitter: deviation from the mean interval */
+		for (i = 0; i < samples->len; i++)
+			g_array_index (samples, double, i) -= distribution->mean;
+		distribution->bin_start = -bin_width * BENCHMARK_N_BINS / 2;
+	} else
+		distribution->bin_start = 0.0;
+
+	g_array_sort (samples, _compare_double);
+
+	distribution->min = g_array_index (samples, double, 0);
+	distribution->p50 = _get_percentile (samples, 0.5);
+	distribution->p99 = _get_percentile (samples, 0.99);
+	distribution->p999 = _get_percentile (samples, 0.999);
+	distribution->max = g_array_index (samples, double, samples->len - 1);
+
+	for (i = 0; i < samples->len; i++) {
+		double bin = floor ((g_array_index (samples, double, i) - distribution->bin_start) / bin_width);
+
+		distribution->bins[(guint) CLAMP (bin, 0, BENCHMARK_N_BINS - 1)]++;
+	}
+}
+
+static void
+benchmark_append_distribution (GString *report, gboolean json, const char *name,
+			       BenchmarkDistribution *distribution, gboolean last)
+{
+	double bin_width = arv_option_histogram_bin_us > 0 ? arv_option_histogram_bin_us : 1;
+	guint i;
+
+	if (json) {
+		g_string_append_printf (report,
+					"  \"%s\": {\n"
+					"    \"n_samples\": %u,\n"
+					"    \"mean\": %.3f,\n"
+					"    \"stddev\": %.3f,\n"
+					"    \"min\": %.3f,\n"
+					"    \"p50\": %.3f,\n"
+					"    \"p99\": %.3f,\n"
+					"    \"p999\": %.3f,\n"
+					"    \"max\": %.3f,\n"
+					"    \"histogram\": {\"bin_start\": %.3f, \"bin_width\": %.3f, \"counts\": [",
+					name,
+					distribution->n_samples, distribution->mean, distribution->stddev,
+					distribution->min, distribution->p50, distribution->p99, distribution->p999,
+					distribution->max, distribution->bin_start, bin_width);
+		for (i = 0; i < BENCHMARK_N_BINS; i++)
+			g_string_append_printf (report, "%s%" G_GUINT64_FORMAT, i > 0 ? ", " : "",
+						distribution->bins[i]);
+		g_string_append_printf (report, "]}\n  }%s\n", last ? "" : ",");
+	} else {
+		g_string_append_printf (report, "%s.n_samples,%u\n", name, distribution->n_samples);
+		g_string_append_printf (report, "%s.mean,%.3f\n", name, distribution->mean);
+		g_string_append_printf (report, "%s.stddev,%.3f\n", name, distribution->stddev);
+		g_string_append_printf (report, "%s.min,%.3f\n", name, distribution->min);
+		g_string_append_printf (report, "%s.p50,%.3f\n", name, distribution->p50);
+		g_string_append_printf (report, "%s.p99,%.3f\n", name, distribution->p99);
+		g_string_append_printf (report, "%s.p999,%.3f\n", name, distribution->p999);
+		g_string_append_printf (report, "%s.max,%.3f\n", name, distribution->max);
+		for (i = 0; i < BENCHMARK_N_BINS; i++)
+			g_string_append_printf (report, "%s.histogram[%.3f],%" G_GUINT64_FORMAT "\n", name,
+						distribution->bin_start + i * bin_width, distribution->bins[i]);
+	}
+}
+
+static void
+benchmark_append_value (GString *report, gboolean json, const char *name, double value)
+{
+	if (json) {
+		if (isnan (value))
+			g_string_append_printf (report, "  \"%s\": null,\n", name);
+		else
+			g_string_append_printf (report, "  \"%s\": %.6g,\n", name, value);
+	} else {
+		if (isnan (value))
+			g_string_append_printf (report, "%s,\n", name);
+		else
+			g_string_append_printf (report, "%s,%.6g\n", name, value);
+	}
+}
+
+static gboolean
+benchmark_report (ApplicationData *data, gboolean json)
+{
+	BenchmarkSnapshot *start = &data->snapshots[0];
+	BenchmarkSnapshot *end = &data->snapshots[1];
+	BenchmarkDistribution latency;
+	BenchmarkDistribution jitter;
+	GString *report;
+	GError *error = NULL;
+	double duration_s;
+	gboolean success = TRUE;
+	unsigned int i;
+
+	if (start->infos == NULL || end->infos == NULL) {
+		printf ("Benchmark interrupted before the end of the measurement window\n");
+		return FALSE;
+	}
+
+	duration_s = (end->time_us - start->time_us) / 1e6;
+
+	benchmark_compute_distribution (data->latencies, FALSE, &latency);
+	benchmark_compute_distribution (data->intervals, TRUE, &jitter);
+
+	report = g_string_new (json ? "{\n" : "name,value\n");
+
+	benchmark_append_value (report, json, "warmup_s", arv_option_warmup_s);
+	benchmark_append_value (report, json, "duration_s", duration_s);
+	benchmark_append_value (report, json, "process_cpu_s", end->process_cpu_s - start->process_cpu_s);
+	benchmark_append_value (report, json, "main_thread_cpu_s", end->main_thread_cpu_s - start->main_thread_cpu_s);
+	benchmark_append_value (report, json, "stream_thread_cpu_s",
+				end->stream_thread_cpu_s - start->stream_thread_cpu_s);
+
+	for (i = 0; i < arv_stream_get_n_infos (data->stream); i++) {
+		const char *name = arv_stream_get_info_name (data->stream, i);
+
+		if (arv_stream_get_info_type (data->stream, i) != G_TYPE_UINT64)
+			continue;
+
+		benchmark_append_value (report, json, name, end->infos[i] - start->infos[i]);
+		if (g_strcmp0 (name, "n_completed_buffers") == 0)
+			benchmark_append_value (report, json, "frame_rate",
+						(end->infos[i] - start->infos[i]) / duration_s);
+	}
+
+	benchmark_append_distribution (report, json, "latency_us", &latency, FALSE);
+	benchmark_append_distribution (report, json, "jitter_us", &jitter, TRUE);
+
+	if (json)
+		g_string_append (report, "}\n");
+
+	if (arv_option_benchmark_output != NULL) {
+		if (!g_file_set_contents (arv_option_benchmark_output, report->str, report->len, &error)) {
+			printf ("Failed to write the benchmark report: %s\n", error->message);
+			g_clear_error (&error);
+			success = FALSE;
+		}
+	} else
+		printf ("%s", report->str);
+
+	g_string_free (report, TRUE);
+
+	return success;
+}
+
 static gboolean
 emit_software_trigger (void *abstract_data)
 {
@@ -375,6 +740,8 @@ main (int argc, char **argv)
 	ArvUvUsbMode usb_mode;
 	GOptionContext *context;
 	GError *error = NULL;
+	gboolean benchmark_json = TRUE;
+	int exit_code = 0;
 	int i;
 
 	data.buffer_count = 0;
@@ -382,6 +749,14 @@ main (int argc, char **argv)
 	data.transferred = 0;
 	data.chunks = NULL;
 	data.chunk_parser = NULL;
+	data.stream = NULL;
+	data.measuring = FALSE;
+	data.latencies = g_array_new (FALSE, FALSE, sizeof (double));
+	data.intervals = g_array_new (FALSE, FALSE, sizeof (double));
+	data.last_system_timestamp_ns = 0;
+	g_mutex_init (&data.usage_mutex);
+	data.stream_thread_cpu_s = NAN;
+	memset (data.snapshots, 0, sizeof (data.snapshots));
 
 	context = g_option_context_new (NULL);
 	g_option_context_set_summary (context, "Small utility for basic device checks.");
@@ -470,6 +845,18 @@ main (int argc, char **argv)
 		return EXIT_FAILURE;
 	}
 
+	if (arv_option_benchmark_format == NULL || g_strcmp0 (arv_option_benchmark_format, "json") == 0)
+		benchmark_json = TRUE;
+	else if (g_strcmp0 (arv_option_benchmark_format, "csv") == 0)
+		benchmark_json = FALSE;
+	else {
+		printf ("Invalid benchmark format\n");
+		return EXIT_FAILURE;
+	}
+
+	if (arv_option_benchmark && arv_option_duration_s <= 0)
+		arv_option_duration_s = 10;
+
         if (arv_option_gv_port_range != NULL) {
                 gboolean success;
 
@@ -652,7 +1039,8 @@ main (int argc, char **argv)
 		}
 
 		if (success) {
-		    stream = arv_camera_create_stream (camera, stream_cb, NULL, &error);
+		    stream = arv_camera_create_stream (camera, stream_cb, &data, &error);
+		    data.stream = stream;
 
                     if (arv_camera_is_gv_device (camera)) {
                             guint gv_packet_size;
@@ -711,6 +1099,12 @@ main (int argc, char **argv)
 
                             data.start_time = g_get_monotonic_time();
 
+			    if (arv_option_benchmark) {
+				    g_timeout_add (1000 * MAX (0, arv_option_warmup_s), benchmark_start_cb, &data);
+				    g_timeout_add (1000 * (MAX (0, arv_option_warmup_s) + arv_option_duration_s),
+						   benchmark_stop_cb, &data);
+			    }
+
 			    g_timeout_add (1000, periodic_task_cb, &data);
 
 			    data.main_loop = g_main_loop_new (NULL, FALSE);
@@ -728,17 +1122,25 @@ main (int argc, char **argv)
 
 			    arv_stream_get_statistics (stream, &n_completed_buffers, &n_failures, &n_underruns);
 
-                            for (i = 0; i < arv_stream_get_n_infos (stream); i++) {
-                                    if (arv_stream_get_info_type (stream, i) == G_TYPE_UINT64) {
-                                            g_print ("%-22s = %" G_GUINT64_FORMAT "\n",
-                                                     arv_stream_get_info_name (stream, i),
-                                                     arv_stream_get_info_uint64 (stream, i));
-                                    }
-                            }
+			    if (arv_option_benchmark) {
+				    arv_camera_stop_acquisition (camera, NULL);
+				    arv_stream_set_emit_signals (stream, FALSE);
 
-			    arv_camera_stop_acquisition (camera, NULL);
+				    if (!benchmark_report (&data, benchmark_json))
+					    exit_code = EXIT_FAILURE;
+			    } else {
+				    for (i = 0; i < arv_stream_get_n_infos (stream); i++) {
+					    if (arv_stream_get_info_type (stream, i) == G_TYPE_UINT64) {
+						    g_print ("%-22s = %" G_GUINT64_FORMAT "\n",
+							     arv_stream_get_info_name (stream, i),
+							     arv_stream_get_info_uint64 (stream, i));
+					    }
+				    }
 
-			    arv_stream_set_emit_signals (stream, FALSE);
+				    arv_camera_stop_acquisition (camera, NULL);
+
+				    arv_stream_set_emit_signals (stream, FALSE);
+			    }
 
 			    g_object_unref (stream);
 		    } else {
@@ -763,5 +1165,11 @@ main (int argc, char **argv)
 
 	g_clear_object (&data.chunk_parser);
 
-	return 0;
+	g_array_unref (data.latencies);
+	g_array_unref (data.intervals);
+	g_free (data.snapshots[0].infos);
+	g_free (data.snapshots[1].infos);
+	g_mutex_clear (&data.usage_mutex);
+
+	return exit_code;
 }
@@ -34,6 +34,12 @@
  * GENICAM features.
  *
  * Here is an example of this API in use: [tests/arvchunkparsertest.c](https://github.com/AravisProject/aravis/blob/main/tests/arvchunkparsertest.c)
+ *
+ * The chunk parser functions are thread safe: a single parser can be used to extract chunk data of different
+ * buffers from several threads at the same time, for example from a pool of workers processing frames in parallel.
+ * Each call uses a Genicam node tree of its own, taken from a pool of instances which grows with the number of
+ * concurrent callers. This is only possible for parsers created using [ctor@ArvChunkParser.new], the others
+ * serialize the calls.
  */
 
 #include <arvchunkparserprivate.h>
@@ -43,6 +49,7 @@
 #include <arvgcstring.h>
 #include <arvgcboolean.h>
 #include <arvdebugprivate.h>
+#include <string.h>
 
 enum {
 	ARV_CHUNK_PARSER_PROPERTY_0,
@@ -58,6 +65,13 @@ arv_chunk_parser_error_quark (void)
 
 typedef struct {
 	ArvGc *genicam;
+
+	char *xml;
+	gsize xml_size;
+
+	GMutex mutex;
+	GCond cond;
+	GSList *idle_genicams;
 } ArvChunkParserPrivate;
 
 struct _ArvChunkParser {
@@ -72,6 +86,54 @@ struct _ArvChunkParserClass {
 
 G_DEFINE_TYPE_WITH_CODE (ArvChunkParser, arv_chunk_parser, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvChunkParser))
 
+static GPrivate arv_chunk_parser_string = G_PRIVATE_INIT (g_free);
+
+/* Takes a Genicam instance from the pool, and binds it to buffer for the duration of the call. When the pool is
+ * empty, a new instance is created if the Genicam data are available, otherwise the caller waits for the release
+ * of the busy instance. */
+
+static ArvGc *
+_acquire_genicam (ArvChunkParser *parser, ArvBuffer *buffer)
+{
+	ArvChunkParserPrivate *priv = parser->priv;
+	ArvGc *genicam = NULL;
+
+	g_mutex_lock (&priv->mutex);
+	while (priv->idle_genicams == NULL && priv->xml == NULL)
+		g_cond_wait (&priv->cond, &priv->mutex);
+	if (priv->idle_genicams != NULL) {
+		genicam = priv->idle_genicams->data;
+		priv->idle_genicams = g_slist_delete_link (priv->idle_genicams, priv->idle_genicams);
+	}
+	g_mutex_unlock (&priv->mutex);
+
+	if (genicam == NULL) {
+		genicam = arv_gc_new (NULL, priv->xml, priv->xml_size);
+		if (!ARV_IS_GC (genicam))
+			return NULL;
+	}
+
+	arv_gc_set_buffer (genicam, buffer);
+
+	return genicam;
+}
+
+static void
+_release_genicam (ArvChunkParser *parser, ArvGc *genicam)
+{
+	ArvChunkParserPrivate *priv = parser->priv;
+
+	if (genicam == NULL)
+		return;
+
+	arv_gc_set_buffer (genicam, NULL);
+
+	g_mutex_lock (&priv->mutex);
+	priv->idle_genicams = g_slist_prepend (priv->idle_genicams, genicam);
+	g_cond_signal (&priv->cond);
+	g_mutex_unlock (&priv->mutex);
+}
+
 /**
  * arv_chunk_parser_get_boolean_value:
  * @parser: a #ArvChunkParser
@@ -85,14 +147,15 @@ G_DEFINE_TYPE_WITH_CODE (ArvChunkParser, arv_chunk_parser, G_TYPE_OBJECT, G_ADD_
 gboolean
 arv_chunk_parser_get_boolean_value (ArvChunkParser *parser, ArvBuffer *buffer, const char *chunk, GError **error)
 {
+	ArvGc *genicam;
 	ArvGcNode *node;
 	gboolean value = FALSE;
 
 	g_return_val_if_fail (ARV_IS_CHUNK_PARSER (parser), 0.0);
 	g_return_val_if_fail (ARV_IS_BUFFER (buffer), 0.0);
 
-	node = arv_gc_get_node (parser->priv->genicam, chunk);
-	arv_gc_set_buffer (parser->priv->genicam, buffer);
+	genicam = _acquire_genicam (parser, buffer);
+	node = genicam != NULL ? arv_gc_get_node (genicam, chunk) : NULL;
 
 	if (ARV_IS_GC_BOOLEAN (node)) {
 		GError *local_error = NULL;
@@ -108,6 +171,8 @@ arv_chunk_parser_get_boolean_value (ArvChunkParser *parser, ArvBuffer *buffer, c
 			     "[%s] Not a boolean", chunk);
 	}
 
+	_release_genicam (parser, genicam);
+
 	return value;
 }
 
@@ -118,26 +183,31 @@ arv_chunk_parser_get_boolean_value (ArvChunkParser *parser, ArvBuffer *buffer, c
  * @chunk: chunk data name
  * @error: a #GError placeholder
  *
- * Returns: the string chunk data value.
+ * Returns: the string chunk data value, valid until the next call to this function from the same thread.
  */
 
 const char *
 arv_chunk_parser_get_string_value (ArvChunkParser *parser, ArvBuffer *buffer, const char *chunk, GError **error)
 {
+	ArvGc *genicam;
 	ArvGcNode *node;
 	const char *string = NULL;
 
 	g_return_val_if_fail (ARV_IS_CHUNK_PARSER (parser), NULL);
 	g_return_val_if_fail (ARV_IS_BUFFER (buffer), NULL);
 
-	node = arv_gc_get_node (parser->priv->genicam, chunk);
-	arv_gc_set_buffer (parser->priv->genicam, buffer);
+	genicam = _acquire_genicam (parser, buffer);
+	node = genicam != NULL ? arv_gc_get_node (genicam, chunk) : NULL;
 
 	if (ARV_IS_GC_STRING (node)) {
 		GError *local_error = NULL;
 
 		string = arv_gc_string_get_value (ARV_GC_STRING (node), &local_error);
 
+		/* The node tree is given back to the pool, keep a copy valid until the next call from this thread */
+		g_private_replace (&arv_chunk_parser_string, g_strdup (string));
+		string = g_private_get (&arv_chunk_parser_string);
+
 		if (local_error != NULL) {
 			arv_warning_chunk ("%s", local_error->message);
 			g_propagate_error (error, local_error);
@@ -147,6 +217,8 @@ arv_chunk_parser_get_string_value (ArvChunkParser *parser, ArvBuffer *buffer, co
 			     "[%s] Not a string", chunk);
 	}
 
+	_release_genicam (parser, genicam);
+
 	return string;
 }
 
@@ -163,14 +235,15 @@ arv_chunk_parser_get_string_value (ArvChunkParser *parser, ArvBuffer *buffer, co
 gint64
 arv_chunk_parser_get_integer_value (ArvChunkParser *parser, ArvBuffer *buffer, const char *chunk, GError **error)
 {
+	ArvGc *genicam;
 	ArvGcNode *node;
 	gint64 value = 0;
 
 	g_return_val_if_fail (ARV_IS_CHUNK_PARSER (parser), 0.0);
 	g_return_val_if_fail (ARV_IS_BUFFER (buffer), 0.0);
 
-	node = arv_gc_get_node (parser->priv->genicam, chunk);
-	arv_gc_set_buffer (parser->priv->genicam, buffer);
+	genicam = _acquire_genicam (parser, buffer);
+	node = genicam != NULL ? arv_gc_get_node (genicam, chunk) : NULL;
 
 	if (ARV_IS_GC_INTEGER (node)) {
 		GError *local_error = NULL;
@@ -186,6 +259,8 @@ arv_chunk_parser_get_integer_value (ArvChunkParser *parser, ArvBuffer *buffer, c
 			     "[%s] Not an integer", chunk);
 	}
 
+	_release_genicam (parser, genicam);
+
 	return value;
 }
 
@@ -202,14 +277,15 @@ arv_chunk_parser_get_integer_value (ArvChunkParser *parser, ArvBuffer *buffer, c
 double
 arv_chunk_parser_get_float_value (ArvChunkParser *parser, ArvBuffer *buffer, const char *chunk, GError **error)
 {
+	ArvGc *genicam;
 	ArvGcNode *node;
 	double value = 0.0;
 
 	g_return_val_if_fail (ARV_IS_CHUNK_PARSER (parser), 0.0);
 	g_return_val_if_fail (ARV_IS_BUFFER (buffer), 0.0);
 
-	node = arv_gc_get_node (parser->priv->genicam, chunk);
-	arv_gc_set_buffer (parser->priv->genicam, buffer);
+	genicam = _acquire_genicam (parser, buffer);
+	node = genicam != NULL ? arv_gc_get_node (genicam, chunk) : NULL;
 
 	if (ARV_IS_GC_FLOAT (node)) {
 		GError *local_error = NULL;
@@ -225,6 +301,8 @@ arv_chunk_parser_get_float_value (ArvChunkParser *parser, ArvBuffer *buffer, con
 			     "[%s] Not a float", chunk);
 	}
 
+	_release_genicam (parser, genicam);
+
 	return value;
 }
 
@@ -254,6 +332,16 @@ arv_chunk_parser_new (const char *xml, gsize size)
 
 	g_object_unref (genicam);
 
+	/* Keep a copy of the Genicam data, for the instantiation of additional node trees for concurrent calls */
+	if (size == (gsize) -1) {
+		chunk_parser->priv->xml = g_strdup (xml);
+		chunk_parser->priv->xml_size = strlen (xml);
+	} else {
+		chunk_parser->priv->xml = g_malloc (size);
+		memcpy (chunk_parser->priv->xml, xml, size);
+		chunk_parser->priv->xml_size = size;
+	}
+
 	return chunk_parser;
 }
 
@@ -267,6 +355,9 @@ _set_property (GObject * object, guint prop_id,
 		case ARV_CHUNK_PARSER_PROPERTY_GENICAM:
 			g_clear_object (&parser->priv->genicam);
 			parser->priv->genicam = g_value_dup_object (value);
+			if (parser->priv->genicam != NULL)
+				parser->priv->idle_genicams = g_slist_prepend (parser->priv->idle_genicams,
+									       g_object_ref (parser->priv->genicam));
 			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -294,6 +385,9 @@ static void
 arv_chunk_parser_init (ArvChunkParser *chunk_parser)
 {
 	chunk_parser->priv = arv_chunk_parser_get_instance_private (chunk_parser);
+
+	g_mutex_init (&chunk_parser->priv->mutex);
+	g_cond_init (&chunk_parser->priv->cond);
 }
 
 static void
@@ -301,7 +395,12 @@ _finalize (GObject *object)
 {
 	ArvChunkParser *chunk_parser = ARV_CHUNK_PARSER (object);
 
+	g_slist_free_full (chunk_parser->priv->idle_genicams, g_object_unref);
 	g_clear_object (&chunk_parser->priv->genicam);
+	g_clear_pointer (&chunk_parser->priv->xml, g_free);
+
+	g_mutex_clear (&chunk_parser->priv->mutex);
+	g_cond_clear (&chunk_parser->priv->cond);
 
 	G_OBJECT_CLASS (arv_chunk_parser_parent_class)->finalize (object);
 }
@@ -26,6 +26,7 @@
 
 #include <glib/gprintf.h>
 #include <stdlib.h>
+#include <string.h>
 #include <arvdebugprivate.h>
 #include <arvenumtypesprivate.h>
 #include <arvmiscprivate.h>
@@ -137,6 +138,542 @@ arv_debug_check	(ArvDebugCategory category, ArvDebugLevel level)
 	return FALSE;
 }
 
+/* Binary ring buffer
+ *
+ * When enabled, the debug messages are not formatted at emission time. The format string pointer, the timestamp
+ * and the raw arguments are copied into a fixed size record of a preallocated ring, which is allocation and lock
+ * free. Formatting is deferred until the ring is dumped, either on demand using arv_debug_dump_ring_buffer(), or
+ * on stderr each time a warning is emitted. The format strings must be literals, which is the case of all the
+ * aravis debug macros. */
+
+#define ARV_DEBUG_RING_DEFAULT_SIZE	4096
+#define ARV_DEBUG_RING_MAX_SIZE		(1U << 20)
+
+typedef enum {
+	ARV_DEBUG_RECORD_TYPE_FORMAT,
+	ARV_DEBUG_RECORD_TYPE_BINARY
+} ArvDebugRecordType;
+
+typedef struct {
+	gint sequence;
+	guint8 category;
+	guint8 level;
+	guint8 type;
+	guint8 truncated;
+	guint32 size;
+	guint32 original_size;
+	gint64 time_us;
+	const char *format;
+	ArvDebugFormatFunc formatter;
+	guint8 data[ARV_DEBUG_RECORD_DATA_SIZE];
+} ArvDebugRecord;
+
+typedef struct {
+	ArvDebugRecord *records;
+	guint n_records;
+	gint head;
+	guint tail;
+} ArvDebugRing;
+
+static ArvDebugRing arv_debug_ring = {0};
+static gint arv_debug_ring_enabled = 0;
+static GMutex arv_debug_ring_mutex;
+
+typedef enum {
+	ARV_DEBUG_ARG_NONE,
+	ARV_DEBUG_ARG_INT,
+	ARV_DEBUG_ARG_LONG,
+	ARV_DEBUG_ARG_INT64,
+	ARV_DEBUG_ARG_SIZE,
+	ARV_DEBUG_ARG_CHAR,
+	ARV_DEBUG_ARG_DOUBLE,
+	ARV_DEBUG_ARG_STRING,
+	ARV_DEBUG_ARG_POINTER,
+	ARV_DEBUG_ARG_INVALID
+} ArvDebugArgType;
+
+typedef struct {
+	ArvDebugArgType type;
+	gboolean is_unsigned;
+	gboolean star_width;
+	gboolean star_precision;
+	const char *flags;		/* flags, width and precision, without the leading % */
+	gsize flags_length;
+	char conversion;
+} ArvDebugSpec;
+
+/* Parses the conversion specification starting at format, which points just after a '%'. Returns a pointer to the
+ * character following the specification. */
+
+static const char *
+_parse_spec (const char *format, ArvDebugSpec *spec)
+{
+	const char *iter = format;
+	int n_longs = 0;
+	gboolean is_size = FALSE;
+	gboolean is_int64 = FALSE;
+
+	memset (spec, 0, sizeof (ArvDebugSpec));
+	spec->flags = format;
+
+	while (*iter != '\0' && strchr ("-+ #0'", *iter) != NULL)
+		iter++;
+	if (*iter == '*') {
+		spec->star_width = TRUE;
+		iter++;
+	} else
+		while (g_ascii_isdigit (*iter))
+			iter++;
+	if (*iter == '.') {
+		iter++;
+		if (*iter == '*') {
+			spec->star_precision = TRUE;
+			iter++;
+		} else
+			while (g_ascii_isdigit (*iter))
+				iter++;
+	}
+
+	spec->flags_length = iter - format;
+
+	for (;;) {
+		if (*iter == 'h') {
+			iter++;
+		} else if (*iter == 'l') {
+			n_longs++;
+			iter++;
+		} else if (*iter == 'q' || *iter == 'j' || *iter == 'L') {
+			is_int64 = TRUE;
+			iter++;
+		} else if (*iter == 'z' || *iter == 't') {
+			is_size = TRUE;
+			iter++;
+		} else if (*iter == 'I') {
+			/* Windows G_GINT64_MODIFIER */
+			if (iter[1] == '6' && iter[2] == '4') {
+				is_int64 = TRUE;
+				iter += 3;
+			} else if (iter[1] == '3' && iter[2] == '2') {
+				iter += 3;
+			} else {
+				is_size = TRUE;
+				iter++;
+			}
+		} else
+			break;
+	}
+
+	spec->conversion = *iter;
+
+	switch (*iter) {
+		case '%':
+			spec->type = ARV_DEBUG_ARG_NONE;
+			break;
+		case 'o':
+		case 'u':
+		case 'x':
+		case 'X':
+			spec->is_unsigned = TRUE;
+			/* Fall through */
+		case 'd':
+		case 'i':
+			if (is_int64 || n_longs > 1)
+				spec->type = ARV_DEBUG_ARG_INT64;
+			else if (is_size)
+				spec->type = ARV_DEBUG_ARG_SIZE;
+			else if (n_longs == 1)
+				spec->type = ARV_DEBUG_ARG_LONG;
+			else
+				spec->type = ARV_DEBUG_ARG_INT;
+			break;
+		case 'c':
+			spec->type = n_longs > 0 ? ARV_DEBUG_ARG_INVALID : ARV_DEBUG_ARG_CHAR;
+			break;
+		case 'e':
+		case 'E':
+		case 'f':
+		case 'F':
+		case 'g':
+		case 'G':
+		case 'a':
+		case 'A':
+			spec->type = is_int64 ? ARV_DEBUG_ARG_INVALID : ARV_DEBUG_ARG_DOUBLE;
+			break;
+		case 's':
+			spec->type = n_longs > 0 ? ARV_DEBUG_ARG_INVALID : ARV_DEBUG_ARG_STRING;
+			break;
+		case 'p':
+			spec->type = ARV_DEBUG_ARG_POINTER;
+			break;
+		default:
+			spec->type = ARV_DEBUG_ARG_INVALID;
+			return iter;
+	}
+
+	return iter + 1;
+}
+
+static gboolean
+_record_append (ArvDebugRecord *record, const void *data, gsize size)
+{
+	if (record->size + size > ARV_DEBUG_RECORD_DATA_SIZE) {
+		record->truncated = TRUE;
+		return FALSE;
+	}
+
+	memcpy (&record->data[record->size], data, size);
+	record->size += size;
+
+	return TRUE;
+}
+
+static gboolean
+_record_append_int (ArvDebugRecord *record, gint64 value)
+{
+	return _record_append (record, &value, sizeof (value));
+}
+
+static void
+_record_capture_arguments (ArvDebugRecord *record, const char *format, va_list args)
+{
+	const char *iter = format;
+
+	while ((iter = strchr (iter, '%')) != NULL) {
+		ArvDebugSpec spec;
+		gint64 value = 0;
+		double double_value;
+		const char *string;
+		guint16 length;
+
+		iter = _parse_spec (iter + 1, &spec);
+
+		if (spec.type == ARV_DEBUG_ARG_NONE)
+			continue;
+		if (spec.type == ARV_DEBUG_ARG_INVALID) {
+			record->truncated = TRUE;
+			return;
+		}
+
+		if (spec.star_width && !_record_append_int (record, va_arg (args, int)))
+			return;
+		if (spec.star_precision && !_record_append_int (record, va_arg (args, int)))
+			return;
+
+		switch (spec.type) {
+			case ARV_DEBUG_ARG_INT:
+				value = spec.is_unsigned ? (gint64) va_arg (args, unsigned int) : va_arg (args, int);
+				break;
+			case ARV_DEBUG_ARG_LONG:
+				value = spec.is_unsigned ? (gint64) va_arg (args, unsigned long) : va_arg (args, long);
+				break;
+			case ARV_DEBUG_ARG_INT64:
+				value = va_arg (args, gint64);
+				break;
+			case ARV_DEBUG_ARG_SIZE:
+				value = spec.is_unsigned ? (gint64) va_arg (args, gsize) : va_arg (args, gssize);
+				break;
+			case ARV_DEBUG_ARG_CHAR:
+				value = va_arg (args, int);
+				break;
+			case ARV_DEBUG_ARG_POINTER:
+				value = (gint64) GPOINTER_TO_SIZE (va_arg (args, void *));
+				break;
+			case ARV_DEBUG_ARG_DOUBLE:
+				double_value = va_arg (args, double);
+				if (!_record_append (record, &double_value, sizeof (double_value)))
+					return;
+				continue;
+			case ARV_DEBUG_ARG_STRING:
+				string = va_arg (args, const char *);
+				if (string == NULL)
+					string = "(null)";
+				length = MIN (strlen (string), G_MAXUINT16);
+				if (record->size + sizeof (length) + length > ARV_DEBUG_RECORD_DATA_SIZE) {
+					if (record->size + sizeof (length) >= ARV_DEBUG_RECORD_DATA_SIZE) {
+						record->truncated = TRUE;
+						return;
+					}
+					length = ARV_DEBUG_RECORD_DATA_SIZE - record->size - sizeof (length);
+					record->truncated = TRUE;
+				}
+				_record_append (record, &length, sizeof (length));
+				_record_append (record, string, length);
+				continue;
+			default:
+				g_assert_not_reached ();
+		}
+
+		if (!_record_append_int (record, value))
+			return;
+	}
+}
+
+static ArvDebugRecord *
+_ring_claim_record (ArvDebugCategory category, ArvDebugLevel level, ArvDebugRecordType type, guint *index)
+{
+	ArvDebugRecord *record;
+
+	*index = (guint) g_atomic_int_add (&arv_debug_ring.head, 1);
+	record = &arv_debug_ring.records[*index & (arv_debug_ring.n_records - 1)];
+
+	g_atomic_int_set (&record->sequence, 0);
+
+	record->category = category;
+	record->level = level;
+	record->type = type;
+	record->truncated = FALSE;
+	record->size = 0;
+	record->original_size = 0;
+	record->time_us = g_get_real_time ();
+	record->format = NULL;
+	record->formatter = NULL;
+
+	return record;
+}
+
+static void
+_ring_commit_record (ArvDebugRecord *record, guint index)
+{
+	g_atomic_int_set (&record->sequence, (gint) (index + 1));
+}
+
+static void
+_ring_record_format (ArvDebugCategory category, ArvDebugLevel level, const char *format, va_list args)
+{
+	ArvDebugRecord *record;
+	guint index;
+
+	record = _ring_claim_record (category, level, ARV_DEBUG_RECORD_TYPE_FORMAT, &index);
+	record->format = format;
+	_record_capture_arguments (record, format, args);
+	_ring_commit_record (record, index);
+}
+
+static gboolean
+_read_int (const ArvDebugRecord *record, gsize *offset, gint64 *value)
+{
+	if (*offset + sizeof (gint64) > record->size)
+		return FALSE;
+
+	memcpy (value, &record->data[*offset], sizeof (gint64));
+	*offset += sizeof (gint64);
+
+	return TRUE;
+}
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#endif
+
+static char *
+_record_format_message (const ArvDebugRecord *record)
+{
+	GString *string;
+	const char *iter;
+	const char *next;
+	gsize offset = 0;
+
+	string = g_string_new ("");
+
+	for (iter = record->format; (next = strchr (iter, '%')) != NULL; ) {
+		ArvDebugSpec spec;
+		GString *spec_string;
+		gint64 value;
+		gboolean success = TRUE;
+
+		g_string_append_len (string, iter, next - iter);
+		iter = _parse_spec (next + 1, &spec);
+
+		if (spec.type == ARV_DEBUG_ARG_NONE) {
+			g_string_append_c (string, '%');
+			continue;
+		}
+		if (spec.type == ARV_DEBUG_ARG_INVALID)
+			break;
+
+		/* Rebuild a single argument format string, with the star width and precision replaced by their
+		 * recorded values */
+
+		spec_string = g_string_new ("%");
+		{
+			const char *flag;
+
+			for (flag = spec.flags; flag < spec.flags + spec.flags_length; flag++) {
+				if (*flag == '*') {
+					success = success && _read_int (record, &offset, &value);
+					g_string_append_printf (spec_string, "%d", (int) value);
+				} else
+					g_string_append_c (spec_string, *flag);
+			}
+		}
+
+		switch (spec.type) {
+			case ARV_DEBUG_ARG_INT:
+			case ARV_DEBUG_ARG_LONG:
+			case ARV_DEBUG_ARG_INT64:
+			case ARV_DEBUG_ARG_SIZE:
+				g_string_append_printf (spec_string, "%s%c", G_GINT64_MODIFIER, spec.conversion);
+				success = success && _read_int (record, &offset, &value);
+				if (success)
+					g_string_append_printf (string, spec_string->str, value);
+				break;
+			case ARV_DEBUG_ARG_CHAR:
+				g_string_append_c (spec_string, spec.conversion);
+				success = success && _read_int (record, &offset, &value);
+				if (success)
+					g_string_append_printf (string, spec_string->str, (int) value);
+				break;
+			case ARV_DEBUG_ARG_POINTER:
+				g_string_append_c (spec_string, spec.conversion);
+				success = success && _read_int (record, &offset, &value);
+				if (success)
+					g_string_append_printf (string, spec_string->str, GSIZE_TO_POINTER ((gsize) value));
+				break;
+			case ARV_DEBUG_ARG_DOUBLE:
+				g_string_append_c (spec_string, spec.conversion);
+				success = success && offset + sizeof (double) <= record->size;
+				if (success) {
+					double double_value;
+
+					memcpy (&double_value, &record->data[offset], sizeof (double));
+					offset += sizeof (double);
+					g_string_append_printf (string, spec_string->str, double_value);
+				}
+				break;
+			case ARV_DEBUG_ARG_STRING:
+				g_string_append_c (spec_string, spec.conversion);
+				success = success && offset + sizeof (guint16) <= record->size;
+				if (success) {
+					char buffer[ARV_DEBUG_RECORD_DATA_SIZE + 1];
+					guint16 length;
+
+					memcpy (&length, &record->data[offset], sizeof (length));
+					offset += sizeof (length);
+					length = MIN (length, record->size - offset);
+					memcpy (buffer, &record->data[offset], length);
+					buffer[length] = '\0';
+					offset += length;
+					g_string_append_printf (string, spec_string->str, buffer);
+				}
+				break;
+			default:
+				success = FALSE;
+				break;
+		}
+
+		g_string_free (spec_string, TRUE);
+
+		if (!success)
+			break;
+	}
+
+	if (next == NULL)
+		g_string_append (string, iter);
+	if (record->truncated)
+		g_string_append (string, "…");
+
+	return arv_g_string_free_and_steal (string);
+}
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+static void
+_append_message (GString *string, gint64 time_us, ArvDebugCategory category, ArvDebugLevel level,
+		 const char *text, gboolean use_color)
+{
+	GDateTime *date;
+	char *time_str;
+	char **lines;
+	int header_length;
+	gint i;
+
+	date = g_date_time_new_from_unix_local (time_us / G_USEC_PER_SEC);
+	time_str = g_date_time_format (date, "%H:%M:%S");
+
+	if (use_color)
+		g_string_append_printf (string, "[\033[34m%s.%03d\033[0m] %s%s%s\033[0m> ",
+					time_str, (int) ((time_us % G_USEC_PER_SEC) / 1000),
+					arv_debug_level_infos[level].color,
+					arv_debug_level_infos[level].symbol,
+					arv_debug_category_infos[category].name);
+	else
+		g_string_append_printf (string, "[%s.%03d] %s%s> ",
+					time_str, (int) ((time_us % G_USEC_PER_SEC) / 1000),
+					arv_debug_level_infos[level].symbol,
+					arv_debug_category_infos[category].name);
+
+	header_length = 19 + strlen (arv_debug_category_infos[category].name);
+
+	lines = g_strsplit (text, "\n", -1);
+	for (i = 0; lines[i] != NULL; i++) {
+		if (strlen (lines[i]) >0)
+			g_string_append_printf (string, "%*s%s\n", i > 0 ? header_length : 0, "", lines[i]);
+	}
+	g_strfreev (lines);
+
+	g_free (time_str);
+	g_date_time_unref (date);
+}
+
+static char *
+_ring_dump (gboolean use_color)
+{
+	GString *string;
+	guint head;
+	guint index;
+
+	string = g_string_new ("");
+
+	g_mutex_lock (&arv_debug_ring_mutex);
+
+	if (arv_debug_ring.records == NULL) {
+		g_mutex_unlock (&arv_debug_ring_mutex);
+		return arv_g_string_free_and_steal (string);
+	}
+
+	head = (guint) g_atomic_int_get (&arv_debug_ring.head);
+	index = arv_debug_ring.tail;
+	if (head - index > arv_debug_ring.n_records) {
+		g_string_append_printf (string, "[…] %u debug records lost\n",
+					head - index - arv_debug_ring.n_records);
+		index = head - arv_debug_ring.n_records;
+	}
+
+	for (; index != head; index++) {
+		ArvDebugRecord *slot = &arv_debug_ring.records[index & (arv_debug_ring.n_records - 1)];
+		ArvDebugRecord record;
+		char *text;
+
+		/* Skip the records being written or already overwritten */
+		if (g_atomic_int_get (&slot->sequence) != (gint) (index + 1))
+			continue;
+		memcpy (&record, slot, sizeof (ArvDebugRecord));
+		if (g_atomic_int_get (&slot->sequence) != (gint) (index + 1))
+			continue;
+
+		if (record.type == ARV_DEBUG_RECORD_TYPE_BINARY) {
+			guint8 data[ARV_DEBUG_RECORD_DATA_SIZE] = {0};
+
+			memcpy (data, record.data, record.size);
+			text = record.formatter (data, record.original_size);
+		} else
+			text = _record_format_message (&record);
+
+		if (text != NULL)
+			_append_message (string, record.time_us, record.category, record.level, text, use_color);
+		g_free (text);
+	}
+
+	arv_debug_ring.tail = head;
+
+	g_mutex_unlock (&arv_debug_ring_mutex);
+
+	return arv_g_string_free_and_steal (string);
+}
+
 static void arv_debug_with_level (ArvDebugCategory category,
 				  ArvDebugLevel level,
 				  const char *format,
@@ -145,54 +682,63 @@ static void arv_debug_with_level (ArvDebugCategory category,
 static void
 arv_debug_with_level (ArvDebugCategory category, ArvDebugLevel level, const char *format, va_list args)
 {
-        char *text = NULL;
-        char *header = NULL;
-	char *time_str = NULL;
-        GDateTime *date = NULL;
-        char **lines;
-        gint i;
+	GString *string;
+	char *text;
 
 	if (!arv_debug_check (category, level))
 		return;
 
-        date = g_date_time_new_now_local ();
-        time_str = g_date_time_format (date, "%H:%M:%S");
-
-	if (stderr_has_color_support ())
-                header = g_strdup_printf ("[\033[34m%s.%03d\033[0m] %s%s%s\033[0m> ",
-                                          time_str, g_date_time_get_microsecond (date) / 1000,
-                                          arv_debug_level_infos[level].color,
-                                          arv_debug_level_infos[level].symbol,
-                                          arv_debug_category_infos[category].name);
-        else
-                header = g_strdup_printf ("[%s.%03d] %s%s> ",
-                                          time_str, g_date_time_get_microsecond (date) / 1000,
-                                          arv_debug_level_infos[level].symbol,
-                                          arv_debug_category_infos[category].name);
-
-        if (header != NULL) {
-                int header_length = 19 + strlen (arv_debug_category_infos[category].name);
-
-                g_fprintf (stderr, "%s", header);
-
-                text = g_strdup_vprintf (format, args);
-                lines = g_strsplit (text, "\n", -1);
-
-                for (i = 0; lines[i] != NULL; i++) {
-                        if (strlen (lines[i]) >0)
-                                g_fprintf (stderr, "%*s%s\n", i > 0 ? header_length : 0, "", lines[i]);
-                }
-
-                g_strfreev (lines);
-                #ifdef G_OS_WIN32
-                         fflush(stderr);
-                #endif
-        }
-
-        g_free (text);
-        g_free (header);
-        g_free (time_str);
-        g_date_time_unref (date);
+	if (g_atomic_int_get (&arv_debug_ring_enabled)) {
+		_ring_record_format (category, level, format, args);
+
+		if (level == ARV_DEBUG_LEVEL_WARNING) {
+			text = _ring_dump (stderr_has_color_support ());
+			g_fprintf (stderr, "%s", text);
+			g_free (text);
+		}
+
+		return;
+	}
+
+	string = g_string_new ("");
+	text = g_strdup_vprintf (format, args);
+
+	_append_message (string, g_get_real_time (), category, level, text, stderr_has_color_support ());
+
+	g_fprintf (stderr, "%s", string->str);
+#ifdef G_OS_WIN32
+	fflush (stderr);
+#endif
+
+	g_free (text);
+	g_string_free (string, TRUE);
+}
+
+gboolean
+arv_debug_ring_is_enabled (void)
+{
+	return g_atomic_int_get (&arv_debug_ring_enabled);
+}
+
+void
+arv_debug_record_binary (ArvDebugCategory category, ArvDebugLevel level, ArvDebugFormatFunc formatter,
+			 const void *data, size_t size)
+{
+	ArvDebugRecord *record;
+	guint index;
+
+	g_return_if_fail (formatter != NULL);
+
+	if (!arv_debug_check (category, level) ||
+	    !g_atomic_int_get (&arv_debug_ring_enabled))
+		return;
+
+	record = _ring_claim_record (category, level, ARV_DEBUG_RECORD_TYPE_BINARY, &index);
+	record->formatter = formatter;
+	record->original_size = size;
+	record->truncated = size > ARV_DEBUG_RECORD_DATA_SIZE;
+	_record_append (record, data, MIN (size, ARV_DEBUG_RECORD_DATA_SIZE));
+	_ring_commit_record (record, index);
 }
 
 void
@@ -259,6 +805,70 @@ arv_debug_enable (const char *category_selection)
 	return arv_debug_initialize (category_selection);
 }
 
+/**
+ * arv_debug_enable_ring_buffer:
+ * @n_records: number of records of the ring buffer, 0 to disable it
+ *
+ * Redirects the debug output to an in-memory binary ring buffer. Instead of being formatted and printed at
+ * emission time, the messages are stored in a preallocated ring of @n_records fixed size records, without memory
+ * allocation nor locking, and formatted later, when arv_debug_dump_ring_buffer() is called. Each time a
+ * warning is emitted, the ring content is also dumped on stderr. This allows to keep stream thread debug output
+ * enabled in the field, without its overhead causing the packet losses it is supposed to diagnose.
+ *
+ * @n_records is rounded up to the next power of two, and clamped to 1048576 records. The ring buffer can only be
+ * allocated once, a subsequent call with a different size fails.
+ *
+ * The `ARV_DEBUG_RING` environment variable can be used to enable the ring buffer at startup, its value being the
+ * number of records, or an empty string for the default size of 4096 records.
+ *
+ * Returns: %TRUE on success
+ *
+ * Since: 0.9.0
+ */
+
+gboolean
+arv_debug_enable_ring_buffer (guint n_records)
+{
+	gboolean success = TRUE;
+
+	if (n_records == 0) {
+		g_atomic_int_set (&arv_debug_ring_enabled, FALSE);
+		return TRUE;
+	}
+
+	n_records = CLAMP (n_records, 2, ARV_DEBUG_RING_MAX_SIZE);
+	n_records = 1U << g_bit_storage (n_records - 1);
+
+	g_mutex_lock (&arv_debug_ring_mutex);
+	if (arv_debug_ring.records == NULL) {
+		arv_debug_ring.records = g_new0 (ArvDebugRecord, n_records);
+		arv_debug_ring.n_records = n_records;
+	} else if (arv_debug_ring.n_records != n_records)
+		success = FALSE;
+	g_mutex_unlock (&arv_debug_ring_mutex);
+
+	if (success)
+		g_atomic_int_set (&arv_debug_ring_enabled, TRUE);
+
+	return success;
+}
+
+/**
+ * arv_debug_dump_ring_buffer:
+ *
+ * Formats the debug records stored in the ring buffer since the last dump. See arv_debug_enable_ring_buffer().
+ *
+ * Returns: (transfer full): a newly allocated string, to be freed using g_free().
+ *
+ * Since: 0.9.0
+ */
+
+char *
+arv_debug_dump_ring_buffer (void)
+{
+	return _ring_dump (FALSE);
+}
+
 static char *
 arv_debug_dup_infos_as_string (void)
 {
@@ -301,6 +911,24 @@ arv_debug_print_infos (void)
 ARV_DEFINE_CONSTRUCTOR (arv_initialize_debug)
 static void
 arv_initialize_debug (void) {
+	const char *ring_size;
+
 	arv_debug_initialize (g_getenv ("ARV_DEBUG"));
+
+	ring_size = g_getenv ("ARV_DEBUG_RING");
+	if (ring_size != NULL) {
+		guint64 n_records = ARV_DEBUG_RING_DEFAULT_SIZE;
+
+		if (ring_size[0] != '\0') {
+			char *end;
+
+			n_records = g_ascii_strtoull (ring_size, &end, 10);
+			/* Reject signed or malformed values */
+			if (!g_ascii_isdigit (ring_size[0]) || *end != '\0')
+				n_records = ARV_DEBUG_RING_DEFAULT_SIZE;
+		}
+
+		arv_debug_enable_ring_buffer (MIN (n_records, ARV_DEBUG_RING_MAX_SIZE));
+	}
 }
 
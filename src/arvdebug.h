@@ -33,6 +33,8 @@
 G_BEGIN_DECLS
 
 ARV_API gboolean	arv_debug_enable		(const char *category_selection);
+ARV_API gboolean	arv_debug_enable_ring_buffer	(guint n_records);
+ARV_API char *		arv_debug_dump_ring_buffer	(void);
 
 G_END_DECLS
 
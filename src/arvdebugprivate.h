@@ -123,6 +123,18 @@ extern ArvDebugCategoryInfos arv_debug_category_infos[];
 
 gboolean	arv_debug_check			(ArvDebugCategory category, ArvDebugLevel level);
 
+/* Deferred formatting of binary debug records, see arv_debug_enable_ring_buffer(). The data passed to the formatter is
+ * a writable copy, zero padded up to ARV_DEBUG_RECORD_DATA_SIZE bytes, and size is the size of the original data,
+ * which may be larger. */
+
+#define ARV_DEBUG_RECORD_DATA_SIZE	448
+
+typedef char *	(*ArvDebugFormatFunc)		(void *data, size_t size);
+
+gboolean	arv_debug_ring_is_enabled	(void);
+void		arv_debug_record_binary		(ArvDebugCategory category, ArvDebugLevel level,
+						 ArvDebugFormatFunc formatter, const void *data, size_t size);
+
 /* private, but used by viewer */
 ARV_API void	arv_warning 			(ArvDebugCategory category, const char *format, ...) G_GNUC_PRINTF (2,3);
 ARV_API void	arv_info 			(ArvDebugCategory category, const char *format, ...) G_GNUC_PRINTF (2,3);
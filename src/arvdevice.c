@@ -41,6 +41,7 @@
 #include <arvgcregister.h>
 #include <arvgcstring.h>
 #include <arvstream.h>
+#include <arvmetricsprivate.h>
 #include <arvdebug.h>
 
 enum {
@@ -59,9 +60,18 @@ arv_device_error_quark (void)
 	return g_quark_from_static_string ("arv-device-error-quark");
 }
 
+typedef struct {
+        char *name;
+        char *description;
+        guint64 *data;
+} ArvDeviceInfo;
+
 typedef struct {
 	GError *init_error;
         GSList *streams;
+
+        GMutex infos_mutex;
+        GPtrArray *infos;
 } ArvDevicePrivate;
 
 static void arv_device_initable_iface_init (GInitableIface *iface);
@@ -1384,9 +1394,129 @@ void arv_device_take_init_error (ArvDevice *device, GError *error)
 	priv->init_error = error;
 }
 
+static void
+arv_device_info_free (ArvDeviceInfo *info)
+{
+        if (info == NULL)
+                return;
+
+        g_free (info->name);
+        g_free (info->description);
+        g_free (info);
+}
+
+/* Device infos are monotonic counters maintained by the device implementations, exported by the metrics module */
+
+void
+arv_device_declare_info (ArvDevice *device, const char *name, const char *description, guint64 *data)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+        ArvDeviceInfo *info;
+
+	g_return_if_fail (ARV_IS_DEVICE (device));
+        g_return_if_fail (name != NULL);
+        g_return_if_fail (data != NULL);
+
+        info = g_new0 (ArvDeviceInfo, 1);
+        info->name = g_strdup (name);
+        info->description = g_strdup (description);
+        info->data = data;
+
+        g_mutex_lock (&priv->infos_mutex);
+        g_ptr_array_add (priv->infos, info);
+        g_mutex_unlock (&priv->infos_mutex);
+}
+
+guint
+arv_device_get_n_infos (ArvDevice *device)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+        guint n_infos;
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), 0);
+
+        g_mutex_lock (&priv->infos_mutex);
+        n_infos = priv->infos->len;
+        g_mutex_unlock (&priv->infos_mutex);
+
+        return n_infos;
+}
+
+const char *
+arv_device_get_info_name (ArvDevice *device, guint id)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+        ArvDeviceInfo *info;
+        const char *value = NULL;
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), NULL);
+
+        g_mutex_lock (&priv->infos_mutex);
+        if (id < priv->infos->len) {
+                info = g_ptr_array_index (priv->infos, id);
+                value = info->name;
+        }
+        g_mutex_unlock (&priv->infos_mutex);
+
+        return value;
+}
+
+const char *
+arv_device_get_info_description (ArvDevice *device, guint id)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+        ArvDeviceInfo *info;
+        const char *value = NULL;
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), NULL);
+
+        g_mutex_lock (&priv->infos_mutex);
+        if (id < priv->infos->len) {
+                info = g_ptr_array_index (priv->infos, id);
+                value = info->description;
+        }
+        g_mutex_unlock (&priv->infos_mutex);
+
+        return value;
+}
+
+guint64
+arv_device_get_info_uint64 (ArvDevice *device, guint id)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+        ArvDeviceInfo *info;
+        guint64 value = 0;
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), 0);
+
+        g_mutex_lock (&priv->infos_mutex);
+        if (id < priv->infos->len) {
+                info = g_ptr_array_index (priv->infos, id);
+                value = *info->data;
+        }
+        g_mutex_unlock (&priv->infos_mutex);
+
+        return value;
+}
+
 static void
 arv_device_init (ArvDevice *device)
 {
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+
+        g_mutex_init (&priv->infos_mutex);
+        priv->infos = g_ptr_array_new_with_free_func ((GDestroyNotify) arv_device_info_free);
+}
+
+/* The device is removed from the metrics registry before the subclasses release their resources. Subclasses
+ * overriding dispose must chain up before freeing the data of their declared infos. */
+
+static void
+arv_device_dispose (GObject *object)
+{
+        arv_metrics_unregister_device (ARV_DEVICE (object));
+
+	G_OBJECT_CLASS (arv_device_parent_class)->dispose (object);
 }
 
 static void
@@ -1403,6 +1533,9 @@ arv_device_finalize (GObject *object)
         }
         g_slist_free(priv->streams);
 
+        g_ptr_array_unref (priv->infos);
+        g_mutex_clear (&priv->infos_mutex);
+
 	G_OBJECT_CLASS (arv_device_parent_class)->finalize (object);
 }
 
@@ -1411,6 +1544,7 @@ arv_device_class_init (ArvDeviceClass *device_class)
 {
 	GObjectClass *object_class = G_OBJECT_CLASS (device_class);
 
+	object_class->dispose = arv_device_dispose;
 	object_class->finalize = arv_device_finalize;
 
 	/**
@@ -1479,6 +1613,8 @@ arv_device_initable_init (GInitable     *initable,
 		return FALSE;
 	}
 
+        arv_metrics_register_device (ARV_DEVICE (initable));
+
 	return TRUE;
 }
 
@@ -37,6 +37,13 @@ void 		arv_device_emit_device_event_signal 	(ArvDevice *device, int event_id);
 #endif
 void		arv_device_take_init_error		(ArvDevice *device, GError *error);
 
+void		arv_device_declare_info			(ArvDevice *device, const char *name, const char *description,
+							 guint64 *data);
+guint		arv_device_get_n_infos			(ArvDevice *device);
+const char *	arv_device_get_info_name		(ArvDevice *device, guint id);
+const char *	arv_device_get_info_description		(ArvDevice *device, guint id);
+guint64		arv_device_get_info_uint64		(ArvDevice *device, guint id);
+
 G_END_DECLS
 
 #endif
@@ -221,7 +221,7 @@ static ArvDomDocument *
 _parse_memory (ArvDomDocument *document, ArvDomNode *node,
 	       const void *buffer, int size, GError **error)
 {
-	static ArvDomSaxParserState state;
+	ArvDomSaxParserState state = {0};
 
 	state.document = document;
 	if (node != NULL)
@@ -233,7 +233,8 @@ _parse_memory (ArvDomDocument *document, ArvDomNode *node,
 		size = strlen (buffer);
 
 	if (xmlSAXUserParseMemory (&sax_handler, &state, buffer, size) < 0) {
-		if (state.document !=  NULL)
+		/* Only release a document created by the parser, not the one we are appending to */
+		if (state.document != NULL && state.document != document)
 			g_object_unref (state.document);
 		state.document = NULL;
 
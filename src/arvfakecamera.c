@@ -30,7 +30,7 @@
  * arv-fake-gv-camera is a GV camera simulator based on this class.
  */
 
-#include <arvfakecamera.h>
+#include <arvfakecameraprivate.h>
 #include <arvversion.h>
 #include <arvgc.h>
 #include <arvgcregisternode.h>
@@ -64,6 +64,21 @@ arv_get_fake_camera_genicam_filename (void)
 	return arv_fake_camera_genicam_filename;
 }
 
+/* Precomputed diagonal ramp, see _ramp_update () */
+
+typedef struct {
+	guint32 width;
+	ArvPixelFormat pixel_format;
+	guint32 exposure_time_us;
+	guint32 gain;
+
+	guint period;
+	guint pixel_size;
+	guint n_lines;
+	size_t line_size;
+	guint8 *lines;
+} ArvFakeCameraRamp;
+
 typedef struct {
 	void *memory;
 
@@ -78,6 +93,8 @@ typedef struct {
 
 	ArvFakeCameraFillPattern fill_pattern_callback;
 	void *fill_pattern_data;
+
+	ArvFakeCameraRamp ramp;
 } ArvFakeCameraPrivate;
 
 struct _ArvFakeCamera {
@@ -199,7 +216,9 @@ arv_fake_camera_get_payload (ArvFakeCamera *camera)
 	height = _get_register (camera, ARV_FAKE_CAMERA_REGISTER_HEIGHT);
         pixel_format = _get_register (camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT);
 
-	return width * height * ARV_PIXEL_FORMAT_BIT_PER_PIXEL(pixel_format)/8;
+	return width * height * ARV_PIXEL_FORMAT_BIT_PER_PIXEL(pixel_format)/8 +
+		(_get_register (camera, ARV_FAKE_CAMERA_REGISTER_CHUNK_MODE_ACTIVE) != 0 ?
+		 ARV_FAKE_CAMERA_CHUNK_DATA_SIZE : 0);
 }
 
 /**
@@ -508,208 +527,196 @@ static struct {
    {128,     0,   0},
   };
 
-static void
-arv_fake_camera_diagonal_ramp (ArvBuffer *buffer, void *fill_pattern_data,
-			       guint32 exposure_time_us,
-			       guint32 gain,
-			       ArvPixelFormat pixel_format)
+/* As the diagonal ramp value only depends on (x + y + frame_id) modulo the ramp period, each image row is a window
+ * of a periodic line, computed once per image width, pixel format and scale. Rows are then simply copied from the
+ * line at an offset rolling with the row index and the frame id. Bayer patterns need a line for each combination
+ * of row parity and window offset parity. */
+
+static gboolean
+_ramp_update (ArvFakeCameraRamp *ramp, guint32 width, ArvPixelFormat pixel_format,
+	      guint32 exposure_time_us, guint32 gain)
 {
-	double pixel_value;
 	double scale;
-	guint32 x, y;
-	guint32 width;
-	guint32 height;
+	guint8 *lut = NULL;
+	guint n_pixels;
+	guint i, j;
+
+	if (ramp->lines != NULL &&
+	    ramp->width == width &&
+	    ramp->pixel_format == pixel_format &&
+	    ramp->exposure_time_us == exposure_time_us &&
+	    ramp->gain == gain)
+		return TRUE;
 
-        g_return_if_fail (buffer != NULL);
-        g_return_if_fail (buffer->priv->n_parts == 1);
+	g_clear_pointer (&ramp->lines, g_free);
 
-	width = buffer->priv->parts[0].width;
-	height = buffer->priv->parts[0].height;
+	switch (pixel_format) {
+		case ARV_PIXEL_FORMAT_MONO_8:
+			ramp->period = 255;
+			ramp->pixel_size = 1;
+			ramp->n_lines = 1;
+			break;
+		case ARV_PIXEL_FORMAT_MONO_16:
+			ramp->period = 65535;
+			ramp->pixel_size = 2;
+			ramp->n_lines = 1;
+			break;
+		case ARV_PIXEL_FORMAT_BAYER_BG_8:
+		case ARV_PIXEL_FORMAT_BAYER_GB_8:
+		case ARV_PIXEL_FORMAT_BAYER_GR_8:
+		case ARV_PIXEL_FORMAT_BAYER_RG_8:
+			ramp->period = 255;
+			ramp->pixel_size = 1;
+			ramp->n_lines = 4;
+			break;
+		case ARV_PIXEL_FORMAT_RGB_8_PACKED:
+			ramp->period = 255;
+			ramp->pixel_size = 3;
+			ramp->n_lines = 1;
+			break;
+		default:
+			return FALSE;
+	}
+
+	ramp->width = width;
+	ramp->pixel_format = pixel_format;
+	ramp->exposure_time_us = exposure_time_us;
+	ramp->gain = gain;
 
 	scale = 1.0 + gain + log10 ((double) exposure_time_us / 10000.0);
 
-	switch (pixel_format)
-	{
-		case ARV_PIXEL_FORMAT_MONO_8:
-			if (height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned char *pixel = &buffer->priv->data [y * width + x];
+	n_pixels = ramp->period + width;
+	ramp->line_size = (size_t) n_pixels * ramp->pixel_size;
+	ramp->lines = g_malloc (ramp->line_size * ramp->n_lines);
 
-						pixel_value = (x + buffer->priv->frame_id + y) % 255;
-						pixel_value *= scale;
+	if (ramp->period == 255) {
+		lut = g_malloc (ramp->period);
+		for (i = 0; i < ramp->period; i++)
+			lut[i] = CLAMP (i * scale, 0, 255);
+	}
 
-						*pixel = CLAMP (pixel_value, 0, 255);
-					}
-				}
-                                buffer->priv->received_size = height * width;
-			}
+	switch (pixel_format) {
+		case ARV_PIXEL_FORMAT_MONO_8:
+			for (j = 0; j < n_pixels; j++)
+				ramp->lines[j] = lut[j % 255];
 			break;
-
 		case ARV_PIXEL_FORMAT_MONO_16:
-			if (2 * height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned short *pixel = (unsigned short *)&buffer->priv->data [2*y * width + 2*x];
+			{
+				guint16 *line = (guint16 *) ramp->lines;
 
-						pixel_value = (256*x + 256*buffer->priv->frame_id + 256*y) % 65535;
-						pixel_value *= scale;
+				for (j = 0; j < n_pixels; j++) {
+					double pixel_value = (256 * (j % 65535)) % 65535;
 
-						*pixel = CLAMP (pixel_value, 0, 65535);
-					}
+					line[j] = CLAMP (pixel_value * scale, 0, 65535);
 				}
-                                buffer->priv->received_size = 2 * height * width;
 			}
 			break;
+		case ARV_PIXEL_FORMAT_RGB_8_PACKED:
+			for (j = 0; j < n_pixels; j++) {
+				guint8 *pixel = &ramp->lines[3 * j];
+				guint index = lut[j % 255];
 
-		case ARV_PIXEL_FORMAT_BAYER_BG_8:
-			if (height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned int index;
-						unsigned char *pixel;
-
-						pixel_value = (x + buffer->priv->frame_id + y) % 255;
-						pixel_value *= scale;
-						index = CLAMP (pixel_value, 0, 255);
-
-						// BG
-						// GR
-						pixel = &buffer->priv->data [y * width + x];
-						if (x & 1) {
-							if (y & 1)
-								*pixel = jet_colormap [index].b;
-							else
-								*pixel = jet_colormap [index].g;
-						} else {
-							if (y & 1)
-								*pixel = jet_colormap [index].g;
-							else
-								*pixel = jet_colormap [index].r;
-						}
-					}
-				}
-                                buffer->priv->received_size = height * width;
+				pixel[0] = jet_colormap [index].r;
+				pixel[1] = jet_colormap [index].g;
+				pixel[2] = jet_colormap [index].b;
 			}
 			break;
-
-		case ARV_PIXEL_FORMAT_BAYER_GB_8:
-			if (height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned int index;
-						unsigned char *pixel;
-
-						pixel_value = (x + buffer->priv->frame_id + y) % 255;
-						pixel_value *= scale;
-						index = CLAMP (pixel_value, 0, 255);
-
-						// GB
-						// RG
-						pixel = &buffer->priv->data [y * width + x];
-						if (x & 1) {
-							if (y & 1)
-								*pixel = jet_colormap [index].g;
-							else
-								*pixel = jet_colormap [index].b;
-						} else {
-							if (y & 1)
-								*pixel = jet_colormap [index].r;
-							else
-								*pixel = jet_colormap [index].g;
-						}
+		default:
+			/* Bayer, line (2 * y_parity + offset_parity). The color filter of a pixel depends on the parity
+			 * of its column, that is (j - offset), and of its row. */
+			for (i = 0; i < 4; i++) {
+				guint8 *line = ramp->lines + i * ramp->line_size;
+				gboolean odd_row = (i & 2) != 0;
+
+				for (j = 0; j < n_pixels; j++) {
+					gboolean odd_column = ((j + i) & 1) != 0;
+					guint index = lut[j % 255];
+					gboolean red, blue;
+
+					switch (pixel_format) {
+						case ARV_PIXEL_FORMAT_BAYER_BG_8:
+							red = !odd_column && !odd_row;
+							blue = odd_column && odd_row;
+							break;
+						case ARV_PIXEL_FORMAT_BAYER_GB_8:
+							red = !odd_column && odd_row;
+							blue = odd_column && !odd_row;
+							break;
+						case ARV_PIXEL_FORMAT_BAYER_GR_8:
+							red = odd_column && !odd_row;
+							blue = !odd_column && odd_row;
+							break;
+						default:
+							red = odd_column && odd_row;
+							blue = !odd_column && !odd_row;
+							break;
 					}
-				}
-                                buffer->priv->received_size = height * width;
-			}
-			break;
 
-		case ARV_PIXEL_FORMAT_BAYER_GR_8:
-			if (height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned int index;
-						unsigned char *pixel;
-
-						pixel_value = (x + buffer->priv->frame_id + y) % 255;
-						pixel_value *= scale;
-						index = CLAMP (pixel_value, 0, 255);
-
-						// GR
-						// BG
-						pixel = &buffer->priv->data [y * width + x];
-						if (x & 1) {
-							if (y & 1)
-								*pixel = jet_colormap [index].g;
-							else
-								*pixel = jet_colormap [index].r;
-						} else {
-							if (y & 1)
-								*pixel = jet_colormap [index].b;
-							else
-								*pixel = jet_colormap [index].g;
-						}
-					}
+					line[j] = red ? jet_colormap [index].r :
+						blue ? jet_colormap [index].b :
+						jet_colormap [index].g;
 				}
-                                buffer->priv->received_size = height * width;
 			}
 			break;
+	}
 
-		case ARV_PIXEL_FORMAT_BAYER_RG_8:
-			if (height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned int index;
-						unsigned char *pixel;
-
-						pixel_value = (x + buffer->priv->frame_id + y) % 255;
-						pixel_value *= scale;
-						index = CLAMP (pixel_value, 0, 255);
-
-						// RG
-						// GB
-						pixel = &buffer->priv->data [y * width + x];
-						if (x & 1) {
-							if (y & 1)
-								*pixel = jet_colormap [index].r;
-							else
-								*pixel = jet_colormap [index].g;
-						} else {
-							if (y & 1)
-								*pixel = jet_colormap [index].g;
-							else
-								*pixel = jet_colormap [index].b;
-						}
-					}
-				}
-                                buffer->priv->received_size = height * width;
-			}
-			break;
+	g_free (lut);
 
-		case ARV_PIXEL_FORMAT_RGB_8_PACKED:
-			if (3 * height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned char *pixel = &buffer->priv->data [3 * (y * width + x)];
-						unsigned int index;
+	return TRUE;
+}
+
+static void
+arv_fake_camera_diagonal_ramp (ArvBuffer *buffer, void *fill_pattern_data,
+			       guint32 exposure_time_us,
+			       guint32 gain,
+			       ArvPixelFormat pixel_format)
+{
+	ArvFakeCamera *camera = fill_pattern_data;
+	ArvFakeCameraRamp *ramp;
+	gboolean is_static;
+	size_t row_size;
+	guint frame_offset;
+	guint32 y;
+	guint32 width;
+	guint32 height;
 
-						pixel_value = (x + buffer->priv->frame_id + y) % 255;
-						pixel_value *= scale;
+        g_return_if_fail (ARV_IS_FAKE_CAMERA (camera));
+        g_return_if_fail (buffer != NULL);
+        g_return_if_fail (buffer->priv->n_parts == 1);
 
-						index = CLAMP (pixel_value, 0, 255);
+	ramp = &camera->priv->ramp;
 
-						pixel[0] = jet_colormap [index].r;
-						pixel[1] = jet_colormap [index].g;
-						pixel[2] = jet_colormap [index].b;
-					}
-				}
-                                buffer->priv->received_size = 3 * height * width;
-			}
-			break;
+	width = buffer->priv->parts[0].width;
+	height = buffer->priv->parts[0].height;
 
-		default:
-			g_critical ("Unsupported pixel format");
-			break;
+	if (!_ramp_update (ramp, width, pixel_format, exposure_time_us, gain)) {
+		g_critical ("Unsupported pixel format");
+		return;
+	}
+
+	row_size = (size_t) width * ramp->pixel_size;
+	if (row_size * height > buffer->priv->allocated_size)
+		return;
+
+	is_static = _get_register (camera, ARV_FAKE_CAMERA_REGISTER_TEST_PATTERN) ==
+		ARV_FAKE_CAMERA_TEST_PATTERN_STATIC;
+	frame_offset = is_static ? 0 : buffer->priv->frame_id % ramp->period;
+
+	for (y = 0; y < height; y++) {
+		guint offset = (y + frame_offset) % ramp->period;
+		const guint8 *line;
+
+		line = ramp->lines + ramp->line_size * (ramp->n_lines == 4 ? 2 * (y & 1) + (offset & 1) : 0);
+		memcpy (&buffer->priv->data[y * row_size], line + offset * ramp->pixel_size, row_size);
+	}
+
+	buffer->priv->received_size = row_size * height;
+
+	/* The static pattern only changes by the frame id, stamped as a big endian value in the first bytes */
+	if (is_static) {
+		guint32 frame_id = GUINT32_TO_BE (buffer->priv->frame_id);
+
+		memcpy (buffer->priv->data, &frame_id, MIN (sizeof (frame_id), buffer->priv->received_size));
 	}
 }
 
@@ -736,23 +743,35 @@ arv_fake_camera_set_fill_pattern (ArvFakeCamera *camera,
 		camera->priv->fill_pattern_data = fill_pattern_data;
 	} else {
 		camera->priv->fill_pattern_callback = arv_fake_camera_diagonal_ramp;
-		camera->priv->fill_pattern_data = NULL;
+		camera->priv->fill_pattern_data = camera;
 	}
 
 	g_mutex_unlock (&camera->priv->fill_pattern_mutex);
 }
 
-/**
- * arv_fake_camera_fill_buffer:
- * @camera: a #ArvFakeCamera
- * @buffer: the #ArvBuffer to fill
- * @packet_size: (out) (optional): the packet size
- *
- * Fill a buffer with data from the fake camera.
- */
+/* Appends a 64 bit big endian chunk after the received data, followed by its id and size */
+
+static void
+_append_chunk (ArvBuffer *buffer, guint32 chunk_id, guint64 value)
+{
+	guint8 *data = buffer->priv->data + buffer->priv->received_size;
+	guint64 value_be = GUINT64_TO_BE (value);
+	guint32 id_be = GUINT32_TO_BE (chunk_id);
+	guint32 size_be = GUINT32_TO_BE (sizeof (value));
+
+	memcpy (data, &value_be, sizeof (value_be));
+	memcpy (data + 8, &id_be, sizeof (id_be));
+	memcpy (data + 12, &size_be, sizeof (size_be));
+
+	buffer->priv->received_size += 16;
+}
+
+/* Fills @buffer, using and advancing @frame_counter for the frame id. Stream channels of the GigE Vision simulator
+ * have their own counter, so each channel sees consecutive frame ids. */
 
 void
-arv_fake_camera_fill_buffer (ArvFakeCamera *camera, ArvBuffer *buffer, guint32 *packet_size)
+arv_fake_camera_fill_buffer_with_frame_counter (ArvFakeCamera *camera, ArvBuffer *buffer,
+						guint32 *frame_counter, guint32 *packet_size)
 {
 	guint32 width;
 	guint32 height;
@@ -775,17 +794,20 @@ arv_fake_camera_fill_buffer (ArvFakeCamera *camera, ArvBuffer *buffer, guint32 *
 		return;
 	}
 
+	/* Buffers may be filled concurrently by several stream channels */
+	g_mutex_lock (&camera->priv->fill_pattern_mutex);
+
 	/* frame id is a 16 bit value, 0 is invalid */
-	camera->priv->frame_id = (camera->priv->frame_id + 1) % 65536;
-	if (camera->priv->frame_id == 0)
-		camera->priv->frame_id = 1;
+	*frame_counter = (*frame_counter + 1) % 65536;
+	if (*frame_counter == 0)
+		*frame_counter = 1;
 
 	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_IMAGE;
 	buffer->priv->chunk_endianness = G_BIG_ENDIAN;
 	buffer->priv->status = ARV_BUFFER_STATUS_SUCCESS;
 	buffer->priv->timestamp_ns = g_get_real_time () * 1000;
 	buffer->priv->system_timestamp_ns = buffer->priv->timestamp_ns;
-	buffer->priv->frame_id = camera->priv->frame_id;
+	buffer->priv->frame_id = *frame_counter;
 
         buffer->priv->parts[0].data_offset = 0;
         buffer->priv->parts[0].component_id = 0;
@@ -798,8 +820,6 @@ arv_fake_camera_fill_buffer (ArvFakeCamera *camera, ArvBuffer *buffer, guint32 *
         buffer->priv->parts[0].x_padding = 0;
         buffer->priv->parts[0].y_padding = 0;
 
-	g_mutex_lock (&camera->priv->fill_pattern_mutex);
-
 	arv_fake_camera_read_register (camera, ARV_FAKE_CAMERA_REGISTER_EXPOSURE_TIME_US, &exposure_time_us);
 	arv_fake_camera_read_register (camera, ARV_FAKE_CAMERA_REGISTER_GAIN_RAW, &gain);
 	arv_fake_camera_read_register (camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT, &pixel_format);
@@ -810,6 +830,14 @@ arv_fake_camera_fill_buffer (ArvFakeCamera *camera, ArvBuffer *buffer, guint32 *
 
         buffer->priv->parts[0].size = buffer->priv->received_size;
 
+	buffer->priv->has_chunks =
+		_get_register (camera, ARV_FAKE_CAMERA_REGISTER_CHUNK_MODE_ACTIVE) != 0 &&
+		buffer->priv->received_size + ARV_FAKE_CAMERA_CHUNK_DATA_SIZE <= buffer->priv->allocated_size;
+	if (buffer->priv->has_chunks) {
+		_append_chunk (buffer, ARV_FAKE_CAMERA_CHUNK_ID_FRAME_ID, buffer->priv->frame_id);
+		_append_chunk (buffer, ARV_FAKE_CAMERA_CHUNK_ID_TIMESTAMP, buffer->priv->timestamp_ns);
+	}
+
 	if (packet_size != NULL)
 		*packet_size =
 			(_get_register (camera, ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_OFFSET) >>
@@ -817,6 +845,24 @@ arv_fake_camera_fill_buffer (ArvFakeCamera *camera, ArvBuffer *buffer, guint32 *
 			ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_MASK;
 }
 
+/**
+ * arv_fake_camera_fill_buffer:
+ * @camera: a #ArvFakeCamera
+ * @buffer: the #ArvBuffer to fill
+ * @packet_size: (out) (optional): the packet size
+ *
+ * Fill a buffer with data from the fake camera.
+ */
+
+void
+arv_fake_camera_fill_buffer (ArvFakeCamera *camera, ArvBuffer *buffer, guint32 *packet_size)
+{
+	if (camera == NULL)
+		return;
+
+	arv_fake_camera_fill_buffer_with_frame_counter (camera, buffer, &camera->priv->frame_id, packet_size);
+}
+
 void
 arv_fake_camera_set_inet_address (ArvFakeCamera *camera, GInetAddress *address)
 {
@@ -989,7 +1035,7 @@ arv_fake_camera_new_full (const char *serial_number, const char *genicam_filenam
 
 	g_mutex_init (&fake_camera->priv->fill_pattern_mutex);
 	fake_camera->priv->fill_pattern_callback = arv_fake_camera_diagonal_ramp;
-	fake_camera->priv->fill_pattern_data = NULL;
+	fake_camera->priv->fill_pattern_data = fake_camera;
 
 	if (genicam_filename != NULL)
 		filename = g_strdup (genicam_filename);
@@ -1070,6 +1116,10 @@ arv_fake_camera_new_full (const char *serial_number, const char *genicam_filenam
 	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_GAIN_RAW, 0);
 	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_GAIN_MODE, 1);
 
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_TEST_PATTERN,
+					ARV_FAKE_CAMERA_TEST_PATTERN_DIAGONAL_RAMP_MOVING);
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_CHUNK_MODE_ACTIVE, 0);
+
 	arv_fake_camera_write_register (fake_camera, ARV_GVBS_HEARTBEAT_TIMEOUT_OFFSET, 3000);
 	arv_fake_camera_write_register (fake_camera, ARV_GVBS_TIMESTAMP_TICK_FREQUENCY_HIGH_OFFSET, 0);
 	arv_fake_camera_write_register (fake_camera, ARV_GVBS_TIMESTAMP_TICK_FREQUENCY_LOW_OFFSET, 1000000000);
@@ -1081,6 +1131,9 @@ arv_fake_camera_new_full (const char *serial_number, const char *genicam_filenam
 
 	arv_fake_camera_write_register (fake_camera, ARV_GVBS_N_STREAM_CHANNELS_OFFSET, 1);
 
+	arv_fake_camera_write_register (fake_camera, ARV_GVBS_GVCP_CAPABILITY_OFFSET,
+					ARV_GVBS_GVCP_CAPABILITY_PACKET_RESEND);
+
 	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_TEST, ARV_FAKE_CAMERA_TEST_REGISTER_DEFAULT);
 
 	return fake_camera;
@@ -1107,6 +1160,7 @@ arv_fake_camera_finalize (GObject *object)
 	ArvFakeCamera *fake_camera = ARV_FAKE_CAMERA (object);
 
 	g_mutex_clear (&fake_camera->priv->fill_pattern_mutex);
+	g_clear_pointer (&fake_camera->priv->ramp.lines, g_free);
 	g_clear_pointer (&fake_camera->priv->memory, g_free);
 	g_clear_pointer (&fake_camera->priv->genicam_xml, g_free);
         g_clear_pointer (&fake_camera->priv->genicam_xml_url, g_free);
@@ -51,6 +51,10 @@ ARV_API void			arv_set_fake_camera_genicam_filename (const char *filename);
 #define ARV_FAKE_CAMERA_REGISTER_BINNING_VERTICAL	0x10c
 #define ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT		0x128
 #define ARV_FAKE_CAMERA_REGISTER_TEST			0x1f0
+#define ARV_FAKE_CAMERA_REGISTER_TEST_PATTERN		0x144
+
+#define ARV_FAKE_CAMERA_TEST_PATTERN_DIAGONAL_RAMP_MOVING	0
+#define ARV_FAKE_CAMERA_TEST_PATTERN_STATIC			1
 
 #define ARV_FAKE_CAMERA_SENSOR_WIDTH			2048
 #define ARV_FAKE_CAMERA_SENSOR_HEIGHT			2048
@@ -86,6 +90,16 @@ ARV_API void			arv_set_fake_camera_genicam_filename (const char *filename);
 #define ARV_FAKE_CAMERA_REGISTER_GAIN_RAW		0x110
 #define ARV_FAKE_CAMERA_REGISTER_GAIN_MODE		0x114
 
+/* Chunk data control */
+
+#define ARV_FAKE_CAMERA_REGISTER_CHUNK_MODE_ACTIVE	0x140
+
+#define ARV_FAKE_CAMERA_CHUNK_ID_FRAME_ID		0x00001001
+#define ARV_FAKE_CAMERA_CHUNK_ID_TIMESTAMP		0x00001002
+
+/* Two 64 bit chunks, each one followed by its id and size */
+#define ARV_FAKE_CAMERA_CHUNK_DATA_SIZE			(2 * (8 + 4 + 4))
+
 #define ARV_TYPE_FAKE_CAMERA             (arv_fake_camera_get_type ())
 ARV_API G_DECLARE_FINAL_TYPE (ArvFakeCamera, arv_fake_camera, ARV, FAKE_CAMERA, GObject)
 
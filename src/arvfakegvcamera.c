@@ -37,6 +37,9 @@ static char *arv_option_interface_name = NULL;
 static char *arv_option_serial_number = NULL;
 static char *arv_option_genicam_file = NULL;
 static double arv_option_gvsp_lost_ratio = 0.0;
+static double arv_option_gvsp_bandwidth = 0.0;
+static char *arv_option_gvsp_faults = NULL;
+static int arv_option_gvsp_n_stream_channels = 1;
 static char *arv_option_debug_domains = NULL;
 
 static const GOptionEntry arv_option_entries[] =
@@ -49,6 +52,12 @@ static const GOptionEntry arv_option_entries[] =
 	        &arv_option_genicam_file, 	"XML Genicam file to use", "genicam_filename"},
 	{ "gvsp-lost-ratio",    'r', 0, G_OPTION_ARG_DOUBLE,
 	        &arv_option_gvsp_lost_ratio,	"GVSP lost packet ratio", "packet_per_thousand"},
+	{ "gvsp-bandwidth",     'b', 0, G_OPTION_ARG_DOUBLE,
+	        &arv_option_gvsp_bandwidth,	"GVSP bandwidth limit (0 for no limit)", "Mbit_per_second"},
+	{ "gvsp-faults",        'f', 0, G_OPTION_ARG_STRING,
+	        &arv_option_gvsp_faults,	"GVSP fault model", "<fault>=<value>[,...]"},
+	{ "gvsp-n-stream-channels", 'n', 0, G_OPTION_ARG_INT,
+	        &arv_option_gvsp_n_stream_channels,	"Number of stream channels (1 to 4)", "n_channels"},
 	{
 		"debug", 			'd', 0, G_OPTION_ARG_STRING,
 		&arv_option_debug_domains, 	NULL,
@@ -63,10 +72,22 @@ description_content[] =
 "any arbitrary genicam data, as the declared features must match the registers\n"
 "of the fake device.\n"
 "\n"
+"The GVSP fault model is a comma separated list of faults:\n"
+"  seed=<n>                    random generator seed, for reproducible faults\n"
+"  loss=<ratio>                uniform packet loss\n"
+"  burst=<ratio>[:<length>]    loss of <length> consecutive packets\n"
+"  reorder=<ratio>[:<window>]  packet delayed by up to <window> packets\n"
+"  duplicate=<ratio>           duplicated packet\n"
+"  error=<ratio>               payload packet replaced by an error packet\n"
+"  trailer-delay=<us>          delay before trailer emission\n"
+"\n"
 "Examples:\n"
 "\n"
 "arv-fake-gv-camera-" ARAVIS_API_VERSION " -i eth0\n"
 "arv-fake-gv-camera-" ARAVIS_API_VERSION " -i 127.0.0.1\n"
+"arv-fake-gv-camera-" ARAVIS_API_VERSION " -i 127.0.0.1 -b 5000\n"
+"arv-fake-gv-camera-" ARAVIS_API_VERSION " -f seed=1,burst=0.001:10,reorder=0.01:4\n"
+"arv-fake-gv-camera-" ARAVIS_API_VERSION " -n 2\n"
 "arv-fake-gv-camera-" ARAVIS_API_VERSION " -s GV02 -d all\n";
 
 int
@@ -98,16 +119,39 @@ main (int argc, char **argv)
 		return EXIT_FAILURE;
 	}
 
-	gv_camera = arv_gv_fake_camera_new_full (arv_option_interface_name, arv_option_serial_number, arv_option_genicam_file);
+	if (arv_option_gvsp_n_stream_channels < 1 || arv_option_gvsp_n_stream_channels > 4) {
+		printf ("Invalid number of stream channels\n");
+		return EXIT_FAILURE;
+	}
 
-	g_object_set (gv_camera, "gvsp-lost-ratio", arv_option_gvsp_lost_ratio / 1000.0, NULL);
+	gv_camera = g_object_new (ARV_TYPE_GV_FAKE_CAMERA,
+				  "interface-name", arv_option_interface_name != NULL ?
+				  arv_option_interface_name : ARV_GV_FAKE_CAMERA_DEFAULT_INTERFACE,
+				  "serial-number", arv_option_serial_number != NULL ?
+				  arv_option_serial_number : ARV_GV_FAKE_CAMERA_DEFAULT_SERIAL_NUMBER,
+				  "genicam-filename", arv_option_genicam_file,
+				  "gvsp-n-stream-channels", (guint) arv_option_gvsp_n_stream_channels,
+				  NULL);
+
+	g_object_set (gv_camera,
+		      "gvsp-lost-ratio", arv_option_gvsp_lost_ratio / 1000.0,
+		      "gvsp-bandwidth", (guint64) (arv_option_gvsp_bandwidth * 1e6),
+		      "gvsp-faults", arv_option_gvsp_faults,
+		      NULL);
 
 	signal (SIGINT, set_cancel);
 
-	if (arv_gv_fake_camera_is_running (gv_camera))
+	if (arv_gv_fake_camera_is_running (gv_camera)) {
+		guint64 n_frames, n_packets;
+		double throughput;
+
 		while (!cancel)
 			g_usleep (1000000);
-	else
+
+		arv_gv_fake_camera_get_stream_statistics (gv_camera, &n_frames, &n_packets, NULL, &throughput);
+		printf ("Last stream: %" G_GUINT64_FORMAT " frames, %" G_GUINT64_FORMAT " packets, %.3f Gbit/s\n",
+			n_frames, n_packets, throughput / 1e9);
+	} else
 		printf ("Failed to start camera\n");
 
 	g_object_unref (gv_camera);
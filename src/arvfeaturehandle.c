@@ -0,0 +1,492 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/**
+ * ArvFeatureHandle:
+ *
+ * [class@ArvFeatureHandle] is a prepared accessor to a Genicam feature of a [class@ArvDevice].
+ *
+ * The feature name lookup and the node type check are done once, at handle creation, instead of at each call as
+ * with the [method@ArvDevice.get_integer_feature_value] family of functions. This is useful for features accessed
+ * in a loop, for example the exposure time or the gain in an auto exposure algorithm.
+ *
+ * ```c
+ * ArvFeatureHandle *handle;
+ *
+ * handle = arv_feature_handle_new (device, "ExposureTime", &error);
+ * if (handle != NULL) {
+ *	for (i = 0; i < n_frames; i++)
+ *		arv_feature_handle_set_float (handle, exposures[i], &error);
+ *	g_object_unref (handle);
+ * }
+ * ```
+ *
+ * A handle keeps a reference to the Genicam document of the device, and stays valid as long as it exists.
+ */
+
+#include <arvfeaturehandle.h>
+#include <arvdevice.h>
+#include <arvgc.h>
+#include <arvgcinteger.h>
+#include <arvgcfloat.h>
+#include <arvgcboolean.h>
+#include <arvgcstring.h>
+#include <arvgccommand.h>
+#include <arvdebugprivate.h>
+
+typedef struct {
+	ArvGc *genicam;
+	ArvGcFeatureNode *node;
+
+	gboolean is_integer;
+	gboolean is_float;
+} ArvFeatureHandlePrivate;
+
+struct _ArvFeatureHandle {
+	GObject	object;
+
+	ArvFeatureHandlePrivate *priv;
+};
+
+struct _ArvFeatureHandleClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvFeatureHandle, arv_feature_handle, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvFeatureHandle))
+
+static gboolean
+_check_type (ArvFeatureHandle *handle, GType node_type, GError **error)
+{
+	if (G_TYPE_CHECK_INSTANCE_TYPE (handle->priv->node, node_type))
+		return TRUE;
+
+	g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_WRONG_FEATURE,
+		     "[%s:%s] Not a %s",
+		     arv_gc_feature_node_get_name (handle->priv->node),
+		     G_OBJECT_TYPE_NAME (handle->priv->node), g_type_name (node_type));
+
+	return FALSE;
+}
+
+/**
+ * arv_feature_handle_new:
+ * @device: a #ArvDevice
+ * @feature: feature name
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Resolves @feature once, for repeated accesses through the returned handle.
+ *
+ * Returns: (transfer full): a new #ArvFeatureHandle, %NULL on error.
+ *
+ * Since: 0.9.0
+ */
+
+ArvFeatureHandle *
+arv_feature_handle_new (ArvDevice *device, const char *feature, GError **error)
+{
+	ArvFeatureHandle *handle;
+	ArvGcNode *node;
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), NULL);
+	g_return_val_if_fail (feature != NULL, NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	node = arv_device_get_feature (device, feature);
+	if (!ARV_IS_GC_FEATURE_NODE (node)) {
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_FEATURE_NOT_FOUND,
+			     "[%s] Not found", feature);
+		return NULL;
+	}
+
+	handle = g_object_new (ARV_TYPE_FEATURE_HANDLE, NULL);
+
+	handle->priv->genicam = g_object_ref (arv_device_get_genicam (device));
+	handle->priv->node = g_object_ref (ARV_GC_FEATURE_NODE (node));
+
+	handle->priv->is_integer = ARV_IS_GC_INTEGER (node);
+	handle->priv->is_float = ARV_IS_GC_FLOAT (node);
+
+	return handle;
+}
+
+/**
+ * arv_feature_handle_get_name:
+ * @handle: a #ArvFeatureHandle
+ *
+ * Returns: the name of the feature accessed by @handle.
+ *
+ * Since: 0.9.0
+ */
+
+const char *
+arv_feature_handle_get_name (ArvFeatureHandle *handle)
+{
+	g_return_val_if_fail (ARV_IS_FEATURE_HANDLE (handle), NULL);
+
+	return arv_gc_feature_node_get_name (handle->priv->node);
+}
+
+/**
+ * arv_feature_handle_get_node:
+ * @handle: a #ArvFeatureHandle
+ *
+ * Returns: (transfer none): the Genicam node accessed by @handle.
+ *
+ * Since: 0.9.0
+ */
+
+ArvGcFeatureNode *
+arv_feature_handle_get_node (ArvFeatureHandle *handle)
+{
+	g_return_val_if_fail (ARV_IS_FEATURE_HANDLE (handle), NULL);
+
+	return handle->priv->node;
+}
+
+/**
+ * arv_feature_handle_get_integer:
+ * @handle: a #ArvFeatureHandle
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Returns: the integer feature value, 0 on error.
+ *
+ * Since: 0.9.0
+ */
+
+gint64
+arv_feature_handle_get_integer (ArvFeatureHandle *handle, GError **error)
+{
+	g_return_val_if_fail (ARV_IS_FEATURE_HANDLE (handle), 0);
+	g_return_val_if_fail (error == NULL || *error == NULL, 0);
+
+	if (!handle->priv->is_integer) {
+		_check_type (handle, ARV_TYPE_GC_INTEGER, error);
+		return 0;
+	}
+
+	return arv_gc_integer_get_value (ARV_GC_INTEGER (handle->priv->node), error);
+}
+
+/**
+ * arv_feature_handle_set_integer:
+ * @handle: a #ArvFeatureHandle
+ * @value: new feature value
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Set the integer feature value.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_feature_handle_set_integer (ArvFeatureHandle *handle, gint64 value, GError **error)
+{
+	g_return_if_fail (ARV_IS_FEATURE_HANDLE (handle));
+
+	if (!handle->priv->is_integer) {
+		_check_type (handle, ARV_TYPE_GC_INTEGER, error);
+		return;
+	}
+
+	arv_gc_integer_set_value (ARV_GC_INTEGER (handle->priv->node), value, error);
+}
+
+/**
+ * arv_feature_handle_get_integer_bounds:
+ * @handle: a #ArvFeatureHandle
+ * @min: (out): minimum feature value
+ * @max: (out): maximum feature value
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Retrieves the integer feature bounds.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_feature_handle_get_integer_bounds (ArvFeatureHandle *handle, gint64 *min, gint64 *max, GError **error)
+{
+	ArvGcInteger *node;
+	GError *local_error = NULL;
+	gint64 minimum = G_MININT64;
+	gint64 maximum = G_MAXINT64;
+
+	if (min != NULL)
+		*min = G_MININT64;
+	if (max != NULL)
+		*max = G_MAXINT64;
+
+	g_return_if_fail (ARV_IS_FEATURE_HANDLE (handle));
+
+	if (!handle->priv->is_integer) {
+		_check_type (handle, ARV_TYPE_GC_INTEGER, error);
+		return;
+	}
+
+	node = ARV_GC_INTEGER (handle->priv->node);
+
+	arv_gc_lock_read (handle->priv->genicam);
+	if (min != NULL)
+		minimum = arv_gc_integer_get_min (node, &local_error);
+	if (local_error == NULL && max != NULL)
+		maximum = arv_gc_integer_get_max (node, &local_error);
+	arv_gc_unlock (handle->priv->genicam);
+
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return;
+	}
+
+	if (min != NULL)
+		*min = minimum;
+	if (max != NULL)
+		*max = maximum;
+}
+
+/**
+ * arv_feature_handle_get_float:
+ * @handle: a #ArvFeatureHandle
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Returns: the float feature value, 0.0 on error.
+ *
+ * Since: 0.9.0
+ */
+
+double
+arv_feature_handle_get_float (ArvFeatureHandle *handle, GError **error)
+{
+	g_return_val_if_fail (ARV_IS_FEATURE_HANDLE (handle), 0.0);
+	g_return_val_if_fail (error == NULL || *error == NULL, 0.0);
+
+	if (!handle->priv->is_float) {
+		_check_type (handle, ARV_TYPE_GC_FLOAT, error);
+		return 0.0;
+	}
+
+	return arv_gc_float_get_value (ARV_GC_FLOAT (handle->priv->node), error);
+}
+
+/**
+ * arv_feature_handle_set_float:
+ * @handle: a #ArvFeatureHandle
+ * @value: new feature value
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Set the float feature value.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_feature_handle_set_float (ArvFeatureHandle *handle, double value, GError **error)
+{
+	g_return_if_fail (ARV_IS_FEATURE_HANDLE (handle));
+
+	if (!handle->priv->is_float) {
+		_check_type (handle, ARV_TYPE_GC_FLOAT, error);
+		return;
+	}
+
+	arv_gc_float_set_value (ARV_GC_FLOAT (handle->priv->node), value, error);
+}
+
+/**
+ * arv_feature_handle_get_float_bounds:
+ * @handle: a #ArvFeatureHandle
+ * @min: (out): minimum feature value
+ * @max: (out): maximum feature value
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Retrieves the float feature bounds.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_feature_handle_get_float_bounds (ArvFeatureHandle *handle, double *min, double *max, GError **error)
+{
+	ArvGcFloat *node;
+	GError *local_error = NULL;
+	double minimum = -G_MAXDOUBLE;
+	double maximum = G_MAXDOUBLE;
+
+	if (min != NULL)
+		*min = -G_MAXDOUBLE;
+	if (max != NULL)
+		*max = G_MAXDOUBLE;
+
+	g_return_if_fail (ARV_IS_FEATURE_HANDLE (handle));
+
+	if (!handle->priv->is_float) {
+		_check_type (handle, ARV_TYPE_GC_FLOAT, error);
+		return;
+	}
+
+	node = ARV_GC_FLOAT (handle->priv->node);
+
+	arv_gc_lock_read (handle->priv->genicam);
+	if (min != NULL)
+		minimum = arv_gc_float_get_min (node, &local_error);
+	if (local_error == NULL && max != NULL)
+		maximum = arv_gc_float_get_max (node, &local_error);
+	arv_gc_unlock (handle->priv->genicam);
+
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return;
+	}
+
+	if (min != NULL)
+		*min = minimum;
+	if (max != NULL)
+		*max = maximum;
+}
+
+/**
+ * arv_feature_handle_get_boolean:
+ * @handle: a #ArvFeatureHandle
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Returns: the boolean feature value, %FALSE on error.
+ *
+ * Since: 0.9.0
+ */
+
+gboolean
+arv_feature_handle_get_boolean (ArvFeatureHandle *handle, GError **error)
+{
+	g_return_val_if_fail (ARV_IS_FEATURE_HANDLE (handle), FALSE);
+
+	if (!_check_type (handle, ARV_TYPE_GC_BOOLEAN, error))
+		return FALSE;
+
+	return arv_gc_boolean_get_value (ARV_GC_BOOLEAN (handle->priv->node), error);
+}
+
+/**
+ * arv_feature_handle_set_boolean:
+ * @handle: a #ArvFeatureHandle
+ * @value: new feature value
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Set the boolean feature value.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_feature_handle_set_boolean (ArvFeatureHandle *handle, gboolean value, GError **error)
+{
+	g_return_if_fail (ARV_IS_FEATURE_HANDLE (handle));
+
+	if (_check_type (handle, ARV_TYPE_GC_BOOLEAN, error))
+		arv_gc_boolean_set_value (ARV_GC_BOOLEAN (handle->priv->node), value, error);
+}
+
+/**
+ * arv_feature_handle_get_string:
+ * @handle: a #ArvFeatureHandle
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * The returned string is owned by the feature node, and may not be valid anymore after the next read of the
+ * feature.
+ *
+ * Returns: the string feature value, %NULL on error.
+ *
+ * Since: 0.9.0
+ */
+
+const char *
+arv_feature_handle_get_string (ArvFeatureHandle *handle, GError **error)
+{
+	g_return_val_if_fail (ARV_IS_FEATURE_HANDLE (handle), NULL);
+
+	if (!_check_type (handle, ARV_TYPE_GC_STRING, error))
+		return NULL;
+
+	return arv_gc_string_get_value (ARV_GC_STRING (handle->priv->node), error);
+}
+
+/**
+ * arv_feature_handle_set_string:
+ * @handle: a #ArvFeatureHandle
+ * @value: new feature value
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Set the string feature value.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_feature_handle_set_string (ArvFeatureHandle *handle, const char *value, GError **error)
+{
+	g_return_if_fail (ARV_IS_FEATURE_HANDLE (handle));
+
+	if (_check_type (handle, ARV_TYPE_GC_STRING, error))
+		arv_gc_string_set_value (ARV_GC_STRING (handle->priv->node), value, error);
+}
+
+/**
+ * arv_feature_handle_execute:
+ * @handle: a #ArvFeatureHandle
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Execute the command feature.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_feature_handle_execute (ArvFeatureHandle *handle, GError **error)
+{
+	g_return_if_fail (ARV_IS_FEATURE_HANDLE (handle));
+
+	if (_check_type (handle, ARV_TYPE_GC_COMMAND, error))
+		arv_gc_command_execute (ARV_GC_COMMAND (handle->priv->node), error);
+}
+
+static void
+arv_feature_handle_init (ArvFeatureHandle *handle)
+{
+	handle->priv = arv_feature_handle_get_instance_private (handle);
+}
+
+static void
+arv_feature_handle_finalize (GObject *object)
+{
+	ArvFeatureHandle *handle = ARV_FEATURE_HANDLE (object);
+
+	g_clear_object (&handle->priv->node);
+	g_clear_object (&handle->priv->genicam);
+
+	G_OBJECT_CLASS (arv_feature_handle_parent_class)->finalize (object);
+}
+
+static void
+arv_feature_handle_class_init (ArvFeatureHandleClass *this_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
+
+	object_class->finalize = arv_feature_handle_finalize;
+}
@@ -0,0 +1,64 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_FEATURE_HANDLE_H
+#define ARV_FEATURE_HANDLE_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvapi.h>
+#include <arvtypes.h>
+#include <arvgcfeaturenode.h>
+
+G_BEGIN_DECLS
+
+#define ARV_TYPE_FEATURE_HANDLE             (arv_feature_handle_get_type ())
+ARV_API G_DECLARE_FINAL_TYPE (ArvFeatureHandle, arv_feature_handle, ARV, FEATURE_HANDLE, GObject)
+
+ARV_API ArvFeatureHandle *	arv_feature_handle_new			(ArvDevice *device, const char *feature, GError **error);
+
+ARV_API const char *		arv_feature_handle_get_name		(ArvFeatureHandle *handle);
+ARV_API ArvGcFeatureNode *	arv_feature_handle_get_node		(ArvFeatureHandle *handle);
+
+ARV_API gint64			arv_feature_handle_get_integer		(ArvFeatureHandle *handle, GError **error);
+ARV_API void			arv_feature_handle_set_integer		(ArvFeatureHandle *handle, gint64 value, GError **error);
+ARV_API void			arv_feature_handle_get_integer_bounds	(ArvFeatureHandle *handle, gint64 *min, gint64 *max,
+									 GError **error);
+
+ARV_API double			arv_feature_handle_get_float		(ArvFeatureHandle *handle, GError **error);
+ARV_API void			arv_feature_handle_set_float		(ArvFeatureHandle *handle, double value, GError **error);
+ARV_API void			arv_feature_handle_get_float_bounds	(ArvFeatureHandle *handle, double *min, double *max,
+									 GError **error);
+
+ARV_API gboolean		arv_feature_handle_get_boolean		(ArvFeatureHandle *handle, GError **error);
+ARV_API void			arv_feature_handle_set_boolean		(ArvFeatureHandle *handle, gboolean value, GError **error);
+
+ARV_API const char *		arv_feature_handle_get_string		(ArvFeatureHandle *handle, GError **error);
+ARV_API void			arv_feature_handle_set_string		(ArvFeatureHandle *handle, const char *value, GError **error);
+
+ARV_API void			arv_feature_handle_execute		(ArvFeatureHandle *handle, GError **error);
+
+G_END_DECLS
+
+#endif
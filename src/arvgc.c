@@ -27,6 +27,15 @@
  * #ArvGc implements the root document for the storage of the Genicam feature
  * nodes. It builds the node tree by parsing an xml file in the Genicam
  * standard format. See http://www.genicam.org.
+ *
+ * The feature nodes are instantiated on demand. At creation, the xml data are only indexed, and the node subtree
+ * defining a feature is built the first time the feature is retrieved, either directly using arv_gc_get_node(), or
+ * through a link from another node.
+ *
+ * Feature accesses are thread safe. Reads can run concurrently from several
+ * threads, while writes and command executions are exclusive. Sequences of
+ * accesses which must not be interleaved with other threads can be grouped
+ * using arv_gc_lock_read(), arv_gc_lock_write() and arv_gc_unlock().
  */
 
 #include <arvgcprivate.h>
@@ -62,12 +71,32 @@
 #include <arvbuffer.h>
 #include <arvdebugprivate.h>
 #include <arvdomparser.h>
+#include <arvdomimplementation.h>
+#include <libxml/parser.h>
 #include <string.h>
 #include <stdarg.h>
 #include <stdio.h>
 
+/* Top level node subtree, not instantiated yet */
+
 typedef struct {
+	gsize start;
+	gsize size;
+	ArvDomNode *parent;
+	gboolean is_loaded;
+} ArvGcLazyNode;
+
+typedef struct {
+	/* Protects the node table and the lazy node index. Recursive, as the instantiation of a node subtree
+	 * registers its feature nodes. */
+	GRecMutex nodes_mutex;
 	GHashTable *nodes;
+
+	char *xml;
+	gsize xml_size;
+	GHashTable *lazy_nodes;		/* name -> ArvGcLazyNode */
+	GPtrArray *lazy_node_list;
+
 	ArvDevice *device;
 	ArvBuffer *buffer;
 
@@ -75,7 +104,20 @@ typedef struct {
 	ArvRangeCheckPolicy range_check_policy;
 	ArvAccessCheckPolicy access_check_policy;
 
+        GRWLock lock;
+
+        guint change_count;
+        guint registration_count;
+
+        gboolean is_profiling;
+        GPtrArray *profile;
+
+        /* Protects the register cache error counter and the profile */
+        GMutex statistics_mutex;
         unsigned n_register_cache_errors;
+        /* Updated concurrently, using atomic operations */
+        guint n_register_cache_hits;
+        guint n_register_cache_misses;
 } ArvGcPrivate;
 
 struct _ArvGc {
@@ -295,13 +337,48 @@ arv_gc_create_element (ArvDomDocument *document, const char *tag_name)
  * Return value: (transfer none): a #ArvGcNode, null if not found.
  */
 
+static void
+_load_lazy_node (ArvGc *genicam, ArvGcLazyNode *lazy_node)
+{
+	GError *error = NULL;
+
+	/* Set before parsing, in case of a lookup of the same name during the node subtree instantiation */
+	lazy_node->is_loaded = TRUE;
+
+	arv_dom_document_append_from_memory (ARV_DOM_DOCUMENT (genicam), lazy_node->parent,
+					     genicam->priv->xml + lazy_node->start, (int) lazy_node->size, &error);
+	if (error != NULL) {
+		arv_warning_genicam ("[Gc::load_lazy_node] Failed to instantiate node at offset %" G_GSIZE_FORMAT " (%s)",
+				     lazy_node->start, error->message);
+		g_clear_error (&error);
+	}
+}
+
 ArvGcNode *
 arv_gc_get_node	(ArvGc *genicam, const char *name)
 {
+	ArvGcNode *node;
+
 	g_return_val_if_fail (ARV_IS_GC (genicam), NULL);
 	g_return_val_if_fail (name != NULL, NULL);
 
-	return g_hash_table_lookup (genicam->priv->nodes, name);
+	g_rec_mutex_lock (&genicam->priv->nodes_mutex);
+
+	/* Even if a node of the same name is already registered, the indexed subtree is instantiated, as the last
+	 * definition in the document wins */
+	if (genicam->priv->lazy_nodes != NULL) {
+		ArvGcLazyNode *lazy_node;
+
+		lazy_node = g_hash_table_lookup (genicam->priv->lazy_nodes, name);
+		if (lazy_node != NULL && !lazy_node->is_loaded)
+			_load_lazy_node (genicam, lazy_node);
+	}
+
+	node = g_hash_table_lookup (genicam->priv->nodes, name);
+
+	g_rec_mutex_unlock (&genicam->priv->nodes_mutex);
+
+	return node;
 }
 
 /**
@@ -336,8 +413,11 @@ arv_gc_register_feature_node (ArvGc *genicam, ArvGcFeatureNode *node)
 
 	g_object_ref (node);
 
+	g_rec_mutex_lock (&genicam->priv->nodes_mutex);
 	g_hash_table_remove (genicam->priv->nodes, (char *) name);
 	g_hash_table_insert (genicam->priv->nodes, (char *) name, node);
+	g_atomic_int_inc (&genicam->priv->registration_count);
+	g_rec_mutex_unlock (&genicam->priv->nodes_mutex);
 
 	arv_debug_genicam ("[Gc::register_feature_node] Register node '%s' [%s]", name,
 			 arv_dom_node_get_node_name (ARV_DOM_NODE (node)));
@@ -372,6 +452,8 @@ arv_gc_set_register_cache_policy (ArvGc *genicam, ArvRegisterCachePolicy policy)
 	g_return_if_fail (ARV_IS_GC (genicam));
 
 	genicam->priv->cache_policy = policy;
+
+	arv_gc_increment_change_count (genicam);
 }
 
 ArvRegisterCachePolicy
@@ -414,6 +496,443 @@ arv_gc_get_access_check_policy (ArvGc *genicam)
 	return genicam->priv->access_check_policy;
 }
 
+/* Thread local record of the genicam documents locked by the current thread.
+ * The state is the nesting depth shifted by one bit, the lowest bit telling if
+ * the outermost lock is a writer lock. Feature accesses call each other
+ * recursively, only the outermost call actually takes the #GRWLock. A thread
+ * rarely holds the lock of more than one document, the records are searched
+ * linearly. */
+
+typedef struct {
+	ArvGc *genicam;
+	guint state;
+} ArvGcLockState;
+
+static GPrivate arv_gc_lock_states = G_PRIVATE_INIT ((GDestroyNotify) g_array_unref);
+
+static GArray *
+_get_lock_states (void)
+{
+	GArray *states = g_private_get (&arv_gc_lock_states);
+
+	if (states == NULL) {
+		states = g_array_sized_new (FALSE, FALSE, sizeof (ArvGcLockState), 2);
+		g_private_set (&arv_gc_lock_states, states);
+	}
+
+	return states;
+}
+
+static ArvGcLockState *
+_find_lock_state (GArray *states, ArvGc *genicam)
+{
+	guint i;
+
+	for (i = 0; i < states->len; i++) {
+		ArvGcLockState *state = &g_array_index (states, ArvGcLockState, i);
+
+		if (state->genicam == genicam)
+			return state;
+	}
+
+	return NULL;
+}
+
+/* A read lock can not be upgraded, a write request nested in a read lock is
+ * refused, and the lock state left untouched. */
+
+static gboolean
+_lock (ArvGc *genicam, gboolean write)
+{
+	GArray *states = _get_lock_states ();
+	ArvGcLockState *state;
+
+	state = _find_lock_state (states, genicam);
+
+	if (state == NULL) {
+		ArvGcLockState new_state = {genicam, write ? 1 : 0};
+
+		if (write)
+			g_rw_lock_writer_lock (&genicam->priv->lock);
+		else
+			g_rw_lock_reader_lock (&genicam->priv->lock);
+
+		g_array_append_val (states, new_state);
+		state = &g_array_index (states, ArvGcLockState, states->len - 1);
+	} else if (write && (state->state & 1) == 0) {
+		return FALSE;
+	}
+
+	state->state += 2;
+
+	return TRUE;
+}
+
+static void
+_unlock (ArvGc *genicam)
+{
+	GArray *states = _get_lock_states ();
+	ArvGcLockState *state;
+	gboolean write;
+
+	state = _find_lock_state (states, genicam);
+
+	g_return_if_fail (state != NULL && state->state >= 2);
+
+	state->state -= 2;
+	if (state->state > 1)
+		return;
+
+	write = state->state == 1;
+	g_array_remove_index_fast (states, state - &g_array_index (states, ArvGcLockState, 0));
+
+	if (write)
+		g_rw_lock_writer_unlock (&genicam->priv->lock);
+	else
+		g_rw_lock_reader_unlock (&genicam->priv->lock);
+}
+
+/**
+ * arv_gc_lock_read:
+ * @genicam: a #ArvGc object
+ *
+ * Acquires the feature access lock of @genicam in shared mode. Feature
+ * reads already take this lock internally, and may run concurrently from
+ * several threads. An explicit lock is useful when a sequence of accesses
+ * must not be interleaved with writes from other threads, for example when
+ * reading the values of several features for a consistent snapshot.
+ *
+ * Locks are recursive for a given thread. A read lock can not be upgraded:
+ * while a thread holds a read lock, its write lock requests fail, and so do
+ * its feature writes and command executions.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_gc_lock_read (ArvGc *genicam)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+	_lock (genicam, FALSE);
+}
+
+/**
+ * arv_gc_lock_write:
+ * @genicam: a #ArvGc object
+ *
+ * Acquires the feature access lock of @genicam in exclusive mode. Feature
+ * writes and command executions already take this lock internally. An
+ * explicit lock is useful for the selector pattern, where a selector value
+ * is set before the access to the selected feature, and the pair must not be
+ * interleaved with accesses from other threads.
+ *
+ * The lock is not acquired if the current thread holds a read lock on
+ * @genicam, in which case arv_gc_unlock() must not be called.
+ *
+ * Returns: %TRUE if the lock was acquired
+ *
+ * Since: 0.9.0
+ */
+
+gboolean
+arv_gc_lock_write (ArvGc *genicam)
+{
+	g_return_val_if_fail (ARV_IS_GC (genicam), FALSE);
+
+	if (!_lock (genicam, TRUE)) {
+		g_critical ("%s: write lock requested while holding a read lock", G_STRFUNC);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/**
+ * arv_gc_unlock:
+ * @genicam: a #ArvGc object
+ *
+ * Releases a lock acquired using arv_gc_lock_read() or arv_gc_lock_write().
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_gc_unlock (ArvGc *genicam)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+	_unlock (genicam);
+}
+
+/* Thread local record of the feature operation being profiled. The node locks mark the feature node evaluations, the
+ * outermost one delimiting the operation. */
+
+typedef struct {
+	ArvGc *genicam;
+	guint depth;
+	gint64 start;
+	GPtrArray *evaluated_nodes;
+	ArvGcProfileOperation *operation;
+} ArvGcProfileState;
+
+static GPrivate arv_gc_profile_states = G_PRIVATE_INIT (g_free);
+
+static ArvGcProfileState *
+_get_profile_state (void)
+{
+	ArvGcProfileState *state = g_private_get (&arv_gc_profile_states);
+
+	if (state == NULL) {
+		state = g_new0 (ArvGcProfileState, 1);
+		g_private_set (&arv_gc_profile_states, state);
+	}
+
+	return state;
+}
+
+/* Returns the operation being profiled for genicam in the current thread, NULL if none */
+
+static ArvGcProfileOperation *
+_get_profile_operation (ArvGc *genicam)
+{
+	ArvGcProfileState *state = g_private_get (&arv_gc_profile_states);
+
+	if (state == NULL || state->depth == 0 || state->genicam != genicam)
+		return NULL;
+
+	return state->operation;
+}
+
+static void
+_profile_enter (ArvGc *genicam, ArvGcNode *node, gboolean write)
+{
+	ArvGcProfileState *state;
+	const char *name;
+
+	state = g_private_get (&arv_gc_profile_states);
+
+	if (state == NULL || state->depth == 0) {
+		if (!g_atomic_int_get (&genicam->priv->is_profiling))
+			return;
+
+		state = _get_profile_state ();
+		state->genicam = genicam;
+		state->start = g_get_monotonic_time ();
+		state->evaluated_nodes = g_ptr_array_new ();
+		state->operation = g_new0 (ArvGcProfileOperation, 1);
+		state->operation->is_write = write;
+	} else if (state->genicam != genicam)
+		return;
+
+	name = ARV_IS_GC_FEATURE_NODE (node) ?
+		arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (node)) :
+		arv_dom_node_get_node_name (ARV_DOM_NODE (node));
+
+	if (state->depth == 0)
+		state->operation->feature = g_strdup (name);
+
+	g_ptr_array_add (state->evaluated_nodes, g_strdup (name));
+	state->depth++;
+}
+
+static void
+_profile_leave (ArvGc *genicam)
+{
+	ArvGcProfileState *state;
+	ArvGcProfileOperation *operation;
+
+	state = g_private_get (&arv_gc_profile_states);
+
+	if (state == NULL || state->depth == 0 || state->genicam != genicam)
+		return;
+
+	state->depth--;
+	if (state->depth > 0)
+		return;
+
+	operation = state->operation;
+	operation->duration_us = g_get_monotonic_time () - state->start;
+	g_ptr_array_add (state->evaluated_nodes, NULL);
+	operation->evaluated_nodes = (char **) g_ptr_array_free (state->evaluated_nodes, FALSE);
+
+	state->genicam = NULL;
+	state->evaluated_nodes = NULL;
+	state->operation = NULL;
+
+	g_mutex_lock (&genicam->priv->statistics_mutex);
+	if (genicam->priv->profile != NULL) {
+		g_ptr_array_add (genicam->priv->profile, operation);
+		operation = NULL;
+	}
+	g_mutex_unlock (&genicam->priv->statistics_mutex);
+
+	if (operation != NULL)
+		arv_gc_profile_operation_free (operation);
+}
+
+void
+arv_gc_profile_port_access (ArvGc *genicam, gboolean write, guint64 length)
+{
+	ArvGcProfileOperation *operation;
+
+	if (genicam == NULL || !g_atomic_int_get (&genicam->priv->is_profiling))
+		return;
+
+	operation = _get_profile_operation (genicam);
+	if (operation == NULL)
+		return;
+
+	if (write) {
+		operation->n_port_writes++;
+		operation->n_bytes_written += length;
+	} else {
+		operation->n_port_reads++;
+		operation->n_bytes_read += length;
+	}
+}
+
+/**
+ * arv_gc_start_profiling:
+ * @genicam: a #ArvGc object
+ *
+ * Starts the recording of the register accesses of each feature operation, that is each read, write or command
+ * execution requested on a feature node. Nested evaluations of other nodes are accounted to the outermost
+ * operation. Any previous recording is discarded.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_gc_start_profiling (ArvGc *genicam)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+	g_mutex_lock (&genicam->priv->statistics_mutex);
+	if (genicam->priv->profile != NULL)
+		g_ptr_array_unref (genicam->priv->profile);
+	genicam->priv->profile = g_ptr_array_new_with_free_func ((GDestroyNotify) arv_gc_profile_operation_free);
+	g_atomic_int_set (&genicam->priv->is_profiling, TRUE);
+	g_mutex_unlock (&genicam->priv->statistics_mutex);
+}
+
+/**
+ * arv_gc_stop_profiling:
+ * @genicam: a #ArvGc object
+ *
+ * Stops the profiling started by arv_gc_start_profiling().
+ *
+ * Returns: (transfer full) (element-type ArvGcProfileOperation) (nullable): the profile of the feature operations
+ * completed since arv_gc_start_profiling(), in completion order. %NULL if profiling was not started.
+ *
+ * Since: 0.9.0
+ */
+
+GPtrArray *
+arv_gc_stop_profiling (ArvGc *genicam)
+{
+	GPtrArray *profile;
+
+	g_return_val_if_fail (ARV_IS_GC (genicam), NULL);
+
+	g_mutex_lock (&genicam->priv->statistics_mutex);
+	g_atomic_int_set (&genicam->priv->is_profiling, FALSE);
+	profile = genicam->priv->profile;
+	genicam->priv->profile = NULL;
+	g_mutex_unlock (&genicam->priv->statistics_mutex);
+
+	return profile;
+}
+
+/**
+ * arv_gc_profile_operation_free:
+ * @operation: (transfer full): a #ArvGcProfileOperation
+ *
+ * Frees a feature operation profile returned by arv_gc_stop_profiling().
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_gc_profile_operation_free (ArvGcProfileOperation *operation)
+{
+	if (operation == NULL)
+		return;
+
+	g_free (operation->feature);
+	g_strfreev (operation->evaluated_nodes);
+	g_free (operation);
+}
+
+/**
+ * arv_gc_profile_operation_copy:
+ * @operation: a #ArvGcProfileOperation
+ *
+ * Returns: (transfer full): a deep copy of @operation, to be freed using arv_gc_profile_operation_free().
+ *
+ * Since: 0.9.0
+ */
+
+ArvGcProfileOperation *
+arv_gc_profile_operation_copy (const ArvGcProfileOperation *operation)
+{
+	ArvGcProfileOperation *copy;
+
+	g_return_val_if_fail (operation != NULL, NULL);
+
+	copy = g_new (ArvGcProfileOperation, 1);
+	*copy = *operation;
+	copy->feature = g_strdup (operation->feature);
+	copy->evaluated_nodes = g_strdupv (operation->evaluated_nodes);
+
+	return copy;
+}
+
+G_DEFINE_BOXED_TYPE (ArvGcProfileOperation, arv_gc_profile_operation,
+		     arv_gc_profile_operation_copy, arv_gc_profile_operation_free)
+
+void
+arv_gc_node_lock_read (ArvGcNode *node)
+{
+	ArvGc *genicam = arv_gc_node_get_genicam (node);
+
+	if (genicam != NULL) {
+		_lock (genicam, FALSE);
+		_profile_enter (genicam, node, FALSE);
+	}
+}
+
+gboolean
+arv_gc_node_lock_write (ArvGcNode *node, GError **error)
+{
+	ArvGc *genicam = arv_gc_node_get_genicam (node);
+
+	if (genicam == NULL)
+		return TRUE;
+
+	if (!_lock (genicam, TRUE)) {
+		g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_WRITE_IN_READ_LOCK,
+			     "[%s] Write access while holding a read lock",
+			     arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (node)));
+		return FALSE;
+	}
+
+	_profile_enter (genicam, node, TRUE);
+
+	return TRUE;
+}
+
+void
+arv_gc_node_unlock (ArvGcNode *node)
+{
+	ArvGc *genicam = arv_gc_node_get_genicam (node);
+
+	if (genicam != NULL) {
+		_profile_leave (genicam);
+		_unlock (genicam);
+	}
+}
+
 static void
 _weak_notify_cb (gpointer data, GObject *object)
 {
@@ -426,14 +945,20 @@ void
 arv_gc_set_buffer (ArvGc *genicam, ArvBuffer *buffer)
 {
 	g_return_if_fail (ARV_IS_GC (genicam));
-	g_return_if_fail (ARV_IS_BUFFER (buffer));
+	g_return_if_fail (buffer == NULL || ARV_IS_BUFFER (buffer));
+
+	if (genicam->priv->buffer == buffer)
+		return;
 
 	if (genicam->priv->buffer != NULL)
 		g_object_weak_unref (G_OBJECT (genicam->priv->buffer), _weak_notify_cb, genicam);
 
-	g_object_weak_ref (G_OBJECT (buffer), _weak_notify_cb, genicam);
+	if (buffer != NULL)
+		g_object_weak_ref (G_OBJECT (buffer), _weak_notify_cb, genicam);
 
 	genicam->priv->buffer = buffer;
+
+	arv_gc_increment_change_count (genicam);
 }
 
 /**
@@ -458,30 +983,377 @@ arv_gc_register_cache_error_add (ArvGc *genicam, guint64 n_errors)
 {
 	g_return_val_if_fail (ARV_IS_GC (genicam), 0);
 
+        g_mutex_lock (&genicam->priv->statistics_mutex);
         genicam->priv->n_register_cache_errors += n_errors;
+        n_errors = genicam->priv->n_register_cache_errors;
+        g_mutex_unlock (&genicam->priv->statistics_mutex);
+
+        return n_errors;
+}
+
+void
+arv_gc_register_cache_count (ArvGc *genicam, gboolean hit)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+        if (hit)
+                g_atomic_int_inc (&genicam->priv->n_register_cache_hits);
+        else
+                g_atomic_int_inc (&genicam->priv->n_register_cache_misses);
+
+        if (g_atomic_int_get (&genicam->priv->is_profiling)) {
+                ArvGcProfileOperation *operation = _get_profile_operation (genicam);
+
+                if (operation != NULL) {
+                        if (hit)
+                                operation->n_cache_hits++;
+                        else
+                                operation->n_cache_misses++;
+                }
+        }
+}
+
+void
+arv_gc_get_register_cache_statistics (ArvGc *genicam, guint64 *n_hits, guint64 *n_misses, guint64 *n_errors)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+        g_mutex_lock (&genicam->priv->statistics_mutex);
+        if (n_hits != NULL)
+                *n_hits = (guint) g_atomic_int_get (&genicam->priv->n_register_cache_hits);
+        if (n_misses != NULL)
+                *n_misses = (guint) g_atomic_int_get (&genicam->priv->n_register_cache_misses);
+        if (n_errors != NULL)
+                *n_errors = genicam->priv->n_register_cache_errors;
+        g_mutex_unlock (&genicam->priv->statistics_mutex);
+}
+
+/* The document change count is incremented each time a feature value may have changed, either because of a write, or
+ * because of a register read which bypassed the register cache. Derived nodes use it for the validation of their
+ * memoized values. */
+
+guint
+arv_gc_get_change_count (ArvGc *genicam)
+{
+	g_return_val_if_fail (ARV_IS_GC (genicam), 0);
+
+	return g_atomic_int_get (&genicam->priv->change_count);
+}
+
+void
+arv_gc_increment_change_count (ArvGc *genicam)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+	g_atomic_int_inc (&genicam->priv->change_count);
+}
+
+/* The registration count is incremented each time a feature node is added to the node table. Property nodes use it
+ * for the validation of their resolved linked node. It never equals 0. */
+
+guint
+arv_gc_get_registration_count (ArvGc *genicam)
+{
+	g_return_val_if_fail (ARV_IS_GC (genicam), 0);
+
+	return g_atomic_int_get (&genicam->priv->registration_count);
+}
+
+/* Indexing pass, which only instantiates the RegisterDescription root element and the Group elements. The other
+ * children of these elements are recorded as byte ranges of the xml data, indexed by the names of the feature nodes
+ * they contain. */
+
+typedef struct {
+	xmlParserCtxtPtr ctxt;
+	const char *xml;
+	gsize size;
+
+	ArvGc *genicam;
+	ArvDomNode *current_node;
+
+	int depth;
+	int lazy_node_depth;
+	ArvGcLazyNode *lazy_node;
+
+	gboolean is_error;
+} ArvGcIndexState;
+
+static gboolean
+_is_feature_node_tag (const char *tag_name)
+{
+	static const char *tag_names[] = {
+		"Category", "Command", "Converter", "IntConverter", "Register", "IntReg", "MaskedIntReg", "FloatReg",
+		"String", "StringReg", "StructReg", "StructEntry", "Integer", "Float", "Boolean", "Enumeration",
+		"SwissKnife", "IntSwissKnife", "Port"
+	};
+	unsigned int i;
+
+	for (i = 0; i < G_N_ELEMENTS (tag_names); i++)
+		if (strcmp (tag_name, tag_names[i]) == 0)
+			return TRUE;
+
+	return FALSE;
+}
 
-        return genicam->priv->n_register_cache_errors;
+static void
+_index_start_element (void *user_data, const xmlChar *name, const xmlChar **attrs)
+{
+	ArvGcIndexState *state = user_data;
+	const char *feature_name = NULL;
+	int i;
+
+	state->depth++;
+
+	if (state->is_error)
+		return;
+
+	if (attrs != NULL)
+		for (i = 0; attrs[i] != NULL && attrs[i+1] != NULL; i += 2)
+			if (strcmp ((char *) attrs[i], "Name") == 0)
+				feature_name = (char *) attrs[i+1];
+
+	if (state->lazy_node == NULL &&
+	    (state->depth == 1 || (state->depth == 2 && strcmp ((char *) name, "Group") == 0))) {
+		ArvDomNode *node;
+
+		if (state->depth == 1) {
+			ArvDomDocument *document;
+
+			document = arv_dom_implementation_create_document (NULL, (char *) name);
+			if (!ARV_IS_GC (document)) {
+				g_clear_object (&document);
+				state->is_error = TRUE;
+				return;
+			}
+
+			state->genicam = ARV_GC (document);
+			state->current_node = ARV_DOM_NODE (document);
+		}
+
+		node = ARV_DOM_NODE (arv_dom_document_create_element (ARV_DOM_DOCUMENT (state->genicam), (char *) name));
+		if (!ARV_IS_DOM_NODE (node) || arv_dom_node_append_child (state->current_node, node) == NULL) {
+			state->is_error = TRUE;
+			return;
+		}
+
+		if (attrs != NULL)
+			for (i = 0; attrs[i] != NULL && attrs[i+1] != NULL; i += 2)
+				arv_dom_element_set_attribute (ARV_DOM_ELEMENT (node), (char *) attrs[i], (char *) attrs[i+1]);
+
+		state->current_node = node;
+
+		return;
+	}
+
+	if (state->lazy_node == NULL) {
+		gsize start;
+
+		/* The parser stands at the end of the start tag */
+		start = MIN (xmlByteConsumed (state->ctxt), state->size - 1);
+		while (start > 0 && state->xml[start] != '<')
+			start--;
+
+		state->lazy_node = g_new0 (ArvGcLazyNode, 1);
+		state->lazy_node->start = start;
+		state->lazy_node->parent = state->current_node;
+		state->lazy_node_depth = state->depth;
+
+		g_ptr_array_add (state->genicam->priv->lazy_node_list, state->lazy_node);
+	}
+
+	if (feature_name != NULL && _is_feature_node_tag ((char *) name))
+		g_hash_table_replace (state->genicam->priv->lazy_nodes, g_strdup (feature_name), state->lazy_node);
+}
+
+static void
+_index_end_element (void *user_data, const xmlChar *name)
+{
+	ArvGcIndexState *state = user_data;
+
+	state->depth--;
+
+	if (state->is_error)
+		return;
+
+	if (state->lazy_node != NULL) {
+		if (state->depth < state->lazy_node_depth) {
+			gsize end;
+
+			/* The parser stands after the end tag */
+			end = MIN (xmlByteConsumed (state->ctxt), state->size);
+			while (end < state->size && state->xml[end - 1] != '>')
+				end++;
+
+			state->lazy_node->size = end - state->lazy_node->start;
+			state->lazy_node = NULL;
+		}
+	} else if (state->current_node != NULL)
+		state->current_node = arv_dom_node_get_parent_node (state->current_node);
 }
 
+/* Entities declared in a DTD would not be available when parsing a fragment */
+
+static void
+_index_internal_subset (void *user_data, const xmlChar *name, const xmlChar *external_id, const xmlChar *system_id)
+{
+	ArvGcIndexState *state = user_data;
+
+	state->is_error = TRUE;
+}
+
+static xmlSAXHandler arv_gc_index_sax_handler = {
+	.internalSubset = _index_internal_subset,
+	.startElement = _index_start_element,
+	.endElement = _index_end_element,
+};
+
+/* Fragments of the xml data are parsed as standalone UTF-8 documents, lazy loading is not possible for other
+ * encodings */
+
+static gboolean
+_is_utf8_xml (const char *xml, gsize size)
+{
+	const char *end;
+	const char *encoding;
+
+	if (size < 2 || (guint8) xml[0] == 0xfe || (guint8) xml[0] == 0xff || xml[0] == '\0' || xml[1] == '\0')
+		return FALSE;
+
+	if (size < 5 || strncmp (xml, "<?xml", 5) != 0)
+		return TRUE;
+
+	end = g_strstr_len (xml, size, "?>");
+	if (end == NULL)
+		return FALSE;
+
+	encoding = g_strstr_len (xml, end - xml, "encoding");
+	if (encoding == NULL)
+		return TRUE;
+
+	encoding += strlen ("encoding");
+	while (encoding < end && (*encoding == ' ' || *encoding == '=' || *encoding == '"' || *encoding == '\''))
+		encoding++;
+
+	return g_ascii_strncasecmp (encoding, "UTF-8", 5) == 0 ||
+		g_ascii_strncasecmp (encoding, "UTF8", 4) == 0 ||
+		g_ascii_strncasecmp (encoding, "US-ASCII", 8) == 0;
+}
+
+static ArvGc *
+_new_lazy (const char *xml, gsize size)
+{
+	ArvGcIndexState state = {0};
+	xmlParserCtxtPtr ctxt;
+	gboolean is_well_formed;
+
+	if (size == 0 || size > G_MAXINT || !_is_utf8_xml (xml, size))
+		return NULL;
+
+	ctxt = xmlCreateMemoryParserCtxt (xml, size);
+	if (ctxt == NULL)
+		return NULL;
+
+	if (ctxt->sax != NULL)
+		xmlFree (ctxt->sax);
+	ctxt->sax = &arv_gc_index_sax_handler;
+	ctxt->userData = &state;
+
+	state.ctxt = ctxt;
+	state.xml = xml;
+	state.size = size;
+
+	xmlParseDocument (ctxt);
+
+	is_well_formed = ctxt->wellFormed;
+
+	ctxt->sax = NULL;
+	xmlFreeParserCtxt (ctxt);
+
+	if (!is_well_formed || state.is_error || state.lazy_node != NULL) {
+		g_clear_object (&state.genicam);
+		return NULL;
+	}
+
+	return state.genicam;
+}
+
+/**
+ * arv_gc_new:
+ * @device: (allow-none): the device used for register access
+ * @xml: Genicam xml data
+ * @size: size of @xml data, in bytes, -1 if NULL terminated
+ *
+ * Creates a new Genicam document from @xml data. The feature nodes are instantiated on first use.
+ *
+ * Returns: a new #ArvGc, %NULL on error
+ */
+
 ArvGc *
 arv_gc_new (ArvDevice *device, const void *xml, size_t size)
+{
+	char *xml_copy;
+
+	g_return_val_if_fail (xml != NULL || size == 0, NULL);
+
+	if (size == (size_t) -1)
+		size = strlen (xml);
+
+	xml_copy = g_malloc (size);
+	memcpy (xml_copy, xml, size);
+
+	return arv_gc_new_take (device, xml_copy, size);
+}
+
+/* Same as arv_gc_new(), but the document takes the ownership of @xml, which avoids a copy of the xml data that are
+ * kept for the lazy instantiation of the feature nodes. @xml is freed on error. */
+
+ArvGc *
+arv_gc_new_take (ArvDevice *device, char *xml, size_t size)
 {
 	ArvDomDocument *document;
 	ArvGc *genicam;
 
-	document = arv_dom_document_new_from_memory (xml, size, NULL);
-	if (!ARV_IS_GC (document)) {
-		if (document != NULL)
-			g_object_unref (document);
+	if (xml == NULL)
 		return NULL;
+
+	genicam = _new_lazy (xml, size);
+	if (genicam != NULL) {
+		arv_debug_genicam ("[Gc::new] Indexed %u node subtrees", genicam->priv->lazy_node_list->len);
+	} else {
+		document = arv_dom_document_new_from_memory (xml, size, NULL);
+		if (!ARV_IS_GC (document)) {
+			if (document != NULL)
+				g_object_unref (document);
+			g_free (xml);
+			return NULL;
+		}
+
+		genicam = ARV_GC (document);
 	}
 
-	genicam = ARV_GC (document);
+	genicam->priv->xml = xml;
+	genicam->priv->xml_size = size;
 	genicam->priv->device = device;
 
 	return genicam;
 }
 
+/* Returns the xml data the document was created from */
+
+const char *
+arv_gc_get_xml (ArvGc *genicam, size_t *size)
+{
+	if (size != NULL)
+		*size = 0;
+
+	g_return_val_if_fail (ARV_IS_GC (genicam), NULL);
+
+	if (size != NULL)
+		*size = genicam->priv->xml_size;
+
+	return genicam->priv->xml;
+}
+
 G_DEFINE_TYPE_WITH_CODE (ArvGc, arv_gc, ARV_TYPE_DOM_DOCUMENT, G_ADD_PRIVATE (ArvGc))
 
 static void
@@ -489,8 +1361,15 @@ arv_gc_init (ArvGc *genicam)
 {
 	genicam->priv = arv_gc_get_instance_private (genicam);
 
+	g_rec_mutex_init (&genicam->priv->nodes_mutex);
+	genicam->priv->registration_count = 1;
 	genicam->priv->nodes = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, g_object_unref);
+	genicam->priv->lazy_nodes = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+	genicam->priv->lazy_node_list = g_ptr_array_new_with_free_func (g_free);
 	genicam->priv->cache_policy = ARV_REGISTER_CACHE_POLICY_DISABLE;
+
+	g_rw_lock_init (&genicam->priv->lock);
+	g_mutex_init (&genicam->priv->statistics_mutex);
 }
 
 static void
@@ -502,6 +1381,14 @@ arv_gc_finalize (GObject *object)
 		g_object_weak_unref (G_OBJECT (genicam->priv->buffer), _weak_notify_cb, genicam);
 
 	g_hash_table_unref (genicam->priv->nodes);
+	g_hash_table_unref (genicam->priv->lazy_nodes);
+	g_ptr_array_unref (genicam->priv->lazy_node_list);
+	g_clear_pointer (&genicam->priv->xml, g_free);
+	g_clear_pointer (&genicam->priv->profile, g_ptr_array_unref);
+	g_rec_mutex_clear (&genicam->priv->nodes_mutex);
+
+	g_rw_lock_clear (&genicam->priv->lock);
+	g_mutex_clear (&genicam->priv->statistics_mutex);
 
 	G_OBJECT_CLASS (arv_gc_parent_class)->finalize (object);
 }
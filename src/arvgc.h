@@ -52,7 +52,8 @@ typedef enum {
 	ARV_GC_ERROR_SET_FROM_STRING_UNDEFINED,
 	ARV_GC_ERROR_GET_AS_STRING_UNDEFINED,
 	ARV_GC_ERROR_INVALID_BIT_RANGE,
-        ARV_GC_ERROR_INVALID_SYNTAX
+        ARV_GC_ERROR_INVALID_SYNTAX,
+	ARV_GC_ERROR_WRITE_IN_READ_LOCK
 } ArvGcError;
 
 /**
@@ -104,6 +105,45 @@ typedef enum {
 	ARV_ACCESS_CHECK_POLICY_DEFAULT = ARV_ACCESS_CHECK_POLICY_DISABLE
 } ArvAccessCheckPolicy;
 
+/**
+ * ArvGcProfileOperation:
+ * @feature: name of the feature node the operation was requested on
+ * @is_write: %TRUE for a value write or a command execution, %FALSE for a read
+ * @evaluated_nodes: %NULL terminated list of the names of the nodes evaluated during the operation, in
+ * evaluation order, including @feature
+ * @n_port_reads: number of port read transactions
+ * @n_port_writes: number of port write transactions
+ * @n_bytes_read: number of bytes read from the port
+ * @n_bytes_written: number of bytes written to the port
+ * @n_cache_hits: number of register cache hits
+ * @n_cache_misses: number of register cache misses
+ * @duration_us: wall time of the operation, in µs
+ *
+ * Register access profile of a feature operation, recorded between arv_gc_start_profiling() and
+ * arv_gc_stop_profiling().
+ *
+ * Since: 0.9.0
+ */
+
+typedef struct {
+	char *feature;
+	gboolean is_write;
+	char **evaluated_nodes;
+	guint n_port_reads;
+	guint n_port_writes;
+	guint64 n_bytes_read;
+	guint64 n_bytes_written;
+	guint n_cache_hits;
+	guint n_cache_misses;
+	gint64 duration_us;
+} ArvGcProfileOperation;
+
+#define ARV_TYPE_GC_PROFILE_OPERATION	(arv_gc_profile_operation_get_type ())
+
+ARV_API GType				arv_gc_profile_operation_get_type	(void);
+ARV_API ArvGcProfileOperation *		arv_gc_profile_operation_copy		(const ArvGcProfileOperation *operation);
+ARV_API void				arv_gc_profile_operation_free		(ArvGcProfileOperation *operation);
+
 #define ARV_TYPE_GC             (arv_gc_get_type ())
 ARV_API G_DECLARE_FINAL_TYPE (ArvGc, arv_gc, ARV, GC, ArvDomDocument)
 
@@ -122,6 +162,13 @@ ARV_API ArvDevice *			arv_gc_get_device			(ArvGc *genicam);
 ARV_API void				arv_gc_set_buffer			(ArvGc *genicam, ArvBuffer *buffer);
 ARV_API ArvBuffer *			arv_gc_get_buffer			(ArvGc *genicam);
 
+ARV_API void				arv_gc_lock_read			(ArvGc *genicam);
+ARV_API gboolean			arv_gc_lock_write			(ArvGc *genicam);
+ARV_API void				arv_gc_unlock				(ArvGc *genicam);
+
+ARV_API void				arv_gc_start_profiling			(ArvGc *genicam);
+ARV_API GPtrArray *			arv_gc_stop_profiling			(ArvGc *genicam);
+
 G_END_DECLS
 
 #endif
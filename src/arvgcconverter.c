@@ -32,6 +32,7 @@
 #include <arvgcfloat.h>
 #include <arvgcdefaultsprivate.h>
 #include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvdebugprivate.h>
 #include <string.h>
 
@@ -50,8 +51,14 @@ typedef struct {
 	ArvGcPropertyNode *is_linear;
 	ArvGcPropertyNode *slope;
 
+	/* Protects the formula_from evaluator state, as conversions to the
+	 * feature value can run concurrently, and the memoized results */
+	GMutex mutex;
 	ArvEvaluator *formula_to;
 	ArvEvaluator *formula_from;
+
+	ArvGcMemo int64_memos[ARV_GC_CONVERTER_NODE_TYPE_INC + 1];
+	ArvGcMemo double_memos[ARV_GC_CONVERTER_NODE_TYPE_INC + 1];
 } ArvGcConverterPrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvGcConverter, arv_gc_converter, ARV_TYPE_GC_FEATURE_NODE,
@@ -124,6 +131,7 @@ arv_gc_converter_init (ArvGcConverter *self)
 {
 	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (ARV_GC_CONVERTER (self));
 
+	g_mutex_init (&priv->mutex);
 	priv->formula_to = arv_evaluator_new (NULL);
 	priv->formula_from = arv_evaluator_new (NULL);
 	priv->value = NULL;
@@ -156,6 +164,7 @@ arv_gc_converter_finalize (GObject *object)
 
 	g_object_unref (priv->formula_to);
 	g_object_unref (priv->formula_from);
+	g_mutex_clear (&priv->mutex);
 
 	G_OBJECT_CLASS (arv_gc_converter_parent_class)->finalize (object);
 }
@@ -366,15 +375,13 @@ arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConve
 	return TRUE;
 }
 
-double
-arv_gc_converter_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
+static double
+_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
 {
 	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (gc_converter);
 	GError *local_error = NULL;
         double value;
 
-	g_return_val_if_fail (ARV_IS_GC_CONVERTER (gc_converter), 0.0);
-
 	if (!arv_gc_converter_update_from_variables (gc_converter, node_type, &local_error)) {
 		if (local_error != NULL)
                         g_propagate_prefixed_error (error, local_error, "[%s] ",
@@ -399,14 +406,50 @@ arv_gc_converter_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverter
         return value;
 }
 
-gint64
-arv_gc_converter_convert_to_int64 (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
+double
+arv_gc_converter_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
 {
 	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (gc_converter);
+	ArvGcMemo *memo;
+	ArvGc *genicam;
 	GError *local_error = NULL;
-        gint64 value;
+	guint change_count;
+	double value;
 
-	g_return_val_if_fail (ARV_IS_GC_CONVERTER (gc_converter), 0);
+	g_return_val_if_fail (ARV_IS_GC_CONVERTER (gc_converter), 0.0);
+	g_return_val_if_fail (node_type <= ARV_GC_CONVERTER_NODE_TYPE_INC, 0.0);
+
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (gc_converter));
+	change_count = arv_gc_get_change_count (genicam);
+	memo = &priv->double_memos[node_type];
+
+	g_mutex_lock (&priv->mutex);
+
+	if (memo->is_valid && memo->change_count == change_count) {
+		value = memo->value.v_double;
+	} else {
+		value = _convert_to_double (gc_converter, node_type, &local_error);
+
+		/* Only keep results of evaluations which did not change the document state */
+		memo->is_valid = local_error == NULL && arv_gc_get_change_count (genicam) == change_count;
+		memo->change_count = change_count;
+		memo->value.v_double = value;
+	}
+
+	g_mutex_unlock (&priv->mutex);
+
+	if (local_error != NULL)
+		g_propagate_error (error, local_error);
+
+	return value;
+}
+
+static gint64
+_convert_to_int64 (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
+{
+	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (gc_converter);
+	GError *local_error = NULL;
+        gint64 value;
 
 	if (!arv_gc_converter_update_from_variables (gc_converter, node_type, &local_error)) {
 		if (local_error != NULL)
@@ -432,6 +475,43 @@ arv_gc_converter_convert_to_int64 (ArvGcConverter *gc_converter, ArvGcConverterN
         return value;
 }
 
+gint64
+arv_gc_converter_convert_to_int64 (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
+{
+	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (gc_converter);
+	ArvGcMemo *memo;
+	ArvGc *genicam;
+	GError *local_error = NULL;
+	guint change_count;
+	gint64 value;
+
+	g_return_val_if_fail (ARV_IS_GC_CONVERTER (gc_converter), 0);
+	g_return_val_if_fail (node_type <= ARV_GC_CONVERTER_NODE_TYPE_INC, 0);
+
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (gc_converter));
+	change_count = arv_gc_get_change_count (genicam);
+	memo = &priv->int64_memos[node_type];
+
+	g_mutex_lock (&priv->mutex);
+
+	if (memo->is_valid && memo->change_count == change_count) {
+		value = memo->value.v_int64;
+	} else {
+		value = _convert_to_int64 (gc_converter, node_type, &local_error);
+
+		memo->is_valid = local_error == NULL && arv_gc_get_change_count (genicam) == change_count;
+		memo->change_count = change_count;
+		memo->value.v_int64 = value;
+	}
+
+	g_mutex_unlock (&priv->mutex);
+
+	if (local_error != NULL)
+		g_propagate_error (error, local_error);
+
+	return value;
+}
+
 static void
 arv_gc_converter_update_to_variables (ArvGcConverter *gc_converter, GError **error)
 {
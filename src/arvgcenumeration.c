@@ -32,6 +32,7 @@
 #include <arvgcstring.h>
 #include <arvgcfeaturenodeprivate.h>
 #include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvmisc.h>
 #include <arvdebugprivate.h>
 #include <string.h>
@@ -44,6 +45,16 @@ struct _ArvGcEnumeration {
 
 	GSList *selecteds;		/* #ArvGcPropertyNode */
 	GSList *selected_features;	/* #ArvGcFeatureNode */
+
+	/* Protects the lazily built indexes and the available entry cache */
+	GMutex mutex;
+	GPtrArray *indexed_entries;	/* #ArvGcEnumEntry, in document order */
+	GHashTable *entries_by_name;
+	GHashTable *entries_by_value;
+	gboolean selected_features_ready;
+
+	GPtrArray *available_entries;
+	guint available_change_count;
 };
 
 struct _ArvGcEnumerationClass {
@@ -93,8 +104,16 @@ arv_gc_enumeration_post_new_child (ArvDomNode *self, ArvDomNode *child)
 				ARV_DOM_NODE_CLASS (arv_gc_enumeration_parent_class)->post_new_child (self, child);
 				break;
 		}
-	} else if (ARV_IS_GC_ENUM_ENTRY (child))
+	} else if (ARV_IS_GC_ENUM_ENTRY (child)) {
 		node->entries = g_slist_prepend (node->entries, child);
+
+		g_mutex_lock (&node->mutex);
+		g_clear_pointer (&node->indexed_entries, g_ptr_array_unref);
+		g_clear_pointer (&node->entries_by_name, g_hash_table_unref);
+		g_clear_pointer (&node->entries_by_value, g_hash_table_unref);
+		g_clear_pointer (&node->available_entries, g_ptr_array_unref);
+		g_mutex_unlock (&node->mutex);
+	}
 }
 
 static void
@@ -105,107 +124,226 @@ arv_gc_enumeration_pre_remove_child (ArvDomNode *self, ArvDomNode *child)
 
 /* ArvGcEnumeration implementation */
 
-/**
- * arv_gc_enumeration_dup_available_int_values:
- * @enumeration: a #ArvGcEnumeration
- * @n_values: (out): the number of values
- * @error: (out): the error that occured, or NULL
- *
- * Return value: (transfer full) (array length=n_values): a newly allocated array of 64 bit integers, to be freed after
- * use using g_free().
- *
- * Since: 0.8.0
- */
+/* Builds the entry indexes on first use, once the document is loaded. Must be called with the enumeration mutex
+ * locked. Entry values are constants, they don't need to be revalidated. */
 
-gint64 *
-arv_gc_enumeration_dup_available_int_values (ArvGcEnumeration *enumeration, guint *n_values, GError **error)
+static gboolean
+_update_indexes (ArvGcEnumeration *enumeration, GError **error)
 {
-	gint64 *values;
-	const GSList *entries, *iter;
-	GSList *available_entries = NULL;
-	unsigned int i;
+	GPtrArray *indexed_entries;
+	GHashTable *entries_by_name;
+	GHashTable *entries_by_value;
+	GSList *iter;
+	guint n_entries;
+	guint i;
+
+	if (enumeration->indexed_entries != NULL)
+		return TRUE;
+
+	n_entries = g_slist_length (enumeration->entries);
+	indexed_entries = g_ptr_array_sized_new (n_entries);
+	g_ptr_array_set_size (indexed_entries, n_entries);
+
+	entries_by_name = g_hash_table_new (g_str_hash, g_str_equal);
+	entries_by_value = g_hash_table_new_full (g_int64_hash, g_int64_equal, g_free, NULL);
+
+	/* The entry list is in reverse document order. The first match of this list wins, as in the previous linear
+	 * searches. */
+	for (iter = enumeration->entries, i = 0; iter != NULL; iter = iter->next, i++) {
+		ArvGcEnumEntry *entry = iter->data;
+		GError *local_error = NULL;
+		const char *name;
+		gint64 value;
+
+		value = arv_gc_enum_entry_get_value (entry, &local_error);
+		if (local_error != NULL) {
+			g_propagate_prefixed_error (error, local_error, "[%s] ",
+						    arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (enumeration)));
+			g_ptr_array_unref (indexed_entries);
+			g_hash_table_unref (entries_by_name);
+			g_hash_table_unref (entries_by_value);
+			return FALSE;
+		}
+
+		g_ptr_array_index (indexed_entries, n_entries - i - 1) = entry;
+
+		if (!g_hash_table_contains (entries_by_value, &value)) {
+			gint64 *key = g_new (gint64, 1);
+
+			*key = value;
+			g_hash_table_insert (entries_by_value, key, entry);
+		}
+
+		name = arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (entry));
+		if (name != NULL && !g_hash_table_contains (entries_by_name, name))
+			g_hash_table_insert (entries_by_name, (char *) name, entry);
+	}
+
+	enumeration->indexed_entries = indexed_entries;
+	enumeration->entries_by_name = entries_by_name;
+	enumeration->entries_by_value = entries_by_value;
+
+	return TRUE;
+}
+
+static ArvGcEnumEntry *
+_lookup_entry_by_value (ArvGcEnumeration *enumeration, gint64 value, GError **error)
+{
+	ArvGcEnumEntry *entry = NULL;
+
+	g_mutex_lock (&enumeration->mutex);
+	if (_update_indexes (enumeration, error))
+		entry = g_hash_table_lookup (enumeration->entries_by_value, &value);
+	g_mutex_unlock (&enumeration->mutex);
+
+	return entry;
+}
+
+static ArvGcEnumEntry *
+_lookup_entry_by_name (ArvGcEnumeration *enumeration, const char *name, GError **error)
+{
+	ArvGcEnumEntry *entry = NULL;
+
+	if (name == NULL)
+		return NULL;
+
+	g_mutex_lock (&enumeration->mutex);
+	if (_update_indexes (enumeration, error))
+		entry = g_hash_table_lookup (enumeration->entries_by_name, name);
+	g_mutex_unlock (&enumeration->mutex);
+
+	return entry;
+}
+
+/* Returns the available and implemented entries, in document order. The result is cached until the next change of
+ * the document state, as entry availability may depend on any other feature. The mutex is not held during the
+ * evaluation of the entry availability, which may read this enumeration. */
+
+static GPtrArray *
+_dup_available_entries (ArvGcEnumeration *enumeration, GError **error)
+{
+	GPtrArray *available_entries;
+	GPtrArray *indexed_entries;
+	ArvGc *genicam;
 	GError *local_error = NULL;
+	guint change_count;
+	guint i;
 
-	g_return_val_if_fail (n_values != NULL, NULL);
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (enumeration));
+	change_count = arv_gc_get_change_count (genicam);
 
-	*n_values = 0;
+	g_mutex_lock (&enumeration->mutex);
 
-	g_return_val_if_fail (ARV_IS_GC_ENUMERATION (enumeration), NULL);
-	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+	if (enumeration->available_entries != NULL && enumeration->available_change_count == change_count) {
+		available_entries = g_ptr_array_ref (enumeration->available_entries);
+		g_mutex_unlock (&enumeration->mutex);
+		return available_entries;
+	}
 
-	entries = arv_gc_enumeration_get_entries (enumeration);
+	if (!_update_indexes (enumeration, &local_error)) {
+		g_mutex_unlock (&enumeration->mutex);
+		g_propagate_error (error, local_error);
+		return NULL;
+	}
 
-	*n_values = 0;
-	for (iter = entries; iter != NULL; iter = iter->next) {
+	indexed_entries = g_ptr_array_ref (enumeration->indexed_entries);
+
+	g_mutex_unlock (&enumeration->mutex);
+
+	available_entries = g_ptr_array_new ();
+
+	for (i = 0; i < indexed_entries->len; i++) {
+		ArvGcFeatureNode *entry = g_ptr_array_index (indexed_entries, i);
 		gboolean is_available;
+		gboolean is_implemented = FALSE;
 
-		is_available = arv_gc_feature_node_is_available (iter->data, &local_error);
+		is_available = arv_gc_feature_node_is_available (entry, &local_error);
+		if (local_error == NULL && is_available)
+			is_implemented = arv_gc_feature_node_is_implemented (entry, &local_error);
 
 		if (local_error != NULL) {
 			g_propagate_prefixed_error (error, local_error, "[%s] ",
-                                                    arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (enumeration)));
-			*n_values = 0;
-			g_slist_free (available_entries);
-
+						    arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (enumeration)));
+			g_ptr_array_unref (available_entries);
+			g_ptr_array_unref (indexed_entries);
 			return NULL;
 		}
 
-		if (is_available) {
-			gboolean is_implemented;
+		if (is_implemented)
+			g_ptr_array_add (available_entries, entry);
+	}
 
-			is_implemented = arv_gc_feature_node_is_implemented (iter->data, &local_error);
+	g_ptr_array_unref (indexed_entries);
 
-			if (local_error != NULL) {
-                                g_propagate_prefixed_error (error, local_error, "[%s] ",
-                                                            arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (enumeration)));
-                                *n_values = 0;
-                                g_slist_free (available_entries);
+	/* Only keep results of evaluations which did not change the document state */
+	if (arv_gc_get_change_count (genicam) == change_count) {
+		g_mutex_lock (&enumeration->mutex);
+		g_clear_pointer (&enumeration->available_entries, g_ptr_array_unref);
+		enumeration->available_entries = g_ptr_array_ref (available_entries);
+		enumeration->available_change_count = change_count;
+		g_mutex_unlock (&enumeration->mutex);
+	}
 
-				return NULL;
-			}
+	return available_entries;
+}
 
-			if (is_implemented) {
-				(*n_values)++;
-				available_entries = g_slist_prepend (available_entries, iter->data);
-			}
-		}
-	}
+static gint64 *
+_dup_available_int_values (ArvGcEnumeration *enumeration, guint *n_values, GError **error)
+{
+	GPtrArray *available_entries;
+	gint64 *values;
+	unsigned int i;
+	GError *local_error = NULL;
 
-	if (*n_values == 0) {
-		g_slist_free (available_entries);
+	*n_values = 0;
+
+	available_entries = _dup_available_entries (enumeration, error);
+	if (available_entries == NULL)
+		return NULL;
+
+	if (available_entries->len == 0) {
+		g_ptr_array_unref (available_entries);
 		return NULL;
 	}
 
-	values = g_new (gint64, *n_values);
-	for (iter = available_entries, i = 0; iter != NULL; iter = iter->next) {
+	values = g_new (gint64, available_entries->len);
+	for (i = 0; i < available_entries->len; i++) {
 
-		values[i] = arv_gc_enum_entry_get_value (iter->data, &local_error);
+		values[i] = arv_gc_enum_entry_get_value (g_ptr_array_index (available_entries, i), &local_error);
 
 		if (local_error != NULL) {
                         g_propagate_prefixed_error (error, local_error, "[%s] ",
                                                     arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (enumeration)));
-                        *n_values = 0;
-                        g_slist_free (available_entries);
+                        g_ptr_array_unref (available_entries);
                         g_free (values);
 
 			return NULL;
 		}
-		i++;
 	}
 
-	g_slist_free (available_entries);
+	*n_values = available_entries->len;
+
+	g_ptr_array_unref (available_entries);
 
 	return values;
 }
 
-static const char **
-_dup_available_string_values (ArvGcEnumeration *enumeration, gboolean display_name ,guint *n_values, GError **error)
+/**
+ * arv_gc_enumeration_dup_available_int_values:
+ * @enumeration: a #ArvGcEnumeration
+ * @n_values: (out): the number of values
+ * @error: (out): the error that occured, or NULL
+ *
+ * Return value: (transfer full) (array length=n_values): a newly allocated array of 64 bit integers, to be freed after
+ * use using g_free().
+ *
+ * Since: 0.8.0
+ */
+
+gint64 *
+arv_gc_enumeration_dup_available_int_values (ArvGcEnumeration *enumeration, guint *n_values, GError **error)
 {
-	const char ** strings;
-	const GSList *entries, *iter;
-	GSList *available_entries = NULL;
-	unsigned int i;
-	GError *local_error = NULL;
+	gint64 *values;
 
 	g_return_val_if_fail (n_values != NULL, NULL);
 
@@ -214,60 +352,50 @@ _dup_available_string_values (ArvGcEnumeration *enumeration, gboolean display_na
 	g_return_val_if_fail (ARV_IS_GC_ENUMERATION (enumeration), NULL);
 	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
 
-	entries = arv_gc_enumeration_get_entries (enumeration);
-
-	*n_values = 0;
-	for (iter = entries; iter != NULL; iter = iter->next) {
-		gboolean is_available;
-
-		is_available = arv_gc_feature_node_is_available (iter->data, &local_error);
-
-		if (local_error != NULL) {
-                        g_propagate_prefixed_error (error, local_error, "[%s] ",
-                                                    arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (enumeration)));
-			*n_values = 0;
-			g_slist_free (available_entries);
+	arv_gc_node_lock_read (ARV_GC_NODE (enumeration));
+	values = _dup_available_int_values (enumeration, n_values, error);
+	arv_gc_node_unlock (ARV_GC_NODE (enumeration));
 
-			return NULL;
-		}
+	return values;
+}
 
-		if (is_available) {
-			gboolean is_implemented;
+static const char **
+_dup_available_string_values (ArvGcEnumeration *enumeration, gboolean display_name ,guint *n_values, GError **error)
+{
+	GPtrArray *available_entries;
+	const char ** strings;
+	unsigned int i;
 
-			is_implemented = arv_gc_feature_node_is_implemented (iter->data, &local_error);
+	g_return_val_if_fail (n_values != NULL, NULL);
 
-			if (local_error != NULL) {
-                                g_propagate_prefixed_error (error, local_error, "[%s] ",
-                                                            arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (enumeration)));
-                                *n_values = 0;
-                                g_slist_free (available_entries);
+	*n_values = 0;
 
-				return NULL;
-			}
+	g_return_val_if_fail (ARV_IS_GC_ENUMERATION (enumeration), NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
 
-			if (is_implemented) {
-				(*n_values)++;
-				available_entries = g_slist_prepend (available_entries, iter->data);
-			}
-		}
-	}
+	available_entries = _dup_available_entries (enumeration, error);
+	if (available_entries == NULL)
+		return NULL;
 
-	if (*n_values == 0) {
-		g_slist_free (available_entries);
+	if (available_entries->len == 0) {
+		g_ptr_array_unref (available_entries);
 		return NULL;
 	}
 
-	strings = g_new (const char*, *n_values);
-	for (iter = available_entries, i = 0; iter != NULL; iter = iter->next, i++) {
+	strings = g_new (const char*, available_entries->len);
+	for (i = 0; i < available_entries->len; i++) {
+		ArvGcFeatureNode *entry = g_ptr_array_index (available_entries, i);
 		const char *string = NULL;
 		if (display_name)
-			string = arv_gc_feature_node_get_display_name (iter->data);
+			string = arv_gc_feature_node_get_display_name (entry);
 		if (string == NULL)
-			string = arv_gc_feature_node_get_name (iter->data);
+			string = arv_gc_feature_node_get_name (entry);
 		strings[i] = string;
 	}
 
-	g_slist_free (available_entries);
+	*n_values = available_entries->len;
+
+	g_ptr_array_unref (available_entries);
 
 	return strings;
 }
@@ -289,7 +417,15 @@ _dup_available_string_values (ArvGcEnumeration *enumeration, gboolean display_na
 const char **
 arv_gc_enumeration_dup_available_string_values (ArvGcEnumeration *enumeration, guint *n_values, GError **error)
 {
-	return _dup_available_string_values (enumeration, FALSE, n_values, error);
+	const char **values;
+
+	g_return_val_if_fail (ARV_IS_GC_ENUMERATION (enumeration), NULL);
+
+	arv_gc_node_lock_read (ARV_GC_NODE (enumeration));
+	values = _dup_available_string_values (enumeration, FALSE, n_values, error);
+	arv_gc_node_unlock (ARV_GC_NODE (enumeration));
+
+	return values;
 }
 
 /**
@@ -309,7 +445,15 @@ arv_gc_enumeration_dup_available_string_values (ArvGcEnumeration *enumeration, g
 const char **
 arv_gc_enumeration_dup_available_display_names (ArvGcEnumeration *enumeration, guint *n_values, GError **error)
 {
-	return _dup_available_string_values (enumeration, TRUE, n_values, error);
+	const char **values;
+
+	g_return_val_if_fail (ARV_IS_GC_ENUMERATION (enumeration), NULL);
+
+	arv_gc_node_lock_read (ARV_GC_NODE (enumeration));
+	values = _dup_available_string_values (enumeration, TRUE, n_values, error);
+	arv_gc_node_unlock (ARV_GC_NODE (enumeration));
+
+	return values;
 }
 
 static gint64
@@ -338,11 +482,18 @@ _get_int_value (ArvGcEnumeration *enumeration, GError **error)
 gint64
 arv_gc_enumeration_get_int_value (ArvGcEnumeration *enumeration, GError **error)
 {
+	gint64 value = 0;
+
+	g_return_val_if_fail (ARV_IS_GC_ENUMERATION (enumeration), 0);
+
+	arv_gc_node_lock_read (ARV_GC_NODE (enumeration));
+
+        if (arv_gc_feature_node_check_read_access (ARV_GC_FEATURE_NODE (enumeration), error))
+                value = _get_int_value (enumeration, error);
 
-        if (!arv_gc_feature_node_check_read_access (ARV_GC_FEATURE_NODE (enumeration), error))
-                return 0;
+	arv_gc_node_unlock (ARV_GC_NODE (enumeration));
 
-        return _get_int_value (enumeration, error);
+	return value;
 }
 
 static gboolean
@@ -410,16 +561,25 @@ _set_int_value (ArvGcEnumeration *enumeration, gint64 value, GError **error)
 gboolean
 arv_gc_enumeration_set_int_value (ArvGcEnumeration *enumeration, gint64 value, GError **error)
 {
-        if (!arv_gc_feature_node_check_write_access (ARV_GC_FEATURE_NODE (enumeration), error))
-                return FALSE;
+	gboolean success = FALSE;
+
+	g_return_val_if_fail (ARV_IS_GC_ENUMERATION (enumeration), FALSE);
+
+	if (!arv_gc_node_lock_write (ARV_GC_NODE (enumeration), error))
+		return FALSE;
 
-        return _set_int_value (enumeration, value, error);
+        if (arv_gc_feature_node_check_write_access (ARV_GC_FEATURE_NODE (enumeration), error))
+                success = _set_int_value (enumeration, value, error);
+
+	arv_gc_node_unlock (ARV_GC_NODE (enumeration));
+
+	return success;
 }
 
 static const char *
 _get_string_value (ArvGcEnumeration *enumeration, GError **error)
 {
-	const GSList *iter;
+	ArvGcEnumEntry *entry;
 	GError *local_error = NULL;
 	gint64 value;
 
@@ -434,25 +594,20 @@ _get_string_value (ArvGcEnumeration *enumeration, GError **error)
 		return NULL;
 	}
 
-	for (iter = enumeration->entries; iter != NULL; iter = iter->next) {
-		gint64 enum_value;
+	entry = _lookup_entry_by_value (enumeration, value, &local_error);
 
-		enum_value = arv_gc_enum_entry_get_value (iter->data, &local_error);
-
-		if (local_error != NULL) {
-                        g_propagate_prefixed_error (error, local_error, "[%s] ",
-                                                    arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (enumeration)));
-                        return NULL;
-                }
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return NULL;
+	}
 
-		if (enum_value == value) {
-			const char *string;
+	if (entry != NULL) {
+		const char *string;
 
-			string = arv_gc_feature_node_get_name (iter->data);
-			arv_debug_genicam ("[GcEnumeration::get_string_value] value = %" G_GINT64_FORMAT " - string = %s",
-					 value, string);
-			return string;
-		}
+		string = arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (entry));
+		arv_debug_genicam ("[GcEnumeration::get_string_value] value = %" G_GINT64_FORMAT " - string = %s",
+				   value, string);
+		return string;
 	}
 
 	arv_warning_genicam ("[GcEnumeration::get_string_value] value = %" G_GINT64_FORMAT " not found for node %s",
@@ -464,47 +619,61 @@ _get_string_value (ArvGcEnumeration *enumeration, GError **error)
 const char *
 arv_gc_enumeration_get_string_value (ArvGcEnumeration *enumeration, GError **error)
 {
-        if (!arv_gc_feature_node_check_read_access (ARV_GC_FEATURE_NODE (enumeration), error))
-                return NULL;
+	const char *value = NULL;
+
+	g_return_val_if_fail (ARV_IS_GC_ENUMERATION (enumeration), NULL);
+
+	arv_gc_node_lock_read (ARV_GC_NODE (enumeration));
+
+        if (arv_gc_feature_node_check_read_access (ARV_GC_FEATURE_NODE (enumeration), error))
+                value = _get_string_value (enumeration, error);
 
-        return _get_string_value (enumeration, error);
+	arv_gc_node_unlock (ARV_GC_NODE (enumeration));
+
+	return value;
 }
 
 static gboolean
 _set_string_value (ArvGcEnumeration *enumeration, const char *value, GError **error)
 {
-	const GSList *iter;
+	ArvGcEnumEntry *entry;
+	GError *local_error = NULL;
 
 	g_return_val_if_fail (ARV_IS_GC_ENUMERATION (enumeration), FALSE);
 	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
 
-	for (iter = enumeration->entries; iter != NULL; iter = iter->next)
-		if (g_strcmp0 (arv_gc_feature_node_get_name (iter->data), value) == 0) {
-			GError *local_error = NULL;
-			gint64 enum_value;
+	entry = _lookup_entry_by_name (enumeration, value, &local_error);
 
-			enum_value = arv_gc_enum_entry_get_value (iter->data, &local_error);
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return FALSE;
+	}
 
-			arv_debug_genicam ("[GcEnumeration::set_string_value] value = %" G_GINT64_FORMAT " - string = %s",
-					 enum_value, value);
+	if (entry != NULL) {
+		gint64 enum_value;
 
-			if (local_error != NULL) {
-                                g_propagate_prefixed_error (error, local_error, "[%s] ",
-                                                            arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (enumeration)));
-                                return FALSE;
-                        }
+		enum_value = arv_gc_enum_entry_get_value (entry, &local_error);
 
-			_set_int_value (enumeration, enum_value, &local_error);
+		arv_debug_genicam ("[GcEnumeration::set_string_value] value = %" G_GINT64_FORMAT " - string = %s",
+				   enum_value, value);
 
-			if (local_error != NULL) {
-                                g_propagate_prefixed_error (error, local_error, "[%s] ",
-                                                            arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (enumeration)));
-				return FALSE;
-			}
+		if (local_error != NULL) {
+			g_propagate_prefixed_error (error, local_error, "[%s] ",
+						    arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (enumeration)));
+			return FALSE;
+		}
+
+		_set_int_value (enumeration, enum_value, &local_error);
 
-			return TRUE;
+		if (local_error != NULL) {
+			g_propagate_prefixed_error (error, local_error, "[%s] ",
+						    arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (enumeration)));
+			return FALSE;
 		}
 
+		return TRUE;
+	}
+
 	arv_warning_genicam ("[GcEnumeration::set_string_value] entry %s not found", value);
 
 	g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_ENUM_ENTRY_NOT_FOUND, "[%s] '%s' not an entry",
@@ -516,10 +685,19 @@ _set_string_value (ArvGcEnumeration *enumeration, const char *value, GError **er
 gboolean
 arv_gc_enumeration_set_string_value (ArvGcEnumeration *enumeration, const char *value, GError **error)
 {
-        if (!arv_gc_feature_node_check_write_access (ARV_GC_FEATURE_NODE (enumeration), error))
-                return FALSE;
+	gboolean success = FALSE;
+
+	g_return_val_if_fail (ARV_IS_GC_ENUMERATION (enumeration), FALSE);
 
-        return _set_string_value (enumeration, value, error);
+	if (!arv_gc_node_lock_write (ARV_GC_NODE (enumeration), error))
+		return FALSE;
+
+        if (arv_gc_feature_node_check_write_access (ARV_GC_FEATURE_NODE (enumeration), error))
+                success = _set_string_value (enumeration, value, error);
+
+	arv_gc_node_unlock (ARV_GC_NODE (enumeration));
+
+	return success;
 }
 
 /**
@@ -566,6 +744,7 @@ arv_gc_enumeration_new (void)
 static void
 arv_gc_enumeration_init (ArvGcEnumeration *gc_enumeration)
 {
+	g_mutex_init (&gc_enumeration->mutex);
 }
 
 static void
@@ -577,6 +756,12 @@ arv_gc_enumeration_finalize (GObject *object)
 	g_clear_pointer (&enumeration->selecteds, g_slist_free);
 	g_clear_pointer (&enumeration->selected_features, g_slist_free);
 
+	g_clear_pointer (&enumeration->indexed_entries, g_ptr_array_unref);
+	g_clear_pointer (&enumeration->entries_by_name, g_hash_table_unref);
+	g_clear_pointer (&enumeration->entries_by_value, g_hash_table_unref);
+	g_clear_pointer (&enumeration->available_entries, g_ptr_array_unref);
+	g_mutex_clear (&enumeration->mutex);
+
 	G_OBJECT_CLASS (arv_gc_enumeration_parent_class)->finalize (object);
 }
 
@@ -671,12 +856,18 @@ arv_gc_enumeration_get_selected_features (ArvGcSelector *selector)
 	ArvGcEnumeration *enumeration = ARV_GC_ENUMERATION (selector);
 	GSList *iter;
 
-	g_clear_pointer (&enumeration->selected_features, g_slist_free);
-	for (iter = enumeration->selecteds; iter != NULL; iter = iter->next) {
-		ArvGcFeatureNode *feature_node = ARV_GC_FEATURE_NODE (arv_gc_property_node_get_linked_node (iter->data));
-		if (ARV_IS_GC_FEATURE_NODE (feature_node))
-		    enumeration->selected_features = g_slist_prepend (enumeration->selected_features, feature_node);
+	/* The selected feature list is resolved once, the returned list must stay valid for concurrent readers */
+	g_mutex_lock (&enumeration->mutex);
+	if (!enumeration->selected_features_ready) {
+		for (iter = enumeration->selecteds; iter != NULL; iter = iter->next) {
+			ArvGcFeatureNode *feature_node = ARV_GC_FEATURE_NODE (arv_gc_property_node_get_linked_node (iter->data));
+			if (ARV_IS_GC_FEATURE_NODE (feature_node))
+				enumeration->selected_features = g_slist_prepend (enumeration->selected_features,
+										  feature_node);
+		}
+		enumeration->selected_features_ready = TRUE;
 	}
+	g_mutex_unlock (&enumeration->mutex);
 
 	return enumeration->selected_features;
 }
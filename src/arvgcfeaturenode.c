@@ -31,6 +31,7 @@
 #include <arvgcfeaturenodeprivate.h>
 #include <arvgcpropertynode.h>
 #include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvgcboolean.h>
 #include <arvgcinteger.h>
 #include <arvgcfloat.h>
@@ -61,8 +62,6 @@ typedef struct {
         ArvGcPropertyNode *cast_alias;
 
 	guint64 change_count;
-
-	char *string_buffer;
 } ArvGcFeatureNodePrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvGcFeatureNode, arv_gc_feature_node, ARV_TYPE_GC_NODE, G_ADD_PRIVATE (ArvGcFeatureNode))
@@ -328,8 +327,9 @@ arv_gc_feature_node_is_implemented (ArvGcFeatureNode *gc_feature_node, GError **
 	if (priv->is_implemented == NULL)
 		return TRUE;
 
-
+	arv_gc_node_lock_read (ARV_GC_NODE (gc_feature_node));
 	value = arv_gc_property_node_get_int64 (priv->is_implemented, &local_error) != 0;
+	arv_gc_node_unlock (ARV_GC_NODE (gc_feature_node));
 
 	if (local_error != NULL) {
                 g_propagate_prefixed_error (error, local_error, "[%s] ",
@@ -353,7 +353,9 @@ arv_gc_feature_node_is_available (ArvGcFeatureNode *gc_feature_node, GError **er
 	if (priv->is_available == NULL)
 		return TRUE;
 
+	arv_gc_node_lock_read (ARV_GC_NODE (gc_feature_node));
 	value = arv_gc_property_node_get_int64 (priv->is_available, &local_error) != 0;
+	arv_gc_node_unlock (ARV_GC_NODE (gc_feature_node));
 
 	if (local_error != NULL) {
                 g_propagate_prefixed_error (error, local_error, "[%s] ",
@@ -376,7 +378,9 @@ arv_gc_feature_node_is_locked (ArvGcFeatureNode *gc_feature_node, GError **error
 	if (priv->is_locked == NULL)
 		return FALSE;
 
+	arv_gc_node_lock_read (ARV_GC_NODE (gc_feature_node));
 	locked = arv_gc_property_node_get_int64 (priv->is_locked, &local_error) != 0;
+	arv_gc_node_unlock (ARV_GC_NODE (gc_feature_node));
 
 	if (local_error != NULL) {
                 g_propagate_prefixed_error (error, local_error, "[%s] ",
@@ -524,31 +528,32 @@ arv_gc_feature_node_set_value_from_string (ArvGcFeatureNode *self, const char *s
  *
  * Retrieve the node value a string.
  *
- * <warning><para>Please note the string content is still owned by the @node object, which means the returned pointer may not be still valid after a new call to this function.</para></warning>
+ * <warning><para>Please note the string content is owned by the library, in a buffer local to the calling thread, which means the returned pointer may not be still valid after a new call to this function from the same thread.</para></warning>
  *
  * Returns: (transfer none): a string representation of the node value, %NULL if not applicable.
  */
 
+/* Numeric values are formatted in a per thread buffer, concurrent readers of the same node don't share the
+ * returned string */
+
+static GPrivate arv_gc_feature_node_string_buffer = G_PRIVATE_INIT (g_free);
+
 const char *
 arv_gc_feature_node_get_value_as_string (ArvGcFeatureNode *self, GError **error)
 {
-	ArvGcFeatureNodePrivate *priv = arv_gc_feature_node_get_instance_private (self);
         GError *local_error = NULL;
         const char *value = NULL;
+	char *string = NULL;
 
 	g_return_val_if_fail (ARV_IS_GC_FEATURE_NODE (self), NULL);
 
 	if (ARV_IS_GC_ENUMERATION (self)) {
                 value = arv_gc_enumeration_get_string_value (ARV_GC_ENUMERATION (self), &local_error);
 	} else if (ARV_IS_GC_INTEGER (self)) {
-		g_free (priv->string_buffer);
-		priv->string_buffer = g_strdup_printf ("%" G_GINT64_FORMAT,
-                                                       arv_gc_integer_get_value (ARV_GC_INTEGER (self), &local_error));
-		value = priv->string_buffer;
+		string = g_strdup_printf ("%" G_GINT64_FORMAT,
+                                          arv_gc_integer_get_value (ARV_GC_INTEGER (self), &local_error));
 	} else if (ARV_IS_GC_FLOAT (self)) {
-		g_free (priv->string_buffer);
-		priv->string_buffer = g_strdup_printf ("%g", arv_gc_float_get_value (ARV_GC_FLOAT (self), &local_error));
-		value = priv->string_buffer;
+		string = g_strdup_printf ("%g", arv_gc_float_get_value (ARV_GC_FLOAT (self), &local_error));
 	} else if (ARV_IS_GC_STRING (self)) {
 		value =  arv_gc_string_get_value (ARV_GC_STRING (self), &local_error);
 	} else if (ARV_IS_GC_BOOLEAN (self)) {
@@ -558,6 +563,11 @@ arv_gc_feature_node_get_value_as_string (ArvGcFeatureNode *self, GError **error)
                              "Don't know how to set value from string");
         }
 
+	if (string != NULL) {
+		g_private_replace (&arv_gc_feature_node_string_buffer, string);
+		value = string;
+	}
+
         if (local_error != NULL)
                 g_propagate_error (error, local_error);
 
@@ -568,10 +578,15 @@ void
 arv_gc_feature_node_increment_change_count (ArvGcFeatureNode *self)
 {
 	ArvGcFeatureNodePrivate *priv = arv_gc_feature_node_get_instance_private (self);
+	ArvGc *genicam;
 
 	g_return_if_fail (ARV_IS_GC_FEATURE_NODE (self));
 
 	priv->change_count++;
+
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (self));
+	if (genicam != NULL)
+		arv_gc_increment_change_count (genicam);
 }
 
 guint64
@@ -599,7 +614,6 @@ arv_gc_feature_node_finalize (GObject *object)
 
 	g_clear_pointer (&priv->name, g_free);
         g_clear_pointer (&priv->comment, g_free);
-	g_clear_pointer (&priv->string_buffer, g_free);
 
 	G_OBJECT_CLASS (arv_gc_feature_node_parent_class)->finalize (object);
 }
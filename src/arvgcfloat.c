@@ -29,6 +29,7 @@
 #include <arvgcfeaturenodeprivate.h>
 #include <arvgcdefaultsprivate.h>
 #include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvmisc.h>
 #include <stdio.h>
 #include <arvdebugprivate.h>
@@ -43,25 +44,28 @@ G_DEFINE_INTERFACE (ArvGcFloat, arv_gc_float, G_TYPE_OBJECT)
 double
 arv_gc_float_get_value (ArvGcFloat *gc_float, GError **error)
 {
+	double value = 0.0;
+
 	g_return_val_if_fail (ARV_IS_GC_FLOAT (gc_float), 0.0);
 	g_return_val_if_fail (error == NULL || *error == NULL, 0.0);
 
-        if (!arv_gc_feature_node_check_read_access (ARV_GC_FEATURE_NODE (gc_float), error))
-                return 0.0;
+	arv_gc_node_lock_read (ARV_GC_NODE (gc_float));
+
+        if (arv_gc_feature_node_check_read_access (ARV_GC_FEATURE_NODE (gc_float), error))
+                value = ARV_GC_FLOAT_GET_IFACE (gc_float)->get_value (gc_float, error);
 
-	return ARV_GC_FLOAT_GET_IFACE (gc_float)->get_value (gc_float, error);
+	arv_gc_node_unlock (ARV_GC_NODE (gc_float));
+
+	return value;
 }
 
-void
-arv_gc_float_set_value (ArvGcFloat *gc_float, double value, GError **error)
+static void
+_set_value (ArvGcFloat *gc_float, double value, GError **error)
 {
 	ArvGc *genicam;
 	ArvRangeCheckPolicy policy;
 	GError *local_error = NULL;
 
-	g_return_if_fail (ARV_IS_GC_FLOAT (gc_float));
-	g_return_if_fail (error == NULL || *error == NULL);
-
         if (!arv_gc_feature_node_check_write_access (ARV_GC_FEATURE_NODE (gc_float), error))
                 return;
 
@@ -107,6 +111,18 @@ arv_gc_float_set_value (ArvGcFloat *gc_float, double value, GError **error)
 	ARV_GC_FLOAT_GET_IFACE (gc_float)->set_value (gc_float, value, error);
 }
 
+void
+arv_gc_float_set_value (ArvGcFloat *gc_float, double value, GError **error)
+{
+	g_return_if_fail (ARV_IS_GC_FLOAT (gc_float));
+	g_return_if_fail (error == NULL || *error == NULL);
+
+	if (!arv_gc_node_lock_write (ARV_GC_NODE (gc_float), error))
+		return;
+	_set_value (gc_float, value, error);
+	arv_gc_node_unlock (ARV_GC_NODE (gc_float));
+}
+
 /**
  * arv_gc_float_get_min:
  * @gc_float: a #ArvGcFloat
@@ -125,8 +141,15 @@ arv_gc_float_get_min (ArvGcFloat *gc_float, GError **error)
 
 	float_interface = ARV_GC_FLOAT_GET_IFACE (gc_float);
 
-	if (float_interface->get_min != NULL)
-		return float_interface->get_min (gc_float, error);
+	if (float_interface->get_min != NULL) {
+		double value;
+
+		arv_gc_node_lock_read (ARV_GC_NODE (gc_float));
+		value = float_interface->get_min (gc_float, error);
+		arv_gc_node_unlock (ARV_GC_NODE (gc_float));
+
+		return value;
+	}
 
 	g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_PROPERTY_NOT_DEFINED, "[%s] <Min> node not found",
 		     arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (gc_float)));
@@ -152,8 +175,15 @@ arv_gc_float_get_max (ArvGcFloat *gc_float, GError **error)
 
 	float_interface = ARV_GC_FLOAT_GET_IFACE (gc_float);
 
-	if (float_interface->get_max != NULL)
-		return float_interface->get_max (gc_float, error);
+	if (float_interface->get_max != NULL) {
+		double value;
+
+		arv_gc_node_lock_read (ARV_GC_NODE (gc_float));
+		value = float_interface->get_max (gc_float, error);
+		arv_gc_node_unlock (ARV_GC_NODE (gc_float));
+
+		return value;
+	}
 
 	g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_PROPERTY_NOT_DEFINED, "[%s] <Max> node not found",
 		     arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (gc_float)));
@@ -179,8 +209,15 @@ arv_gc_float_get_inc (ArvGcFloat *gc_float, GError **error)
 
 	float_interface = ARV_GC_FLOAT_GET_IFACE (gc_float);
 
-	if (float_interface->get_inc != NULL)
-		return float_interface->get_inc (gc_float, error);
+	if (float_interface->get_inc != NULL) {
+		double value;
+
+		arv_gc_node_lock_read (ARV_GC_NODE (gc_float));
+		value = float_interface->get_inc (gc_float, error);
+		arv_gc_node_unlock (ARV_GC_NODE (gc_float));
+
+		return value;
+	}
 
 	g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_PROPERTY_NOT_DEFINED, "[%s] <Inc> node not found",
 		     arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (gc_float)));
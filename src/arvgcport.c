@@ -34,7 +34,7 @@
 #include <arvchunkparserprivate.h>
 #include <arvbuffer.h>
 #include <arvgcpropertynode.h>
-#include <arvgc.h>
+#include <arvgcprivate.h>
 #include <memory.h>
 
 typedef struct {
@@ -77,6 +77,8 @@ static ArvGvLegacyInfos arv_gc_port_legacy_infos[] = {
 typedef struct {
 	ArvGcPropertyNode *chunk_id;
 	ArvGcPropertyNode *event_id;
+	gsize chunk_id_resolved;
+	guint chunk_id_value;
 	gboolean has_done_legacy_check;
 	gboolean has_legacy_infos;
 } ArvGcPortPrivate;
@@ -165,6 +167,20 @@ _use_legacy_endianness_mechanism (ArvGcPort *port, guint64 length)
 	return length == 4 && port->priv->has_legacy_infos;
 }
 
+/* The chunk id is resolved once, instead of parsing its hexadecimal string on each access */
+
+static guint
+_get_chunk_id (ArvGcPort *port)
+{
+	if (g_once_init_enter (&port->priv->chunk_id_resolved)) {
+		port->priv->chunk_id_value = g_ascii_strtoll (arv_gc_property_node_get_string (port->priv->chunk_id, NULL),
+							      NULL, 16);
+		g_once_init_leave (&port->priv->chunk_id_resolved, 1);
+	}
+
+	return port->priv->chunk_id_value;
+}
+
 void
 arv_gc_port_read (ArvGcPort *port, void *buffer, guint64 address, guint64 length, GError **error)
 {
@@ -189,7 +205,7 @@ arv_gc_port_read (ArvGcPort *port, void *buffer, guint64 address, guint64 length
 			size_t chunk_data_size;
 			guint chunk_id;
 
-			chunk_id = g_ascii_strtoll (arv_gc_property_node_get_string (port->priv->chunk_id, NULL), NULL, 16);
+			chunk_id = _get_chunk_id (port);
 			chunk_data = (char *) arv_buffer_get_chunk_data (chunk_data_buffer, chunk_id, &chunk_data_size);
 
 			if (chunk_data != NULL) {
@@ -236,6 +252,8 @@ arv_gc_port_read (ArvGcPort *port, void *buffer, guint64 address, guint64 length
 				*((guint32 *) buffer) = GUINT32_TO_BE (value);
 			} else
 				arv_device_read_memory (device, address, length, buffer, error);
+
+			arv_gc_profile_port_access (genicam, FALSE, length);
 		} else {
 			g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_NO_DEVICE_SET,
 				     "[%s] No device set",
@@ -271,7 +289,7 @@ arv_gc_port_write (ArvGcPort *port, void *buffer, guint64 address, guint64 lengt
 			size_t chunk_data_size;
 			guint chunk_id;
 
-			chunk_id = g_ascii_strtoll (arv_gc_property_node_get_string (port->priv->chunk_id, NULL), NULL, 16);
+			chunk_id = _get_chunk_id (port);
 			chunk_data = (char *) arv_buffer_get_chunk_data (chunk_data_buffer, chunk_id, &chunk_data_size);
 
 			if (chunk_data != NULL) {
@@ -303,6 +321,8 @@ arv_gc_port_write (ArvGcPort *port, void *buffer, guint64 address, guint64 lengt
 				arv_device_write_register (device, address, value, error);
 			} else
 				arv_device_write_memory (device, address, length, buffer, error);
+
+			arv_gc_profile_port_access (genicam, TRUE, length);
 		} else {
 			g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_NO_DEVICE_SET,
 				     "[%s] No device set",
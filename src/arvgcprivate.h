@@ -25,6 +25,33 @@
 
 #include <arvgc.h>
 
+ArvGc *                    arv_gc_new_take                         (ArvDevice *device, char *xml, size_t size);
+const char *               arv_gc_get_xml                          (ArvGc *genicam, size_t *size);
+
 ARV_API guint64            arv_gc_register_cache_error_add         (ArvGc *genicam, guint64 n_errors);
+void                       arv_gc_register_cache_count             (ArvGc *genicam, gboolean hit);
+void                       arv_gc_get_register_cache_statistics    (ArvGc *genicam, guint64 *n_hits,
+                                                                    guint64 *n_misses, guint64 *n_errors);
+
+void                       arv_gc_node_lock_read                   (ArvGcNode *node);
+gboolean                   arv_gc_node_lock_write                  (ArvGcNode *node, GError **error);
+void                       arv_gc_node_unlock                      (ArvGcNode *node);
+
+void                       arv_gc_profile_port_access              (ArvGc *genicam, gboolean write, guint64 length);
+
+guint                      arv_gc_get_change_count                 (ArvGc *genicam);
+void                       arv_gc_increment_change_count           (ArvGc *genicam);
+guint                      arv_gc_get_registration_count           (ArvGc *genicam);
+
+/* Last result of a formula evaluation, valid as long as the document change count is equal to change_count */
+
+typedef struct {
+	gboolean is_valid;
+	guint change_count;
+	union {
+		gint64 v_int64;
+		double v_double;
+	} value;
+} ArvGcMemo;
 
 #endif
@@ -35,6 +35,7 @@
 #include <arvgcboolean.h>
 #include <arvgcstring.h>
 #include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvdomtext.h>
 #include <arvmiscprivate.h>
 #include <arvdebugprivate.h>
@@ -55,6 +56,16 @@ typedef struct {
 
 	gboolean value_data_up_to_date;
 	char *value_data;
+
+	/* Constant values, parsed once from value_data. For keyword properties (Endianess, Sign, AccessMode...),
+	 * v_int64 holds the corresponding enumeration value, or -1 if unknown. */
+	gint64 v_int64;
+	double v_double;
+
+	/* Node pointed to by a pointer property, valid as long as the document registration count is equal to
+	 * linked_node_registration_count */
+	ArvGcNode *linked_node;
+	guint linked_node_registration_count;
 } ArvGcPropertyNodePrivate;
 
 G_DEFINE_TYPE_WITH_CODE (ArvGcPropertyNode, arv_gc_property_node, ARV_TYPE_GC_NODE, G_ADD_PRIVATE (ArvGcPropertyNode))
@@ -227,23 +238,98 @@ arv_gc_property_node_get_attribute (ArvDomElement *self, const char *name)
 
 /* ArvGcPropertyNode implementation */
 
+static GMutex value_data_mutex;
+
+static const char *_get_value_data (ArvGcPropertyNode *property_node);
+
+static gint64
+_parse_keyword (const char *data, const char **keywords, const gint64 *values, unsigned int n_keywords)
+{
+	unsigned int i;
+
+	for (i = 0; i < n_keywords; i++)
+		if (g_strcmp0 (data, keywords[i]) == 0)
+			return values[i];
+
+	return -1;
+}
+
+static void
+_update_value_data (ArvGcPropertyNodePrivate *priv, char *data)
+{
+	static const char *access_mode_keywords[] = {"RO", "WO", "RW"};
+	static const gint64 access_mode_values[] = {ARV_GC_ACCESS_MODE_RO, ARV_GC_ACCESS_MODE_WO, ARV_GC_ACCESS_MODE_RW};
+	static const char *cachable_keywords[] = {"WriteAround", "WriteThrough"};
+	static const gint64 cachable_values[] = {ARV_GC_CACHABLE_WRITE_AROUND, ARV_GC_CACHABLE_WRITE_THROUGH};
+
+	g_free (priv->value_data);
+	priv->value_data = data;
+
+	switch (priv->type) {
+		case ARV_GC_PROPERTY_NODE_TYPE_ENDIANNESS:
+			priv->v_int64 = g_strcmp0 (data, "BigEndian") == 0 ? G_BIG_ENDIAN : G_LITTLE_ENDIAN;
+			break;
+		case ARV_GC_PROPERTY_NODE_TYPE_SIGN:
+			priv->v_int64 = g_strcmp0 (data, "Unsigned") == 0 ?
+				ARV_GC_SIGNEDNESS_UNSIGNED : ARV_GC_SIGNEDNESS_SIGNED;
+			break;
+		case ARV_GC_PROPERTY_NODE_TYPE_ACCESS_MODE:
+		case ARV_GC_PROPERTY_NODE_TYPE_IMPOSED_ACCESS_MODE:
+			priv->v_int64 = _parse_keyword (data, access_mode_keywords, access_mode_values,
+							G_N_ELEMENTS (access_mode_keywords));
+			break;
+		case ARV_GC_PROPERTY_NODE_TYPE_CACHABLE:
+			priv->v_int64 = _parse_keyword (data, cachable_keywords, cachable_values,
+							G_N_ELEMENTS (cachable_keywords));
+			break;
+		case ARV_GC_PROPERTY_NODE_TYPE_LSB:
+		case ARV_GC_PROPERTY_NODE_TYPE_MSB:
+		case ARV_GC_PROPERTY_NODE_TYPE_BIT:
+			priv->v_int64 = data != NULL ? g_ascii_strtoll (data, NULL, 10) : 0;
+			break;
+		default:
+			priv->v_int64 = data != NULL ? g_ascii_strtoll (data, NULL, 0) : 0;
+			break;
+	}
+
+	priv->v_double = data != NULL ? g_ascii_strtod (data, NULL) : 0.0;
+
+	g_atomic_int_set (&priv->linked_node_registration_count, 0);
+}
+
+static gint64
+_get_int64_data (ArvGcPropertyNode *property_node)
+{
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
+
+	_get_value_data (property_node);
+
+	return priv->v_int64;
+}
+
 static const char *
 _get_value_data (ArvGcPropertyNode *property_node)
 {
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
 	ArvDomNode *dom_node = ARV_DOM_NODE (property_node);
 
-	if (!priv->value_data_up_to_date) {
-		ArvDomNode *iter;
-		GString *string = g_string_new (NULL);
+	if (!g_atomic_int_get (&priv->value_data_up_to_date)) {
+		/* Concurrent readers may race for the first evaluation */
+		g_mutex_lock (&value_data_mutex);
 
-		for (iter = arv_dom_node_get_first_child (dom_node);
-		     iter != NULL;
-		     iter = arv_dom_node_get_next_sibling (iter))
-			g_string_append (string, arv_dom_character_data_get_data (ARV_DOM_CHARACTER_DATA (iter)));
-		g_free (priv->value_data);
-		priv->value_data = arv_g_string_free_and_steal(string);
-		priv->value_data_up_to_date = TRUE;
+		if (!priv->value_data_up_to_date) {
+			ArvDomNode *iter;
+			GString *string = g_string_new (NULL);
+
+			for (iter = arv_dom_node_get_first_child (dom_node);
+			     iter != NULL;
+			     iter = arv_dom_node_get_next_sibling (iter))
+				g_string_append (string, arv_dom_character_data_get_data (ARV_DOM_CHARACTER_DATA (iter)));
+			_update_value_data (priv, arv_g_string_free_and_steal(string));
+			g_atomic_int_set (&priv->value_data_up_to_date, TRUE);
+		}
+
+		g_mutex_unlock (&value_data_mutex);
 	}
 
 	return priv->value_data;
@@ -254,6 +340,7 @@ _set_value_data (ArvGcPropertyNode *property_node, const char *data)
 {
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
 	ArvDomNode *dom_node = ARV_DOM_NODE (property_node);
+	ArvGc *genicam;
 
 	if (arv_dom_node_get_first_child (dom_node) != NULL) {
 		ArvDomNode *iter;
@@ -265,26 +352,55 @@ _set_value_data (ArvGcPropertyNode *property_node, const char *data)
 			arv_dom_character_data_set_data (ARV_DOM_CHARACTER_DATA (iter), "");
 	}
 
-	g_free (priv->value_data);
-	priv->value_data = g_strdup (data);
+	_update_value_data (priv, g_strdup (data));
 	priv->value_data_up_to_date = TRUE;
+
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (property_node));
+	if (genicam != NULL)
+		arv_gc_increment_change_count (genicam);
 }
 
-static ArvDomNode *
-_get_pvalue_node (ArvGcPropertyNode *property_node)
+/* The node name lookup is only done on the first evaluation, or after the registration of new feature nodes */
+
+static ArvGcNode *
+_get_linked_node (ArvGcPropertyNode *property_node)
 {
-	ArvDomNode *pvalue_node;
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
+	ArvGcNode *linked_node;
 	const char *node_name;
 	ArvGc *genicam;
+	guint registration_count;
 
-	if (arv_gc_property_node_get_node_type (property_node) < ARV_GC_PROPERTY_NODE_TYPE_P_UNKNONW)
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (property_node));
+	if (genicam == NULL)
 		return NULL;
 
 	node_name = _get_value_data (property_node);
-	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (property_node));
-	pvalue_node = ARV_DOM_NODE (arv_gc_get_node (genicam, node_name));
 
-	return pvalue_node;
+	registration_count = arv_gc_get_registration_count (genicam);
+	if (g_atomic_int_get (&priv->linked_node_registration_count) == registration_count)
+		return g_atomic_pointer_get (&priv->linked_node);
+
+	linked_node = arv_gc_get_node (genicam, node_name);
+
+	/* The lookup may have instantiated new nodes */
+	registration_count = arv_gc_get_registration_count (genicam);
+
+	g_mutex_lock (&value_data_mutex);
+	g_atomic_pointer_set (&priv->linked_node, linked_node);
+	g_atomic_int_set (&priv->linked_node_registration_count, registration_count);
+	g_mutex_unlock (&value_data_mutex);
+
+	return linked_node;
+}
+
+static ArvDomNode *
+_get_pvalue_node (ArvGcPropertyNode *property_node)
+{
+	if (arv_gc_property_node_get_node_type (property_node) < ARV_GC_PROPERTY_NODE_TYPE_P_UNKNONW)
+		return NULL;
+
+	return ARV_DOM_NODE (_get_linked_node (property_node));
 }
 
 /**
@@ -375,7 +491,7 @@ arv_gc_property_node_get_int64 (ArvGcPropertyNode *node, GError **error)
 
 	pvalue_node = _get_pvalue_node (node);
 	if (pvalue_node == NULL)
-		return g_ascii_strtoll (_get_value_data (node), NULL, 0);
+		return _get_int64_data (node);
 
 	if (ARV_IS_GC_INTEGER (pvalue_node)) {
 		return arv_gc_integer_get_value (ARV_GC_INTEGER (pvalue_node), error);
@@ -430,9 +546,12 @@ arv_gc_property_node_get_double (ArvGcPropertyNode *node, GError **error)
 	g_return_val_if_fail (error == NULL || *error == NULL, 0.0);
 
 	pvalue_node = _get_pvalue_node (node);
-	if (pvalue_node == NULL)
-		return g_ascii_strtod (_get_value_data (node), NULL);
+	if (pvalue_node == NULL) {
+		ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (node);
 
+		_get_value_data (node);
+		return priv->v_double;
+	}
 
 	if (ARV_IS_GC_FLOAT (pvalue_node)) {
 		return arv_gc_float_get_value (ARV_GC_FLOAT (pvalue_node), error);
@@ -495,15 +614,12 @@ arv_gc_property_node_get_node_type (ArvGcPropertyNode *node)
 ArvGcNode *
 arv_gc_property_node_get_linked_node (ArvGcPropertyNode *node)
 {
-	ArvGc *genicam;
-
 	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (node), NULL);
 
 	if (arv_gc_property_node_get_node_type (node) <= ARV_GC_PROPERTY_NODE_TYPE_P_UNKNONW)
 		return NULL;
 
-	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (node));
-	return arv_gc_get_node (genicam, _get_value_data (node));
+	return _get_linked_node (node);
 }
 
 static ArvGcNode *
@@ -725,7 +841,7 @@ arv_gc_property_node_get_display_precision (ArvGcPropertyNode *self, gint64 defa
 	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (self), default_value);
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_DISPLAY_PRECISION, default_value);
 
-	return g_ascii_strtoll (_get_value_data (self), NULL, 0);
+	return _get_int64_data (self);
 }
 
 ArvGcNode *
@@ -840,7 +956,7 @@ ArvGcAccessMode
 arv_gc_property_node_get_access_mode (ArvGcPropertyNode *self, ArvGcAccessMode default_value)
 {
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (self);
-	const char *value;
+	gint64 value;
 
 	if (self == NULL)
 		return default_value;
@@ -849,16 +965,9 @@ arv_gc_property_node_get_access_mode (ArvGcPropertyNode *self, ArvGcAccessMode d
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_ACCESS_MODE ||
 			      priv->type == ARV_GC_PROPERTY_NODE_TYPE_IMPOSED_ACCESS_MODE, default_value);
 
-	value = _get_value_data (self);
+	value = _get_int64_data (self);
 
-	if (g_strcmp0 (value, "RO") == 0)
-		return ARV_GC_ACCESS_MODE_RO;
-	else if (g_strcmp0 (value, "WO") == 0)
-		return ARV_GC_ACCESS_MODE_WO;
-	else if (g_strcmp0 (value, "RW") == 0)
-		return ARV_GC_ACCESS_MODE_RW;
-
-	return default_value;
+	return value >= 0 ? value : default_value;
 }
 
 ArvGcNode *
@@ -871,7 +980,7 @@ ArvGcCachable
 arv_gc_property_node_get_cachable (ArvGcPropertyNode *self, ArvGcCachable default_value)
 {
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (self);
-	const char *value;
+	gint64 value;
 
 	if (self == NULL)
 		return default_value;
@@ -879,14 +988,9 @@ arv_gc_property_node_get_cachable (ArvGcPropertyNode *self, ArvGcCachable defaul
 	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (self), default_value);
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_CACHABLE, default_value);
 
-	value = _get_value_data (self);
-
-	if (g_strcmp0 (value, "WriteAround") == 0)
-		return ARV_GC_CACHABLE_WRITE_AROUND;
-	else if (g_strcmp0 (value, "WriteThrough") == 0)
-		return ARV_GC_CACHABLE_WRITE_THROUGH;
+	value = _get_int64_data (self);
 
-	return ARV_GC_CACHABLE_NO_CACHE;
+	return value >= 0 ? value : ARV_GC_CACHABLE_NO_CACHE;
 }
 
 ArvGcNode *
@@ -912,10 +1016,7 @@ arv_gc_property_node_get_endianness (ArvGcPropertyNode *self, guint default_valu
 	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (self), default_value);
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_ENDIANNESS, default_value);
 
-	if (g_strcmp0 (_get_value_data (self), "BigEndian") == 0)
-		return G_BIG_ENDIAN;
-
-	return G_LITTLE_ENDIAN;
+	return _get_int64_data (self);
 }
 
 ArvGcNode *
@@ -935,10 +1036,7 @@ arv_gc_property_node_get_sign (ArvGcPropertyNode *self, ArvGcSignedness default_
 	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (self), default_value);
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_SIGN, default_value);
 
-	if (g_strcmp0 (_get_value_data (self), "Unsigned") == 0)
-		return ARV_GC_SIGNEDNESS_UNSIGNED;
-
-	return ARV_GC_SIGNEDNESS_SIGNED;
+	return _get_int64_data (self);
 }
 
 ArvGcNode *
@@ -959,7 +1057,7 @@ arv_gc_property_node_get_lsb (ArvGcPropertyNode *self, guint default_value)
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_LSB ||
 			      priv->type == ARV_GC_PROPERTY_NODE_TYPE_BIT, default_value);
 
-	return g_ascii_strtoll (_get_value_data (self), NULL, 10);
+	return _get_int64_data (self);
 }
 
 ArvGcNode *
@@ -980,7 +1078,7 @@ arv_gc_property_node_get_msb (ArvGcPropertyNode *self, guint default_value)
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_MSB ||
 			      priv->type == ARV_GC_PROPERTY_NODE_TYPE_BIT, default_value);
 
-	return g_ascii_strtoll (_get_value_data (self), NULL, 10);
+	return _get_int64_data (self);
 }
 
 ArvGcNode *
@@ -26,6 +26,8 @@
  */
 
 #include <arvgcregister.h>
+#include <arvgcnode.h>
+#include <arvgcprivate.h>
 #include <arvmisc.h>
 
 static void
@@ -43,7 +45,9 @@ arv_gc_register_get (ArvGcRegister *gc_register, void *buffer, guint64 length, G
 	g_return_if_fail (length > 0);
 	g_return_if_fail (error == NULL || *error == NULL);
 
+	arv_gc_node_lock_read (ARV_GC_NODE (gc_register));
 	ARV_GC_REGISTER_GET_IFACE (gc_register)->get (gc_register, buffer, length, error);
+	arv_gc_node_unlock (ARV_GC_NODE (gc_register));
 }
 
 void
@@ -54,25 +58,40 @@ arv_gc_register_set (ArvGcRegister *gc_register, const void *buffer, guint64 len
 	g_return_if_fail (length > 0);
 	g_return_if_fail (error == NULL || *error == NULL);
 
+	if (!arv_gc_node_lock_write (ARV_GC_NODE (gc_register), error))
+		return;
 	ARV_GC_REGISTER_GET_IFACE (gc_register)->set (gc_register, buffer, length, error);
+	arv_gc_node_unlock (ARV_GC_NODE (gc_register));
 }
 
 guint64
 arv_gc_register_get_address (ArvGcRegister *gc_register, GError **error)
 {
+	guint64 address;
+
 	g_return_val_if_fail (ARV_IS_GC_REGISTER (gc_register), 0);
 	g_return_val_if_fail (error == NULL || *error == NULL, 0);
 
-	return ARV_GC_REGISTER_GET_IFACE (gc_register)->get_address (gc_register, error);
+	arv_gc_node_lock_read (ARV_GC_NODE (gc_register));
+	address = ARV_GC_REGISTER_GET_IFACE (gc_register)->get_address (gc_register, error);
+	arv_gc_node_unlock (ARV_GC_NODE (gc_register));
+
+	return address;
 }
 
 guint64
 arv_gc_register_get_length (ArvGcRegister *gc_register, GError **error)
 {
+	guint64 length;
+
 	g_return_val_if_fail (ARV_IS_GC_REGISTER (gc_register), 0);
 	g_return_val_if_fail (error == NULL || *error == NULL, 0);
 
-	return ARV_GC_REGISTER_GET_IFACE (gc_register)->get_length (gc_register, error);
+	arv_gc_node_lock_read (ARV_GC_NODE (gc_register));
+	length = ARV_GC_REGISTER_GET_IFACE (gc_register)->get_length (gc_register, error);
+	arv_gc_node_unlock (ARV_GC_NODE (gc_register));
+
+	return length;
 }
 
 /**
@@ -39,6 +39,7 @@
 #include <arvgcprivate.h>
 #include <arvmiscprivate.h>
 #include <arvdebugprivate.h>
+#include <arvtraceprivate.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -85,6 +86,9 @@ typedef struct {
 
 	GSList *invalidators;		/* #ArvGcPropertyNode */
 
+	/* Protects the register caches, the cache flag and the invalidator
+	 * states, since a same node can be read from concurrent threads. */
+	GMutex mutex;
 	gboolean cached;
 	GHashTable *caches;
 	guint n_cache_hits;
@@ -279,10 +283,15 @@ _get_cached (ArvGcRegisterNode *self, ArvRegisterCachePolicy *cache_policy)
 			cached = FALSE;
 	}
 
-	if (cached)
+	if (cached) {
 		priv->n_cache_hits++;
-	else
+		ARV_TRACE1 (register_cache_hit, arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (self)));
+	} else {
 		priv->n_cache_misses++;
+		ARV_TRACE1 (register_cache_miss, arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (self)));
+	}
+
+        arv_gc_register_cache_count (genicam, cached);
 
 	return cached;
 }
@@ -382,6 +391,10 @@ _read_from_port (ArvGcRegisterNode *self, gint64 address, gint64 length, void *b
 		priv->cached = TRUE;
 	else
 		priv->cached = FALSE;
+
+	/* The value read from the device may differ from the previous one */
+	if (!priv->cached || cache_policy != ARV_REGISTER_CACHE_POLICY_ENABLE)
+		arv_gc_increment_change_count (arv_gc_node_get_genicam (ARV_GC_NODE (self)));
 }
 
 static void
@@ -427,6 +440,7 @@ arv_gc_register_node_init (ArvGcRegisterNode *self)
 {
 	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (ARV_GC_REGISTER_NODE (self));
 
+	g_mutex_init (&priv->mutex);
 	priv->cached = FALSE;
 	priv->caches = g_hash_table_new_full (arv_gc_cache_key_hash, arv_gc_cache_key_equal, g_free, g_free);
 	priv->n_cache_hits = 0;
@@ -445,6 +459,7 @@ arv_gc_register_node_finalize (GObject *self)
 	g_slist_free (priv->indexes);
 	g_slist_free (priv->invalidators);
 	g_clear_pointer (&priv->caches, g_hash_table_unref);
+	g_mutex_clear (&priv->mutex);
 
 	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (self));
 	if (ARV_IS_GC (genicam)) {
@@ -494,7 +509,7 @@ arv_gc_register_node_class_init (ArvGcRegisterNodeClass *this_class)
 /* ArvGcRegister interface implementation */
 
 static void
-arv_gc_register_node_get (ArvGcRegister *gc_register, void *buffer, guint64 length, GError **error)
+_get (ArvGcRegister *gc_register, void *buffer, guint64 length, GError **error)
 {
 	ArvGcRegisterNode *gc_register_node = ARV_GC_REGISTER_NODE (gc_register);
 	GError *local_error = NULL;
@@ -531,7 +546,17 @@ arv_gc_register_node_get (ArvGcRegister *gc_register, void *buffer, guint64 leng
 }
 
 static void
-arv_gc_register_node_set (ArvGcRegister *gc_register, const void *buffer, guint64 length, GError **error)
+arv_gc_register_node_get (ArvGcRegister *gc_register, void *buffer, guint64 length, GError **error)
+{
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (ARV_GC_REGISTER_NODE (gc_register));
+
+	g_mutex_lock (&priv->mutex);
+	_get (gc_register, buffer, length, error);
+	g_mutex_unlock (&priv->mutex);
+}
+
+static void
+_set (ArvGcRegister *gc_register, const void *buffer, guint64 length, GError **error)
 {
 	ArvGcRegisterNode *gc_register_node = ARV_GC_REGISTER_NODE (gc_register);
 	GError *local_error = NULL;
@@ -568,6 +593,16 @@ arv_gc_register_node_set (ArvGcRegister *gc_register, const void *buffer, guint6
 	arv_debug_genicam ("[GcRegisterNode::set] 0x%" G_GINT64_MODIFIER "x,%" G_GUINT64_FORMAT, address, length);
 }
 
+static void
+arv_gc_register_node_set (ArvGcRegister *gc_register, const void *buffer, guint64 length, GError **error)
+{
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (ARV_GC_REGISTER_NODE (gc_register));
+
+	g_mutex_lock (&priv->mutex);
+	_set (gc_register, buffer, length, error);
+	g_mutex_unlock (&priv->mutex);
+}
+
 static guint64
 arv_gc_register_node_get_address (ArvGcRegister *gc_register, GError **error)
 {
@@ -670,6 +705,9 @@ arv_gc_register_node_get_masked_integer_value (ArvGcRegisterNode *self,
 					       ArvGcCachable cachable,
 					       gboolean is_masked, GError **error)
 {
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (self);
+	gint64 value;
+
 	g_return_val_if_fail (ARV_IS_GC_REGISTER_NODE (self), 0);
 	g_return_val_if_fail (error == NULL || *error == NULL, 0);
 
@@ -679,7 +717,11 @@ arv_gc_register_node_get_masked_integer_value (ArvGcRegisterNode *self,
 	if (endianness == 0)
 		endianness = _get_endianness (self);
 
-	return _get_integer_value (self, lsb, msb, signedness, endianness, cachable, is_masked, error);
+	g_mutex_lock (&priv->mutex);
+	value = _get_integer_value (self, lsb, msb, signedness, endianness, cachable, is_masked, error);
+	g_mutex_unlock (&priv->mutex);
+
+	return value;
 }
 
 static void
@@ -761,6 +803,8 @@ arv_gc_register_node_set_masked_integer_value (ArvGcRegisterNode *self,
 					       gboolean is_masked,
 					       gint64 value, GError **error)
 {
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (self);
+
 	g_return_if_fail (ARV_IS_GC_REGISTER_NODE (self));
 	g_return_if_fail (error == NULL || *error == NULL);
 
@@ -770,7 +814,9 @@ arv_gc_register_node_set_masked_integer_value (ArvGcRegisterNode *self,
 	if (endianness == 0)
 		endianness = _get_endianness (self);
 
+	g_mutex_lock (&priv->mutex);
 	_set_integer_value (self, lsb, msb, signedness, endianness, cachable, is_masked, value, error);
+	g_mutex_unlock (&priv->mutex);
 }
 
 guint
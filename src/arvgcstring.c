@@ -28,6 +28,7 @@
 #include <arvgcstring.h>
 #include <arvmisc.h>
 #include <arvgcfeaturenodeprivate.h>
+#include <arvgcprivate.h>
 
 static void
 arv_gc_string_default_init (ArvGcStringInterface *gc_string_iface)
@@ -49,13 +50,19 @@ G_DEFINE_INTERFACE (ArvGcString, arv_gc_string, G_TYPE_OBJECT)
 const char *
 arv_gc_string_get_value (ArvGcString *gc_string, GError **error)
 {
+	const char *value = NULL;
+
 	g_return_val_if_fail (ARV_IS_GC_STRING (gc_string), NULL);
 	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
 
-        if (!arv_gc_feature_node_check_read_access (ARV_GC_FEATURE_NODE (gc_string), error))
-                return NULL;
+	arv_gc_node_lock_read (ARV_GC_NODE (gc_string));
+
+        if (arv_gc_feature_node_check_read_access (ARV_GC_FEATURE_NODE (gc_string), error))
+                value = ARV_GC_STRING_GET_IFACE (gc_string)->get_value (gc_string, error);
+
+	arv_gc_node_unlock (ARV_GC_NODE (gc_string));
 
-	return ARV_GC_STRING_GET_IFACE (gc_string)->get_value (gc_string, error);
+	return value;
 }
 
 /**
@@ -73,10 +80,13 @@ arv_gc_string_set_value (ArvGcString *gc_string, const char *value, GError **err
 	g_return_if_fail (ARV_IS_GC_STRING (gc_string));
 	g_return_if_fail (error == NULL || *error == NULL);
 
-        if (!arv_gc_feature_node_check_write_access (ARV_GC_FEATURE_NODE (gc_string), error))
-                return;
+	if (!arv_gc_node_lock_write (ARV_GC_NODE (gc_string), error))
+		return;
 
-	ARV_GC_STRING_GET_IFACE (gc_string)->set_value (gc_string, value, error);
+        if (arv_gc_feature_node_check_write_access (ARV_GC_FEATURE_NODE (gc_string), error))
+                ARV_GC_STRING_GET_IFACE (gc_string)->set_value (gc_string, value, error);
+
+	arv_gc_node_unlock (ARV_GC_NODE (gc_string));
 }
 
 /**
@@ -97,8 +107,14 @@ arv_gc_string_get_max_length (ArvGcString *gc_string, GError **error)
 
 	string_interface = ARV_GC_STRING_GET_IFACE (gc_string);
 
-	if (string_interface->get_max_length != NULL)
-		return string_interface->get_max_length (gc_string, error);
-	else
+	if (string_interface->get_max_length != NULL) {
+		gint64 max_length;
+
+		arv_gc_node_lock_read (ARV_GC_NODE (gc_string));
+		max_length = string_interface->get_max_length (gc_string, error);
+		arv_gc_node_unlock (ARV_GC_NODE (gc_string));
+
+		return max_length;
+	} else
 		return 0;
 }
@@ -27,6 +27,7 @@
 #include <string.h>
 
 typedef struct {
+	GMutex mutex;
 	char *string;
 } ArvGcStringRegNodePrivate;
 
@@ -48,26 +49,38 @@ arv_gc_string_reg_node_get_string_value (ArvGcString *self, GError **error)
 {
 	ArvGcStringRegNodePrivate *priv = arv_gc_string_reg_node_get_instance_private (ARV_GC_STRING_REG_NODE (self));
 	GError *local_error = NULL;
+	const char *value;
+	char *string = NULL;
 	gint64 length;
 
 	length = arv_gc_string_get_max_length (self, &local_error);
 	if (local_error == NULL) {
-		priv->string = g_realloc (priv->string, length + 1);
-
-		if (priv->string != NULL) {
-			arv_gc_register_get (ARV_GC_REGISTER (self), priv->string, length, &local_error);
-			if (local_error == NULL)
-				priv->string[length] = '\0';
-		}
-	} else {
-		g_clear_pointer (&priv->string, g_free);
+		string = g_malloc (length + 1);
+		arv_gc_register_get (ARV_GC_REGISTER (self), string, length, &local_error);
+		string[length] = '\0';
 	}
 
-	if (local_error != NULL)
+	if (local_error != NULL) {
 		g_propagate_prefixed_error (error, local_error, "[%s] ",
                                             arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (self)));
+		g_free (string);
+		return NULL;
+	}
 
-	return priv->string;
+	/* Other threads may still use the returned string, only replace it
+	 * when the register content has changed. */
+
+	g_mutex_lock (&priv->mutex);
+	if (g_strcmp0 (priv->string, string) == 0) {
+		g_free (string);
+	} else {
+		g_free (priv->string);
+		priv->string = string;
+	}
+	value = priv->string;
+	g_mutex_unlock (&priv->mutex);
+
+	return value;
 }
 
 static void
@@ -132,6 +145,9 @@ arv_gc_string_reg_node_string_interface_init (ArvGcStringInterface *interface)
 static void
 arv_gc_string_reg_node_init (ArvGcStringRegNode *self)
 {
+	ArvGcStringRegNodePrivate *priv = arv_gc_string_reg_node_get_instance_private (self);
+
+	g_mutex_init (&priv->mutex);
 }
 
 static void
@@ -140,6 +156,7 @@ arv_gc_string_reg_node_finalize (GObject *self)
 	ArvGcStringRegNodePrivate *priv = arv_gc_string_reg_node_get_instance_private (ARV_GC_STRING_REG_NODE (self));
 
 	g_clear_pointer (&priv->string, g_free);
+	g_mutex_clear (&priv->mutex);
 
 	G_OBJECT_CLASS (arv_gc_string_reg_node_parent_class)->finalize (self);
 }
@@ -31,6 +31,7 @@
 #include <arvgcfloat.h>
 #include <arvgcport.h>
 #include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvdebug.h>
 #include <string.h>
 
@@ -44,7 +45,13 @@ typedef struct {
 	ArvGcPropertyNode *unit;
 	ArvGcPropertyNode *representation;
 
+	/* Evaluation sets the formula variables, which must not be interleaved
+	 * between concurrent readers. Also protects the memoized results. */
+	GMutex mutex;
 	ArvEvaluator *formula;
+
+	ArvGcMemo int64_memo;
+	ArvGcMemo double_memo;
 } ArvGcSwissKnifePrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvGcSwissKnife, arv_gc_swiss_knife, ARV_TYPE_GC_FEATURE_NODE, G_ADD_PRIVATE (ArvGcSwissKnife))
@@ -98,6 +105,7 @@ arv_gc_swiss_knife_init (ArvGcSwissKnife *self)
 {
 	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
 
+	g_mutex_init (&priv->mutex);
 	priv->formula = arv_evaluator_new (NULL);
 }
 
@@ -117,6 +125,7 @@ arv_gc_swiss_knife_finalize (GObject *object)
 	g_slist_free (priv->constants);
 
 	g_clear_object (&priv->formula);
+	g_mutex_clear (&priv->mutex);
 
 	G_OBJECT_CLASS (arv_gc_swiss_knife_parent_class)->finalize (object);
 }
@@ -226,14 +235,12 @@ _update_variables (ArvGcSwissKnife *self, GError **error)
 	}
 }
 
-gint64
-arv_gc_swiss_knife_get_integer_value (ArvGcSwissKnife *self, GError **error)
+static gint64
+_get_integer_value (ArvGcSwissKnife *self, GError **error)
 {
 	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
 	GError *local_error = NULL;
 
-	g_return_val_if_fail (ARV_IS_GC_SWISS_KNIFE (self), 0);
-
 	_update_variables (self, &local_error);
 
 	if (local_error != NULL) {
@@ -245,13 +252,46 @@ arv_gc_swiss_knife_get_integer_value (ArvGcSwissKnife *self, GError **error)
 	return arv_evaluator_evaluate_as_int64 (priv->formula, NULL);
 }
 
-double
-arv_gc_swiss_knife_get_float_value (ArvGcSwissKnife *self, GError **error)
+gint64
+arv_gc_swiss_knife_get_integer_value (ArvGcSwissKnife *self, GError **error)
 {
 	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
+	ArvGc *genicam;
 	GError *local_error = NULL;
+	guint change_count;
+	gint64 value;
 
-	g_return_val_if_fail (ARV_IS_GC_SWISS_KNIFE (self), 0.0);
+	g_return_val_if_fail (ARV_IS_GC_SWISS_KNIFE (self), 0);
+
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (self));
+	change_count = arv_gc_get_change_count (genicam);
+
+	g_mutex_lock (&priv->mutex);
+
+	if (priv->int64_memo.is_valid && priv->int64_memo.change_count == change_count) {
+		value = priv->int64_memo.value.v_int64;
+	} else {
+		value = _get_integer_value (self, &local_error);
+
+		/* Only keep results of evaluations which did not change the document state */
+		priv->int64_memo.is_valid = local_error == NULL && arv_gc_get_change_count (genicam) == change_count;
+		priv->int64_memo.change_count = change_count;
+		priv->int64_memo.value.v_int64 = value;
+	}
+
+	g_mutex_unlock (&priv->mutex);
+
+	if (local_error != NULL)
+		g_propagate_error (error, local_error);
+
+	return value;
+}
+
+static double
+_get_float_value (ArvGcSwissKnife *self, GError **error)
+{
+	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
+	GError *local_error = NULL;
 
 	_update_variables (self, &local_error);
 
@@ -264,6 +304,40 @@ arv_gc_swiss_knife_get_float_value (ArvGcSwissKnife *self, GError **error)
 	return arv_evaluator_evaluate_as_double (priv->formula, NULL);
 }
 
+double
+arv_gc_swiss_knife_get_float_value (ArvGcSwissKnife *self, GError **error)
+{
+	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
+	ArvGc *genicam;
+	GError *local_error = NULL;
+	guint change_count;
+	double value;
+
+	g_return_val_if_fail (ARV_IS_GC_SWISS_KNIFE (self), 0.0);
+
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (self));
+	change_count = arv_gc_get_change_count (genicam);
+
+	g_mutex_lock (&priv->mutex);
+
+	if (priv->double_memo.is_valid && priv->double_memo.change_count == change_count) {
+		value = priv->double_memo.value.v_double;
+	} else {
+		value = _get_float_value (self, &local_error);
+
+		priv->double_memo.is_valid = local_error == NULL && arv_gc_get_change_count (genicam) == change_count;
+		priv->double_memo.change_count = change_count;
+		priv->double_memo.value.v_double = value;
+	}
+
+	g_mutex_unlock (&priv->mutex);
+
+	if (local_error != NULL)
+		g_propagate_error (error, local_error);
+
+	return value;
+}
+
 ArvGcRepresentation
 arv_gc_swiss_knife_get_representation (ArvGcSwissKnife *self)
 {
@@ -32,6 +32,7 @@
 #include <arvgentlstreamprivate.h>
 #include <arvmiscprivate.h>
 #include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvdebugprivate.h>
 #include <arvzip.h>
 #include <arvstr.h>
@@ -47,9 +48,6 @@ enum
 typedef struct {
 	ArvGc *genicam;
 
-	char *genicam_xml;
-	size_t genicam_xml_size;
-
 	char *interface_id;
 	char *device_id;
 
@@ -236,8 +234,12 @@ arv_gentl_device_get_genicam_xml (ArvDevice *device, size_t *size)
 {
 	ArvGenTLDevicePrivate *priv = arv_gentl_device_get_instance_private (ARV_GENTL_DEVICE (device));
 
-	*size = priv->genicam_xml_size;
-	return priv->genicam_xml;
+	if (priv->genicam == NULL) {
+		*size = 0;
+		return NULL;
+	}
+
+	return arv_gc_get_xml (priv->genicam, size);
 }
 
 static ArvGc *
@@ -319,8 +321,6 @@ arv_gentl_device_init (ArvGenTLDevice *gentl_device)
 	ArvGenTLDevicePrivate *priv = arv_gentl_device_get_instance_private (gentl_device);
 
 	priv->genicam = NULL;
-	priv->genicam_xml = NULL;
-	priv->genicam_xml_size = 0;
 	priv->gentl_system = NULL;
 	priv->device_handle = NULL;
 	priv->interface_id = NULL;
@@ -523,6 +523,8 @@ arv_gentl_device_constructed (GObject *self)
 	ArvGenTLDevicePrivate *priv = arv_gentl_device_get_instance_private (gentl_device);
 	ArvGenTLModule *gentl = arv_gentl_system_get_gentl(priv->gentl_system);
         char *url = NULL;
+	char *genicam_xml;
+	size_t genicam_xml_size;
 
 	G_OBJECT_CLASS (arv_gentl_device_parent_class)->constructed (self);
 
@@ -544,8 +546,8 @@ arv_gentl_device_constructed (GObject *self)
 		return;
 	}
 
-	priv->genicam_xml = _load_genicam (gentl_device, &priv->genicam_xml_size, &url, NULL);
-	if (priv->genicam_xml == NULL) {
+	genicam_xml = _load_genicam (gentl_device, &genicam_xml_size, &url, NULL);
+	if (genicam_xml == NULL) {
 		arv_device_take_init_error (ARV_DEVICE (gentl_device),
                                             g_error_new (ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_GENICAM_NOT_FOUND,
                                                          "Failed to load GenICam data for device '%s' of interface '%s'",
@@ -553,7 +555,7 @@ arv_gentl_device_constructed (GObject *self)
 		return;
 	}
 
-	priv->genicam = arv_gc_new (ARV_DEVICE(self), priv->genicam_xml, priv->genicam_xml_size);
+	priv->genicam = arv_gc_new_take (ARV_DEVICE(self), genicam_xml, genicam_xml_size);
         arv_dom_document_set_url (ARV_DOM_DOCUMENT(priv->genicam), url);
         g_free (url);
 
@@ -577,7 +579,6 @@ arv_gentl_device_finalize (GObject *object)
 	arv_gentl_system_close_device_handle(priv->gentl_system, priv->interface_id, priv->device_handle);
 
 	g_clear_object (&priv->genicam);
-	g_clear_pointer (&priv->genicam_xml, g_free);
 
 	g_clear_pointer(&priv->interface_id, g_free);
 	g_clear_pointer(&priv->device_id, g_free);
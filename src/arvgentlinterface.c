@@ -292,7 +292,11 @@ arv_gentl_interface_open_device (ArvInterface *interface, const char *device_id,
 {
 	ArvGenTLInterfacePrivate *priv = arv_gentl_interface_get_instance_private(ARV_GENTL_INTERFACE (interface));
 	ArvDevice *device = NULL;
-	ArvGenTLInterfaceDeviceInfos *device_info = g_hash_table_lookup(priv->devices, device_id);
+	ArvGenTLInterfaceDeviceInfos *device_info;
+
+	arv_interface_lock_device_list (interface);
+
+	device_info = g_hash_table_lookup(priv->devices, device_id);
 
 	/* Refresh devices if the requested device is in the cache. */
 	if (device_info == NULL) {
@@ -300,8 +304,14 @@ arv_gentl_interface_open_device (ArvInterface *interface, const char *device_id,
 		device_info = g_hash_table_lookup(priv->devices, device_id);
 	}
 
+	if (device_info != NULL)
+		arv_gentl_interface_device_infos_ref (device_info);
+
+	arv_interface_unlock_device_list (interface);
+
 	if (device_info) {
 		device = arv_gentl_device_new(device_info->system, device_info->interface, device_id, error);
+		arv_gentl_interface_device_infos_unref (device_info);
 	}
 
 	return device;
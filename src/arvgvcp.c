@@ -390,6 +390,7 @@ arv_gvcp_packet_new_discovery_ack (guint16 packet_id, size_t *packet_size)
 
 /**
  * arv_gvcp_packet_new_packet_resend_cmd: (skip)
+ * @stream_channel: index of the stream channel
  * @frame_id: frame id
  * @first_block: first missing packet
  * @last_block: last missing packet
@@ -403,7 +404,7 @@ arv_gvcp_packet_new_discovery_ack (guint16 packet_id, size_t *packet_size)
  */
 
 ArvGvcpPacket *
-arv_gvcp_packet_new_packet_resend_cmd (guint64 frame_id,
+arv_gvcp_packet_new_packet_resend_cmd (guint16 stream_channel, guint64 frame_id,
 				       guint32 first_block, guint32 last_block,
 				       gboolean extended_ids,
 				       guint16 packet_id, size_t *packet_size)
@@ -426,12 +427,12 @@ arv_gvcp_packet_new_packet_resend_cmd (guint64 frame_id,
 	data = (guint32 *) &packet->data;
 
 	if (extended_ids) {
-		data[0] = 0;
+		data[0] = g_htonl ((guint32) stream_channel << 16);
 		data[1] = g_htonl (first_block);
 		data[2] = g_htonl (last_block);
 		*((guint64 *) &data[3]) = GUINT64_TO_BE (frame_id);
 	} else {
-		data[0] = g_htonl ((guint32) frame_id);
+		data[0] = g_htonl (((guint32) stream_channel << 16) | (frame_id & 0xffff));
 		/* With regular ids, only the 24 bits are valid */
 		data[1] = g_htonl (first_block & ARV_GVSP_PACKET_ID_MASK);
 		data[2] = g_htonl (last_block & ARV_GVSP_PACKET_ID_MASK);
@@ -661,6 +662,25 @@ arv_gvcp_packet_to_string (const ArvGvcpPacket *packet)
         return arv_g_string_free_and_steal(string);
 }
 
+/* Formatter of the packets stored in the debug ring buffer, which may have been truncated */
+
+static char *
+_packet_record_to_string (void *data, size_t size)
+{
+	ArvGvcpPacket *packet = data;
+	size_t max_data_size;
+
+	if (size < sizeof (ArvGvcpHeader))
+		return NULL;
+
+	max_data_size = MIN (size, ARV_DEBUG_RECORD_DATA_SIZE) - sizeof (ArvGvcpHeader);
+
+	if (g_ntohs (packet->header.size) > max_data_size)
+		packet->header.size = g_htons (max_data_size);
+
+	return arv_gvcp_packet_to_string (packet);
+}
+
 /**
  * arv_gvcp_packet_debug:
  * @packet: a #ArvGvcpPacket
@@ -677,6 +697,12 @@ arv_gvcp_packet_debug (const ArvGvcpPacket *packet, ArvDebugLevel level)
 	if (!arv_debug_check (ARV_DEBUG_CATEGORY_CP, level))
 		return;
 
+	if (arv_debug_ring_is_enabled ()) {
+		arv_debug_record_binary (ARV_DEBUG_CATEGORY_CP, level, _packet_record_to_string,
+					 packet, sizeof (ArvGvcpHeader) + g_ntohs (packet->header.size));
+		return;
+	}
+
 	string = arv_gvcp_packet_to_string (packet);
 	switch (level) {
 		case ARV_DEBUG_LEVEL_TRACE:
@@ -25,6 +25,7 @@
 
 #include <arvtypes.h>
 #include <arvdebugprivate.h>
+#include <arvgvspprivate.h>
 
 G_BEGIN_DECLS
 
@@ -136,6 +137,16 @@ G_BEGIN_DECLS
 
 #define ARV_GVBS_STREAM_CHANNEL_0_IP_ADDRESS_OFFSET		0x00000d18
 
+#define ARV_GVBS_STREAM_CHANNEL_0_SOURCE_PORT_OFFSET		0x00000d1c
+
+#define ARV_GVBS_STREAM_CHANNEL_0_CAPABILITY_OFFSET		0x00000d20
+#define ARV_GVBS_STREAM_CHANNEL_0_CONFIGURATION_OFFSET		0x00000d24
+/* Bit 25 in the big endian bit numbering used by ArvGevSCCAPMultipart and ArvGevSCCFGMultipart */
+#define ARV_GVBS_STREAM_CHANNEL_0_MULTIPART			(1 << 6)
+
+/* Address increment between two consecutive stream channel register blocks */
+#define ARV_GVBS_STREAM_CHANNEL_SIZE				0x00000040
+
 #define ARV_GVCP_DATA_SIZE_MAX				512
 
 /**
@@ -336,7 +347,7 @@ ArvGvcpPacket * 	arv_gvcp_packet_new_write_register_ack 	(guint32 data_index,
 								 guint16 packet_id, size_t *packet_size);
 ArvGvcpPacket * 	arv_gvcp_packet_new_discovery_cmd 	(gboolean allow_broadcast_discovery_ack, size_t *packet_size);
 ArvGvcpPacket * 	arv_gvcp_packet_new_discovery_ack 	(guint16 packet_id, size_t *packet_size);
-ArvGvcpPacket * 	arv_gvcp_packet_new_packet_resend_cmd 	(guint64 frame_id,
+ArvGvcpPacket * 	arv_gvcp_packet_new_packet_resend_cmd 	(guint16 stream_channel, guint64 frame_id,
 								 guint32 first_block, guint32 last_block,
 								 gboolean extended_ids,
 								 guint16 packet_id, size_t *packet_size);
@@ -512,6 +523,44 @@ arv_gvcp_packet_get_write_register_cmd_infos (const ArvGvcpPacket *packet, guint
 		*value = g_ntohl (*((guint32 *) ((char *) packet + sizeof (ArvGvcpPacket) + sizeof (guint32))));
 }
 
+static inline void
+arv_gvcp_packet_get_packet_resend_cmd_infos (const ArvGvcpPacket *packet, guint16 *stream_channel, guint64 *frame_id,
+					     guint32 *first_block, guint32 *last_block, gboolean *extended_ids)
+{
+	const guint32 *data;
+	gboolean extended;
+
+	if (packet == NULL) {
+		if (stream_channel != NULL)
+			*stream_channel = 0;
+		if (frame_id != NULL)
+			*frame_id = 0;
+		if (first_block != NULL)
+			*first_block = 0;
+		if (last_block != NULL)
+			*last_block = 0;
+		if (extended_ids != NULL)
+			*extended_ids = FALSE;
+		return;
+	}
+
+	data = (const guint32 *) &packet->data;
+	extended = (packet->header.packet_flags & ARV_GVCP_CMD_PACKET_FLAGS_EXTENDED_IDS) != 0;
+
+	if (extended_ids != NULL)
+		*extended_ids = extended;
+	if (stream_channel != NULL)
+		*stream_channel = g_ntohl (data[0]) >> 16;
+	if (frame_id != NULL)
+		*frame_id = extended ?
+			GUINT64_FROM_BE (*((const guint64 *) &data[3])) :
+			g_ntohl (data[0]) & 0xffff;
+	if (first_block != NULL)
+		*first_block = extended ? g_ntohl (data[1]) : g_ntohl (data[1]) & ARV_GVSP_PACKET_ID_MASK;
+	if (last_block != NULL)
+		*last_block = extended ? g_ntohl (data[2]) : g_ntohl (data[2]) & ARV_GVSP_PACKET_ID_MASK;
+}
+
 static inline size_t
 arv_gvcp_packet_get_write_register_ack_size (void)
 {
@@ -28,12 +28,14 @@
 #include <arvgvdeviceprivate.h>
 #include <arvdeviceprivate.h>
 #include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvgccommand.h>
 #include <arvgcboolean.h>
 #include <arvgcregisterdescriptionnode.h>
 #include <arvdebugprivate.h>
 #include <arvgvstreamprivate.h>
 #include <arvgvcpprivate.h>
+#include <arvtraceprivate.h>
 #include <arvgvspprivate.h>
 #include <arvnetworkprivate.h>
 #include <arvzip.h>
@@ -70,6 +72,13 @@ typedef struct {
 	unsigned int gvcp_timeout_ms;
 
 	gboolean is_controller;
+
+	guint64 n_gvcp_commands;
+	guint64 n_gvcp_retries;
+	guint64 n_gvcp_timeouts;
+	guint64 n_gvcp_errors;
+	guint64 n_heartbeat_failures;
+	guint64 n_control_lost;
 } ArvGvDeviceIOData;
 
 typedef struct {
@@ -83,9 +92,6 @@ typedef struct {
 
 	ArvGc *genicam;
 
-	char *genicam_xml;
-	size_t genicam_xml_size;
-
 	gboolean is_big_endian_device;
 
 	gboolean is_packet_resend_supported;
@@ -94,6 +100,9 @@ typedef struct {
 	ArvGvStreamOption stream_options;
 	ArvGvPacketSizeAdjustment packet_size_adjustment;
 
+	GInetAddress *stream_multicast_address;
+	guint16 stream_multicast_port;
+
 	gboolean first_stream_created;
 
 	gboolean init_success;
@@ -206,6 +215,8 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 
 		arv_gvcp_packet_debug (packet, ARV_DEBUG_LEVEL_TRACE);
 
+		ARV_TRACE4 (gvcp_command, command, io_data->packet_id, address, n_retries);
+
 		success = g_socket_send_to (io_data->socket, io_data->device_address,
 					    (const char *) packet, packet_size,
 					    NULL, &local_error) >= 0;
@@ -281,14 +292,19 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 					if (local_error != NULL)
 						arv_warning_device ("[GvDevice::%s] Ack reception error: %s", operation,
 								    local_error->message);
-					else
+					else {
 						arv_warning_device ("[GvDevice::%s] Ack reception timeout", operation);
+						io_data->n_gvcp_timeouts++;
+					}
 					g_clear_error (&local_error);
 				}
 			} while (pending_ack || (!expected_answer && timeout_ms > 0));
 
 			success = success && expected_answer;
 
+			if (success)
+				ARV_TRACE3 (gvcp_ack, command, io_data->packet_id, command_error);
+
 			if (success && command_error == ARV_GVCP_ERROR_NONE) {
 				switch (command) {
 					case ARV_GVCP_COMMAND_READ_MEMORY_CMD:
@@ -316,10 +332,15 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 
 	arv_gvcp_packet_free (packet);
 
-	g_mutex_unlock (&io_data->mutex);
-
 	success = success && command_error == ARV_GVCP_ERROR_NONE;
 
+	io_data->n_gvcp_commands++;
+	io_data->n_gvcp_retries += n_retries - 1;
+	if (!success)
+		io_data->n_gvcp_errors++;
+
+	g_mutex_unlock (&io_data->mutex);
+
 	if (!success) {
 		switch (command) {
 			case ARV_GVCP_COMMAND_READ_MEMORY_CMD:
@@ -474,6 +495,8 @@ arv_gv_device_heartbeat_thread (void *data)
 				counter++;
 			}
 
+			io_data->n_heartbeat_failures += counter - 1;
+
 			if (!g_cancellable_is_cancelled (thread_data->cancellable)) {
 				arv_debug_device ("[GvDevice::Heartbeat] Ack value = %d", value);
 
@@ -487,6 +510,7 @@ arv_gv_device_heartbeat_thread (void *data)
 					arv_device_emit_control_lost_signal (ARV_DEVICE (thread_data->gv_device));
 
 					io_data->is_controller = FALSE;
+					io_data->n_control_lost++;
 				}
 			} else
 				io_data->is_controller = FALSE;
@@ -1396,10 +1420,13 @@ arv_gv_device_get_genicam_xml (ArvDevice *device, size_t *size)
 {
 	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (ARV_GV_DEVICE (device));
 
-        if (size != NULL)
-                *size = priv->genicam_xml_size;
+        if (priv->genicam == NULL) {
+                if (size != NULL)
+                        *size = 0;
+                return NULL;
+        }
 
-        return priv->genicam_xml;
+        return arv_gc_get_xml (priv->genicam, size);
 }
 
 void
@@ -1835,9 +1862,8 @@ arv_gv_device_load_genicam (ArvGvDevice *gv_device, GError **error)
 		return;
 	}
 
-	priv->genicam_xml = xml;
-	priv->genicam_xml_size = size;
-        priv->genicam = arv_gc_new (ARV_DEVICE (gv_device), xml, size);
+        /* The document takes the ownership of the xml data, which are kept for the lazy node instantiation */
+        priv->genicam = arv_gc_new_take (ARV_DEVICE (gv_device), xml, size);
         arv_gc_set_default_gv_features(priv->genicam);
         arv_dom_document_set_url (ARV_DOM_DOCUMENT(priv->genicam), url);
 
@@ -1865,16 +1891,22 @@ arv_gv_device_create_stream (ArvDevice *device, ArvStreamCallback callback, void
 	}
 
 	if (!priv->io_data->is_controller) {
-		arv_warning_device ("[GvDevice::create_stream] Can't create stream without control access");
-		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_CONTROLLER,
-			     "Controller privilege required for streaming control");
-		return NULL;
-	}
+		guint32 destination;
+
+		/* Without control access, only a multicast stream set up by the controller can be monitored */
+		destination = arv_device_get_integer_feature_value (device, "ArvGevSCDA", NULL);
+		if ((destination & 0xf0000000) != 0xe0000000) {
+			arv_warning_device ("[GvDevice::create_stream] Can't create stream without control access");
+			g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_CONTROLLER,
+				     "Controller privilege required for streaming control");
+			return NULL;
+		}
 
-	if (priv->packet_size_adjustment != ARV_GV_PACKET_SIZE_ADJUSTMENT_NEVER &&
-	    ((priv->packet_size_adjustment != ARV_GV_PACKET_SIZE_ADJUSTMENT_ONCE &&
-	      priv->packet_size_adjustment != ARV_GV_PACKET_SIZE_ADJUSTMENT_ON_FAILURE_ONCE) ||
-	     !priv->first_stream_created)) {
+		arv_info_device ("[GvDevice::create_stream] Create monitor stream on multicast destination");
+	} else if (priv->packet_size_adjustment != ARV_GV_PACKET_SIZE_ADJUSTMENT_NEVER &&
+		   ((priv->packet_size_adjustment != ARV_GV_PACKET_SIZE_ADJUSTMENT_ONCE &&
+		     priv->packet_size_adjustment != ARV_GV_PACKET_SIZE_ADJUSTMENT_ON_FAILURE_ONCE) ||
+		    !priv->first_stream_created)) {
 		auto_packet_size (gv_device,
                                   priv->packet_size_adjustment == ARV_GV_PACKET_SIZE_ADJUSTMENT_ON_FAILURE ||
                                   priv->packet_size_adjustment == ARV_GV_PACKET_SIZE_ADJUSTMENT_ON_FAILURE_ONCE,
@@ -1944,6 +1976,65 @@ arv_gv_device_set_stream_options (ArvGvDevice *gv_device, ArvGvStreamOption opti
 	priv->stream_options = options;
 }
 
+/**
+ * arv_gv_device_set_stream_multicast_address:
+ * @gv_device: a #ArvGvDevice
+ * @address: (allow-none): a multicast group address, %NULL for unicast streaming
+ * @port: destination port, 0 for an automatically selected one
+ *
+ * Sets the multicast group the streams are sent to. It must be called before arv_device_create_stream(). The
+ * stream created by the controller joins the group and points the stream channel destination to it. Any other
+ * application, or device instance without control access, can then create a monitor stream receiving the same
+ * frames. Missing packets are resent in unicast to the stream requesting them.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_gv_device_set_stream_multicast_address (ArvGvDevice *gv_device, GInetAddress *address, guint16 port)
+{
+	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (gv_device);
+
+	g_return_if_fail (ARV_IS_GV_DEVICE (gv_device));
+	g_return_if_fail (address == NULL ||
+			  (G_IS_INET_ADDRESS (address) &&
+			   g_inet_address_get_family (address) == G_SOCKET_FAMILY_IPV4 &&
+			   g_inet_address_get_is_multicast (address)));
+
+	if (address != NULL)
+		g_object_ref (address);
+	g_clear_object (&priv->stream_multicast_address);
+	priv->stream_multicast_address = address;
+	priv->stream_multicast_port = address != NULL ? port : 0;
+}
+
+/**
+ * arv_gv_device_get_stream_multicast_address:
+ * @gv_device: a #ArvGvDevice
+ * @port: (out) (optional): destination port placeholder
+ *
+ * Returns: (transfer none) (nullable): the multicast group set by arv_gv_device_set_stream_multicast_address(),
+ * %NULL for unicast streaming
+ *
+ * Since: 0.9.0
+ */
+
+GInetAddress *
+arv_gv_device_get_stream_multicast_address (ArvGvDevice *gv_device, guint16 *port)
+{
+	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (gv_device);
+
+	if (port != NULL)
+		*port = 0;
+
+	g_return_val_if_fail (ARV_IS_GV_DEVICE (gv_device), NULL);
+
+	if (port != NULL)
+		*port = priv->stream_multicast_port;
+
+	return priv->stream_multicast_address;
+}
+
 /**
  * arv_gv_device_new:
  * @interface_address: address of the interface connected to the device
@@ -2027,6 +2118,19 @@ arv_gv_device_constructed (GObject *object)
 
 	priv->io_data = io_data;
 
+	arv_device_declare_info (ARV_DEVICE (gv_device), "gvcp_commands",
+				 "GVCP commands", &io_data->n_gvcp_commands);
+	arv_device_declare_info (ARV_DEVICE (gv_device), "gvcp_retries",
+				 "GVCP command retries", &io_data->n_gvcp_retries);
+	arv_device_declare_info (ARV_DEVICE (gv_device), "gvcp_timeouts",
+				 "GVCP acknowledge timeouts", &io_data->n_gvcp_timeouts);
+	arv_device_declare_info (ARV_DEVICE (gv_device), "gvcp_errors",
+				 "Failed GVCP commands", &io_data->n_gvcp_errors);
+	arv_device_declare_info (ARV_DEVICE (gv_device), "heartbeat_failures",
+				 "Failed heartbeat register reads", &io_data->n_heartbeat_failures);
+	arv_device_declare_info (ARV_DEVICE (gv_device), "control_lost",
+				 "Control channel privilege losses", &io_data->n_control_lost);
+
 	arv_gv_device_load_genicam (gv_device, &local_error);
 	if (local_error != NULL) {
 		arv_device_take_init_error (ARV_DEVICE (gv_device), local_error);
@@ -2079,8 +2183,6 @@ arv_gv_device_init (ArvGvDevice *gv_device)
 	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (gv_device);
 
 	priv->genicam = NULL;
-	priv->genicam_xml = NULL;
-	priv->genicam_xml_size = 0;
 	priv->stream_options = ARV_GV_STREAM_OPTION_NONE;
 }
 
@@ -2106,7 +2208,7 @@ arv_gv_device_finalize (GObject *object)
 		priv->heartbeat_thread = NULL;
 	}
 
-	if (priv->init_success)
+	if (priv->init_success && priv->io_data->is_controller)
 		arv_gv_device_leave_control (gv_device, NULL);
 
 	io_data = priv->io_data;
@@ -2121,10 +2223,10 @@ arv_gv_device_finalize (GObject *object)
 	g_clear_pointer (&priv->io_data, g_free);
 
 	g_clear_object (&priv->genicam);
-	g_clear_pointer (&priv->genicam_xml, g_free);
 
 	g_clear_object (&priv->interface_address);
 	g_clear_object (&priv->device_address);
+	g_clear_object (&priv->stream_multicast_address);
 
 	G_OBJECT_CLASS (arv_gv_device_parent_class)->finalize (object);
 }
@@ -2158,7 +2260,7 @@ GSocketAddress *arv_gv_device_get_device_address(ArvGvDevice *gv_device)
 {
 	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (gv_device);
 
-	return priv->io_data->device_address;
+	return priv->io_data != NULL ? priv->io_data->device_address : NULL;
 }
 
 static void
@@ -90,6 +90,10 @@ ARV_API guint			arv_gv_device_auto_packet_size			(ArvGvDevice *gv_device, GError
 ARV_API ArvGvStreamOption	arv_gv_device_get_stream_options		(ArvGvDevice *gv_device);
 ARV_API void			arv_gv_device_set_stream_options		(ArvGvDevice *gv_device,
                                                                                  ArvGvStreamOption options);
+ARV_API void			arv_gv_device_set_stream_multicast_address	(ArvGvDevice *gv_device,
+                                                                                 GInetAddress *address, guint16 port);
+ARV_API GInetAddress *		arv_gv_device_get_stream_multicast_address	(ArvGvDevice *gv_device,
+                                                                                 guint16 *port);
 
 ARV_API gboolean		arv_gv_device_get_current_ip			(ArvGvDevice *gv_device,
                                                                                  GInetAddress **ip,
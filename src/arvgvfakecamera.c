@@ -21,13 +21,14 @@
  */
 
 #include <arvgvfakecamera.h>
-#include <arvfakecamera.h>
+#include <arvfakecameraprivate.h>
 #include <arvbufferprivate.h>
 #include <arvgvcpprivate.h>
 #include <arvgvspprivate.h>
 #include <arvmisc.h>
 #include <arvmiscprivate.h>
 #include <arvnetworkprivate.h>
+#include <string.h>
 
 /**
  * SECTION: arvgvfakecamera
@@ -38,6 +39,29 @@
 
 #define ARV_GV_FAKE_CAMERA_BUFFER_SIZE	65536
 
+/* Maximum number of packets handed to the kernel in a single call */
+#define ARV_GV_FAKE_CAMERA_N_BATCH_PACKETS	64
+/* Room for the largest GVSP header (multipart leader) */
+#define ARV_GV_FAKE_CAMERA_HEADER_SLOT_SIZE	256
+/* Maximum transmission time of a batch when pacing is enabled */
+#define ARV_GV_FAKE_CAMERA_PACING_QUANTUM_NS	50000
+/* Ethernet header and frame check sequence, not included in GVSP packet size */
+#define ARV_GV_FAKE_CAMERA_ETHERNET_OVERHEAD	(14 + 4)
+/* Maximum number of packets held back for reordering simulation */
+#define ARV_GV_FAKE_CAMERA_N_HELD_PACKETS	16
+
+#define ARV_GV_FAKE_CAMERA_HISTORY_SIZE_DEFAULT	4
+
+#define ARV_GV_FAKE_CAMERA_N_STREAM_CHANNELS_MAX	4
+/* Image, depth and chunk data */
+#define ARV_GV_FAKE_CAMERA_N_PARTS_MAX		3
+#define ARV_GV_FAKE_CAMERA_PACKET_SIZE_DEFAULT	1400
+
+/* Polling period of an idle stream channel */
+#define ARV_GV_FAKE_CAMERA_IDLE_PERIOD_US	10000
+/* Maximum wait between two checks of the stream channel state */
+#define ARV_GV_FAKE_CAMERA_WAIT_SLICE_US	100000
+
 enum {
 	ARV_GV_FAKE_CAMERA_INPUT_SOCKET_GVCP = 0,
 	ARV_GV_FAKE_CAMERA_INPUT_SOCKET_GLOBAL_DISCOVERY,
@@ -52,9 +76,115 @@ enum
   PROP_SERIAL_NUMBER,
   PROP_GENICAM_FILENAME,
   PROP_GVSP_LOST_PACKET_RATIO,
+  PROP_GVSP_BANDWIDTH,
+  PROP_GVSP_FAULTS,
+  PROP_GVSP_HISTORY_SIZE,
+  PROP_GVSP_N_STREAM_CHANNELS,
   PROP_CM_DOMAIN
 };
 
+/* Fault injection model. All the random decisions are taken from a single
+ * seeded generator, which makes a given fault sequence reproducible. */
+
+typedef struct {
+	GRand *rand;
+	guint32 seed;
+
+	double loss_ratio;
+	double burst_ratio;
+	guint burst_length;
+	double reorder_ratio;
+	guint reorder_window;
+	double duplicate_ratio;
+	double error_ratio;
+	guint64 trailer_delay_us;
+
+	guint burst_remaining;
+
+	guint64 n_dropped;
+	guint64 n_reordered;
+	guint64 n_duplicated;
+	guint64 n_errors;
+} ArvGvFakeCameraFaults;
+
+typedef struct {
+	guint8 header[ARV_GV_FAKE_CAMERA_HEADER_SLOT_SIZE];
+	size_t header_size;
+	const void *data;
+	size_t data_size;
+	guint countdown;
+} ArvGvFakeCameraHeldPacket;
+
+/* Batched GVSP emission. Packet headers are built in a per-batch array, while
+ * the payload vectors point directly into the image buffer. */
+
+typedef struct {
+	GSocket *socket;
+	GSocketAddress *address;
+
+	GOutputMessage messages[ARV_GV_FAKE_CAMERA_N_BATCH_PACKETS];
+	GOutputVector vectors[ARV_GV_FAKE_CAMERA_N_BATCH_PACKETS][2];
+	guint8 headers[ARV_GV_FAKE_CAMERA_N_BATCH_PACKETS][ARV_GV_FAKE_CAMERA_HEADER_SLOT_SIZE];
+	guint n_messages;
+
+	ArvGvFakeCameraHeldPacket held[ARV_GV_FAKE_CAMERA_N_HELD_PACKETS];
+	guint n_held;
+
+	guint64 packet_delay_ns;
+	guint64 bandwidth;
+
+	gint64 batch_duration_ns;
+	gint64 next_batch_time_ns;
+
+	guint64 n_packets;
+	guint64 n_bytes;
+} ArvGvFakeCameraSender;
+
+/* Sent frame, kept in the history ring for packet resend */
+
+typedef struct {
+	ArvBuffer *buffer;
+	size_t payload;
+	guint32 packet_size;
+	guint32 n_packets;
+	gboolean is_multipart;
+	/* Block id of the first packet of each part, followed by the trailer block id */
+	guint32 part_first_block[ARV_GV_FAKE_CAMERA_N_PARTS_MAX + 1];
+} ArvGvFakeCameraFrame;
+
+typedef struct {
+	guint64 frame_id;
+	guint32 first_block;
+	guint32 last_block;
+	GSocketAddress *requester_address;
+} ArvGvFakeCameraResendRequest;
+
+static void
+_resend_request_free (ArvGvFakeCameraResendRequest *request)
+{
+	g_clear_object (&request->requester_address);
+	g_free (request);
+}
+
+/* Stream channel, with its own socket and sender thread. The sender and the frame history are only accessed from
+ * the channel thread, resend requests are forwarded to it through a queue. */
+
+typedef struct {
+	ArvGvFakeCamera *gv_fake_camera;
+	guint index;
+
+	GSocket *socket;
+	GThread *thread;
+	GAsyncQueue *resend_requests;
+
+	ArvGvFakeCameraSender *sender;
+	ArvGvFakeCameraFrame *history;
+	guint n_history_frames;
+	guint history_index;
+
+	guint32 frame_id;
+} ArvGvFakeCameraChannel;
+
 typedef struct {
 	char *interface_name;
 	char *serial_number;
@@ -72,12 +202,28 @@ typedef struct {
 
 	GSocket *input_sockets[ARV_GV_FAKE_CAMERA_N_INPUT_SOCKETS];
 
-	GSocket *gvsp_socket;
-
 	GThread *thread;
 	gboolean cancel;
 
 	double gvsp_lost_packet_ratio;
+	guint64 gvsp_bandwidth;
+	guint gvsp_history_size;
+
+	ArvGvFakeCameraChannel channels[ARV_GV_FAKE_CAMERA_N_STREAM_CHANNELS_MAX];
+	guint n_stream_channels;
+
+	GMutex faults_mutex;
+	ArvGvFakeCameraFaults faults;
+
+	GMutex statistics_mutex;
+	guint n_streaming_channels;
+	guint64 n_sent_frames;
+	guint64 n_sent_packets;
+	guint64 n_sent_bytes;
+	guint64 n_resent_packets;
+	guint64 n_unavailable_packets;
+	gint64 stream_start_time_us;
+	gint64 stream_last_time_us;
 } ArvGvFakeCameraPrivate;
 
 struct _ArvGvFakeCamera {
@@ -106,6 +252,737 @@ _g_inet_socket_address_is_equal (GInetSocketAddress *a, GInetSocketAddress *b)
 				     g_inet_socket_address_get_address (b));
 }
 
+static gint64
+_get_time_ns (void)
+{
+	return g_get_monotonic_time () * 1000LL;
+}
+
+static void
+_wait_until (gint64 time_ns)
+{
+	gint64 remaining_ns;
+
+	remaining_ns = time_ns - _get_time_ns ();
+
+	/* Sleep for the bulk of the delay, and spin for the rest, as the
+	 * scheduler granularity is too coarse for packet pacing */
+	if (remaining_ns > 200000)
+		g_usleep ((remaining_ns - 100000) / 1000);
+
+	while (_get_time_ns () < time_ns);
+}
+
+static void
+_sender_init (ArvGvFakeCameraSender *sender, GSocket *socket, GSocketAddress *address)
+{
+	memset (sender, 0, sizeof (ArvGvFakeCameraSender));
+
+	sender->socket = socket;
+	sender->address = address;
+}
+
+static void
+_sender_flush (ArvGvFakeCameraSender *sender)
+{
+	GError *error = NULL;
+	guint n_sent = 0;
+	guint i;
+
+	if (sender->n_messages == 0)
+		return;
+
+	if (sender->batch_duration_ns > 0) {
+		gint64 start_time_ns;
+
+		_wait_until (sender->next_batch_time_ns);
+
+		start_time_ns = MAX (sender->next_batch_time_ns, _get_time_ns ());
+		sender->next_batch_time_ns = start_time_ns + sender->batch_duration_ns;
+	}
+
+	while (n_sent < sender->n_messages) {
+		gint count;
+
+		count = g_socket_send_messages (sender->socket,
+						&sender->messages[n_sent], sender->n_messages - n_sent,
+						0, NULL, &error);
+		if (count <= 0)
+			break;
+
+		for (i = n_sent; i < n_sent + count; i++)
+			sender->n_bytes += sender->messages[i].bytes_sent;
+
+		sender->n_packets += count;
+		n_sent += count;
+	}
+
+	if (error != NULL) {
+		arv_info_stream_thread ("[GvFakeCamera::flush] Failed to send %u packets: %s",
+					sender->n_messages - n_sent, error->message);
+		g_clear_error (&error);
+	}
+
+	sender->n_messages = 0;
+	sender->batch_duration_ns = 0;
+}
+
+/* Returns the header slot of the next packet */
+
+static void *
+_sender_get_header (ArvGvFakeCameraSender *sender, size_t *header_size)
+{
+	*header_size = ARV_GV_FAKE_CAMERA_HEADER_SLOT_SIZE;
+
+	return sender->headers[sender->n_messages];
+}
+
+static void
+_sender_push (ArvGvFakeCameraSender *sender, const void *header, size_t header_size,
+	      const void *data, size_t data_size)
+{
+	GOutputMessage *message;
+	GOutputVector *vectors;
+
+	if (header != sender->headers[sender->n_messages])
+		memcpy (sender->headers[sender->n_messages], header, header_size);
+
+	vectors = sender->vectors[sender->n_messages];
+	vectors[0].buffer = sender->headers[sender->n_messages];
+	vectors[0].size = header_size;
+	vectors[1].buffer = data;
+	vectors[1].size = data_size;
+
+	message = &sender->messages[sender->n_messages];
+	message->address = sender->address;
+	message->vectors = vectors;
+	message->num_vectors = data_size > 0 ? 2 : 1;
+	message->bytes_sent = 0;
+	message->control_messages = NULL;
+	message->num_control_messages = 0;
+
+	sender->n_messages++;
+
+	if (sender->packet_delay_ns > 0 || sender->bandwidth > 0) {
+		guint64 wire_size;
+		guint64 duration_ns;
+
+		wire_size = header_size + data_size + ARV_GVSP_PACKET_UDP_OVERHEAD + ARV_GV_FAKE_CAMERA_ETHERNET_OVERHEAD;
+		duration_ns = sender->bandwidth > 0 ? (wire_size * 8 * 1000000000ULL) / sender->bandwidth : 0;
+
+		sender->batch_duration_ns += MAX (duration_ns, sender->packet_delay_ns);
+	}
+
+	if (sender->n_messages >= ARV_GV_FAKE_CAMERA_N_BATCH_PACKETS ||
+	    sender->batch_duration_ns >= ARV_GV_FAKE_CAMERA_PACING_QUANTUM_NS)
+		_sender_flush (sender);
+}
+
+/* Sends the held packets whose reordering delay is elapsed, or all of them */
+
+static void
+_sender_release_held (ArvGvFakeCameraSender *sender, gboolean release_all)
+{
+	guint i = 0;
+
+	while (i < sender->n_held) {
+		ArvGvFakeCameraHeldPacket *held = &sender->held[i];
+
+		if (release_all || held->countdown <= 1) {
+			_sender_push (sender, held->header, held->header_size, held->data, held->data_size);
+			sender->n_held--;
+			if (i < sender->n_held)
+				sender->held[i] = sender->held[sender->n_held];
+		} else {
+			held->countdown--;
+			i++;
+		}
+	}
+}
+
+static void
+_faults_init (ArvGvFakeCameraFaults *faults)
+{
+	memset (faults, 0, sizeof (ArvGvFakeCameraFaults));
+
+	faults->seed = g_random_int ();
+	faults->burst_length = 1;
+	faults->reorder_window = 1;
+	faults->rand = g_rand_new_with_seed (faults->seed);
+}
+
+static void
+_faults_clear (ArvGvFakeCameraFaults *faults)
+{
+	g_clear_pointer (&faults->rand, g_rand_free);
+}
+
+/*
+ * Fault model description, a comma separated list of:
+ *
+ *   seed=<n>                    seed of the random generator, random by default
+ *   loss=<ratio>                uniform packet loss
+ *   burst=<ratio>[:<length>]    loss of <length> consecutive packets
+ *   reorder=<ratio>[:<window>]  packet delayed by up to <window> packets
+ *   duplicate=<ratio>           packet sent twice
+ *   error=<ratio>               payload packet replaced by an error packet
+ *   trailer-delay=<us>          delay before the trailer emission
+ */
+
+static gboolean
+_faults_parse (ArvGvFakeCameraFaults *faults, const char *description)
+{
+	char **tokens;
+	gboolean success = TRUE;
+	guint i;
+
+	_faults_clear (faults);
+	_faults_init (faults);
+
+	if (description == NULL)
+		return TRUE;
+
+	tokens = g_strsplit (description, ",", -1);
+
+	for (i = 0; tokens[i] != NULL; i++) {
+		char **key_value;
+		char **params;
+		const char *key;
+
+		key_value = g_strsplit (g_strstrip (tokens[i]), "=", 2);
+		if (key_value[0] == NULL || key_value[0][0] == '\0') {
+			g_strfreev (key_value);
+			continue;
+		}
+
+		if (key_value[1] == NULL) {
+			arv_warning_device ("[GvFakeCamera::parse_faults] Missing value for '%s'", key_value[0]);
+			g_strfreev (key_value);
+			success = FALSE;
+			continue;
+		}
+
+		key = key_value[0];
+		params = g_strsplit (key_value[1], ":", 2);
+
+		if (g_strcmp0 (key, "seed") == 0) {
+			faults->seed = g_ascii_strtoull (params[0], NULL, 10);
+		} else if (g_strcmp0 (key, "loss") == 0) {
+			faults->loss_ratio = g_ascii_strtod (params[0], NULL);
+		} else if (g_strcmp0 (key, "burst") == 0) {
+			faults->burst_ratio = g_ascii_strtod (params[0], NULL);
+			if (params[1] != NULL)
+				faults->burst_length = MAX (1, g_ascii_strtoull (params[1], NULL, 10));
+		} else if (g_strcmp0 (key, "reorder") == 0) {
+			faults->reorder_ratio = g_ascii_strtod (params[0], NULL);
+			if (params[1] != NULL)
+				faults->reorder_window = CLAMP (g_ascii_strtoull (params[1], NULL, 10),
+								1, ARV_GV_FAKE_CAMERA_N_BATCH_PACKETS);
+		} else if (g_strcmp0 (key, "duplicate") == 0) {
+			faults->duplicate_ratio = g_ascii_strtod (params[0], NULL);
+		} else if (g_strcmp0 (key, "error") == 0) {
+			faults->error_ratio = g_ascii_strtod (params[0], NULL);
+		} else if (g_strcmp0 (key, "trailer-delay") == 0) {
+			faults->trailer_delay_us = g_ascii_strtoull (params[0], NULL, 10);
+		} else {
+			arv_warning_device ("[GvFakeCamera::parse_faults] Unknown fault '%s'", key);
+			success = FALSE;
+		}
+
+		g_strfreev (params);
+		g_strfreev (key_value);
+	}
+
+	g_strfreev (tokens);
+
+	g_rand_set_seed (faults->rand, faults->seed);
+
+	return success;
+}
+
+static gboolean
+_faults_check (ArvGvFakeCameraFaults *faults, double ratio)
+{
+	return ratio > 0.0 && g_rand_double (faults->rand) < ratio;
+}
+
+/* Faults applied to a single packet */
+
+typedef struct {
+	gboolean drop;
+	gboolean error;
+	gboolean duplicate;
+	guint reorder_countdown;
+} ArvGvFakeCameraPacketFaults;
+
+/* Draws the faults of the next packet. The fault model is shared by all the stream channels, it must be called
+ * with the faults mutex held. */
+
+static void
+_faults_draw (ArvGvFakeCameraFaults *faults, double lost_ratio, gboolean is_payload, gboolean can_hold,
+	      ArvGvFakeCameraPacketFaults *packet_faults)
+{
+	memset (packet_faults, 0, sizeof (ArvGvFakeCameraPacketFaults));
+
+	if (faults->burst_remaining > 0) {
+		faults->burst_remaining--;
+		faults->n_dropped++;
+		packet_faults->drop = TRUE;
+		return;
+	}
+
+	if (_faults_check (faults, faults->burst_ratio)) {
+		faults->burst_remaining = faults->burst_length - 1;
+		faults->n_dropped++;
+		packet_faults->drop = TRUE;
+		return;
+	}
+
+	if (_faults_check (faults, lost_ratio) ||
+	    _faults_check (faults, faults->loss_ratio)) {
+		faults->n_dropped++;
+		packet_faults->drop = TRUE;
+		return;
+	}
+
+	if (is_payload && _faults_check (faults, faults->error_ratio)) {
+		packet_faults->error = TRUE;
+		faults->n_errors++;
+	}
+
+	if (can_hold && _faults_check (faults, faults->reorder_ratio)) {
+		packet_faults->reorder_countdown = 1 + g_rand_int_range (faults->rand, 0, faults->reorder_window);
+		faults->n_reordered++;
+		return;
+	}
+
+	packet_faults->duplicate = _faults_check (faults, faults->duplicate_ratio);
+	if (packet_faults->duplicate)
+		faults->n_duplicated++;
+}
+
+/* Emits the packet built in the current header slot of @sender, applying @packet_faults */
+
+static void
+_emit_packet (ArvGvFakeCameraSender *sender, const ArvGvFakeCameraPacketFaults *packet_faults,
+	      size_t header_size, const void *data, size_t data_size)
+{
+	void *header = sender->headers[sender->n_messages];
+
+	if (packet_faults->drop)
+		return;
+
+	if (packet_faults->error) {
+		((ArvGvspPacket *) header)->packet_type = g_htons (ARV_GVSP_PACKET_TYPE_PACKET_UNAVAILABLE);
+		data = NULL;
+		data_size = 0;
+	}
+
+	if (packet_faults->reorder_countdown > 0) {
+		ArvGvFakeCameraHeldPacket *held = &sender->held[sender->n_held++];
+
+		memcpy (held->header, header, header_size);
+		held->header_size = header_size;
+		held->data = data;
+		held->data_size = data_size;
+		held->countdown = packet_faults->reorder_countdown;
+		return;
+	}
+
+	_sender_push (sender, header, header_size, data, data_size);
+	if (packet_faults->duplicate)
+		_sender_push (sender, header, header_size, data, data_size);
+
+	_sender_release_held (sender, FALSE);
+}
+
+static guint32
+_read_channel_register (ArvFakeCamera *camera, guint channel_index, guint32 channel_0_address)
+{
+	guint32 value = 0;
+
+	arv_fake_camera_read_register (camera, channel_0_address + channel_index * ARV_GVBS_STREAM_CHANNEL_SIZE, &value);
+
+	return value;
+}
+
+static guint64
+_get_packet_delay_ns (ArvFakeCamera *camera, guint channel_index)
+{
+	guint32 packet_delay;
+	guint32 frequency_high;
+	guint32 frequency_low;
+	guint64 frequency;
+
+	packet_delay = _read_channel_register (camera, channel_index, ARV_GVBS_STREAM_CHANNEL_0_PACKET_DELAY_OFFSET);
+	arv_fake_camera_read_register (camera, ARV_GVBS_TIMESTAMP_TICK_FREQUENCY_HIGH_OFFSET, &frequency_high);
+	arv_fake_camera_read_register (camera, ARV_GVBS_TIMESTAMP_TICK_FREQUENCY_LOW_OFFSET, &frequency_low);
+
+	frequency = ((guint64) frequency_high << 32) | frequency_low;
+	if (frequency == 0)
+		return 0;
+
+	return ((guint64) packet_delay * 1000000000ULL) / frequency;
+}
+
+static GSocketAddress *
+_get_stream_address (ArvFakeCamera *camera, guint channel_index)
+{
+	GSocketAddress *stream_address;
+	GInetAddress *inet_address;
+	guint32 value;
+
+	arv_fake_camera_read_memory (camera,
+				     ARV_GVBS_STREAM_CHANNEL_0_IP_ADDRESS_OFFSET +
+				     channel_index * ARV_GVBS_STREAM_CHANNEL_SIZE,
+				     sizeof (value), &value);
+
+	inet_address = g_inet_address_new_from_bytes ((guint8 *) &value, G_SOCKET_FAMILY_IPV4);
+	stream_address = g_inet_socket_address_new
+		(inet_address,
+		 _read_channel_register (camera, channel_index, ARV_GVBS_STREAM_CHANNEL_0_PORT_OFFSET) & 0xffff);
+
+	g_object_unref (inet_address);
+
+	return stream_address;
+}
+
+static gboolean
+_is_channel_streaming (ArvGvFakeCamera *gv_fake_camera, guint channel_index)
+{
+	ArvFakeCamera *camera = gv_fake_camera->priv->camera;
+
+	return arv_fake_camera_get_control_channel_privilege (camera) != 0 &&
+		arv_fake_camera_get_acquisition_status (camera) != 0 &&
+		(_read_channel_register (camera, channel_index, ARV_GVBS_STREAM_CHANNEL_0_PORT_OFFSET) & 0xffff) != 0;
+}
+
+/* Turns the image filled by the fake camera into a multipart payload, by appending a 16 bit depth part. Chunk
+ * data, if any, are moved to a third part. */
+
+static void
+_set_multipart_payload (ArvBuffer *buffer)
+{
+	ArvBufferPartInfos image = buffer->priv->parts[0];
+	size_t depth_size = (size_t) image.width * image.height * 2;
+	size_t chunk_size = buffer->priv->received_size - image.size;
+	guint8 *depth;
+	guint n_parts;
+	guint x, y;
+
+	if (image.size + depth_size + chunk_size > buffer->priv->allocated_size)
+		return;
+
+	if (chunk_size > 0)
+		memmove (buffer->priv->data + image.size + depth_size, buffer->priv->data + image.size, chunk_size);
+
+	depth = buffer->priv->data + image.size;
+	for (y = 0; y < image.height; y++) {
+		for (x = 0; x < image.width; x++) {
+			guint16 value = (x + y + buffer->priv->frame_id) & 0xffff;
+			size_t index = 2 * ((size_t) y * image.width + x);
+
+			depth[index] = value & 0xff;
+			depth[index + 1] = value >> 8;
+		}
+	}
+
+	n_parts = chunk_size > 0 ? 3 : 2;
+
+	/* Part infos are reset by arv_buffer_set_n_parts */
+	arv_buffer_set_n_parts (buffer, n_parts);
+
+	buffer->priv->parts[0] = image;
+
+	buffer->priv->parts[1].data_offset = image.size;
+	buffer->priv->parts[1].size = depth_size;
+	buffer->priv->parts[1].component_id = 1;
+	buffer->priv->parts[1].data_type = ARV_BUFFER_PART_DATA_TYPE_3D_IMAGE;
+	buffer->priv->parts[1].pixel_format = ARV_PIXEL_FORMAT_COORD3D_C_16;
+	buffer->priv->parts[1].width = image.width;
+	buffer->priv->parts[1].height = image.height;
+	buffer->priv->parts[1].x_offset = image.x_offset;
+	buffer->priv->parts[1].y_offset = image.y_offset;
+
+	if (chunk_size > 0) {
+		buffer->priv->parts[2].data_offset = image.size + depth_size;
+		buffer->priv->parts[2].size = chunk_size;
+		buffer->priv->parts[2].component_id = 2;
+		buffer->priv->parts[2].data_type = ARV_BUFFER_PART_DATA_TYPE_CHUNK_DATA;
+	}
+
+	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_MULTIPART;
+	buffer->priv->received_size = image.size + depth_size + chunk_size;
+}
+
+/* Computes the packet layout of a freshly filled frame */
+
+static void
+_prepare_frame (ArvGvFakeCameraFrame *frame)
+{
+	ArvBuffer *buffer = frame->buffer;
+	size_t block_size;
+	guint i;
+
+	frame->payload = buffer->priv->received_size;
+	frame->is_multipart = buffer->priv->payload_type == ARV_BUFFER_PAYLOAD_TYPE_MULTIPART;
+
+	if (frame->is_multipart) {
+		block_size = frame->packet_size - ARV_GVSP_MULTIPART_PACKET_PROTOCOL_OVERHEAD (TRUE);
+
+		/* Each part starts in a new packet */
+		frame->part_first_block[0] = 1;
+		for (i = 0; i < buffer->priv->n_parts; i++)
+			frame->part_first_block[i + 1] = frame->part_first_block[i] +
+				(buffer->priv->parts[i].size + block_size - 1) / block_size;
+
+		frame->n_packets = frame->part_first_block[buffer->priv->n_parts] + 1;
+	} else {
+		block_size = frame->packet_size - ARV_GVSP_PACKET_PROTOCOL_OVERHEAD (FALSE);
+		frame->n_packets = 2 + (frame->payload + block_size - 1) / block_size;
+	}
+}
+
+/* Multipart frames always use extended ids, as the part count is stored in the leader packet infos */
+
+static gboolean
+_build_multipart_packet (ArvGvFakeCameraFrame *frame, guint32 block_id,
+			 void *header, size_t *header_size, const void **data, size_t *data_size)
+{
+	ArvBuffer *buffer = frame->buffer;
+	size_t block_size;
+	ptrdiff_t part_offset;
+	guint part_id;
+	guint i;
+
+	if (block_id == 0) {
+		ArvGvspPacket *packet;
+
+		packet = arv_gvsp_packet_new_multipart_leader (buffer->priv->frame_id, block_id,
+							       arv_buffer_get_timestamp (buffer),
+							       buffer->priv->n_parts, buffer->priv->has_chunks,
+							       header, header_size);
+		if (packet == NULL)
+			return FALSE;
+
+		for (i = 0; i < buffer->priv->n_parts; i++) {
+			ArvBufferPartInfos *part = &buffer->priv->parts[i];
+
+			arv_gvsp_multipart_leader_packet_set_part_infos (packet, i, part->component_id,
+									 part->data_type, part->size,
+									 part->pixel_format,
+									 part->width, part->height,
+									 part->x_offset, part->y_offset,
+									 part->x_padding, part->y_padding);
+		}
+
+		return TRUE;
+	}
+
+	if (block_id == frame->n_packets - 1)
+		return arv_gvsp_packet_new_multipart_trailer (buffer->priv->frame_id, block_id,
+							      buffer->priv->has_chunks,
+							      header, header_size) != NULL;
+
+	for (part_id = 0; block_id >= frame->part_first_block[part_id + 1]; part_id++);
+
+	block_size = frame->packet_size - ARV_GVSP_MULTIPART_PACKET_PROTOCOL_OVERHEAD (TRUE);
+	part_offset = (block_id - frame->part_first_block[part_id]) * block_size;
+
+	*data = ((char *) buffer->priv->data) + buffer->priv->parts[part_id].data_offset + part_offset;
+	*data_size = MIN (block_size, buffer->priv->parts[part_id].size - part_offset);
+
+	return arv_gvsp_packet_new_multipart_header (buffer->priv->frame_id, block_id, part_id,
+						     buffer->priv->parts[part_id].data_offset + part_offset,
+						     header, header_size) != NULL;
+}
+
+/* Builds the header of packet @block_id of @frame, and returns the location of its data in the image buffer */
+
+static gboolean
+_build_packet (ArvGvFakeCameraFrame *frame, guint32 block_id,
+	       void *header, size_t *header_size, const void **data, size_t *data_size)
+{
+	ArvBuffer *buffer = frame->buffer;
+	size_t data_size_max;
+	ptrdiff_t offset;
+
+	*data = NULL;
+	*data_size = 0;
+
+	if (block_id >= frame->n_packets)
+		return FALSE;
+
+	if (frame->is_multipart)
+		return _build_multipart_packet (frame, block_id, header, header_size, data, data_size);
+
+	if (block_id == 0)
+		return arv_gvsp_packet_new_image_leader (buffer->priv->frame_id,
+							 block_id,
+							 arv_buffer_get_timestamp (buffer),
+							 arv_buffer_get_image_pixel_format (buffer),
+							 arv_buffer_get_image_width (buffer),
+							 arv_buffer_get_image_height (buffer),
+							 arv_buffer_get_image_x (buffer),
+							 arv_buffer_get_image_y (buffer),
+							 0, 0,
+							 buffer->priv->has_chunks,
+							 header, header_size) != NULL;
+
+	if (block_id == frame->n_packets - 1)
+		return arv_gvsp_packet_new_data_trailer (buffer->priv->frame_id, block_id,
+							 buffer->priv->has_chunks,
+							 header, header_size) != NULL;
+
+	data_size_max = frame->packet_size - ARV_GVSP_PACKET_PROTOCOL_OVERHEAD (FALSE);
+	offset = (block_id - 1) * data_size_max;
+
+	*data = ((char *) buffer->priv->data) + offset;
+	*data_size = MIN (data_size_max, frame->payload - offset);
+
+	return arv_gvsp_packet_new_payload_header (buffer->priv->frame_id, block_id,
+						   header, header_size) != NULL;
+}
+
+static void
+_send_frame (ArvGvFakeCamera *gv_fake_camera, ArvGvFakeCameraChannel *channel, ArvGvFakeCameraFrame *frame)
+{
+	ArvGvFakeCameraSender *sender = channel->sender;
+	ArvGvFakeCameraFaults *faults = &gv_fake_camera->priv->faults;
+	double lost_ratio = gv_fake_camera->priv->gvsp_lost_packet_ratio;
+	guint64 trailer_delay_us;
+	guint64 n_packets;
+	guint64 n_bytes;
+	guint32 block_id;
+
+	sender->packet_delay_ns = _get_packet_delay_ns (gv_fake_camera->priv->camera, channel->index);
+	sender->bandwidth = gv_fake_camera->priv->gvsp_bandwidth;
+
+	n_packets = sender->n_packets;
+	n_bytes = sender->n_bytes;
+
+	g_mutex_lock (&gv_fake_camera->priv->faults_mutex);
+	trailer_delay_us = faults->trailer_delay_us;
+	g_mutex_unlock (&gv_fake_camera->priv->faults_mutex);
+
+	/* Only the fault draws are serialized, the channels pace and send their packets concurrently */
+	for (block_id = 0; block_id < frame->n_packets; block_id++) {
+		ArvGvFakeCameraPacketFaults packet_faults;
+		const void *data;
+		size_t data_size;
+		size_t header_size;
+		void *header;
+
+		if (block_id == frame->n_packets - 1 && trailer_delay_us > 0) {
+			_sender_flush (sender);
+			g_usleep (trailer_delay_us);
+		}
+
+		header = _sender_get_header (sender, &header_size);
+		if (!_build_packet (frame, block_id, header, &header_size, &data, &data_size))
+			continue;
+
+		g_mutex_lock (&gv_fake_camera->priv->faults_mutex);
+		_faults_draw (faults, lost_ratio, block_id > 0 && block_id < frame->n_packets - 1,
+			      sender->n_held < ARV_GV_FAKE_CAMERA_N_HELD_PACKETS, &packet_faults);
+		g_mutex_unlock (&gv_fake_camera->priv->faults_mutex);
+
+		_emit_packet (sender, &packet_faults, header_size, data, data_size);
+	}
+
+	_sender_release_held (sender, TRUE);
+
+	_sender_flush (sender);
+
+	g_mutex_lock (&gv_fake_camera->priv->statistics_mutex);
+	gv_fake_camera->priv->n_sent_frames++;
+	gv_fake_camera->priv->n_sent_packets += sender->n_packets - n_packets;
+	gv_fake_camera->priv->n_sent_bytes += sender->n_bytes - n_bytes;
+	gv_fake_camera->priv->stream_last_time_us = g_get_monotonic_time ();
+	g_mutex_unlock (&gv_fake_camera->priv->statistics_mutex);
+}
+
+static void
+_resend_packets (ArvGvFakeCameraChannel *channel, guint64 frame_id, guint32 first_block, guint32 last_block)
+{
+	ArvGvFakeCamera *gv_fake_camera = channel->gv_fake_camera;
+	ArvGvFakeCameraSender *sender = channel->sender;
+	ArvGvFakeCameraFrame *frame = NULL;
+	guint64 n_packets;
+	guint32 block_id;
+	size_t header_size;
+	void *header;
+	guint i;
+
+	if (sender == NULL || channel->history == NULL)
+		return;
+
+	for (i = 0; i < channel->n_history_frames && frame == NULL; i++) {
+		ArvGvFakeCameraFrame *candidate = &channel->history[i];
+
+		if (candidate->buffer != NULL && candidate->n_packets > 0 &&
+		    (guint16) candidate->buffer->priv->frame_id == (guint16) frame_id)
+			frame = candidate;
+	}
+
+	if (frame == NULL || first_block >= frame->n_packets) {
+		arv_info_stream_thread ("[GvFakeCamera::resend_packets] Packet %u of frame %" G_GUINT64_FORMAT
+					" unavailable on channel %u", first_block, frame_id, channel->index);
+
+		header = _sender_get_header (sender, &header_size);
+		arv_gvsp_packet_new_payload_header (frame_id, first_block, header, &header_size);
+		((ArvGvspPacket *) header)->packet_type = g_htons (ARV_GVSP_PACKET_TYPE_PACKET_UNAVAILABLE);
+		_sender_push (sender, header, header_size, NULL, 0);
+		_sender_flush (sender);
+
+		g_mutex_lock (&gv_fake_camera->priv->statistics_mutex);
+		gv_fake_camera->priv->n_unavailable_packets++;
+		g_mutex_unlock (&gv_fake_camera->priv->statistics_mutex);
+		return;
+	}
+
+	last_block = MIN (last_block, frame->n_packets - 1);
+	n_packets = sender->n_packets;
+
+	for (block_id = first_block; block_id <= last_block; block_id++) {
+		const void *data;
+		size_t data_size;
+
+		header = _sender_get_header (sender, &header_size);
+		if (_build_packet (frame, block_id, header, &header_size, &data, &data_size))
+			_sender_push (sender, header, header_size, data, data_size);
+	}
+
+	_sender_flush (sender);
+
+	g_mutex_lock (&gv_fake_camera->priv->statistics_mutex);
+	gv_fake_camera->priv->n_resent_packets += sender->n_packets - n_packets;
+	g_mutex_unlock (&gv_fake_camera->priv->statistics_mutex);
+}
+
+/* Packets missed by a receiver of a multicast stream are unicast to it, instead of being sent again to the whole
+ * group */
+
+static void
+_serve_resend_request (ArvGvFakeCameraChannel *channel, ArvGvFakeCameraResendRequest *request)
+{
+	ArvGvFakeCameraSender *sender = channel->sender;
+	GSocketAddress *stream_address;
+
+	if (sender == NULL)
+		return;
+
+	stream_address = sender->address;
+	if (request->requester_address != NULL &&
+	    g_inet_address_get_is_multicast (g_inet_socket_address_get_address
+					     (G_INET_SOCKET_ADDRESS (stream_address))))
+		sender->address = request->requester_address;
+
+	_resend_packets (channel, request->frame_id, request->first_block, request->last_block);
+
+	sender->address = stream_address;
+}
+
 static gboolean
 _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 			GSocketAddress *remote_address,
@@ -211,6 +1088,37 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 			ack_packet = arv_gvcp_packet_new_write_register_ack (1, packet_id,
 									     &ack_packet_size);
 			break;
+		case ARV_GVCP_COMMAND_PACKET_RESEND_CMD:
+			{
+				ArvGvFakeCameraResendRequest *request;
+				guint16 stream_channel;
+				guint64 frame_id;
+				guint32 first_block, last_block;
+
+				arv_gvcp_packet_get_packet_resend_cmd_infos (packet, &stream_channel, &frame_id,
+									     &first_block, &last_block, NULL);
+				arv_info_device ("[GvFakeCamera::handle_control_packet] Packet resend command"
+						 " channel %u frame %" G_GUINT64_FORMAT " (%u to %u)",
+						 stream_channel, frame_id, first_block, last_block);
+
+				if (stream_channel < gv_fake_camera->priv->n_stream_channels &&
+				    gv_fake_camera->priv->channels[stream_channel].resend_requests != NULL) {
+					/* Served by the stream channel thread, which owns the frame history */
+					request = g_new (ArvGvFakeCameraResendRequest, 1);
+					request->frame_id = frame_id;
+					request->first_block = first_block;
+					request->last_block = last_block;
+					request->requester_address = g_object_ref (remote_address);
+					g_async_queue_push (gv_fake_camera->priv->channels[stream_channel].resend_requests,
+							    request);
+				} else
+					arv_warning_device ("[GvFakeCamera::handle_control_packet] Invalid stream channel %u",
+							    stream_channel);
+
+				/* Resend requests are not acknowledged */
+				success = TRUE;
+			}
+			break;
 		default:
 			arv_warning_device ("[GvFakeCamera::handle_control_packet] Unknown command");
 	}
@@ -241,198 +1149,272 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 	return success;
 }
 
-static void *
-_thread (void *user_data)
+static void
+_reset_statistics (ArvGvFakeCamera *gv_fake_camera)
 {
-	ArvGvFakeCamera *gv_fake_camera = user_data;
-	ArvBuffer *image_buffer = NULL;
-	GError *error = NULL;
-	GSocketAddress *stream_address = NULL;
-	void *packet_buffer;
-	size_t packet_size;
-	size_t payload = 0;
-	guint16 block_id;
-	ptrdiff_t offset;
-	guint32 gv_packet_size;
-	GInputVector input_vector;
-	int n_events;
-	gboolean is_streaming = FALSE;
+	g_mutex_lock (&gv_fake_camera->priv->statistics_mutex);
+	gv_fake_camera->priv->n_sent_frames = 0;
+	gv_fake_camera->priv->n_sent_packets = 0;
+	gv_fake_camera->priv->n_sent_bytes = 0;
+	gv_fake_camera->priv->n_resent_packets = 0;
+	gv_fake_camera->priv->n_unavailable_packets = 0;
+	gv_fake_camera->priv->stream_start_time_us = g_get_monotonic_time ();
+	gv_fake_camera->priv->stream_last_time_us = gv_fake_camera->priv->stream_start_time_us;
+	g_mutex_unlock (&gv_fake_camera->priv->statistics_mutex);
+
+	g_mutex_lock (&gv_fake_camera->priv->faults_mutex);
+	g_rand_set_seed (gv_fake_camera->priv->faults.rand, gv_fake_camera->priv->faults.seed);
+	gv_fake_camera->priv->faults.burst_remaining = 0;
+	gv_fake_camera->priv->faults.n_dropped = 0;
+	gv_fake_camera->priv->faults.n_reordered = 0;
+	gv_fake_camera->priv->faults.n_duplicated = 0;
+	gv_fake_camera->priv->faults.n_errors = 0;
+	g_mutex_unlock (&gv_fake_camera->priv->faults_mutex);
+}
 
-	input_vector.buffer = g_malloc0 (ARV_GV_FAKE_CAMERA_BUFFER_SIZE);
-	input_vector.size = ARV_GV_FAKE_CAMERA_BUFFER_SIZE;
+static void
+_start_stream (ArvGvFakeCameraChannel *channel, GSocketAddress *stream_address)
+{
+	ArvGvFakeCameraPrivate *priv = channel->gv_fake_camera->priv;
+	gboolean is_first;
 
-	packet_buffer = g_malloc (ARV_GV_FAKE_CAMERA_BUFFER_SIZE);
+	channel->sender = g_new0 (ArvGvFakeCameraSender, 1);
+	_sender_init (channel->sender, channel->socket, stream_address);
 
-	do {
-		guint64 next_timestamp_us;
+	channel->n_history_frames = priv->gvsp_history_size;
+	channel->history = g_new0 (ArvGvFakeCameraFrame, channel->n_history_frames);
+	channel->history_index = 0;
 
-		if (is_streaming) {
-			arv_fake_camera_get_sleep_time_for_next_frame (gv_fake_camera->priv->camera, &next_timestamp_us);
-		} else {
-			next_timestamp_us = g_get_real_time () + 100000;
-		}
+	/* Statistics cover all the stream channels */
+	g_mutex_lock (&priv->statistics_mutex);
+	is_first = priv->n_streaming_channels++ == 0;
+	g_mutex_unlock (&priv->statistics_mutex);
 
-		do {
-			gint timeout_ms;
+	if (is_first)
+		_reset_statistics (channel->gv_fake_camera);
+}
 
-			timeout_ms =  (next_timestamp_us - g_get_real_time ()) / 1000LL;
-			if (timeout_ms < 0)
-				timeout_ms = 0;
-			else if (timeout_ms > 100)
-				timeout_ms = 100;
+static void
+_stop_stream (ArvGvFakeCameraChannel *channel)
+{
+	ArvGvFakeCamera *gv_fake_camera = channel->gv_fake_camera;
+	ArvGvFakeCameraPrivate *priv = gv_fake_camera->priv;
+	ArvGvFakeCameraResendRequest *request;
+	guint64 n_frames, n_bytes;
+	double throughput;
+	gboolean is_last;
+	guint i;
+
+	for (i = 0; i < channel->n_history_frames; i++)
+		g_clear_object (&channel->history[i].buffer);
+	g_clear_pointer (&channel->history, g_free);
+	g_clear_pointer (&channel->sender, g_free);
+	channel->n_history_frames = 0;
+
+	while ((request = g_async_queue_try_pop (channel->resend_requests)) != NULL)
+		_resend_request_free (request);
+
+	g_mutex_lock (&priv->statistics_mutex);
+	is_last = --priv->n_streaming_channels == 0;
+	g_mutex_unlock (&priv->statistics_mutex);
+
+	arv_info_stream_thread ("[GvFakeCamera::stream_thread] Stop stream on channel %u", channel->index);
+
+	if (!is_last)
+		return;
+
+	arv_gv_fake_camera_get_stream_statistics (gv_fake_camera, &n_frames, NULL, &n_bytes, &throughput);
+	arv_info_stream_thread ("[GvFakeCamera::stream_thread] Stream statistics "
+				"(%" G_GUINT64_FORMAT " frames, %" G_GUINT64_FORMAT " bytes, %.3f Gbit/s)",
+				n_frames, n_bytes, throughput / 1e9);
+	arv_info_stream_thread ("[GvFakeCamera::stream_thread] Resent packets: %" G_GUINT64_FORMAT
+				", unavailable: %" G_GUINT64_FORMAT,
+				priv->n_resent_packets, priv->n_unavailable_packets);
+	arv_info_stream_thread ("[GvFakeCamera::stream_thread] Faults: dropped %" G_GUINT64_FORMAT
+				", reordered %" G_GUINT64_FORMAT
+				", duplicated %" G_GUINT64_FORMAT
+				", errors %" G_GUINT64_FORMAT,
+				priv->faults.n_dropped, priv->faults.n_reordered,
+				priv->faults.n_duplicated, priv->faults.n_errors);
+}
 
-			n_events = g_poll (gv_fake_camera->priv->socket_fds, gv_fake_camera->priv->n_socket_fds, timeout_ms);
-			if (n_events > 0) {
-				unsigned int i;
+/* Waits until @time_us, while serving the resend requests. Returns early if the streaming state of the channel
+ * changes. */
 
-				for (i = 0; i < ARV_GV_FAKE_CAMERA_N_INPUT_SOCKETS; i++) {
-					GSocket *socket = gv_fake_camera->priv->input_sockets[i];
-					int count;
+static void
+_channel_wait (ArvGvFakeCameraChannel *channel, gint64 time_us, gboolean is_streaming)
+{
+	ArvGvFakeCamera *gv_fake_camera = channel->gv_fake_camera;
 
-					if (G_IS_SOCKET (socket)) {
-						GSocketAddress *remote_address = NULL;
+	while (!g_atomic_int_get (&gv_fake_camera->priv->cancel)) {
+		ArvGvFakeCameraResendRequest *request;
+		gint64 remaining_us;
 
-						arv_gpollfd_clear_one (&gv_fake_camera->priv->socket_fds[i], socket);
+		remaining_us = time_us - g_get_real_time ();
+		if (remaining_us <= 0)
+			return;
 
-						count = g_socket_receive_message (socket, &remote_address, &input_vector, 1, NULL, NULL,
-										  NULL, NULL, NULL);
-						if (count > 0) {
-							if (_handle_control_packet (gv_fake_camera, socket,
-										    remote_address, input_vector.buffer, count))
-								arv_info_device ("[GvFakeCamera::thread] Control packet received");
-						}
-						g_clear_object (&remote_address);
-					}
-				}
+		request = g_async_queue_timeout_pop (channel->resend_requests,
+						     MIN (remaining_us, ARV_GV_FAKE_CAMERA_WAIT_SLICE_US));
+		if (request != NULL) {
+			_serve_resend_request (channel, request);
+			_resend_request_free (request);
+		}
 
-				if (arv_fake_camera_get_control_channel_privilege (gv_fake_camera->priv->camera) == 0 ||
-				    arv_fake_camera_get_acquisition_status (gv_fake_camera->priv->camera) == 0) {
-					if (stream_address != NULL) {
-						g_object_unref (stream_address);
-						stream_address = NULL;
-						g_object_unref (image_buffer);
-						image_buffer = NULL;
-						arv_info_stream_thread ("[GvFakeCamera::thread] Stop stream");
-					}
-					is_streaming = FALSE;
-				}
-			}
-		} while (!g_atomic_int_get (&gv_fake_camera->priv->cancel) && g_get_real_time () < next_timestamp_us);
-
-		if (arv_fake_camera_get_control_channel_privilege (gv_fake_camera->priv->camera) != 0 &&
-		    arv_fake_camera_get_acquisition_status (gv_fake_camera->priv->camera) != 0) {
-			if (stream_address == NULL) {
-				GInetAddress *inet_address;
-				char *inet_address_string;
-
-				stream_address = arv_fake_camera_get_stream_address (gv_fake_camera->priv->camera);
-				inet_address = g_inet_socket_address_get_address
-					(G_INET_SOCKET_ADDRESS (stream_address));
-				inet_address_string = g_inet_address_to_string (inet_address);
-				arv_info_stream_thread ("[GvFakeCamera::thread] Start stream to %s (%d)",
-							 inet_address_string,
-							 g_inet_socket_address_get_port
-							 (G_INET_SOCKET_ADDRESS (stream_address)));
-				g_free (inet_address_string);
-
-				payload = arv_fake_camera_get_payload (gv_fake_camera->priv->camera);
-				image_buffer = arv_buffer_new (payload, NULL);
-			}
+		if (_is_channel_streaming (gv_fake_camera, channel->index) != is_streaming)
+			return;
+	}
+}
 
-			if (arv_fake_camera_is_in_free_running_mode (gv_fake_camera->priv->camera) ||
-			    (arv_fake_camera_is_in_software_trigger_mode (gv_fake_camera->priv->camera) &&
-			     arv_fake_camera_check_and_acknowledge_software_trigger (gv_fake_camera->priv->camera))) {
-				arv_fake_camera_fill_buffer (gv_fake_camera->priv->camera, image_buffer, &gv_packet_size);
-
-				arv_info_stream_thread ("[GvFakeCamera::thread] Send frame %" G_GUINT64_FORMAT, image_buffer->priv->frame_id);
-
-				block_id = 0;
-
-				packet_size = ARV_GV_FAKE_CAMERA_BUFFER_SIZE;
-                                arv_gvsp_packet_new_image_leader (image_buffer->priv->frame_id,
-                                                                  block_id,
-                                                                  arv_buffer_get_timestamp(image_buffer),
-                                                                  arv_buffer_get_image_pixel_format(image_buffer),
-                                                                  arv_buffer_get_image_width(image_buffer),
-                                                                  arv_buffer_get_image_height(image_buffer),
-                                                                  arv_buffer_get_image_x(image_buffer),
-                                                                  arv_buffer_get_image_y(image_buffer),
-                                                                  0, 0,
-                                                                  packet_buffer, &packet_size);
-
-				if (g_random_double () >= gv_fake_camera->priv->gvsp_lost_packet_ratio)
-					g_socket_send_to (gv_fake_camera->priv->gvsp_socket, stream_address,
-							packet_buffer, packet_size, NULL, &error);
-				else
-					arv_info_stream_thread ("Drop GVSP leader packet frame: %" G_GUINT64_FORMAT, image_buffer->priv->frame_id);
-
-				if (error != NULL) {
-					arv_warning_stream_thread ("[GvFakeCamera::thread] Failed to send leader for frame %" G_GUINT64_FORMAT
-								": %s", image_buffer->priv->frame_id, error->message);
-					g_clear_error (&error);
-				}
+static void
+_acquire_and_send_frame (ArvGvFakeCameraChannel *channel)
+{
+	ArvGvFakeCamera *gv_fake_camera = channel->gv_fake_camera;
+	ArvFakeCamera *camera = gv_fake_camera->priv->camera;
+	ArvGvFakeCameraFrame *frame;
+	gboolean is_multipart;
+	size_t payload;
+
+	is_multipart = (_read_channel_register (camera, channel->index,
+						ARV_GVBS_STREAM_CHANNEL_0_CONFIGURATION_OFFSET) &
+			ARV_GVBS_STREAM_CHANNEL_0_MULTIPART) != 0;
+
+	payload = arv_fake_camera_get_payload (camera);
+	if (is_multipart) {
+		guint32 width = 0;
+		guint32 height = 0;
+
+		arv_fake_camera_read_register (camera, ARV_FAKE_CAMERA_REGISTER_WIDTH, &width);
+		arv_fake_camera_read_register (camera, ARV_FAKE_CAMERA_REGISTER_HEIGHT, &height);
+		payload += (size_t) width * height * 2;
+	}
 
-				block_id++;
+	channel->history_index = (channel->history_index + 1) % channel->n_history_frames;
+	frame = &channel->history[channel->history_index];
+	if (frame->buffer != NULL && frame->buffer->priv->allocated_size < payload)
+		g_clear_object (&frame->buffer);
+	if (frame->buffer == NULL)
+		frame->buffer = arv_buffer_new (payload, NULL);
+	frame->n_packets = 0;
 
-				offset = 0;
-				while (offset < payload) {
-					size_t data_size;
+	arv_fake_camera_fill_buffer_with_frame_counter (camera, frame->buffer, &channel->frame_id, NULL);
+	if (frame->buffer->priv->status != ARV_BUFFER_STATUS_SUCCESS)
+		return;
 
-					data_size = MIN (gv_packet_size - ARV_GVSP_PACKET_PROTOCOL_OVERHEAD (FALSE),
-							payload - offset);
+	if (is_multipart)
+		_set_multipart_payload (frame->buffer);
 
-					packet_size = ARV_GV_FAKE_CAMERA_BUFFER_SIZE;
-                                        arv_gvsp_packet_new_payload (image_buffer->priv->frame_id, block_id,
-                                                                     data_size, ((char *) image_buffer->priv->data) + offset,
-                                                                     packet_buffer, &packet_size);
+	frame->packet_size = (_read_channel_register (camera, channel->index,
+						      ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_OFFSET) >>
+			      ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_POS) &
+		ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_MASK;
 
-					if (g_random_double () >= gv_fake_camera->priv->gvsp_lost_packet_ratio)
-						g_socket_send_to (gv_fake_camera->priv->gvsp_socket, stream_address,
-								packet_buffer, packet_size, NULL, &error);
-					else
-						arv_info_stream_thread ("Drop GVSP data packet frame:%" G_GUINT64_FORMAT
-									", block:%u", image_buffer->priv->frame_id, block_id);
+	_prepare_frame (frame);
 
-					if (error != NULL) {
-						arv_info_stream_thread ("[GvFakeCamera::thread] Failed to send frame block %d for frame"
-									" %" G_GUINT64_FORMAT ": %s",
-									block_id, image_buffer->priv->frame_id, error->message);
-						g_clear_error (&error);
-					}
+	arv_info_stream_thread ("[GvFakeCamera::stream_thread] Send frame %" G_GUINT64_FORMAT " on channel %u",
+				frame->buffer->priv->frame_id, channel->index);
 
-					offset += data_size;
-					block_id++;
-				}
+	_send_frame (gv_fake_camera, channel, frame);
+}
 
-				packet_size = ARV_GV_FAKE_CAMERA_BUFFER_SIZE;
-				arv_gvsp_packet_new_data_trailer (image_buffer->priv->frame_id, block_id,
-								packet_buffer, &packet_size);
-
-				if (g_random_double () >= gv_fake_camera->priv->gvsp_lost_packet_ratio)
-					g_socket_send_to (gv_fake_camera->priv->gvsp_socket, stream_address,
-							packet_buffer, packet_size, NULL, &error);
-				else
-					arv_info_stream_thread ("Drop GVSP trailer packet frame: %" G_GUINT64_FORMAT,
-								image_buffer->priv->frame_id);
-
-				if (error != NULL) {
-					arv_info_stream_thread ("[GvFakeCamera::thread] Failed to send trailer for frame %" G_GUINT64_FORMAT
-								": %s", image_buffer->priv->frame_id, error->message);
-					g_clear_error (&error);
-				}
+static void *
+_stream_thread (void *user_data)
+{
+	ArvGvFakeCameraChannel *channel = user_data;
+	ArvGvFakeCamera *gv_fake_camera = channel->gv_fake_camera;
+	ArvFakeCamera *camera = gv_fake_camera->priv->camera;
+	GSocketAddress *stream_address = NULL;
+
+	while (!g_atomic_int_get (&gv_fake_camera->priv->cancel)) {
+		guint64 next_timestamp_us;
 
-				is_streaming = TRUE;
+		if (!_is_channel_streaming (gv_fake_camera, channel->index)) {
+			if (stream_address != NULL) {
+				_stop_stream (channel);
+				g_clear_object (&stream_address);
 			}
+
+			_channel_wait (channel, g_get_real_time () + ARV_GV_FAKE_CAMERA_IDLE_PERIOD_US, FALSE);
+			continue;
 		}
 
-	} while (!g_atomic_int_get (&gv_fake_camera->priv->cancel));
+		if (stream_address == NULL) {
+			GInetAddress *inet_address;
+			char *inet_address_string;
+
+			stream_address = _get_stream_address (camera, channel->index);
+			inet_address = g_inet_socket_address_get_address (G_INET_SOCKET_ADDRESS (stream_address));
+			inet_address_string = g_inet_address_to_string (inet_address);
+			arv_info_stream_thread ("[GvFakeCamera::stream_thread] Start stream on channel %u to %s (%d)",
+						channel->index, inet_address_string,
+						g_inet_socket_address_get_port (G_INET_SOCKET_ADDRESS (stream_address)));
+			g_free (inet_address_string);
+
+			_start_stream (channel, stream_address);
+		}
+
+		arv_fake_camera_get_sleep_time_for_next_frame (camera, &next_timestamp_us);
+		_channel_wait (channel, next_timestamp_us, TRUE);
+
+		if (g_atomic_int_get (&gv_fake_camera->priv->cancel) ||
+		    !_is_channel_streaming (gv_fake_camera, channel->index))
+			continue;
+
+		/* Software triggers are acknowledged by the first stream channel only */
+		if (arv_fake_camera_is_in_free_running_mode (camera) ||
+		    (channel->index == 0 &&
+		     arv_fake_camera_is_in_software_trigger_mode (camera) &&
+		     arv_fake_camera_check_and_acknowledge_software_trigger (camera)))
+			_acquire_and_send_frame (channel);
+	}
 
-	if (stream_address != NULL)
+	if (stream_address != NULL) {
+		_stop_stream (channel);
 		g_object_unref (stream_address);
-	if (image_buffer != NULL)
-		g_object_unref (image_buffer);
+	}
+
+	return NULL;
+}
+
+/* Control thread, only handling the GVCP requests. The streams are emitted by the stream channel threads. */
+
+static void *
+_thread (void *user_data)
+{
+	ArvGvFakeCamera *gv_fake_camera = user_data;
+	GInputVector input_vector;
+	int n_events;
+
+	input_vector.buffer = g_malloc0 (ARV_GV_FAKE_CAMERA_BUFFER_SIZE);
+	input_vector.size = ARV_GV_FAKE_CAMERA_BUFFER_SIZE;
+
+	do {
+		n_events = g_poll (gv_fake_camera->priv->socket_fds, gv_fake_camera->priv->n_socket_fds, 100);
+		if (n_events > 0) {
+			unsigned int i;
+
+			for (i = 0; i < ARV_GV_FAKE_CAMERA_N_INPUT_SOCKETS; i++) {
+				GSocket *socket = gv_fake_camera->priv->input_sockets[i];
+				int count;
+
+				if (G_IS_SOCKET (socket)) {
+					GSocketAddress *remote_address = NULL;
+
+					arv_gpollfd_clear_one (&gv_fake_camera->priv->socket_fds[i], socket);
+
+					count = g_socket_receive_message (socket, &remote_address, &input_vector, 1, NULL, NULL,
+									  NULL, NULL, NULL);
+					if (count > 0) {
+						if (_handle_control_packet (gv_fake_camera, socket,
+									    remote_address, input_vector.buffer, count))
+							arv_info_device ("[GvFakeCamera::thread] Control packet received");
+					}
+					g_clear_object (&remote_address);
+				}
+			}
+		}
+	} while (!g_atomic_int_get (&gv_fake_camera->priv->cancel));
 
-	g_free (packet_buffer);
 	g_free (input_vector.buffer);
 
 	return NULL;
@@ -512,8 +1494,31 @@ arv_gv_fake_camera_start (ArvGvFakeCamera *gv_fake_camera)
 	gvcp_inet_address = g_object_ref (g_inet_socket_address_get_address (G_INET_SOCKET_ADDRESS (socket_address)));
 	arv_fake_camera_set_inet_address (gv_fake_camera->priv->camera, gvcp_inet_address);
 
-	_create_and_bind_input_socket (&gv_fake_camera->priv->gvsp_socket,
-								 "GVSP", gvcp_inet_address, 0, FALSE, TRUE);
+	for (i = 0; i < gv_fake_camera->priv->n_stream_channels; i++) {
+		ArvGvFakeCameraChannel *channel = &gv_fake_camera->priv->channels[i];
+		GSocketAddress *local_address;
+
+		channel->gv_fake_camera = gv_fake_camera;
+		channel->index = i;
+		channel->resend_requests = g_async_queue_new_full ((GDestroyNotify) _resend_request_free);
+
+		if (_create_and_bind_input_socket (&channel->socket, "GVSP", gvcp_inet_address, 0, FALSE, TRUE)) {
+			/* For multicast stream destinations */
+			if (!arv_socket_set_multicast_interface (channel->socket, gvcp_inet_address))
+				arv_warning_device ("[GvFakeCamera::start] Failed to set multicast interface of "
+						    "stream channel %u", i);
+
+			local_address = g_socket_get_local_address (channel->socket, NULL);
+			if (G_IS_INET_SOCKET_ADDRESS (local_address))
+				arv_fake_camera_write_register (gv_fake_camera->priv->camera,
+								ARV_GVBS_STREAM_CHANNEL_0_SOURCE_PORT_OFFSET +
+								i * ARV_GVBS_STREAM_CHANNEL_SIZE,
+								g_inet_socket_address_get_port
+								(G_INET_SOCKET_ADDRESS (local_address)));
+			g_clear_object (&local_address);
+		}
+	}
+
 	_create_and_bind_input_socket
 		(&gv_fake_camera->priv->input_sockets[ARV_GV_FAKE_CAMERA_INPUT_SOCKET_GVCP],
 		 "GVCP", gvcp_inet_address, ARV_GVCP_PORT, FALSE, FALSE);
@@ -561,6 +1566,13 @@ arv_gv_fake_camera_start (ArvGvFakeCamera *gv_fake_camera)
 	gv_fake_camera->priv->cancel = FALSE;
 	gv_fake_camera->priv->thread = g_thread_new ("arv_fake_gv_fake_camera", _thread, gv_fake_camera);
 
+	for (i = 0; i < gv_fake_camera->priv->n_stream_channels; i++) {
+		ArvGvFakeCameraChannel *channel = &gv_fake_camera->priv->channels[i];
+
+		if (G_IS_SOCKET (channel->socket))
+			channel->thread = g_thread_new ("arv_gv_fake_camera_stream", _stream_thread, channel);
+	}
+
 	return TRUE;
 }
 
@@ -579,12 +1591,23 @@ arv_gv_fake_camera_stop (ArvGvFakeCamera *gv_fake_camera)
 		gv_fake_camera->priv->thread = NULL;
 	}
 
+	for (i = 0; i < gv_fake_camera->priv->n_stream_channels; i++) {
+		ArvGvFakeCameraChannel *channel = &gv_fake_camera->priv->channels[i];
+
+		if (channel->thread != NULL) {
+			g_thread_join (channel->thread);
+			channel->thread = NULL;
+		}
+
+		g_clear_object (&channel->socket);
+		g_clear_pointer (&channel->resend_requests, g_async_queue_unref);
+	}
+
 	arv_gpollfd_finish_all (gv_fake_camera->priv->socket_fds, gv_fake_camera->priv->n_socket_fds);
 
 	for (i = 0; i < ARV_GV_FAKE_CAMERA_N_INPUT_SOCKETS; i++) {
 		g_clear_object (&gv_fake_camera->priv->input_sockets[i]);
 	}
-	g_clear_object (&gv_fake_camera->priv->gvsp_socket);
 
 	g_clear_object (&gv_fake_camera->priv->controller_address);
 }
@@ -650,6 +1673,22 @@ _set_property (GObject *object, guint prop_id, const GValue *value, GParamSpec *
 		case PROP_GVSP_LOST_PACKET_RATIO:
 			gv_fake_camera->priv->gvsp_lost_packet_ratio = g_value_get_double (value);
 			break;
+		case PROP_GVSP_BANDWIDTH:
+			gv_fake_camera->priv->gvsp_bandwidth = g_value_get_uint64 (value);
+			break;
+		case PROP_GVSP_FAULTS:
+			g_mutex_lock (&gv_fake_camera->priv->faults_mutex);
+			if (!_faults_parse (&gv_fake_camera->priv->faults, g_value_get_string (value)))
+				arv_warning_device ("[GvFakeCamera::set_property] Invalid fault description '%s'",
+						    g_value_get_string (value));
+			g_mutex_unlock (&gv_fake_camera->priv->faults_mutex);
+			break;
+		case PROP_GVSP_HISTORY_SIZE:
+			gv_fake_camera->priv->gvsp_history_size = g_value_get_uint (value);
+			break;
+		case PROP_GVSP_N_STREAM_CHANNELS:
+			gv_fake_camera->priv->n_stream_channels = g_value_get_uint (value);
+			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 			break;
@@ -675,6 +1714,45 @@ arv_gv_fake_camera_get_fake_camera (ArvGvFakeCamera *gv_fake_camera)
         return gv_fake_camera->priv->camera;
 }
 
+/**
+ * arv_gv_fake_camera_get_stream_statistics:
+ * @gv_fake_camera: a #ArvGvFakeCamera
+ * @n_frames: (out) (optional): number of frames sent since the stream start
+ * @n_packets: (out) (optional): number of GVSP packets sent since the stream start
+ * @n_bytes: (out) (optional): number of bytes sent since the stream start, UDP payload only
+ * @throughput: (out) (optional): achieved throughput, in bits per second
+ *
+ * Retrieves the emission statistics of the current, or last, stream. Packets dropped because of the lost packet
+ * ratio setting are not accounted.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_gv_fake_camera_get_stream_statistics (ArvGvFakeCamera *gv_fake_camera,
+					  guint64 *n_frames, guint64 *n_packets, guint64 *n_bytes,
+					  double *throughput)
+{
+	gint64 elapsed_us;
+
+	g_return_if_fail (ARV_IS_GV_FAKE_CAMERA (gv_fake_camera));
+
+	g_mutex_lock (&gv_fake_camera->priv->statistics_mutex);
+
+	if (n_frames != NULL)
+		*n_frames = gv_fake_camera->priv->n_sent_frames;
+	if (n_packets != NULL)
+		*n_packets = gv_fake_camera->priv->n_sent_packets;
+	if (n_bytes != NULL)
+		*n_bytes = gv_fake_camera->priv->n_sent_bytes;
+
+	elapsed_us = gv_fake_camera->priv->stream_last_time_us - gv_fake_camera->priv->stream_start_time_us;
+	if (throughput != NULL)
+		*throughput = elapsed_us > 0 ? (8.0 * gv_fake_camera->priv->n_sent_bytes * 1e6) / elapsed_us : 0.0;
+
+	g_mutex_unlock (&gv_fake_camera->priv->statistics_mutex);
+}
+
 /**
  * arv_gv_fake_camera_is_running:
  * @gv_fake_camera: a #ArvGvFakeCamera
@@ -696,16 +1774,37 @@ static void
 arv_gv_fake_camera_init (ArvGvFakeCamera *gv_fake_camera)
 {
 	gv_fake_camera->priv = arv_gv_fake_camera_get_instance_private (gv_fake_camera);
+
+	g_mutex_init (&gv_fake_camera->priv->statistics_mutex);
+	g_mutex_init (&gv_fake_camera->priv->faults_mutex);
+
+	_faults_init (&gv_fake_camera->priv->faults);
 }
 
 static void
 _constructed (GObject *gobject)
 {
 	ArvGvFakeCamera *gv_fake_camera = ARV_GV_FAKE_CAMERA (gobject);
+	ArvFakeCamera *camera;
+	guint i;
 
 	G_OBJECT_CLASS (arv_gv_fake_camera_parent_class)->constructed (gobject);
 
-	gv_fake_camera->priv->camera = arv_fake_camera_new_full (gv_fake_camera->priv->serial_number, gv_fake_camera->priv->genicam_filename);
+	camera = arv_fake_camera_new_full (gv_fake_camera->priv->serial_number, gv_fake_camera->priv->genicam_filename);
+	gv_fake_camera->priv->camera = camera;
+
+	arv_fake_camera_write_register (camera, ARV_GVBS_N_STREAM_CHANNELS_OFFSET,
+					gv_fake_camera->priv->n_stream_channels);
+	for (i = 0; i < gv_fake_camera->priv->n_stream_channels; i++) {
+		guint32 offset = i * ARV_GVBS_STREAM_CHANNEL_SIZE;
+
+		if (i > 0)
+			arv_fake_camera_write_register (camera, ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_OFFSET + offset,
+							ARV_GV_FAKE_CAMERA_PACKET_SIZE_DEFAULT);
+		arv_fake_camera_write_register (camera, ARV_GVBS_STREAM_CHANNEL_0_CAPABILITY_OFFSET + offset,
+						ARV_GVBS_STREAM_CHANNEL_0_MULTIPART);
+	}
+
 	gv_fake_camera->priv->is_running = arv_gv_fake_camera_start (gv_fake_camera);
 }
 
@@ -724,6 +1823,11 @@ _finalize (GObject *object)
 	g_clear_pointer (&gv_fake_camera->priv->serial_number, g_free);
 	g_clear_pointer (&gv_fake_camera->priv->genicam_filename, g_free);
 
+	_faults_clear (&gv_fake_camera->priv->faults);
+
+	g_mutex_clear (&gv_fake_camera->priv->statistics_mutex);
+	g_mutex_clear (&gv_fake_camera->priv->faults_mutex);
+
 	G_OBJECT_CLASS (arv_gv_fake_camera_parent_class)->finalize (object);
 }
 
@@ -772,4 +1876,68 @@ arv_gv_fake_camera_class_init (ArvGvFakeCameraClass *this_class)
 							      G_PARAM_WRITABLE | G_PARAM_CONSTRUCT |
 							      G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
 							      G_PARAM_STATIC_BLURB));
+	g_object_class_install_property (object_class,
+					 PROP_GVSP_BANDWIDTH,
+					 g_param_spec_uint64 ("gvsp-bandwidth",
+							      "GVSP bandwidth",
+							      "GVSP bandwidth limit per stream channel, in bits per second, "
+							      "0 for no limit",
+							      0, G_MAXUINT64, 0,
+							      G_PARAM_WRITABLE | G_PARAM_CONSTRUCT |
+							      G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
+							      G_PARAM_STATIC_BLURB));
+	/**
+	 * ArvGvFakeCamera:gvsp-faults:
+	 *
+	 * GVSP fault model, as a comma separated list of faults. Possible faults are: `loss=<ratio>` for uniform
+	 * packet loss, `burst=<ratio>[:<length>]` for loss of consecutive packets, `reorder=<ratio>[:<window>]`
+	 * for packets delayed by up to `<window>` packets, `duplicate=<ratio>` for duplicated packets,
+	 * `error=<ratio>` for payload packets replaced by error packets and `trailer-delay=<us>` for a delayed
+	 * trailer emission. `seed=<n>` sets the seed of the random generator, which makes the fault sequence
+	 * reproducible. The generator is reseeded at each stream start.
+	 *
+	 * Since: 0.9.0
+	 */
+	g_object_class_install_property (object_class,
+					 PROP_GVSP_FAULTS,
+					 g_param_spec_string ("gvsp-faults",
+							      "GVSP faults",
+							      "GVSP fault model description",
+							      NULL,
+							      G_PARAM_WRITABLE |
+							      G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
+							      G_PARAM_STATIC_BLURB));
+	/**
+	 * ArvGvFakeCamera:gvsp-history-size:
+	 *
+	 * Number of sent frames kept for packet resend. Changes are taken into account at the next stream start.
+	 *
+	 * Since: 0.9.0
+	 */
+	g_object_class_install_property (object_class,
+					 PROP_GVSP_HISTORY_SIZE,
+					 g_param_spec_uint ("gvsp-history-size",
+							    "GVSP history size",
+							    "Number of frames kept for packet resend",
+							    1, 256, ARV_GV_FAKE_CAMERA_HISTORY_SIZE_DEFAULT,
+							    G_PARAM_WRITABLE | G_PARAM_CONSTRUCT |
+							    G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
+							    G_PARAM_STATIC_BLURB));
+	/**
+	 * ArvGvFakeCamera:gvsp-n-stream-channels:
+	 *
+	 * Number of stream channels. Each channel is served by its own sender thread, and supports multipart
+	 * payloads, made of the image and of a 16 bit depth map.
+	 *
+	 * Since: 0.9.0
+	 */
+	g_object_class_install_property (object_class,
+					 PROP_GVSP_N_STREAM_CHANNELS,
+					 g_param_spec_uint ("gvsp-n-stream-channels",
+							    "GVSP stream channel count",
+							    "Number of stream channels",
+							    1, ARV_GV_FAKE_CAMERA_N_STREAM_CHANNELS_MAX, 1,
+							    G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE |
+							    G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
+							    G_PARAM_STATIC_BLURB));
 }
@@ -649,6 +649,8 @@ _open_device (ArvInterface *interface, GHashTable *devices, const char *device_i
 
 	gv_interface = ARV_GV_INTERFACE (interface);
 
+	arv_interface_lock_device_list (interface);
+
 	if (device_id == NULL) {
 		GList *device_list;
 
@@ -658,6 +660,11 @@ _open_device (ArvInterface *interface, GHashTable *devices, const char *device_i
 	} else
 		device_infos = g_hash_table_lookup (devices, device_id);
 
+	if (device_infos != NULL)
+		arv_gv_interface_device_infos_ref (device_infos);
+
+	arv_interface_unlock_device_list (interface);
+
 	if (device_infos == NULL) {
 		struct addrinfo hints;
 		struct addrinfo *servinfo, *endpoint;
@@ -710,6 +717,8 @@ _open_device (ArvInterface *interface, GHashTable *devices, const char *device_i
 	device = arv_gv_device_new (device_infos->interface_address, device_address, error);
 	g_object_unref (device_address);
 
+	arv_gv_interface_device_infos_unref (device_infos);
+
 	return device;
 }
 
@@ -70,6 +70,7 @@ arv_gvsp_packet_new_image_leader (guint16 frame_id, guint32 packet_id,
                                   guint32 width, guint32 height,
                                   guint32 x_offset, guint32 y_offset,
                                   guint32 x_padding, guint32 y_padding,
+                                  gboolean has_chunks,
                                   void *buffer, size_t *buffer_size)
 {
         ArvGvspPacket *packet;
@@ -82,7 +83,8 @@ arv_gvsp_packet_new_image_leader (guint16 frame_id, guint32 packet_id,
 
 		leader = arv_gvsp_packet_get_data (packet);
 		leader->flags = 0;
-		leader->payload_type = g_htons (ARV_BUFFER_PAYLOAD_TYPE_IMAGE);
+		leader->payload_type = g_htons (ARV_BUFFER_PAYLOAD_TYPE_IMAGE |
+						(has_chunks ? ARV_GVSP_PAYLOAD_TYPE_CHUNK_FLAG : 0));
 		leader->timestamp_high = g_htonl (((guint64) timestamp >> 32));
 		leader->timestamp_low  = g_htonl ((guint64) timestamp & 0xffffffff);
 		leader->infos.pixel_format = g_htonl (pixel_format);
@@ -99,6 +101,7 @@ arv_gvsp_packet_new_image_leader (guint16 frame_id, guint32 packet_id,
 
 ArvGvspPacket *
 arv_gvsp_packet_new_data_trailer (guint16 frame_id, guint32 packet_id,
+				  gboolean has_chunks,
 				  void *buffer, size_t *buffer_size)
 {
 	ArvGvspPacket *packet;
@@ -110,7 +113,8 @@ arv_gvsp_packet_new_data_trailer (guint16 frame_id, guint32 packet_id,
 		ArvGvspTrailer *trailer;
 
 		trailer = arv_gvsp_packet_get_data (packet);
-		trailer->payload_type = g_htonl (ARV_BUFFER_PAYLOAD_TYPE_IMAGE);
+		trailer->payload_type = g_htonl (ARV_BUFFER_PAYLOAD_TYPE_IMAGE |
+						 (has_chunks ? ARV_GVSP_PAYLOAD_TYPE_CHUNK_FLAG : 0));
 		trailer->data0 = 0;
 	}
 
@@ -133,6 +137,186 @@ arv_gvsp_packet_new_payload (guint16 frame_id, guint32 packet_id,
 	return packet;
 }
 
+/*
+ * arv_gvsp_packet_new_payload_header:
+ *
+ * Writes only the header part of a payload packet in @buffer. The packet data
+ * is expected to be sent from another memory location, using scatter/gather
+ * I/O, which avoids a copy of the image data.
+ */
+
+ArvGvspPacket *
+arv_gvsp_packet_new_payload_header (guint16 frame_id, guint32 packet_id,
+                                    void *buffer, size_t *buffer_size)
+{
+	return arv_gvsp_packet_new (ARV_GVSP_CONTENT_TYPE_PAYLOAD,
+				    frame_id, packet_id, 0, buffer, buffer_size);
+}
+
+/* Extended id mode packets, mandatory for multipart payloads. @infos is stored in the lower 24 bits of the
+ * packet infos field, which hold the number of parts for multipart leaders. */
+
+static ArvGvspPacket *
+arv_gvsp_packet_new_extended (ArvGvspContentType content_type, guint32 infos,
+			      guint64 frame_id, guint32 packet_id, size_t data_size,
+			      void *buffer, size_t *buffer_size)
+{
+	ArvGvspPacket *packet;
+	ArvGvspExtendedHeader *header;
+	size_t packet_size;
+
+	packet_size = sizeof (ArvGvspPacket) + sizeof (ArvGvspExtendedHeader) + data_size;
+	if (buffer != NULL && (buffer_size == NULL || packet_size > *buffer_size))
+		return NULL;
+
+	if (buffer_size != NULL)
+		*buffer_size = packet_size;
+
+	if (buffer != NULL)
+		packet = buffer;
+	else
+		packet = g_malloc (packet_size);
+
+	packet->packet_type = 0;
+
+	header = (void *) &packet->header;
+	header->flags = 0;
+	header->packet_infos = g_htonl (((guint32) ARV_GVSP_PACKET_EXTENDED_ID_MODE_MASK << 24) |
+					((content_type << ARV_GVSP_PACKET_INFOS_CONTENT_TYPE_POS) &
+					 ARV_GVSP_PACKET_INFOS_CONTENT_TYPE_MASK) |
+					(infos & ARV_GVSP_PACKET_ID_MASK));
+	header->frame_id = GUINT64_TO_BE (frame_id);
+	header->packet_id = g_htonl (packet_id);
+
+	return packet;
+}
+
+/*
+ * arv_gvsp_packet_new_multipart_leader:
+ *
+ * Writes a multipart leader, with room for @n_parts part descriptions, to be
+ * filled using arv_gvsp_multipart_leader_packet_set_part_infos().
+ */
+
+ArvGvspPacket *
+arv_gvsp_packet_new_multipart_leader (guint64 frame_id, guint32 packet_id,
+				      guint64 timestamp, guint n_parts, gboolean has_chunks,
+				      void *buffer, size_t *buffer_size)
+{
+	ArvGvspPacket *packet;
+
+	if (n_parts < 1 || n_parts > ARV_GVSP_PACKET_INFOS_N_PARTS_MASK)
+		return NULL;
+
+	packet = arv_gvsp_packet_new_extended (ARV_GVSP_CONTENT_TYPE_LEADER, n_parts,
+					       frame_id, packet_id,
+					       sizeof (ArvGvspMultipartLeader) + n_parts * sizeof (ArvGvspPartInfos),
+					       buffer, buffer_size);
+
+	if (packet != NULL) {
+		ArvGvspMultipartLeader *leader;
+
+		leader = arv_gvsp_packet_get_data (packet);
+		leader->flags = 0;
+		leader->payload_type = g_htons (ARV_BUFFER_PAYLOAD_TYPE_MULTIPART |
+						(has_chunks ? ARV_GVSP_PAYLOAD_TYPE_CHUNK_FLAG : 0));
+		leader->timestamp_high = g_htonl (((guint64) timestamp >> 32));
+		leader->timestamp_low  = g_htonl ((guint64) timestamp & 0xffffffff);
+		memset (leader->parts, 0, n_parts * sizeof (ArvGvspPartInfos));
+	}
+
+	return packet;
+}
+
+gboolean
+arv_gvsp_multipart_leader_packet_set_part_infos (ArvGvspPacket *packet, guint part_id,
+						 guint purpose_id,
+						 ArvBufferPartDataType data_type,
+						 size_t size,
+						 ArvPixelFormat pixel_format,
+						 guint32 width, guint32 height,
+						 guint32 x_offset, guint32 y_offset,
+						 guint32 x_padding, guint32 y_padding)
+{
+	ArvGvspMultipartLeader *leader;
+	ArvGvspPartInfos *infos;
+
+	if (part_id >= arv_gvsp_leader_packet_get_multipart_n_parts (packet))
+		return FALSE;
+
+	leader = arv_gvsp_packet_get_data (packet);
+	infos = &leader->parts[part_id];
+
+	infos->data_type = g_htons (data_type);
+	infos->part_length_high = g_htons (((guint64) size >> 32) & 0xffff);
+	infos->part_length_low = g_htonl ((guint64) size & 0xffffffff);
+	infos->pixel_format = g_htonl (pixel_format);
+	infos->data_purpose_id = g_htons (purpose_id);
+	infos->width = g_htonl (width);
+	infos->height = g_htonl (height);
+	infos->x_offset = g_htonl (x_offset);
+	infos->y_offset = g_htonl (y_offset);
+	infos->x_padding = g_htons (x_padding);
+	infos->y_padding = g_htons (y_padding);
+
+	return TRUE;
+}
+
+/*
+ * arv_gvsp_packet_new_multipart_header:
+ *
+ * Writes only the header part of a multipart data packet, the data being sent
+ * from another memory location. @offset is the position of the data in the
+ * whole payload.
+ */
+
+ArvGvspPacket *
+arv_gvsp_packet_new_multipart_header (guint64 frame_id, guint32 packet_id,
+				      guint part_id, ptrdiff_t offset,
+				      void *buffer, size_t *buffer_size)
+{
+	ArvGvspPacket *packet;
+
+	packet = arv_gvsp_packet_new_extended (ARV_GVSP_CONTENT_TYPE_MULTIPART, 0,
+					       frame_id, packet_id, sizeof (ArvGvspMultipart),
+					       buffer, buffer_size);
+
+	if (packet != NULL) {
+		ArvGvspMultipart *multipart;
+
+		multipart = arv_gvsp_packet_get_data (packet);
+		multipart->part_id = part_id;
+		multipart->zone_info = 0;
+		multipart->offset_high = g_htons (((guint64) offset >> 32) & 0xffff);
+		multipart->offset_low = g_htonl ((guint64) offset & 0xffffffff);
+	}
+
+	return packet;
+}
+
+ArvGvspPacket *
+arv_gvsp_packet_new_multipart_trailer (guint64 frame_id, guint32 packet_id,
+				       gboolean has_chunks,
+				       void *buffer, size_t *buffer_size)
+{
+	ArvGvspPacket *packet;
+
+	packet = arv_gvsp_packet_new_extended (ARV_GVSP_CONTENT_TYPE_TRAILER, 0,
+					       frame_id, packet_id, sizeof (ArvGvspTrailer),
+					       buffer, buffer_size);
+
+	if (packet != NULL) {
+		ArvGvspTrailer *trailer;
+
+		trailer = arv_gvsp_packet_get_data (packet);
+		trailer->payload_type = g_htonl (ARV_BUFFER_PAYLOAD_TYPE_MULTIPART |
+						 (has_chunks ? ARV_GVSP_PAYLOAD_TYPE_CHUNK_FLAG : 0));
+		trailer->data0 = 0;
+	}
+
+	return packet;
+}
+
 static const char *
 arv_enum_to_string (GType type,
 		    guint enum_value)
@@ -277,6 +461,15 @@ arv_gvsp_packet_to_string (const ArvGvspPacket *packet, size_t packet_size)
         return arv_g_string_free_and_steal(string);
 }
 
+/* Formatter of the packets stored in the debug ring buffer. Only the packet headers are decoded, which always fit in
+ * a debug record. */
+
+static char *
+_packet_record_to_string (void *data, size_t size)
+{
+	return arv_gvsp_packet_to_string (data, size);
+}
+
 void
 arv_gvsp_packet_debug (const ArvGvspPacket *packet, size_t packet_size, ArvDebugLevel level)
 {
@@ -285,6 +478,12 @@ arv_gvsp_packet_debug (const ArvGvspPacket *packet, size_t packet_size, ArvDebug
 	if (!arv_debug_check (ARV_DEBUG_CATEGORY_SP, level))
 		return;
 
+	if (arv_debug_ring_is_enabled ()) {
+		arv_debug_record_binary (ARV_DEBUG_CATEGORY_SP, level, _packet_record_to_string,
+					 packet, packet_size);
+		return;
+	}
+
 	string = arv_gvsp_packet_to_string (packet, packet_size);
 	switch (level) {
 		case ARV_DEBUG_LEVEL_TRACE:
@@ -34,6 +34,7 @@ G_BEGIN_DECLS
 #define ARV_GVSP_PACKET_INFOS_CONTENT_TYPE_MASK	0x7f000000
 #define ARV_GVSP_PACKET_INFOS_CONTENT_TYPE_POS	24
 #define ARV_GVSP_PACKET_INFOS_N_PARTS_MASK   	0x000000ff
+#define ARV_GVSP_PAYLOAD_TYPE_CHUNK_FLAG	0x4000
 
 /**
  * ArvGvspPacketType:
@@ -239,12 +240,34 @@ ArvGvspPacket *		arv_gvsp_packet_new_image_leader	(guint16 frame_id, guint32 pac
 								 guint32 width, guint32 height,
 								 guint32 x_offset, guint32 y_offset,
 								 guint32 x_padding, guint32 y_padding,
+								 gboolean has_chunks,
 								 void *buffer, size_t *buffer_size);
 ArvGvspPacket *		arv_gvsp_packet_new_data_trailer	(guint16 frame_id, guint32 packet_id,
+								 gboolean has_chunks,
 								 void *buffer, size_t *buffer_size);
 ArvGvspPacket *		arv_gvsp_packet_new_payload		(guint16 frame_id, guint32 packet_id,
 								 size_t size, void *data,
 								 void *buffer, size_t *buffer_size);
+ArvGvspPacket *		arv_gvsp_packet_new_payload_header	(guint16 frame_id, guint32 packet_id,
+								 void *buffer, size_t *buffer_size);
+ArvGvspPacket *		arv_gvsp_packet_new_multipart_leader	(guint64 frame_id, guint32 packet_id,
+								 guint64 timestamp, guint n_parts,
+								 gboolean has_chunks,
+								 void *buffer, size_t *buffer_size);
+gboolean		arv_gvsp_multipart_leader_packet_set_part_infos (ArvGvspPacket *packet, guint part_id,
+									 guint purpose_id,
+									 ArvBufferPartDataType data_type,
+									 size_t size,
+									 ArvPixelFormat pixel_format,
+									 guint32 width, guint32 height,
+									 guint32 x_offset, guint32 y_offset,
+									 guint32 x_padding, guint32 y_padding);
+ArvGvspPacket *		arv_gvsp_packet_new_multipart_header	(guint64 frame_id, guint32 packet_id,
+								 guint part_id, ptrdiff_t offset,
+								 void *buffer, size_t *buffer_size);
+ArvGvspPacket *		arv_gvsp_packet_new_multipart_trailer	(guint64 frame_id, guint32 packet_id,
+								 gboolean has_chunks,
+								 void *buffer, size_t *buffer_size);
 char * 			arv_gvsp_packet_to_string 		(const ArvGvspPacket *packet, size_t packet_size);
 void 			arv_gvsp_packet_debug 			(const ArvGvspPacket *packet, size_t packet_size,
 								 ArvDebugLevel level);
@@ -34,6 +34,7 @@
 #include <arvparamsprivate.h>
 #include <arvgvspprivate.h>
 #include <arvgvcpprivate.h>
+#include <arvtraceprivate.h>
 #include <arvdebug.h>
 #include <arvmisc.h>
 #include <arvmiscprivate.h>
@@ -79,6 +80,7 @@ typedef struct {
         ArvGvDevice *gv_device;
 
         guint stream_channel;
+	gboolean is_monitor;
 
 	GThread *thread;
 	ArvGvStreamThreadData *thread_data;
@@ -138,12 +140,14 @@ struct _ArvGvStreamThreadData {
 	void *callback_data;
 
 	GSocket *socket;
+	GSocket *resend_socket;
 	GInetAddress *interface_address;
 	GSocketAddress *interface_socket_address;
 	GInetAddress *device_address;
 	GSocketAddress *device_socket_address;
 	guint16 source_stream_port;
 	guint16 stream_port;
+	guint16 stream_channel;
 
 	ArvGvStreamPacketResend packet_resend;
 	double packet_request_ratio;
@@ -206,16 +210,22 @@ _send_packet_request (ArvGvStreamThreadData *thread_data,
 
 	thread_data->packet_id = arv_gvcp_next_packet_id (thread_data->packet_id);
 
-	packet = arv_gvcp_packet_new_packet_resend_cmd (frame_id, first_block, last_block, extended_ids,
+	packet = arv_gvcp_packet_new_packet_resend_cmd (thread_data->stream_channel,
+							frame_id, first_block, last_block, extended_ids,
 							thread_data->packet_id, &packet_size);
 
+	ARV_TRACE4 (resend_request, thread_data->stream, frame_id, first_block, last_block);
+
 	arv_debug_stream_thread ("[GvStream::send_packet_request] frame_id = %" G_GUINT64_FORMAT
 			       " (from packet %" G_GUINT32_FORMAT " to %" G_GUINT32_FORMAT ")",
 			       frame_id, first_block, last_block);
 
 	arv_gvcp_packet_debug (packet, ARV_DEBUG_LEVEL_DEBUG);
 
-	g_socket_send_to (thread_data->socket, thread_data->device_socket_address, (const char *) packet, packet_size,
+	/* In multicast mode, the request is sent from the unicast resend socket, as the device sends the missing
+	 * packets back to the requester */
+	g_socket_send_to (thread_data->resend_socket != NULL ? thread_data->resend_socket : thread_data->socket,
+			  thread_data->device_socket_address, (const char *) packet, packet_size,
 			  NULL, NULL);
 
 	arv_gvcp_packet_free (packet);
@@ -425,6 +435,8 @@ _find_frame_data (ArvGvStreamThreadData *thread_data,
 
 	thread_data->frames = g_slist_append (thread_data->frames, frame);
 
+	ARV_TRACE3 (frame_start, thread_data->stream, frame_id, frame->buffer);
+
 	arv_debug_stream_thread ("[GvStream::find_frame_data] Start frame %" G_GUINT64_FORMAT, frame_id);
 
 	frame->extended_ids = extended_ids;
@@ -762,6 +774,9 @@ _close_frame (ArvGvStreamThreadData *thread_data,
 	    frame->buffer->priv->status != ARV_BUFFER_STATUS_ABORTED)
 		thread_data->n_missing_packets += (int) frame->n_packets - (frame->last_valid_packet + 1);
 
+	ARV_TRACE5 (frame_completed, thread_data->stream, frame->frame_id, frame->buffer,
+		    frame->buffer->priv->status, time_us - frame->first_packet_time_us);
+
 	arv_stream_push_output_buffer (thread_data->stream, frame->buffer);
 	if (thread_data->callback != NULL)
 		thread_data->callback (thread_data->callback_data,
@@ -897,6 +912,8 @@ _process_packet (ArvGvStreamThreadData *thread_data, const ArvGvspPacket *packet
 	frame_id = arv_gvsp_packet_get_frame_id (packet);
 	packet_id = arv_gvsp_packet_get_packet_id (packet);
 
+	ARV_TRACE4 (gvsp_packet_received, thread_data->stream, frame_id, packet_id, packet_size);
+
 	if (thread_data->first_packet) {
 		thread_data->last_frame_id = frame_id - 1;
 		thread_data->first_packet = FALSE;
@@ -996,10 +1013,13 @@ _loop (ArvGvStreamThreadData *thread_data)
 {
 	ArvGvStreamFrameData *frame;
 	ArvGvspPacket *packet_buffers;
-	GPollFD poll_fd[2];
+	GPollFD poll_fd[3];
+	GSocket *sockets[2];
+	guint n_sockets = 0;
 	guint64 time_us;
 	gboolean use_poll;
 	int i;
+	guint j;
 	GInputVector packet_iv[ARV_GV_STREAM_NUM_BUFFERS] = { {NULL, 0}, };
 	GInputMessage packet_im[ARV_GV_STREAM_NUM_BUFFERS] = { {NULL, NULL, 0, 0, 0, NULL, NULL}, };
 	// we don't need to consider the IP and UDP header size
@@ -1007,11 +1027,18 @@ _loop (ArvGvStreamThreadData *thread_data)
 
 	arv_info_stream ("[GvStream::loop] Standard socket method");
 
-	poll_fd[0].fd = g_socket_get_fd (thread_data->socket);
-	poll_fd[0].events =  G_IO_IN;
-	poll_fd[0].revents = 0;
+	/* In multicast mode, resent packets are received on the unicast resend socket */
+	sockets[n_sockets++] = thread_data->socket;
+	if (thread_data->resend_socket != NULL)
+		sockets[n_sockets++] = thread_data->resend_socket;
+
+	for (j = 0; j < n_sockets; j++) {
+		poll_fd[j].fd = g_socket_get_fd (sockets[j]);
+		poll_fd[j].events =  G_IO_IN;
+		poll_fd[j].revents = 0;
+	}
 
-	arv_gpollfd_prepare_all(poll_fd,1);
+	arv_gpollfd_prepare_all(poll_fd, n_sockets);
 
 	packet_buffers = g_malloc0 (packet_buffer_size * ARV_GV_STREAM_NUM_BUFFERS);
 
@@ -1022,7 +1049,7 @@ _loop (ArvGvStreamThreadData *thread_data)
 		packet_im[i].num_vectors = 1;
 	}
 
-	use_poll = g_cancellable_make_pollfd (thread_data->cancellable, &poll_fd[1]);
+	use_poll = g_cancellable_make_pollfd (thread_data->cancellable, &poll_fd[n_sockets]);
 
         g_mutex_lock (&thread_data->thread_started_mutex);
         thread_data->thread_started = TRUE;
@@ -1033,6 +1060,7 @@ _loop (ArvGvStreamThreadData *thread_data)
                 int timeout_ms;
 		int n_events;
 		int errsv;
+		gboolean received;
 
 		if (thread_data->frames != NULL)
 			timeout_ms = thread_data->packet_timeout_us / 1000;
@@ -1040,18 +1068,26 @@ _loop (ArvGvStreamThreadData *thread_data)
 			timeout_ms = ARV_GV_STREAM_POLL_TIMEOUT_US / 1000;
 
 		do {
-			poll_fd[0].revents = 0;
-			n_events = g_poll (poll_fd, use_poll ?  2 : 1, timeout_ms);
+			for (j = 0; j < n_sockets; j++)
+				poll_fd[j].revents = 0;
+			n_events = g_poll (poll_fd, use_poll ?  n_sockets + 1 : n_sockets, timeout_ms);
 			errsv = errno;
 
 		} while (n_events < 0 && errsv == EINTR);
 
-		if (poll_fd[0].revents != 0) {
+		received = FALSE;
+
+		for (j = 0; j < n_sockets; j++) {
                         GError *error = NULL;
                         int n_msgs;
 
-			arv_gpollfd_clear_one (&poll_fd[0], thread_data->socket);
-			n_msgs = g_socket_receive_messages (thread_data->socket,
+			if (poll_fd[j].revents == 0)
+				continue;
+
+			received = TRUE;
+
+			arv_gpollfd_clear_one (&poll_fd[j], sockets[j]);
+			n_msgs = g_socket_receive_messages (sockets[j],
 		 					    packet_im,
 		 					    ARV_GV_STREAM_NUM_BUFFERS,
 		 					    G_SOCKET_MSG_NONE,
@@ -1072,17 +1108,20 @@ _loop (ArvGvStreamThreadData *thread_data)
                                                            error != NULL ? error->message : "Unknown reason");
                                 g_clear_error (&error);
                         }
-                } else {
+                }
+
+		if (!received) {
                         time_us = g_get_monotonic_time ();
                         _check_frame_completion (thread_data, time_us, NULL);
                 }
 
+		arv_stream_publish_infos (thread_data->stream);
 	} while (!g_cancellable_is_cancelled (thread_data->cancellable));
 
 	if (use_poll)
 		g_cancellable_release_fd (thread_data->cancellable);
 
-	arv_gpollfd_finish_all (poll_fd,1);
+	arv_gpollfd_finish_all (poll_fd, n_sockets);
 	g_free (packet_buffers);
 }
 
@@ -1349,6 +1388,8 @@ _ring_buffer_loop (ArvGvStreamThreadData *thread_data)
 			descriptor->h1.block_status = TP_STATUS_KERNEL;
 			block_id = (block_id + 1) % req.tp_block_nr;
 		}
+
+		arv_stream_publish_infos (thread_data->stream);
 	} while (!g_cancellable_is_cancelled (thread_data->cancellable));
 
 	if (use_poll)
@@ -1392,6 +1433,7 @@ arv_gv_stream_thread (void *data)
 		_loop (thread_data);
 
 	_flush_frames (thread_data, g_get_monotonic_time ());
+	arv_stream_publish_infos (thread_data->stream);
 
 	if (thread_data->callback != NULL)
 		thread_data->callback (thread_data->callback_data, ARV_STREAM_CALLBACK_TYPE_EXIT, NULL);
@@ -1490,17 +1532,16 @@ arv_gv_stream_get_statistics (ArvGvStream *gv_stream,
 			      guint64 *n_missing_packets)
 
 {
-	ArvGvStreamPrivate *priv = arv_gv_stream_get_instance_private (gv_stream);
-	ArvGvStreamThreadData *thread_data;
+	ArvStreamStatistics statistics;
 
 	g_return_if_fail (ARV_IS_GV_STREAM (gv_stream));
 
-	thread_data = priv->thread_data;
+	arv_stream_get_statistics_snapshot (ARV_STREAM (gv_stream), NULL, &statistics);
 
 	if (n_resent_packets != NULL)
-		*n_resent_packets = thread_data->n_resent_packets;
+		*n_resent_packets = statistics.n_resent_packets;
 	if (n_missing_packets != NULL)
-		*n_missing_packets = thread_data->n_missing_packets;
+		*n_missing_packets = statistics.n_missing_packets;
 }
 
 static void
@@ -1598,6 +1639,8 @@ arv_gv_stream_constructed (GObject *object)
 	guint64 timestamp_tick_frequency;
 	const guint8 *address_bytes;
 	GInetSocketAddress *local_address;
+	GInetAddress *multicast_address = NULL;
+	guint16 multicast_port = 0;
 	guint packet_size;
 
 	G_OBJECT_CLASS (arv_gv_stream_parent_class)->constructed (object);
@@ -1614,11 +1657,38 @@ arv_gv_stream_constructed (GObject *object)
 
         arv_info_stream ("[GvStream::stream_new] Stream channel = %u", priv->stream_channel);
 
+	/* Without control access, the stream monitors the multicast destination set up by the controller, and never
+	 * writes to the device */
+	priv->is_monitor = !arv_gv_device_is_controller (priv->gv_device);
+	if (priv->is_monitor) {
+		guint32 destination;
+
+		destination = g_htonl (arv_device_get_integer_feature_value (ARV_DEVICE (priv->gv_device),
+									     "ArvGevSCDA", NULL));
+		multicast_address = g_inet_address_new_from_bytes ((guint8 *) &destination, G_SOCKET_FAMILY_IPV4);
+		multicast_port = arv_device_get_integer_feature_value (ARV_DEVICE (priv->gv_device),
+								       "ArvGevSCPHostPort", NULL);
+
+		if (!g_inet_address_get_is_multicast (multicast_address) || multicast_port == 0) {
+			arv_stream_take_init_error (stream, g_error_new (ARV_DEVICE_ERROR,
+									 ARV_DEVICE_ERROR_NOT_CONTROLLER,
+									 "Controller privilege required for "
+									 "unicast streaming"));
+			g_clear_object (&multicast_address);
+			g_clear_object (&priv->gv_device);
+			return;
+		}
+	} else {
+		multicast_address = arv_gv_device_get_stream_multicast_address (priv->gv_device, &multicast_port);
+		if (multicast_address != NULL)
+			g_object_ref (multicast_address);
+	}
+
 	timestamp_tick_frequency = arv_gv_device_get_timestamp_tick_frequency (priv->gv_device, NULL);
 	options = arv_gv_device_get_stream_options (priv->gv_device);
 
 	packet_size = arv_gv_device_get_packet_size (priv->gv_device, NULL);
-	if (packet_size <= ARV_GVSP_PACKET_PROTOCOL_OVERHEAD(FALSE)) {
+	if (packet_size <= ARV_GVSP_PACKET_PROTOCOL_OVERHEAD(FALSE) && !priv->is_monitor) {
 		arv_gv_device_set_packet_size (priv->gv_device, ARV_GV_DEVICE_GVSP_PACKET_SIZE_DEFAULT, NULL);
 		arv_info_stream ("[GvStream::stream_new] Packet size set to default value (%d)",
 				  ARV_GV_DEVICE_GVSP_PACKET_SIZE_DEFAULT);
@@ -1630,6 +1700,7 @@ arv_gv_stream_constructed (GObject *object)
 	if (packet_size <= ARV_GVSP_PACKET_PROTOCOL_OVERHEAD(FALSE)) {
 		arv_stream_take_init_error (stream, g_error_new (ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_PROTOCOL_ERROR,
 								 "Invalid packet size (%d byte(s))", packet_size));
+		g_clear_object (&multicast_address);
 		g_clear_object (&priv->gv_device);
 		return;
 	}
@@ -1644,8 +1715,14 @@ arv_gv_stream_constructed (GObject *object)
 	priv->thread_data->timestamp_tick_frequency = timestamp_tick_frequency;
 	priv->thread_data->scps_packet_size = packet_size;
 	priv->thread_data->use_packet_socket = (options & ARV_GV_STREAM_OPTION_PACKET_SOCKET_DISABLED) == 0;
+	if (multicast_address != NULL && priv->thread_data->use_packet_socket) {
+		/* Resent packets are received on a second socket, which the packet socket filter doesn't cover */
+		priv->thread_data->use_packet_socket = FALSE;
+		arv_info_stream ("[GvStream::stream_new] Packet socket disabled for multicast streaming");
+	}
 
 	priv->thread_data->packet_id = 65300;
+	priv->thread_data->stream_channel = priv->stream_channel;
 
 	priv->thread_data->histogram = arv_histogram_new (3, 100, 2000, 0);
 
@@ -1653,6 +1730,8 @@ arv_gv_stream_constructed (GObject *object)
 	arv_histogram_set_variable_name (priv->thread_data->histogram, 1, "packet_time");
 	arv_histogram_set_variable_name (priv->thread_data->histogram, 2, "inter_packet");
 
+	arv_stream_declare_histogram (ARV_STREAM (gv_stream), priv->thread_data->histogram);
+
 	interface_address = g_inet_socket_address_get_address
                 (G_INET_SOCKET_ADDRESS (arv_gv_device_get_interface_address (priv->gv_device)));
 	device_address = g_inet_socket_address_get_address
@@ -1664,21 +1743,71 @@ arv_gv_stream_constructed (GObject *object)
 	priv->thread_data->device_socket_address = g_inet_socket_address_new (device_address, ARV_GVCP_PORT);
 	g_socket_set_blocking (priv->thread_data->socket, FALSE);
 
-	priv->thread_data->interface_socket_address = arv_socket_bind_with_range (priv->thread_data->socket,
-                                                                                  interface_address, 0, FALSE, NULL);
+	if (multicast_address == NULL) {
+		priv->thread_data->interface_socket_address = arv_socket_bind_with_range (priv->thread_data->socket,
+											  interface_address, 0, FALSE,
+											  NULL);
+	} else {
+		GInetAddress *bind_address;
+		GSocketAddress *resend_address;
+
+		/* The destination port is shared by all the receivers of the group */
+#ifdef G_OS_WIN32
+		bind_address = g_inet_address_new_any (G_SOCKET_FAMILY_IPV4);
+#else
+		bind_address = g_object_ref (multicast_address);
+#endif
+		priv->thread_data->interface_socket_address = arv_socket_bind_with_range (priv->thread_data->socket,
+											  bind_address,
+											  multicast_port, TRUE,
+											  &error);
+		g_object_unref (bind_address);
+
+		if (error == NULL)
+			arv_socket_join_multicast_group (priv->thread_data->socket, multicast_address,
+							 interface_address, &error);
+
+		if (error == NULL) {
+			priv->thread_data->resend_socket = g_socket_new (G_SOCKET_FAMILY_IPV4, G_SOCKET_TYPE_DATAGRAM,
+									 G_SOCKET_PROTOCOL_UDP, NULL);
+			g_socket_set_blocking (priv->thread_data->resend_socket, FALSE);
+			resend_address = arv_socket_bind_with_range (priv->thread_data->resend_socket,
+								     interface_address, 0, FALSE, &error);
+			g_clear_object (&resend_address);
+		}
+
+		if (error != NULL) {
+			arv_stream_take_init_error (stream, error);
+			g_object_unref (multicast_address);
+			g_clear_object (&priv->gv_device);
+			return;
+		}
+	}
 
 	local_address = G_INET_SOCKET_ADDRESS (g_socket_get_local_address (priv->thread_data->socket, NULL));
 	priv->thread_data->stream_port = g_inet_socket_address_get_port (local_address);
 	g_object_unref (local_address);
 
-	address_bytes = g_inet_address_to_bytes (interface_address);
-	arv_device_set_integer_feature_value (ARV_DEVICE (priv->gv_device),
-                                              "ArvGevSCDA", g_htonl (*((guint32 *) address_bytes)), NULL);
-	arv_device_set_integer_feature_value (ARV_DEVICE (priv->gv_device),
-                                              "ArvGevSCPHostPort", priv->thread_data->stream_port, NULL);
+	if (!priv->is_monitor) {
+		address_bytes = g_inet_address_to_bytes (multicast_address != NULL ?
+							 multicast_address : interface_address);
+		arv_device_set_integer_feature_value (ARV_DEVICE (priv->gv_device),
+						      "ArvGevSCDA", g_htonl (*((guint32 *) address_bytes)), NULL);
+		arv_device_set_integer_feature_value (ARV_DEVICE (priv->gv_device),
+						      "ArvGevSCPHostPort", priv->thread_data->stream_port, NULL);
+	}
 	priv->thread_data->source_stream_port = arv_device_get_integer_feature_value (ARV_DEVICE (priv->gv_device),
                                                                                       "ArvGevSCSP", NULL);
 
+	if (multicast_address != NULL) {
+		char *multicast_string = g_inet_address_to_string (multicast_address);
+
+		arv_info_stream ("[GvStream::stream_new] Multicast group = %s (%s)", multicast_string,
+				 priv->is_monitor ? "monitor" : "controller");
+		g_free (multicast_string);
+		g_object_unref (multicast_address);
+	}
+
 	arv_info_stream ("[GvStream::stream_new] Destination stream port = %d", priv->thread_data->stream_port);
 	arv_info_stream ("[GvStream::stream_new] Source stream port = %d", priv->thread_data->source_stream_port);
 
@@ -1730,8 +1859,11 @@ arv_gv_stream_finalize (GObject *object)
                 arv_gv_stream_stop_acquisition (ARV_STREAM (object), NULL);
 
         /* Stop the stream channel. We use a raw register write here, as the Genicam based access rely on
-         * ArvGevStreamSelector state, and we don't want to change it here. */
-        arv_device_write_register(ARV_DEVICE(priv->gv_device), 0xd00 + 0x40 * priv->stream_channel, 0x0000, &error);
+         * ArvGevStreamSelector state, and we don't want to change it here. A monitor stream leaves the stream
+         * channel to the controller. The device is not kept by a stream which failed to initialize. */
+        if (!priv->is_monitor && priv->gv_device != NULL)
+                arv_device_write_register(ARV_DEVICE(priv->gv_device), 0xd00 + 0x40 * priv->stream_channel, 0x0000,
+                                          &error);
 
         if (error != NULL) {
                 arv_warning_stream ("Failed to stop stream channel %d (%s)", priv->stream_channel, error->message);
@@ -1795,6 +1927,7 @@ arv_gv_stream_finalize (GObject *object)
 		g_clear_object (&thread_data->device_socket_address);
 		g_clear_object (&thread_data->interface_socket_address);
 		g_clear_object (&thread_data->socket);
+		g_clear_object (&thread_data->resend_socket);
 
 		g_clear_pointer (&thread_data, g_free);
 	}
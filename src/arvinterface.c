@@ -34,6 +34,8 @@
 #include <arvinterfaceprivate.h>
 
 typedef struct {
+	/* Protects device_ids, and the device lists of the derived classes */
+	GMutex device_list_mutex;
 	GArray *device_ids;
         int flags;
 } ArvInterfacePrivate;
@@ -86,11 +88,38 @@ arv_interface_update_device_list (ArvInterface *iface)
 	ArvInterfacePrivate *priv = arv_interface_get_instance_private (iface);
 	g_return_if_fail (ARV_IS_INTERFACE (iface));
 
+	g_mutex_lock (&priv->device_list_mutex);
+
 	arv_interface_clear_device_ids (iface);
 
 	ARV_INTERFACE_GET_CLASS (iface)->update_device_list (iface, priv->device_ids);
 
 	g_array_sort (priv->device_ids, (GCompareFunc) _compare_device_ids);
+
+	g_mutex_unlock (&priv->device_list_mutex);
+}
+
+/* The device list lock must be held by the derived classes while they access their device list from the open_device
+ * implementation, but not during the device instantiation, in order to allow concurrent device openings. */
+
+void
+arv_interface_lock_device_list (ArvInterface *iface)
+{
+	ArvInterfacePrivate *priv = arv_interface_get_instance_private (iface);
+
+	g_return_if_fail (ARV_IS_INTERFACE (iface));
+
+	g_mutex_lock (&priv->device_list_mutex);
+}
+
+void
+arv_interface_unlock_device_list (ArvInterface *iface)
+{
+	ArvInterfacePrivate *priv = arv_interface_get_instance_private (iface);
+
+	g_return_if_fail (ARV_IS_INTERFACE (iface));
+
+	g_mutex_unlock (&priv->device_list_mutex);
 }
 
 void
@@ -396,6 +425,7 @@ arv_interface_init (ArvInterface *iface)
 {
 	ArvInterfacePrivate *priv = arv_interface_get_instance_private (iface);
 
+	g_mutex_init (&priv->device_list_mutex);
 	priv->device_ids = g_array_new (FALSE, TRUE, sizeof (ArvInterfaceDeviceIds *));
 }
 
@@ -410,6 +440,8 @@ arv_interface_finalize (GObject *object)
 	arv_interface_clear_device_ids (iface);
 	g_array_free (priv->device_ids, TRUE);
 	priv->device_ids = NULL;
+
+	g_mutex_clear (&priv->device_list_mutex);
 }
 
 static void
@@ -49,6 +49,9 @@ typedef struct {
 void            arv_interface_set_flags         (ArvInterface *iface, int flags);
 int             arv_interface_get_flags         (ArvInterface *iface);
 
+void            arv_interface_lock_device_list          (ArvInterface *iface);
+void            arv_interface_unlock_device_list        (ArvInterface *iface);
+
 G_END_DECLS
 
 #endif
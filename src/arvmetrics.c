@@ -0,0 +1,782 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/**
+ * SECTION: arvmetrics
+ * @short_description: OpenMetrics exporter
+ *
+ * The metrics exporter exposes the counters of all the live #ArvDevice and #ArvStream instances of the
+ * process in the OpenMetrics text format, which can be scraped by Prometheus or any compatible collector.
+ *
+ * The exporter is started either by calling arv_metrics_start(), or by setting the `ARV_METRICS`
+ * environment variable to the listening address before the first device is created, for example
+ * `ARV_METRICS=127.0.0.1:9464` or, on unix platforms, `ARV_METRICS=unix:/run/aravis/metrics.sock`. An empty
+ * value selects the default address.
+ *
+ * The exported families are:
+ *
+ * - `aravis_device_<info>_total`: device counters, like the GVCP command, retry and timeout counts
+ * - `aravis_device_register_cache_{hits,misses,errors}_total`: Genicam register cache statistics
+ * - `aravis_stream_<info>_total`: stream counters, like the completed buffer or resent packet counts
+ * - `aravis_stream_<variable>_seconds`: stream timing histograms, when available
+ *
+ * Devices and streams are listed once their construction is complete, until they are disposed. All values are
+ * read from the lock-free statistics snapshots, scraping never stalls the acquisition threads.
+ *
+ * Since: 0.9.0
+ */
+
+#include <arvmetricsprivate.h>
+#include <arvdeviceprivate.h>
+#include <arvstreamprivate.h>
+#include <arvgcprivate.h>
+#include <arvgc.h>
+#include <arvgvdevice.h>
+#include <arvmiscprivate.h>
+#include <arvdebugprivate.h>
+#include <gio/gio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#ifdef G_OS_UNIX
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define ARV_METRICS_DEFAULT_ADDRESS	"127.0.0.1:9464"
+#define ARV_METRICS_DEFAULT_PORT	9464
+#define ARV_METRICS_CONTENT_TYPE	"application/openmetrics-text; version=1.0.0; charset=utf-8"
+#define ARV_METRICS_REQUEST_SIZE_MAX	4096
+
+typedef struct {
+	GObject *object;
+	guint serial;
+} ArvMetricsEntry;
+
+typedef struct {
+	char *name;
+	const char *type;
+	char *help;
+	GString *samples;
+} ArvMetricsFamily;
+
+typedef struct {
+	GSocket *socket;
+	GCancellable *cancellable;
+	GThread *thread;
+	char *unix_path;
+} ArvMetricsServer;
+
+static GMutex arv_metrics_mutex;
+static GPtrArray *arv_metrics_devices = NULL;
+static GPtrArray *arv_metrics_streams = NULL;
+static guint arv_metrics_serial = 0;
+static ArvMetricsServer *arv_metrics_server = NULL;
+
+static gpointer
+_auto_start (gpointer data)
+{
+	const char *address;
+
+	address = g_getenv ("ARV_METRICS");
+	if (address != NULL) {
+		GError *error = NULL;
+
+		if (!arv_metrics_start (address[0] != '\0' ? address : NULL, &error)) {
+			arv_warning_misc ("[Metrics::auto_start] Failed to start exporter on '%s': %s",
+					  address, error->message);
+			g_clear_error (&error);
+		}
+	}
+
+	return NULL;
+}
+
+static void
+_register (GPtrArray **entries, GObject *object)
+{
+	static GOnce auto_start_once = G_ONCE_INIT;
+	guint i;
+
+	g_mutex_lock (&arv_metrics_mutex);
+
+	if (*entries == NULL)
+		*entries = g_ptr_array_new_with_free_func (g_free);
+
+	for (i = 0; i < (*entries)->len; i++)
+		if (((ArvMetricsEntry *) g_ptr_array_index (*entries, i))->object == object)
+			break;
+
+	if (i == (*entries)->len) {
+		ArvMetricsEntry *entry;
+
+		entry = g_new0 (ArvMetricsEntry, 1);
+		entry->object = object;
+		entry->serial = arv_metrics_serial++;
+		g_ptr_array_add (*entries, entry);
+	}
+
+	g_mutex_unlock (&arv_metrics_mutex);
+
+	g_once (&auto_start_once, _auto_start, NULL);
+}
+
+static void
+_unregister (GPtrArray *entries, GObject *object)
+{
+	guint i;
+
+	g_mutex_lock (&arv_metrics_mutex);
+
+	for (i = 0; entries != NULL && i < entries->len; i++) {
+		ArvMetricsEntry *entry = g_ptr_array_index (entries, i);
+
+		if (entry->object == object) {
+			g_ptr_array_remove_index (entries, i);
+			break;
+		}
+	}
+
+	g_mutex_unlock (&arv_metrics_mutex);
+}
+
+/* Objects are registered once their construction is complete, and unregistered on dispose, before any of their
+ * resources is released. The registry does not hold any reference, a scrape is done under the registry lock, which
+ * delays the disposal of the objects it reads. */
+
+void
+arv_metrics_register_device (ArvDevice *device)
+{
+	_register (&arv_metrics_devices, G_OBJECT (device));
+}
+
+void
+arv_metrics_unregister_device (ArvDevice *device)
+{
+	_unregister (arv_metrics_devices, G_OBJECT (device));
+}
+
+void
+arv_metrics_register_stream (ArvStream *stream)
+{
+	_register (&arv_metrics_streams, G_OBJECT (stream));
+}
+
+void
+arv_metrics_unregister_stream (ArvStream *stream)
+{
+	_unregister (arv_metrics_streams, G_OBJECT (stream));
+}
+
+static guint
+_get_serial (GPtrArray *entries, gconstpointer object)
+{
+	guint i;
+
+	for (i = 0; entries != NULL && i < entries->len; i++) {
+		ArvMetricsEntry *entry = g_ptr_array_index (entries, i);
+
+		if (entry->object == object)
+			return entry->serial;
+	}
+
+	return 0;
+}
+
+static void
+_append_label_value (GString *string, const char *value)
+{
+	const char *iter;
+
+	for (iter = value; *iter != '\0'; iter++) {
+		switch (*iter) {
+			case '\\':
+				g_string_append (string, "\\\\");
+				break;
+			case '"':
+				g_string_append (string, "\\\"");
+				break;
+			case '\n':
+				g_string_append (string, "\\n");
+				break;
+			default:
+				g_string_append_c (string, *iter);
+		}
+	}
+}
+
+static char *
+_get_device_label (ArvDevice *device)
+{
+	GString *label;
+
+	label = g_string_new ("device=\"");
+
+	if (ARV_IS_GV_DEVICE (device)) {
+		GSocketAddress *address;
+
+		address = arv_gv_device_get_device_address (ARV_GV_DEVICE (device));
+		if (G_IS_INET_SOCKET_ADDRESS (address)) {
+			char *ip;
+
+			ip = g_inet_address_to_string
+				(g_inet_socket_address_get_address (G_INET_SOCKET_ADDRESS (address)));
+			_append_label_value (label, ip);
+			g_free (ip);
+		}
+	} else {
+		g_string_append_printf (label, "%s-%u", G_OBJECT_TYPE_NAME (device),
+					_get_serial (arv_metrics_devices, device));
+	}
+
+	g_string_append_c (label, '"');
+
+	return g_string_free (label, FALSE);
+}
+
+static void
+arv_metrics_family_free (ArvMetricsFamily *family)
+{
+	g_free (family->name);
+	g_free (family->help);
+	g_string_free (family->samples, TRUE);
+	g_free (family);
+}
+
+static GString *
+_get_family (GHashTable *families, GPtrArray *ordered,
+	     const char *name, const char *type, const char *help)
+{
+	ArvMetricsFamily *family;
+
+	family = g_hash_table_lookup (families, name);
+	if (family == NULL) {
+		family = g_new0 (ArvMetricsFamily, 1);
+		family->name = g_strdup (name);
+		family->type = type;
+		family->help = g_strdup (help);
+		family->samples = g_string_new ("");
+		g_hash_table_insert (families, family->name, family);
+		g_ptr_array_add (ordered, family);
+	}
+
+	return family->samples;
+}
+
+static void
+_append_counter (GHashTable *families, GPtrArray *ordered, const char *prefix, const char *info_name,
+		 const char *help, const char *labels, guint64 value)
+{
+	GString *samples;
+	char *name;
+
+	if (g_str_has_prefix (info_name, "n_"))
+		info_name += 2;
+
+	name = g_strdup_printf ("%s_%s", prefix, info_name);
+	samples = _get_family (families, ordered, name, "counter", help);
+	g_string_append_printf (samples, "%s_total{%s} %" G_GUINT64_FORMAT "\n", name, labels, value);
+	g_free (name);
+}
+
+static void
+_append_gauge (GHashTable *families, GPtrArray *ordered, const char *prefix, const char *info_name,
+	       const char *help, const char *labels, double value)
+{
+	GString *samples;
+	char *name;
+	char buffer[G_ASCII_DTOSTR_BUF_SIZE];
+
+	name = g_strdup_printf ("%s_%s", prefix, info_name);
+	samples = _get_family (families, ordered, name, "gauge", help);
+	g_string_append_printf (samples, "%s{%s} %s\n", name, labels,
+				g_ascii_dtostr (buffer, sizeof (buffer), value));
+	g_free (name);
+}
+
+static void
+_append_device (GHashTable *families, GPtrArray *ordered, ArvDevice *device, const char *labels)
+{
+	ArvGc *genicam;
+	guint n_infos;
+	guint i;
+
+	n_infos = arv_device_get_n_infos (device);
+	for (i = 0; i < n_infos; i++)
+		_append_counter (families, ordered, "aravis_device",
+				 arv_device_get_info_name (device, i),
+				 arv_device_get_info_description (device, i),
+				 labels, arv_device_get_info_uint64 (device, i));
+
+	genicam = arv_device_get_genicam (device);
+	if (ARV_IS_GC (genicam)) {
+		guint64 n_hits, n_misses, n_errors;
+
+		arv_gc_get_register_cache_statistics (genicam, &n_hits, &n_misses, &n_errors);
+
+		_append_counter (families, ordered, "aravis_device", "register_cache_hits",
+				 "Number of register reads served by the Genicam cache", labels, n_hits);
+		_append_counter (families, ordered, "aravis_device", "register_cache_misses",
+				 "Number of register reads sent to the device", labels, n_misses);
+		_append_counter (families, ordered, "aravis_device", "register_cache_errors",
+				 "Number of register cache inconsistencies detected by the cache check policy",
+				 labels, n_errors);
+	}
+}
+
+static const struct {
+	const char *name;
+	const char *description;
+} arv_metrics_stream_descriptions[] = {
+	{"n_completed_buffers",		"Number of successfully completed buffers"},
+	{"n_failures",			"Number of buffers completed with an error"},
+	{"n_underruns",			"Number of frames dropped because no input buffer was available"},
+	{"n_timeouts",			"Number of buffers completed on timeout"},
+	{"n_aborted",			"Number of aborted buffers"},
+	{"n_missing_frames",		"Number of frames never received"},
+	{"n_size_mismatch_errors",	"Number of frames larger than the buffer size"},
+	{"n_received_packets",		"Number of received packets"},
+	{"n_missing_packets",		"Number of missing packets"},
+	{"n_error_packets",		"Number of packets with an error status"},
+	{"n_ignored_packets",		"Number of ignored packets"},
+	{"n_resend_requests",		"Number of packet resend requests"},
+	{"n_resent_packets",		"Number of received resent packets"},
+	{"n_resend_ratio_reached",	"Number of frames for which the packet resend ratio limit was reached"},
+	{"n_resend_disabled",		"Number of frames with missing packets and packet resend disabled"},
+	{"n_duplicated_packets",	"Number of duplicated packets"},
+	{"n_transferred_bytes",		"Number of transferred bytes"},
+	{"n_ignored_bytes",		"Number of ignored bytes"},
+	{"frame_retention",		"Time from the first packet of a frame to the buffer completion"},
+	{"packet_time",			"Packet arrival time, relative to the first packet of its frame"},
+	{"inter_packet",		"Time between consecutive packets of a frame"},
+};
+
+static const char *
+_get_stream_description (const char *name)
+{
+	guint i;
+
+	for (i = 0; i < G_N_ELEMENTS (arv_metrics_stream_descriptions); i++)
+		if (g_strcmp0 (arv_metrics_stream_descriptions[i].name, name) == 0)
+			return arv_metrics_stream_descriptions[i].description;
+
+	return "Stream statistic";
+}
+
+static void
+_append_stream (GHashTable *families, GPtrArray *ordered, ArvStream *stream, const char *labels)
+{
+	ArvHistogram *histogram;
+	guint n_infos;
+	guint i;
+
+	n_infos = arv_stream_get_n_infos (stream);
+	for (i = 0; i < n_infos; i++) {
+		const char *name = arv_stream_get_info_name (stream, i);
+		GType type = arv_stream_get_info_type (stream, i);
+
+		if (type == G_TYPE_UINT64)
+			_append_counter (families, ordered, "aravis_stream", name,
+					 _get_stream_description (name), labels,
+					 arv_stream_get_info_uint64 (stream, i));
+		else if (type == G_TYPE_DOUBLE)
+			_append_gauge (families, ordered, "aravis_stream", name,
+				       _get_stream_description (name), labels,
+				       arv_stream_get_info_double (stream, i));
+	}
+
+	histogram = arv_stream_get_histogram (stream);
+	if (histogram != NULL) {
+		guint n_variables = arv_histogram_get_n_variables (histogram);
+
+		for (i = 0; i < n_variables; i++) {
+			const char *variable = arv_histogram_get_variable_name (histogram, i);
+			GString *samples;
+			char *name;
+
+			if (variable == NULL)
+				continue;
+
+			name = g_strdup_printf ("aravis_stream_%s_seconds", variable);
+			samples = _get_family (families, ordered, name, "histogram",
+					       _get_stream_description (variable));
+			arv_histogram_append_openmetrics (histogram, i, samples, name, labels, 1e-6);
+			g_free (name);
+		}
+	}
+}
+
+/**
+ * arv_metrics_to_string:
+ *
+ * Renders the current value of the metrics of all the live devices and streams in the OpenMetrics text
+ * format.
+ *
+ * Returns: (transfer full): a newly allocated string, to be freed using g_free().
+ *
+ * Since: 0.9.0
+ */
+
+char *
+arv_metrics_to_string (void)
+{
+	GHashTable *families;
+	GPtrArray *ordered;
+	GString *string;
+	guint i;
+
+	families = g_hash_table_new (g_str_hash, g_str_equal);
+	ordered = g_ptr_array_new_with_free_func ((GDestroyNotify) arv_metrics_family_free);
+
+	g_mutex_lock (&arv_metrics_mutex);
+
+	for (i = 0; arv_metrics_devices != NULL && i < arv_metrics_devices->len; i++) {
+		ArvMetricsEntry *entry = g_ptr_array_index (arv_metrics_devices, i);
+		ArvDevice *device = ARV_DEVICE (entry->object);
+		char *labels;
+
+		labels = _get_device_label (device);
+		_append_device (families, ordered, device, labels);
+		g_free (labels);
+	}
+
+	for (i = 0; arv_metrics_streams != NULL && i < arv_metrics_streams->len; i++) {
+		ArvMetricsEntry *entry = g_ptr_array_index (arv_metrics_streams, i);
+		ArvStream *stream = ARV_STREAM (entry->object);
+		ArvDevice *device = arv_stream_get_device (stream);
+		char *device_label;
+		char *labels;
+
+		device_label = ARV_IS_DEVICE (device) ? _get_device_label (device) : g_strdup ("device=\"\"");
+		labels = g_strdup_printf ("%s,stream=\"%u\"", device_label, entry->serial);
+		_append_stream (families, ordered, stream, labels);
+		g_free (labels);
+		g_free (device_label);
+	}
+
+	g_mutex_unlock (&arv_metrics_mutex);
+
+	string = g_string_new ("");
+
+	for (i = 0; i < ordered->len; i++) {
+		ArvMetricsFamily *family = g_ptr_array_index (ordered, i);
+
+		g_string_append_printf (string, "# TYPE %s %s\n", family->name, family->type);
+		if (family->help != NULL)
+			g_string_append_printf (string, "# HELP %s %s\n", family->name, family->help);
+		g_string_append (string, family->samples->str);
+	}
+
+	g_string_append (string, "# EOF\n");
+
+	g_ptr_array_unref (ordered);
+	g_hash_table_unref (families);
+
+	return g_string_free (string, FALSE);
+}
+
+static void
+_handle_connection (GSocket *socket, GCancellable *cancellable)
+{
+	GString *response;
+	char request[ARV_METRICS_REQUEST_SIZE_MAX + 1];
+	gsize size = 0;
+	gssize count;
+
+	g_socket_set_timeout (socket, 5);
+
+	while (size < ARV_METRICS_REQUEST_SIZE_MAX) {
+		count = g_socket_receive (socket, request + size, ARV_METRICS_REQUEST_SIZE_MAX - size,
+					  cancellable, NULL);
+		if (count <= 0)
+			return;
+		size += count;
+		request[size] = '\0';
+		if (strstr (request, "\r\n\r\n") != NULL)
+			break;
+	}
+
+	response = g_string_new ("");
+
+	if (g_str_has_prefix (request, "GET ")) {
+		char *body = arv_metrics_to_string ();
+		size_t body_size = strlen (body);
+
+		g_string_append_printf (response,
+					"HTTP/1.1 200 OK\r\n"
+					"Content-Type: " ARV_METRICS_CONTENT_TYPE "\r\n"
+					"Content-Length: %" G_GSIZE_FORMAT "\r\n"
+					"Connection: close\r\n"
+					"\r\n", body_size);
+		g_string_append_len (response, body, body_size);
+		g_free (body);
+	} else {
+		g_string_append (response,
+				 "HTTP/1.1 405 Method Not Allowed\r\n"
+				 "Allow: GET\r\n"
+				 "Content-Length: 0\r\n"
+				 "Connection: close\r\n"
+				 "\r\n");
+	}
+
+	for (size = 0; size < response->len; size += count) {
+		count = g_socket_send (socket, response->str + size, response->len - size, cancellable, NULL);
+		if (count <= 0)
+			break;
+	}
+
+	g_string_free (response, TRUE);
+}
+
+static gpointer
+_server_thread (gpointer data)
+{
+	ArvMetricsServer *server = data;
+
+	while (!g_cancellable_is_cancelled (server->cancellable)) {
+		GSocket *socket;
+		GError *error = NULL;
+
+		socket = g_socket_accept (server->socket, server->cancellable, &error);
+		if (socket == NULL) {
+			if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+				arv_warning_misc ("[Metrics::server_thread] Accept failed: %s", error->message);
+			g_clear_error (&error);
+			continue;
+		}
+
+		_handle_connection (socket, server->cancellable);
+
+		g_socket_close (socket, NULL);
+		g_object_unref (socket);
+	}
+
+	return NULL;
+}
+
+static GSocket *
+_create_unix_socket (const char *path, GError **error)
+{
+#ifdef G_OS_UNIX
+	struct sockaddr_un address = {0};
+	struct stat path_stat;
+	GSocket *unix_socket;
+	int fd;
+
+	if (strlen (path) >= sizeof (address.sun_path)) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+			     "Unix socket path too long (%s)", path);
+		return NULL;
+	}
+
+	/* Only replace a stale socket, never an arbitrary file */
+	if (lstat (path, &path_stat) == 0) {
+		if (!S_ISSOCK (path_stat.st_mode)) {
+			g_set_error (error, G_IO_ERROR, G_IO_ERROR_EXISTS,
+				     "'%s' exists and is not a socket", path);
+			return NULL;
+		}
+		if (unlink (path) != 0 && errno != ENOENT) {
+			int errsv = errno;
+
+			g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+				     "Failed to remove stale socket '%s': %s", path, g_strerror (errsv));
+			return NULL;
+		}
+	} else if (errno != ENOENT) {
+		int errsv = errno;
+
+		g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+			     "Failed to check '%s': %s", path, g_strerror (errsv));
+		return NULL;
+	}
+
+	fd = socket (AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) {
+		g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errno),
+			     "Failed to create unix socket: %s", g_strerror (errno));
+		return NULL;
+	}
+
+	address.sun_family = AF_UNIX;
+	strcpy (address.sun_path, path);
+
+	if (bind (fd, (struct sockaddr *) &address, sizeof (address)) != 0 ||
+	    listen (fd, 8) != 0) {
+		int errsv = errno;
+
+		g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+			     "Failed to listen on '%s': %s", path, g_strerror (errsv));
+		close (fd);
+		return NULL;
+	}
+
+	unix_socket = g_socket_new_from_fd (fd, error);
+	if (unix_socket == NULL)
+		close (fd);
+
+	return unix_socket;
+#else
+	g_set_error (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+		     "Unix socket metrics exporter is not supported on this platform");
+	return NULL;
+#endif
+}
+
+static GSocket *
+_create_tcp_socket (const char *address, GError **error)
+{
+	GSocketConnectable *connectable;
+	GSocketAddressEnumerator *enumerator;
+	GSocketAddress *socket_address;
+	GSocket *socket = NULL;
+
+	connectable = g_network_address_parse (address, ARV_METRICS_DEFAULT_PORT, error);
+	if (connectable == NULL)
+		return NULL;
+
+	enumerator = g_socket_connectable_enumerate (connectable);
+	socket_address = g_socket_address_enumerator_next (enumerator, NULL, error);
+
+	if (socket_address != NULL) {
+		socket = g_socket_new (g_socket_address_get_family (socket_address),
+				       G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_TCP, error);
+		if (socket != NULL &&
+		    (!g_socket_bind (socket, socket_address, TRUE, error) ||
+		     !g_socket_listen (socket, error)))
+			g_clear_object (&socket);
+		g_object_unref (socket_address);
+	} else if (error != NULL && *error == NULL) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND,
+			     "Failed to resolve '%s'", address);
+	}
+
+	g_object_unref (enumerator);
+	g_object_unref (connectable);
+
+	return socket;
+}
+
+/**
+ * arv_metrics_start:
+ * @address: (allow-none): listening address, %NULL for the default 127.0.0.1:9464
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Starts an HTTP server answering GET requests with the output of arv_metrics_to_string(). The address
+ * is either a host:port pair, or on unix platforms a `unix:` prefixed socket path. The server runs in its
+ * own thread. Only one exporter can be running at a time.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.9.0
+ */
+
+gboolean
+arv_metrics_start (const char *address, GError **error)
+{
+	ArvMetricsServer *server;
+	GSocket *socket;
+
+	if (address == NULL)
+		address = ARV_METRICS_DEFAULT_ADDRESS;
+
+	g_mutex_lock (&arv_metrics_mutex);
+	if (arv_metrics_server != NULL) {
+		g_mutex_unlock (&arv_metrics_mutex);
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_EXISTS, "Metrics exporter already running");
+		return FALSE;
+	}
+	g_mutex_unlock (&arv_metrics_mutex);
+
+	if (g_str_has_prefix (address, "unix:"))
+		socket = _create_unix_socket (address + strlen ("unix:"), error);
+	else
+		socket = _create_tcp_socket (address, error);
+
+	if (socket == NULL)
+		return FALSE;
+
+	server = g_new0 (ArvMetricsServer, 1);
+	server->socket = socket;
+	server->cancellable = g_cancellable_new ();
+	if (g_str_has_prefix (address, "unix:"))
+		server->unix_path = g_strdup (address + strlen ("unix:"));
+
+	g_mutex_lock (&arv_metrics_mutex);
+	if (arv_metrics_server != NULL) {
+		g_mutex_unlock (&arv_metrics_mutex);
+		g_socket_close (server->socket, NULL);
+		g_object_unref (server->socket);
+		g_object_unref (server->cancellable);
+		g_free (server->unix_path);
+		g_free (server);
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_EXISTS, "Metrics exporter already running");
+		return FALSE;
+	}
+	arv_metrics_server = server;
+	server->thread = g_thread_new ("arv_metrics", _server_thread, server);
+	g_mutex_unlock (&arv_metrics_mutex);
+
+	arv_info_misc ("[Metrics::start] Exporter listening on '%s'", address);
+
+	return TRUE;
+}
+
+/**
+ * arv_metrics_stop:
+ *
+ * Stops the metrics exporter started by arv_metrics_start(), if any.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_metrics_stop (void)
+{
+	ArvMetricsServer *server;
+
+	g_mutex_lock (&arv_metrics_mutex);
+	server = arv_metrics_server;
+	arv_metrics_server = NULL;
+	g_mutex_unlock (&arv_metrics_mutex);
+
+	if (server == NULL)
+		return;
+
+	g_cancellable_cancel (server->cancellable);
+	g_thread_join (server->thread);
+
+	g_socket_close (server->socket, NULL);
+	g_object_unref (server->socket);
+	g_object_unref (server->cancellable);
+
+#ifdef G_OS_UNIX
+	if (server->unix_path != NULL)
+		unlink (server->unix_path);
+#endif
+
+	g_free (server->unix_path);
+	g_free (server);
+}
@@ -114,6 +114,7 @@ struct _ArvHistogramVariable {
 
 	double maximum;
         double minimum;
+	double sum;
 
 	guint64 *bins;
 };
@@ -225,6 +226,7 @@ arv_histogram_reset (ArvHistogram *histogram)
 		variable->last_seen_maximum = 0;
 		variable->and_more = variable->and_less = 0;
                 variable->counter = 0;
+		variable->sum = 0.0;
 		for (i = 0; i < histogram->n_bins; i++)
 			variable->bins[i] = 0;
 	}
@@ -268,11 +270,64 @@ arv_histogram_fill (ArvHistogram *histogram, guint id, int value)
 	else
 		variable->bins[class]++;
 
+	variable->sum += value;
 	variable->counter++;
 
 	return TRUE;
 }
 
+guint
+arv_histogram_get_n_variables (const ArvHistogram *histogram)
+{
+	g_return_val_if_fail (histogram != NULL, 0);
+
+	return histogram->n_variables;
+}
+
+const char *
+arv_histogram_get_variable_name (const ArvHistogram *histogram, guint id)
+{
+	g_return_val_if_fail (histogram != NULL, NULL);
+	g_return_val_if_fail (id < histogram->n_variables, NULL);
+
+	return histogram->variables[id].name;
+}
+
+/* Appends the bucket, sum and count samples of an OpenMetrics histogram. Bucket bounds are multiplied by scale, for unit
+ * conversion. The histogram may be filled concurrently, count is computed from the read buckets to keep the samples
+ * consistent. */
+
+void
+arv_histogram_append_openmetrics (const ArvHistogram *histogram, guint id, GString *string,
+				  const char *name, const char *labels, double scale)
+{
+	const ArvHistogramVariable *variable;
+	guint64 cumulative;
+	char buffer[G_ASCII_DTOSTR_BUF_SIZE];
+	guint i;
+
+	g_return_if_fail (histogram != NULL);
+	g_return_if_fail (id < histogram->n_variables);
+	g_return_if_fail (string != NULL);
+
+	variable = &histogram->variables[id];
+	cumulative = variable->and_less;
+
+	for (i = 0; i < histogram->n_bins; i++) {
+		cumulative += variable->bins[i];
+		g_string_append_printf (string, "%s_bucket{%s%sle=\"%g\"} %" G_GUINT64_FORMAT "\n",
+					name, labels, labels[0] != '\0' ? "," : "",
+					(histogram->offset + (i + 1) * histogram->bin_step) * scale, cumulative);
+	}
+
+	cumulative += variable->and_more;
+	g_string_append_printf (string, "%s_bucket{%s%sle=\"+Inf\"} %" G_GUINT64_FORMAT "\n",
+				name, labels, labels[0] != '\0' ? "," : "", cumulative);
+	g_string_append_printf (string, "%s_sum{%s} %s\n", name, labels,
+				g_ascii_dtostr (buffer, sizeof (buffer), variable->sum * scale));
+	g_string_append_printf (string, "%s_count{%s} %" G_GUINT64_FORMAT "\n", name, labels, cumulative);
+}
+
 char *
 arv_histogram_to_string (const ArvHistogram *histogram)
 {
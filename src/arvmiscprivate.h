@@ -40,6 +40,12 @@ void 			arv_histogram_reset 		(ArvHistogram *histogram);
 gboolean 		arv_histogram_fill 		(ArvHistogram *histogram, guint histogram_id, int value);
 void 			arv_histogram_set_variable_name	(ArvHistogram *histogram, guint histogram_id, char const *name);
 
+guint			arv_histogram_get_n_variables	(const ArvHistogram *histogram);
+const char *		arv_histogram_get_variable_name	(const ArvHistogram *histogram, guint histogram_id);
+void			arv_histogram_append_openmetrics (const ArvHistogram *histogram, guint histogram_id,
+							  GString *string, const char *name, const char *labels,
+							  double scale);
+
 char *			arv_histogram_to_string 	(const ArvHistogram *histogram);
 
 struct _ArvValue {
@@ -475,6 +475,52 @@ arv_socket_set_recv_buffer_size (int socket_fd, gint buffer_size)
 	return result == 0;
 }
 
+/* Joins the multicast @group on the interface owning @interface_address */
+
+gboolean
+arv_socket_join_multicast_group (GSocket *socket, GInetAddress *group, GInetAddress *interface_address, GError **error)
+{
+	struct ip_mreq request;
+	int result;
+
+	g_return_val_if_fail (G_IS_SOCKET (socket), FALSE);
+	g_return_val_if_fail (G_IS_INET_ADDRESS (group), FALSE);
+	g_return_val_if_fail (G_IS_INET_ADDRESS (interface_address), FALSE);
+
+	memcpy (&request.imr_multiaddr, g_inet_address_to_bytes (group), sizeof (request.imr_multiaddr));
+	memcpy (&request.imr_interface, g_inet_address_to_bytes (interface_address), sizeof (request.imr_interface));
+
+	result = setsockopt (g_socket_get_fd (socket), IPPROTO_IP, IP_ADD_MEMBERSHIP,
+			     (const char *) &request, sizeof (request));
+	if (result != 0) {
+		char *group_string = g_inet_address_to_string (group);
+
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED,
+			     "Failed to join multicast group %s", group_string);
+		g_free (group_string);
+
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/* Sends the outgoing multicast datagrams through the interface owning @interface_address */
+
+gboolean
+arv_socket_set_multicast_interface (GSocket *socket, GInetAddress *interface_address)
+{
+	struct in_addr address;
+
+	g_return_val_if_fail (G_IS_SOCKET (socket), FALSE);
+	g_return_val_if_fail (G_IS_INET_ADDRESS (interface_address), FALSE);
+
+	memcpy (&address, g_inet_address_to_bytes (interface_address), sizeof (address));
+
+	return setsockopt (g_socket_get_fd (socket), IPPROTO_IP, IP_MULTICAST_IF,
+			   (const char *) &address, sizeof (address)) == 0;
+}
+
 
 ArvNetworkInterface*
 arv_network_get_interface_by_name (const char* name)
@@ -108,6 +108,12 @@ ARV_API gboolean		arv_network_interface_is_loopback	(ArvNetworkInterface *a);
 
 gboolean			arv_socket_set_recv_buffer_size		(int socket_fd, gint buffer_size);
 
+/* Multicast */
+
+gboolean		arv_socket_join_multicast_group		(GSocket *socket, GInetAddress *group,
+								 GInetAddress *interface_address, GError **error);
+gboolean		arv_socket_set_multicast_interface	(GSocket *socket, GInetAddress *interface_address);
+
 #ifdef G_OS_WIN32
 	/* mingw only defines with _WIN32_WINNT>=0x0600, see
 	 * https://github.com/AravisProject/aravis/issues/416#issuecomment-717220610 */
@@ -0,0 +1,127 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_SHARED_STREAM_PRIVATE_H
+#define ARV_SHARED_STREAM_PRIVATE_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvbufferprivate.h>
+
+G_BEGIN_DECLS
+
+/* Layout of the shared memory region of a stream publisher:
+ *
+ * - the header,
+ * - the descriptor ring, announcing the published buffers,
+ * - the sequence of the buffer currently published in each slot, 0 if the slot is not published,
+ * - the buffer references of each subscriber, one row of slot reference counts per subscriber,
+ * - the buffer slots, starting on a page boundary, so they can be mapped read-only by the subscribers.
+ *
+ * The region is written by the publisher only, except for the reference counts. Descriptors are read with a sequence
+ * lock: a reader validates the descriptor sequence before and after copying it. A subscriber then takes a reference
+ * on the slot, and checks the slot is still published with the same sequence. The publisher retires a slot by
+ * clearing its sequence before checking its reference counts, so either the subscriber sees the slot retired, or the
+ * publisher sees the reference. */
+
+#define ARV_SHARED_STREAM_MAGIC			0x53565241	/* "ARVS" */
+#define ARV_SHARED_STREAM_VERSION		1
+
+#define ARV_SHARED_STREAM_N_PARTS_MAX		8
+#define ARV_SHARED_STREAM_N_SUBSCRIBERS_MAX	16
+
+#define ARV_SHARED_STREAM_SOCKET_PREFIX		"aravis-stream-"
+
+typedef struct {
+	gint sequence;
+	guint32 slot;
+
+	guint32 status;
+	guint32 payload_type;
+	guint64 received_size;
+
+	guint64 frame_id;
+	guint64 timestamp_ns;
+	guint64 system_timestamp_ns;
+
+	guint32 has_chunks;
+	guint32 chunk_endianness;
+
+	guint32 has_gendc;
+	guint32 gendc_descriptor_size;
+	guint64 gendc_data_size;
+	guint64 gendc_data_offset;
+
+	guint32 n_parts;
+	ArvBufferPartInfos parts[ARV_SHARED_STREAM_N_PARTS_MAX];
+} ArvSharedStreamDescriptor;
+
+typedef struct {
+	guint32 magic;
+	guint32 version;
+	guint32 descriptor_size;
+	guint32 n_slots;
+	guint32 ring_size;
+	guint32 n_subscribers_max;
+
+	guint64 slot_size;
+	guint64 size;
+
+	guint64 descriptors_offset;
+	guint64 slot_sequences_offset;
+	guint64 references_offset;
+	guint64 data_offset;
+
+	/* Sequence of the last published buffer, sequences skip 0 when wrapping around */
+	gint write_sequence;
+} ArvSharedStreamHeader;
+
+static inline guint32
+arv_shared_stream_next_sequence (guint32 sequence)
+{
+	return sequence == G_MAXUINT32 ? 1 : sequence + 1;
+}
+
+static inline ArvSharedStreamDescriptor *
+arv_shared_stream_get_descriptor (ArvSharedStreamHeader *header, guint32 sequence)
+{
+	return (ArvSharedStreamDescriptor *) ((char *) header + header->descriptors_offset) +
+		sequence % header->ring_size;
+}
+
+static inline gint *
+arv_shared_stream_get_slot_sequence (ArvSharedStreamHeader *header, guint slot)
+{
+	return (gint *) ((char *) header + header->slot_sequences_offset) + slot;
+}
+
+static inline gint *
+arv_shared_stream_get_reference (ArvSharedStreamHeader *header, guint subscriber, guint slot)
+{
+	return (gint *) ((char *) header + header->references_offset) + subscriber * header->n_slots + slot;
+}
+
+G_END_DECLS
+
+#endif
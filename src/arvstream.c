@@ -34,15 +34,38 @@
 #include <arvbuffer.h>
 #include <arvdevice.h>
 #include <arvdebugprivate.h>
+#include <arvmetricsprivate.h>
+#include <arvtraceprivate.h>
 #include <gio/gio.h>
+#include <string.h>
+
+#define ARV_STREAM_N_PUBLISHED_INFOS_MAX	32
 
 typedef struct {
         char *name;
         char *description;
         GType type;
         gpointer data;
+        guint id;
+        gssize statistics_offset;
 } ArvStreamInfo;
 
+static const struct {
+        const char *name;
+        gssize offset;
+} arv_stream_statistics_fields[] = {
+        {"n_completed_buffers",         G_STRUCT_OFFSET (ArvStreamStatistics, n_completed_buffers)},
+        {"n_failures",                  G_STRUCT_OFFSET (ArvStreamStatistics, n_failures)},
+        {"n_underruns",                 G_STRUCT_OFFSET (ArvStreamStatistics, n_underruns)},
+        {"n_aborted",                   G_STRUCT_OFFSET (ArvStreamStatistics, n_aborted)},
+        {"n_transferred_bytes",         G_STRUCT_OFFSET (ArvStreamStatistics, n_transferred_bytes)},
+        {"n_ignored_bytes",             G_STRUCT_OFFSET (ArvStreamStatistics, n_ignored_bytes)},
+        {"n_received_packets",          G_STRUCT_OFFSET (ArvStreamStatistics, n_received_packets)},
+        {"n_missing_packets",           G_STRUCT_OFFSET (ArvStreamStatistics, n_missing_packets)},
+        {"n_resend_requests",           G_STRUCT_OFFSET (ArvStreamStatistics, n_resend_requests)},
+        {"n_resent_packets",            G_STRUCT_OFFSET (ArvStreamStatistics, n_resent_packets)}
+};
+
 enum {
 	ARV_STREAM_SIGNAL_NEW_BUFFER,
 	ARV_STREAM_SIGNAL_LAST
@@ -73,7 +96,18 @@ typedef struct {
 
 	GError *init_error;
 
+        /* Infos are immutable once declared, the lock only protects the array */
+        GMutex infos_mutex;
         GPtrArray *infos;
+
+        /* Copy of the infos published by the stream thread, protected by a sequence lock */
+        GMutex statistics_mutex;
+        gint statistics_sequence;
+        gint statistics_published;
+        gint64 statistics_time_us;
+        guint64 statistics[ARV_STREAM_N_PUBLISHED_INFOS_MAX];
+
+        ArvHistogram *histogram;
 } ArvStreamPrivate;
 
 static void arv_stream_initable_iface_init (GInitableIface *iface);
@@ -103,6 +137,8 @@ arv_stream_push_buffer (ArvStream *stream, ArvBuffer *buffer)
 	g_return_if_fail (ARV_IS_STREAM (stream));
 	g_return_if_fail (ARV_IS_BUFFER (buffer));
 
+	ARV_TRACE2 (buffer_push, stream, buffer);
+
 	g_async_queue_push (priv->input_queue, buffer);
 }
 
@@ -125,10 +161,15 @@ ArvBuffer *
 arv_stream_pop_buffer (ArvStream *stream)
 {
 	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+	ArvBuffer *buffer;
 
 	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
 
-	return g_async_queue_pop (priv->output_queue);
+	buffer = g_async_queue_pop (priv->output_queue);
+
+	ARV_TRACE2 (buffer_pop, stream, buffer);
+
+	return buffer;
 }
 
 /**
@@ -150,10 +191,15 @@ ArvBuffer *
 arv_stream_try_pop_buffer (ArvStream *stream)
 {
 	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+	ArvBuffer *buffer;
 
 	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
 
-	return g_async_queue_try_pop (priv->output_queue);
+	buffer = g_async_queue_try_pop (priv->output_queue);
+
+	ARV_TRACE2 (buffer_pop, stream, buffer);
+
+	return buffer;
 }
 
 /**
@@ -175,10 +221,15 @@ ArvBuffer *
 arv_stream_timeout_pop_buffer (ArvStream *stream, guint64 timeout)
 {
 	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+	ArvBuffer *buffer;
 
 	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
 
-	return g_async_queue_timeout_pop (priv->output_queue, timeout);
+	buffer = g_async_queue_timeout_pop (priv->output_queue, timeout);
+
+	ARV_TRACE2 (buffer_pop, stream, buffer);
+
+	return buffer;
 }
 
 /**
@@ -413,18 +464,188 @@ arv_stream_get_statistics (ArvStream *stream,
 			   guint64 *n_failures,
 			   guint64 *n_underruns)
 {
-	guint64 dummy;
+	ArvStreamStatistics statistics;
+
+	arv_stream_get_statistics_snapshot (stream, NULL, &statistics);
+
+	if (n_completed_buffers != NULL)
+		*n_completed_buffers = statistics.n_completed_buffers;
+	if (n_failures != NULL)
+		*n_failures = statistics.n_failures;
+	if (n_underruns != NULL)
+		*n_underruns = statistics.n_underruns;
+}
+
+/* The published values are copied with relaxed atomic accesses where the compiler provides them, so the sequence lock
+ * readers do not race with the writer. On other platforms, or for 64 bit values on 32 bit platforms, a torn copy is
+ * still detected by the sequence check. */
+
+#if defined (__ATOMIC_RELAXED) && GLIB_SIZEOF_VOID_P == 8
+#define ARV_STREAM_STATISTICS_LOAD(location)		__atomic_load_n ((location), __ATOMIC_RELAXED)
+#define ARV_STREAM_STATISTICS_STORE(location, value)	__atomic_store_n ((location), (value), __ATOMIC_RELAXED)
+#else
+#define ARV_STREAM_STATISTICS_LOAD(location)		(*(location))
+#define ARV_STREAM_STATISTICS_STORE(location, value)	(*(location) = (value))
+#endif
+
+/* Sequence lock reader. Returns FALSE if no statistics were published by the stream thread yet, or if the info is not
+ * part of the published set, in which case the live value must be used. The second sequence read is an atomic
+ * read-modify-write, a full barrier which keeps the copy loads ordered before it. */
+
+static gboolean
+_read_published_infos (ArvStreamPrivate *priv, guint first, guint n_infos, guint64 *values, gint64 *time_us)
+{
+	gint sequence;
+	guint i;
+
+	if (!g_atomic_int_get (&priv->statistics_published) ||
+	    first + n_infos > ARV_STREAM_N_PUBLISHED_INFOS_MAX)
+		return FALSE;
+
+	for (;;) {
+		sequence = g_atomic_int_get (&priv->statistics_sequence);
+		if ((sequence & 1) != 0) {
+			g_thread_yield ();
+			continue;
+		}
+
+		for (i = 0; i < n_infos; i++)
+			values[i] = ARV_STREAM_STATISTICS_LOAD (&priv->statistics[first + i]);
+		if (time_us != NULL)
+			*time_us = ARV_STREAM_STATISTICS_LOAD (&priv->statistics_time_us);
+
+		if (g_atomic_int_add (&priv->statistics_sequence, 0) == sequence)
+			return TRUE;
+	}
+}
+
+static guint64
+_get_info_value (ArvStreamPrivate *priv, const ArvStreamInfo *info)
+{
+	guint64 value;
+
+	if (!_read_published_infos (priv, info->id, 1, &value, NULL))
+		memcpy (&value, info->data, sizeof (guint64));
+
+	return value;
+}
+
+/* Sequence lock writer. The info values must only be modified between arv_stream_begin_infos_update() and
+ * arv_stream_end_infos_update(), which publishes a consistent copy for lock free reading from other threads. Writers
+ * are serialized, which allows the update of the infos from several threads, for example from the stream thread and
+ * from the USB transfer callbacks. Once published, all the info accessors use the published copy. */
+
+void
+arv_stream_begin_infos_update (ArvStream *stream)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+
+	g_mutex_lock (&priv->statistics_mutex);
+}
+
+void
+arv_stream_end_infos_update (ArvStream *stream)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+	guint n_infos;
+	guint i;
+
+	n_infos = MIN (priv->infos->len, ARV_STREAM_N_PUBLISHED_INFOS_MAX);
+
+	g_atomic_int_inc (&priv->statistics_sequence);
+
+	for (i = 0; i < n_infos; i++) {
+		ArvStreamInfo *info = g_ptr_array_index (priv->infos, i);
+		guint64 value;
+
+		memcpy (&value, info->data, sizeof (guint64));
+		ARV_STREAM_STATISTICS_STORE (&priv->statistics[i], value);
+	}
+	ARV_STREAM_STATISTICS_STORE (&priv->statistics_time_us, g_get_monotonic_time ());
+
+	g_atomic_int_inc (&priv->statistics_sequence);
 
-	if (n_completed_buffers == NULL)
-		n_completed_buffers = &dummy;
-	if (n_failures == NULL)
-		n_failures = &dummy;
-	if (n_underruns == NULL)
-		n_underruns = &dummy;
+	if (G_UNLIKELY (!g_atomic_int_get (&priv->statistics_published)))
+		g_atomic_int_set (&priv->statistics_published, TRUE);
 
-	*n_completed_buffers = arv_stream_get_info_uint64_by_name (stream, "n_completed_buffers");
-	*n_failures = arv_stream_get_info_uint64_by_name (stream, "n_failures");
-	*n_underruns = arv_stream_get_info_uint64_by_name (stream, "n_underruns");
+	g_mutex_unlock (&priv->statistics_mutex);
+}
+
+/* Publishes the infos updated by the calling thread, at a convenient point, typically once per receive loop
+ * iteration. */
+
+void
+arv_stream_publish_infos (ArvStream *stream)
+{
+	arv_stream_begin_infos_update (stream);
+	arv_stream_end_infos_update (stream);
+}
+
+/**
+ * arv_stream_get_statistics_snapshot:
+ * @stream: a #ArvStream
+ * @previous: (allow-none): a previous snapshot of the same stream, for the rate computation
+ * @statistics: (out caller-allocates): the statistics snapshot
+ *
+ * Retrieves a consistent snapshot of the main stream statistics, without locking the stream thread. Counters not
+ * supported by the stream implementation are set to 0. If @previous is given, the rates are computed over the
+ * interval between the two snapshots, otherwise they are set to 0.
+ *
+ * This method is thread safe, and cheap enough to be called at a high rate.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_stream_get_statistics_snapshot (ArvStream *stream,
+				    const ArvStreamStatistics *previous,
+				    ArvStreamStatistics *statistics)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+	guint64 values[ARV_STREAM_N_PUBLISHED_INFOS_MAX];
+	gint64 time_us;
+	double interval_s;
+	guint n_infos;
+	guint i;
+
+	g_return_if_fail (statistics != NULL);
+
+	memset (statistics, 0, sizeof (ArvStreamStatistics));
+
+	g_return_if_fail (ARV_IS_STREAM (stream));
+
+	n_infos = MIN (priv->infos->len, ARV_STREAM_N_PUBLISHED_INFOS_MAX);
+
+	if (!_read_published_infos (priv, 0, n_infos, values, &time_us)) {
+		for (i = 0; i < n_infos; i++) {
+			ArvStreamInfo *info = g_ptr_array_index (priv->infos, i);
+
+			memcpy (&values[i], info->data, sizeof (guint64));
+		}
+		time_us = g_get_monotonic_time ();
+	}
+
+	statistics->time_us = time_us;
+
+	for (i = 0; i < n_infos; i++) {
+		ArvStreamInfo *info = g_ptr_array_index (priv->infos, i);
+
+		if (info->statistics_offset >= 0)
+			G_STRUCT_MEMBER (guint64, statistics, info->statistics_offset) = values[i];
+	}
+
+	if (previous == NULL || previous->time_us >= statistics->time_us)
+		return;
+
+	interval_s = (statistics->time_us - previous->time_us) / 1e6;
+
+	statistics->completed_buffer_rate =
+		(double) (statistics->n_completed_buffers - previous->n_completed_buffers) / interval_s;
+	statistics->failure_rate = (double) (statistics->n_failures - previous->n_failures) / interval_s;
+	statistics->transferred_byte_rate =
+		(double) (statistics->n_transferred_bytes - previous->n_transferred_bytes) / interval_s;
+	statistics->missing_packet_rate =
+		(double) (statistics->n_missing_packets - previous->n_missing_packets) / interval_s;
 }
 
 /**
@@ -505,8 +726,69 @@ arv_stream_declare_info (ArvStream *stream, const char *name, GType type, gpoint
         info->name = g_strdup (name);
         info->type = type;
         info->data = data;
+        info->statistics_offset = -1;
+
+        if (type == G_TYPE_UINT64) {
+                guint i;
 
+                for (i = 0; i < G_N_ELEMENTS (arv_stream_statistics_fields); i++)
+                        if (g_strcmp0 (name, arv_stream_statistics_fields[i].name) == 0) {
+                                info->statistics_offset = arv_stream_statistics_fields[i].offset;
+                                break;
+                        }
+        }
+
+        g_mutex_lock (&priv->infos_mutex);
+        info->id = priv->infos->len;
         g_ptr_array_add (priv->infos, info);
+        g_mutex_unlock (&priv->infos_mutex);
+}
+
+static const ArvStreamInfo *
+_get_info (ArvStreamPrivate *priv, guint id)
+{
+        const ArvStreamInfo *info = NULL;
+
+        g_mutex_lock (&priv->infos_mutex);
+        if (id < priv->infos->len)
+                info = g_ptr_array_index (priv->infos, id);
+        g_mutex_unlock (&priv->infos_mutex);
+
+        return info;
+}
+
+/* The stream histogram is exported by the metrics module. Its variables are expected to be durations in µs. */
+
+void
+arv_stream_declare_histogram (ArvStream *stream, ArvHistogram *histogram)
+{
+        ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+
+	g_return_if_fail (ARV_IS_STREAM (stream));
+
+        g_clear_pointer (&priv->histogram, arv_histogram_unref);
+        if (histogram != NULL)
+                priv->histogram = arv_histogram_ref (histogram);
+}
+
+ArvHistogram *
+arv_stream_get_histogram (ArvStream *stream)
+{
+        ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+
+	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
+
+        return priv->histogram;
+}
+
+ArvDevice *
+arv_stream_get_device (ArvStream *stream)
+{
+        ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+
+	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
+
+        return priv->device;
 }
 
 /**
@@ -523,9 +805,15 @@ arv_stream_get_n_infos (ArvStream *stream)
 {
         ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
 
+        guint n_infos;
+
         g_return_val_if_fail (ARV_IS_STREAM (stream), 0);
 
-        return priv->infos->len;
+        g_mutex_lock (&priv->infos_mutex);
+        n_infos = priv->infos->len;
+        g_mutex_unlock (&priv->infos_mutex);
+
+        return n_infos;
 }
 
 /**
@@ -545,9 +833,10 @@ arv_stream_get_info_name (ArvStream *stream, guint id)
         const ArvStreamInfo *info;
 
         g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
-        g_return_val_if_fail (id < priv->infos->len, NULL);
 
-        info = g_ptr_array_index (priv->infos, id);
+        info = _get_info (priv, id);
+        g_return_val_if_fail (info != NULL, NULL);
+
         if (info != NULL)
                 return info->name;
 
@@ -572,9 +861,10 @@ arv_stream_get_info_type (ArvStream *stream, guint id)
         const ArvStreamInfo *info;
 
         g_return_val_if_fail (ARV_IS_STREAM (stream), 0);
-        g_return_val_if_fail (id < priv->infos->len, 0);
 
-        info = g_ptr_array_index (priv->infos, id);
+        info = _get_info (priv, id);
+        g_return_val_if_fail (info != NULL, 0);
+
         if (info != NULL)
                 return info->type;
 
@@ -598,14 +888,14 @@ arv_stream_get_info_uint64 (ArvStream *stream, guint id)
         const ArvStreamInfo *info;
 
         g_return_val_if_fail (ARV_IS_STREAM (stream), 0);
-        g_return_val_if_fail (id < priv->infos->len, 0);
 
-        info = g_ptr_array_index (priv->infos, id);
+        info = _get_info (priv, id);
+        g_return_val_if_fail (info != NULL, 0);
 
         g_return_val_if_fail (info->type == G_TYPE_UINT64, 0);
 
         if (info != NULL)
-                return *((guint64 *) (info->data));
+                return _get_info_value (priv, info);
 
         return 0;
 }
@@ -627,14 +917,20 @@ arv_stream_get_info_double (ArvStream *stream, guint id)
         const ArvStreamInfo *info;
 
         g_return_val_if_fail (ARV_IS_STREAM (stream), 0);
-        g_return_val_if_fail (id < priv->infos->len, 0);
 
-        info = g_ptr_array_index (priv->infos, id);
+        info = _get_info (priv, id);
+        g_return_val_if_fail (info != NULL, 0);
 
         g_return_val_if_fail (info->type == G_TYPE_DOUBLE, 0);
 
-        if (info != NULL)
-                return *((double *) (info->data));
+        if (info != NULL) {
+                guint64 value = _get_info_value (priv, info);
+                double double_value;
+
+                memcpy (&double_value, &value, sizeof (double));
+
+                return double_value;
+        }
 
         return 0;
 }
@@ -643,16 +939,21 @@ static const ArvStreamInfo *
 _find_info_by_name (ArvStream *stream, const char *name)
 {
 	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+        const ArvStreamInfo *found = NULL;
         guint i;
 
+        g_mutex_lock (&priv->infos_mutex);
         for (i = 0; i < priv->infos->len; i++) {
                 ArvStreamInfo *info = g_ptr_array_index (priv->infos, i);
 
-                if (info != NULL && g_strcmp0 (name, info->name) == 0)
-                        return info;
+                if (info != NULL && g_strcmp0 (name, info->name) == 0) {
+                        found = info;
+                        break;
+                }
         }
+        g_mutex_unlock (&priv->infos_mutex);
 
-        return NULL;
+        return found;
 }
 
 /**
@@ -678,7 +979,7 @@ arv_stream_get_info_uint64_by_name (ArvStream *stream, const char *name)
         g_return_val_if_fail (info != NULL, 0);
         g_return_val_if_fail (info->type == G_TYPE_UINT64, 0);
 
-        return *((guint64 *) (info->data));
+        return _get_info_value (arv_stream_get_instance_private (stream), info);
 }
 
 /**
@@ -695,6 +996,8 @@ double
 arv_stream_get_info_double_by_name (ArvStream *stream, const char *name)
 {
         const ArvStreamInfo *info;
+        guint64 value;
+        double double_value;
 
 	g_return_val_if_fail (ARV_IS_STREAM (stream), 0);
         g_return_val_if_fail (name != NULL, 0);
@@ -704,7 +1007,10 @@ arv_stream_get_info_double_by_name (ArvStream *stream, const char *name)
         g_return_val_if_fail (info != NULL, 0);
         g_return_val_if_fail (info->type == G_TYPE_DOUBLE, 0);
 
-        return *((double *) (info->data));
+        value = _get_info_value (arv_stream_get_instance_private (stream), info);
+        memcpy (&double_value, &value, sizeof (double));
+
+        return double_value;
 }
 
 gboolean
@@ -814,9 +1120,22 @@ arv_stream_init (ArvStream *stream)
 
 	priv->emit_signals = FALSE;
 
+        g_mutex_init (&priv->infos_mutex);
         priv->infos = g_ptr_array_new ();
 
 	g_rec_mutex_init (&priv->mutex);
+	g_mutex_init (&priv->statistics_mutex);
+}
+
+/* The stream is removed from the metrics registry before the subclasses release their resources. Subclasses
+ * overriding dispose must chain up before freeing the data of their declared infos. */
+
+static void
+arv_stream_dispose (GObject *object)
+{
+        arv_metrics_unregister_stream (ARV_STREAM (object));
+
+	G_OBJECT_CLASS (arv_stream_parent_class)->dispose (object);
 }
 
 static void
@@ -836,6 +1155,7 @@ arv_stream_finalize (GObject *object)
 	g_async_queue_unref (priv->output_queue);
 
 	g_rec_mutex_clear (&priv->mutex);
+	g_mutex_clear (&priv->statistics_mutex);
 
 	g_clear_object (&priv->device);
 
@@ -843,6 +1163,8 @@ arv_stream_finalize (GObject *object)
 
         g_ptr_array_foreach (priv->infos, (GFunc) arv_stream_info_free, NULL);
         g_clear_pointer (&priv->infos, g_ptr_array_unref);
+        g_mutex_clear (&priv->infos_mutex);
+        g_clear_pointer (&priv->histogram, arv_histogram_unref);
 
 	if (priv->destroy_notify != NULL) {
 		priv->destroy_notify(priv->callback_data);
@@ -856,6 +1178,7 @@ arv_stream_class_init (ArvStreamClass *node_class)
 {
 	GObjectClass *object_class = G_OBJECT_CLASS (node_class);
 
+	object_class->dispose = arv_stream_dispose;
 	object_class->finalize = arv_stream_finalize;
 	object_class->set_property = arv_stream_set_property;
 	object_class->get_property = arv_stream_get_property;
@@ -944,6 +1267,8 @@ arv_stream_initable_init (GInitable     *initable,
 		return FALSE;
 	}
 
+        arv_metrics_register_stream (ARV_STREAM (initable));
+
 	return TRUE;
 }
 
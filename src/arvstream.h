@@ -91,6 +91,50 @@ struct _ArvStreamClass {
 
 typedef void (*ArvStreamCallback)	(void *user_data, ArvStreamCallbackType type, ArvBuffer *buffer);
 
+/**
+ * ArvStreamStatistics:
+ * @time_us: monotonic time of the snapshot, in µs
+ * @n_completed_buffers: number of complete received buffers
+ * @n_failures: number of reception failures
+ * @n_underruns: number of input buffer underruns
+ * @n_aborted: number of aborted buffers
+ * @n_transferred_bytes: number of received bytes
+ * @n_ignored_bytes: number of ignored bytes
+ * @n_received_packets: number of received packets
+ * @n_missing_packets: number of missing packets
+ * @n_resend_requests: number of packet resend requests
+ * @n_resent_packets: number of resent packets
+ * @completed_buffer_rate: completed buffers per second since the previous snapshot
+ * @failure_rate: failures per second since the previous snapshot
+ * @transferred_byte_rate: received bytes per second since the previous snapshot
+ * @missing_packet_rate: missing packets per second since the previous snapshot
+ *
+ * A consistent snapshot of the main stream statistics, see arv_stream_get_statistics_snapshot(). The packet counters
+ * are only meaningful for packet based protocols.
+ *
+ * Since: 0.9.0
+ */
+
+typedef struct {
+	gint64 time_us;
+
+	guint64 n_completed_buffers;
+	guint64 n_failures;
+	guint64 n_underruns;
+	guint64 n_aborted;
+	guint64 n_transferred_bytes;
+	guint64 n_ignored_bytes;
+	guint64 n_received_packets;
+	guint64 n_missing_packets;
+	guint64 n_resend_requests;
+	guint64 n_resent_packets;
+
+	double completed_buffer_rate;
+	double failure_rate;
+	double transferred_byte_rate;
+	double missing_packet_rate;
+} ArvStreamStatistics;
+
 ARV_API void		arv_stream_push_buffer			(ArvStream *stream, ArvBuffer *buffer);
 ARV_API ArvBuffer *	arv_stream_pop_buffer			(ArvStream *stream);
 ARV_API ArvBuffer *	arv_stream_try_pop_buffer		(ArvStream *stream);
@@ -111,6 +155,10 @@ ARV_API void		arv_stream_get_statistics		(ArvStream *stream,
 								 guint64 *n_failures,
 								 guint64 *n_underruns);
 
+ARV_API void		arv_stream_get_statistics_snapshot	(ArvStream *stream,
+								 const ArvStreamStatistics *previous,
+								 ArvStreamStatistics *statistics);
+
 ARV_API guint		arv_stream_get_n_infos			(ArvStream *stream);
 ARV_API const char *	arv_stream_get_info_name		(ArvStream *stream, guint id);
 ARV_API GType		arv_stream_get_info_type		(ArvStream *stream, guint id);
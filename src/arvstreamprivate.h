@@ -28,6 +28,7 @@
 #endif
 
 #include <arvstream.h>
+#include <arvmiscprivate.h>
 
 G_BEGIN_DECLS
 
@@ -37,6 +38,12 @@ void		arv_stream_push_output_buffer		(ArvStream *stream, ArvBuffer *buffer);
 void		arv_stream_take_init_error		(ArvStream *device, GError *error);
 
 void            arv_stream_declare_info                 (ArvStream *stream, const char *name, GType type, gpointer data);
+void		arv_stream_publish_infos		(ArvStream *stream);
+void		arv_stream_begin_infos_update		(ArvStream *stream);
+void		arv_stream_end_infos_update		(ArvStream *stream);
+void		arv_stream_declare_histogram		(ArvStream *stream, ArvHistogram *histogram);
+ArvHistogram *	arv_stream_get_histogram		(ArvStream *stream);
+ArvDevice *	arv_stream_get_device			(ArvStream *stream);
 
 G_END_DECLS
 
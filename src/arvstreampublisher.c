@@ -0,0 +1,780 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/**
+ * ArvStreamPublisher:
+ *
+ * [class@ArvStreamPublisher] shares the buffers of a stream with other local processes, without copy.
+ *
+ * The publisher allocates the buffer pool of the stream in a shared memory region (memfd), and pushes it to the
+ * stream. Once the application has popped a completed buffer, and is done with it, it hands the buffer over to
+ * [method@ArvStreamPublisher.publish], which announces it to the subscribers through a descriptor ring stored in the
+ * same region. Any number of [class@ArvStreamSubscriber], up to 16, can then connect to the publisher by its name,
+ * map the region, and get the published buffers.
+ *
+ * ```c
+ * publisher = arv_stream_publisher_new (stream, "camera-1", 16, arv_camera_get_payload (camera, NULL), &error);
+ * arv_camera_start_acquisition (camera, NULL);
+ * while (running) {
+ *	buffer = arv_stream_timeout_pop_buffer (stream, 1000000);
+ *	if (buffer != NULL)
+ *		arv_stream_publisher_publish (publisher, buffer);
+ * }
+ * ```
+ *
+ * Half of the buffers stay published, the oldest published buffer being given back to the stream for each new
+ * publication, unless a subscriber still holds a reference on it. In that case, the buffer is given back to the
+ * stream once released. The references of a subscriber are dropped when its connection is closed, even if the
+ * subscriber process did not exit cleanly.
+ *
+ * Subscribers map the buffer data read-only, but they have write access to the control area of the region, which
+ * holds the descriptor ring and the buffer reference counts, and they receive a writable file descriptor of the
+ * whole region. A misbehaving subscriber can then corrupt the published buffers, or the state of the other
+ * subscribers. For this reason, only the processes running as the same user as the publisher are accepted as
+ * subscribers.
+ *
+ * Shared memory stream publishing is only available on Linux.
+ */
+
+/* For memfd_create and the file sealing API */
+#define _GNU_SOURCE
+
+#include <arvstreampublisher.h>
+#include <arvsharedstreamprivate.h>
+#include <arvdebugprivate.h>
+#include <gio/gunixconnection.h>
+#include <gio/gunixsocketaddress.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+#define ARV_STREAM_PUBLISHER_POLL_TIMEOUT_MS	10
+#define ARV_STREAM_PUBLISHER_ALIGNMENT		64
+
+typedef struct {
+	void *data;
+	size_t size;
+} ArvStreamPublisherMapping;
+
+typedef struct {
+	char *name;
+	ArvStream *stream;
+
+	int fd;
+	GBytes *mapping;
+	ArvSharedStreamHeader *header;
+	guint8 *data;
+
+	guint n_slots;
+	size_t slot_size;
+
+	/* Buffers held by the publisher, NULL when owned by the stream */
+	ArvBuffer **slots;
+	GQueue published;
+	GSList *retired;
+	guint n_published_max;
+	guint32 sequence;
+
+	GSocket *socket;
+	GSocketConnection *subscribers[ARV_SHARED_STREAM_N_SUBSCRIBERS_MAX];
+	guint n_subscribers;
+
+	GMutex mutex;
+
+	GThread *thread;
+	GCancellable *cancellable;
+
+	guint64 n_published_buffers;
+} ArvStreamPublisherPrivate;
+
+struct _ArvStreamPublisher {
+	GObject	object;
+
+	ArvStreamPublisherPrivate *priv;
+};
+
+struct _ArvStreamPublisherClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvStreamPublisher, arv_stream_publisher, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvStreamPublisher))
+
+static guint64
+_align (guint64 value, guint64 alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+static void
+_mapping_free (ArvStreamPublisherMapping *mapping)
+{
+	munmap (mapping->data, mapping->size);
+	g_free (mapping);
+}
+
+static gboolean
+_create_region (ArvStreamPublisher *publisher, guint n_buffers, size_t buffer_size, GError **error)
+{
+	ArvStreamPublisherPrivate *priv = publisher->priv;
+	ArvStreamPublisherMapping *mapping;
+	ArvSharedStreamHeader *header;
+	guint64 page_size;
+	guint64 descriptors_offset;
+	guint64 slot_sequences_offset;
+	guint64 references_offset;
+	guint64 data_offset;
+	guint64 size;
+	guint32 ring_size;
+	void *data;
+	int errsv;
+
+	page_size = sysconf (_SC_PAGESIZE);
+
+	/* The descriptors of a slot must outlive its publication */
+	ring_size = 2 * n_buffers;
+
+	priv->n_slots = n_buffers;
+	priv->slot_size = _align (buffer_size, page_size);
+
+	descriptors_offset = _align (sizeof (ArvSharedStreamHeader), ARV_STREAM_PUBLISHER_ALIGNMENT);
+	slot_sequences_offset = _align (descriptors_offset + ring_size * sizeof (ArvSharedStreamDescriptor),
+					ARV_STREAM_PUBLISHER_ALIGNMENT);
+	references_offset = _align (slot_sequences_offset + n_buffers * sizeof (gint),
+				    ARV_STREAM_PUBLISHER_ALIGNMENT);
+	data_offset = _align (references_offset + ARV_SHARED_STREAM_N_SUBSCRIBERS_MAX * n_buffers * sizeof (gint),
+			      page_size);
+	size = data_offset + (guint64) n_buffers * priv->slot_size;
+
+	priv->fd = memfd_create (priv->name, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+	if (priv->fd < 0) {
+		errsv = errno;
+		g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+			     "Failed to create shared memory for stream '%s': %s", priv->name, g_strerror (errsv));
+		return FALSE;
+	}
+
+	/* Subscribers can trust the region size */
+	if (ftruncate (priv->fd, size) != 0 ||
+	    fcntl (priv->fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0) {
+		errsv = errno;
+		g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+			     "Failed to size shared memory for stream '%s': %s", priv->name, g_strerror (errsv));
+		return FALSE;
+	}
+
+	data = mmap (NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, priv->fd, 0);
+	if (data == MAP_FAILED) {
+		errsv = errno;
+		g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+			     "Failed to map shared memory for stream '%s': %s", priv->name, g_strerror (errsv));
+		return FALSE;
+	}
+
+	mapping = g_new (ArvStreamPublisherMapping, 1);
+	mapping->data = data;
+	mapping->size = size;
+
+	/* The buffers given to the stream keep the region mapped */
+	priv->mapping = g_bytes_new_with_free_func (data, size, (GDestroyNotify) _mapping_free, mapping);
+
+	header = data;
+	header->magic = ARV_SHARED_STREAM_MAGIC;
+	header->version = ARV_SHARED_STREAM_VERSION;
+	header->descriptor_size = sizeof (ArvSharedStreamDescriptor);
+	header->n_slots = n_buffers;
+	header->ring_size = ring_size;
+	header->n_subscribers_max = ARV_SHARED_STREAM_N_SUBSCRIBERS_MAX;
+	header->slot_size = priv->slot_size;
+	header->size = size;
+	header->descriptors_offset = descriptors_offset;
+	header->slot_sequences_offset = slot_sequences_offset;
+	header->references_offset = references_offset;
+	header->data_offset = data_offset;
+
+	priv->header = header;
+	priv->data = (guint8 *) data + data_offset;
+
+	arv_info_stream ("[StreamPublisher::create_region] %u buffers of %" G_GSIZE_FORMAT " bytes "
+			 "(%" G_GUINT64_FORMAT " bytes of shared memory)", n_buffers, buffer_size, size);
+
+	return TRUE;
+}
+
+static gboolean
+_listen (ArvStreamPublisher *publisher, GError **error)
+{
+	ArvStreamPublisherPrivate *priv = publisher->priv;
+	GSocketAddress *address;
+	char *socket_name;
+	gboolean success;
+
+	priv->socket = g_socket_new (G_SOCKET_FAMILY_UNIX, G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_DEFAULT, error);
+	if (priv->socket == NULL)
+		return FALSE;
+
+	/* The abstract namespace doesn't leave a socket file behind */
+	socket_name = g_strconcat (ARV_SHARED_STREAM_SOCKET_PREFIX, priv->name, NULL);
+	address = g_unix_socket_address_new_with_type (socket_name, -1, G_UNIX_SOCKET_ADDRESS_ABSTRACT);
+	g_free (socket_name);
+
+	success = g_socket_bind (priv->socket, address, FALSE, error) && g_socket_listen (priv->socket, error);
+	g_object_unref (address);
+
+	if (success)
+		g_socket_set_blocking (priv->socket, FALSE);
+
+	return success;
+}
+
+static gint
+_get_slot (ArvStreamPublisher *publisher, ArvBuffer *buffer)
+{
+	ArvStreamPublisherPrivate *priv = publisher->priv;
+	ptrdiff_t offset;
+
+	if (buffer->priv->data < priv->data ||
+	    buffer->priv->data >= priv->data + (size_t) priv->n_slots * priv->slot_size)
+		return -1;
+
+	offset = buffer->priv->data - priv->data;
+	if (offset % priv->slot_size != 0)
+		return -1;
+
+	return offset / priv->slot_size;
+}
+
+static gboolean
+_is_slot_referenced (ArvStreamPublisher *publisher, guint slot)
+{
+	guint i;
+
+	for (i = 0; i < ARV_SHARED_STREAM_N_SUBSCRIBERS_MAX; i++)
+		if (g_atomic_int_get (arv_shared_stream_get_reference (publisher->priv->header, i, slot)) > 0)
+			return TRUE;
+
+	return FALSE;
+}
+
+static void
+_recycle_slot (ArvStreamPublisher *publisher, guint slot)
+{
+	ArvStreamPublisherPrivate *priv = publisher->priv;
+	ArvBuffer *buffer = priv->slots[slot];
+
+	priv->slots[slot] = NULL;
+	arv_stream_push_buffer (priv->stream, buffer);
+}
+
+static void
+_retire_slot (ArvStreamPublisher *publisher, guint slot)
+{
+	ArvStreamPublisherPrivate *priv = publisher->priv;
+
+	/* Clear the slot sequence before looking at the references, see arvsharedstreamprivate.h */
+	g_atomic_int_set (arv_shared_stream_get_slot_sequence (priv->header, slot), 0);
+
+	if (_is_slot_referenced (publisher, slot))
+		priv->retired = g_slist_prepend (priv->retired, GUINT_TO_POINTER (slot));
+	else
+		_recycle_slot (publisher, slot);
+}
+
+static void
+_reclaim_retired_slots (ArvStreamPublisher *publisher)
+{
+	ArvStreamPublisherPrivate *priv = publisher->priv;
+	GSList *iter;
+	GSList *next;
+
+	for (iter = priv->retired; iter != NULL; iter = next) {
+		guint slot = GPOINTER_TO_UINT (iter->data);
+
+		next = iter->next;
+
+		if (!_is_slot_referenced (publisher, slot)) {
+			_recycle_slot (publisher, slot);
+			priv->retired = g_slist_delete_link (priv->retired, iter);
+		}
+	}
+}
+
+static void
+_remove_subscriber (ArvStreamPublisher *publisher, guint index)
+{
+	ArvStreamPublisherPrivate *priv = publisher->priv;
+	guint i;
+
+	g_clear_object (&priv->subscribers[index]);
+	priv->n_subscribers--;
+
+	/* Drop the references the subscriber may have left behind */
+	for (i = 0; i < priv->n_slots; i++)
+		g_atomic_int_set (arv_shared_stream_get_reference (priv->header, index, i), 0);
+
+	arv_info_stream ("[StreamPublisher::remove_subscriber] Subscriber %u disconnected from '%s'",
+			 index, priv->name);
+}
+
+static gboolean
+_is_same_user (GSocket *socket)
+{
+	GCredentials *peer_credentials;
+	GCredentials *credentials;
+	gboolean is_same_user;
+
+	peer_credentials = g_socket_get_credentials (socket, NULL);
+	if (peer_credentials == NULL)
+		return FALSE;
+
+	credentials = g_credentials_new ();
+	is_same_user = g_credentials_is_same_user (peer_credentials, credentials, NULL);
+
+	g_object_unref (credentials);
+	g_object_unref (peer_credentials);
+
+	return is_same_user;
+}
+
+static void
+_accept_subscriber (ArvStreamPublisher *publisher)
+{
+	ArvStreamPublisherPrivate *priv = publisher->priv;
+	GSocketConnection *connection;
+	GSocket *socket;
+	GError *error = NULL;
+	guint32 index;
+
+	socket = g_socket_accept (priv->socket, NULL, &error);
+	if (socket == NULL) {
+		if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK))
+			arv_warning_stream ("[StreamPublisher::accept_subscriber] Failed to accept subscriber (%s)",
+					    error->message);
+		g_clear_error (&error);
+		return;
+	}
+
+	/* Subscribers get write access to the shared memory, only trust the processes of the same user */
+	if (!_is_same_user (socket)) {
+		arv_warning_stream ("[StreamPublisher::accept_subscriber] Subscriber of '%s' rejected, "
+				    "not running as the same user", priv->name);
+		g_object_unref (socket);
+		return;
+	}
+
+	connection = g_socket_connection_factory_create_connection (socket);
+	g_object_unref (socket);
+
+	g_mutex_lock (&priv->mutex);
+
+	for (index = 0; index < ARV_SHARED_STREAM_N_SUBSCRIBERS_MAX; index++)
+		if (priv->subscribers[index] == NULL)
+			break;
+
+	if (index >= ARV_SHARED_STREAM_N_SUBSCRIBERS_MAX) {
+		g_mutex_unlock (&priv->mutex);
+		arv_warning_stream ("[StreamPublisher::accept_subscriber] Too many subscribers for '%s'", priv->name);
+		g_object_unref (connection);
+		return;
+	}
+
+	/* The subscriber gets the shared memory, and the index of its reference row */
+	if (!g_unix_connection_send_fd (G_UNIX_CONNECTION (connection), priv->fd, NULL, &error) ||
+	    !g_output_stream_write_all (g_io_stream_get_output_stream (G_IO_STREAM (connection)),
+					&index, sizeof (index), NULL, NULL, &error)) {
+		g_mutex_unlock (&priv->mutex);
+		arv_warning_stream ("[StreamPublisher::accept_subscriber] Failed to send shared memory (%s)",
+				    error->message);
+		g_clear_error (&error);
+		g_object_unref (connection);
+		return;
+	}
+
+	g_socket_set_blocking (g_socket_connection_get_socket (connection), FALSE);
+
+	priv->subscribers[index] = connection;
+	priv->n_subscribers++;
+
+	g_mutex_unlock (&priv->mutex);
+
+	arv_info_stream ("[StreamPublisher::accept_subscriber] Subscriber %u connected to '%s'", index, priv->name);
+}
+
+static void
+_check_subscriber (ArvStreamPublisher *publisher, guint index)
+{
+	ArvStreamPublisherPrivate *priv = publisher->priv;
+	GError *error = NULL;
+	char data[64];
+	gssize n_bytes;
+
+	if (priv->subscribers[index] == NULL)
+		return;
+
+	/* Subscribers don't send anything, the socket is readable when the connection is closed */
+	n_bytes = g_socket_receive (g_socket_connection_get_socket (priv->subscribers[index]),
+				    data, sizeof (data), NULL, &error);
+	if (n_bytes == 0 ||
+	    (n_bytes < 0 && !g_error_matches (error, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK)))
+		_remove_subscriber (publisher, index);
+
+	g_clear_error (&error);
+}
+
+static void
+_notify_subscribers (ArvStreamPublisher *publisher, guint32 sequence)
+{
+	ArvStreamPublisherPrivate *priv = publisher->priv;
+	guint i;
+
+	/* Notifications only wake up the subscribers, a subscriber which is not reading them may miss some */
+	for (i = 0; i < ARV_SHARED_STREAM_N_SUBSCRIBERS_MAX; i++)
+		if (priv->subscribers[i] != NULL)
+			g_socket_send (g_socket_connection_get_socket (priv->subscribers[i]),
+				       (const char *) &sequence, sizeof (sequence), NULL, NULL);
+}
+
+static void *
+_publisher_thread (void *data)
+{
+	ArvStreamPublisher *publisher = data;
+	ArvStreamPublisherPrivate *priv = publisher->priv;
+	GPollFD poll_fds[ARV_SHARED_STREAM_N_SUBSCRIBERS_MAX + 2];
+	guint indexes[ARV_SHARED_STREAM_N_SUBSCRIBERS_MAX + 1];
+	gboolean use_poll;
+	GPollFD cancel_fd;
+	guint n_fds;
+	guint i;
+
+	use_poll = g_cancellable_make_pollfd (priv->cancellable, &cancel_fd);
+
+	while (!g_cancellable_is_cancelled (priv->cancellable)) {
+		n_fds = 0;
+
+		poll_fds[n_fds].fd = g_socket_get_fd (priv->socket);
+		poll_fds[n_fds].events = G_IO_IN;
+		poll_fds[n_fds].revents = 0;
+		n_fds++;
+
+		g_mutex_lock (&priv->mutex);
+		for (i = 0; i < ARV_SHARED_STREAM_N_SUBSCRIBERS_MAX; i++) {
+			if (priv->subscribers[i] != NULL) {
+				poll_fds[n_fds].fd = g_socket_get_fd (g_socket_connection_get_socket
+								      (priv->subscribers[i]));
+				poll_fds[n_fds].events = G_IO_IN;
+				poll_fds[n_fds].revents = 0;
+				indexes[n_fds] = i;
+				n_fds++;
+			}
+		}
+		g_mutex_unlock (&priv->mutex);
+
+		if (use_poll) {
+			poll_fds[n_fds] = cancel_fd;
+			poll_fds[n_fds].revents = 0;
+		}
+
+		/* The timeout is used for the release of the retired slots */
+		g_poll (poll_fds, use_poll ? n_fds + 1 : n_fds, ARV_STREAM_PUBLISHER_POLL_TIMEOUT_MS);
+
+		if (poll_fds[0].revents != 0)
+			_accept_subscriber (publisher);
+
+		g_mutex_lock (&priv->mutex);
+		for (i = 1; i < n_fds; i++)
+			if (poll_fds[i].revents != 0)
+				_check_subscriber (publisher, indexes[i]);
+
+		_reclaim_retired_slots (publisher);
+		g_mutex_unlock (&priv->mutex);
+	}
+
+	if (use_poll)
+		g_cancellable_release_fd (priv->cancellable);
+
+	return NULL;
+}
+
+/**
+ * arv_stream_publisher_new:
+ * @stream: a #ArvStream
+ * @name: publisher name, used by the subscribers to connect
+ * @n_buffers: number of buffers to allocate, at least 2
+ * @buffer_size: size of the buffers, usually the payload size of the camera
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Allocates @n_buffers buffers in a shared memory region, and pushes them to @stream. The publisher name must be
+ * unique on the host.
+ *
+ * Returns: (transfer full): a new #ArvStreamPublisher, %NULL on error
+ *
+ * Since: 0.9.0
+ */
+
+ArvStreamPublisher *
+arv_stream_publisher_new (ArvStream *stream, const char *name, guint n_buffers, size_t buffer_size, GError **error)
+{
+	ArvStreamPublisher *publisher;
+	ArvStreamPublisherPrivate *priv;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
+	g_return_val_if_fail (name != NULL, NULL);
+	g_return_val_if_fail (n_buffers >= 2, NULL);
+	g_return_val_if_fail (buffer_size > 0, NULL);
+
+	publisher = g_object_new (ARV_TYPE_STREAM_PUBLISHER, NULL);
+	priv = publisher->priv;
+
+	priv->name = g_strdup (name);
+	priv->stream = g_object_ref (stream);
+
+	if (!_create_region (publisher, n_buffers, buffer_size, error) ||
+	    !_listen (publisher, error)) {
+		g_object_unref (publisher);
+		return NULL;
+	}
+
+	priv->slots = g_new0 (ArvBuffer *, n_buffers);
+	priv->n_published_max = n_buffers / 2;
+
+	for (i = 0; i < n_buffers; i++)
+		arv_stream_push_buffer (stream, arv_buffer_new_full (buffer_size,
+								     priv->data + (size_t) i * priv->slot_size,
+								     g_bytes_ref (priv->mapping),
+								     (GDestroyNotify) g_bytes_unref));
+
+	priv->cancellable = g_cancellable_new ();
+	priv->thread = g_thread_new ("arv_stream_publisher", _publisher_thread, publisher);
+
+	return publisher;
+}
+
+/**
+ * arv_stream_publisher_get_name:
+ * @publisher: a #ArvStreamPublisher
+ *
+ * Returns: the name used by the subscribers to connect to @publisher
+ *
+ * Since: 0.9.0
+ */
+
+const char *
+arv_stream_publisher_get_name (ArvStreamPublisher *publisher)
+{
+	g_return_val_if_fail (ARV_IS_STREAM_PUBLISHER (publisher), NULL);
+
+	return publisher->priv->name;
+}
+
+/**
+ * arv_stream_publisher_get_n_subscribers:
+ * @publisher: a #ArvStreamPublisher
+ *
+ * Returns: the number of connected subscribers
+ *
+ * Since: 0.9.0
+ */
+
+guint
+arv_stream_publisher_get_n_subscribers (ArvStreamPublisher *publisher)
+{
+	guint n_subscribers;
+
+	g_return_val_if_fail (ARV_IS_STREAM_PUBLISHER (publisher), 0);
+
+	g_mutex_lock (&publisher->priv->mutex);
+	n_subscribers = publisher->priv->n_subscribers;
+	g_mutex_unlock (&publisher->priv->mutex);
+
+	return n_subscribers;
+}
+
+/**
+ * arv_stream_publisher_get_n_published_buffers:
+ * @publisher: a #ArvStreamPublisher
+ *
+ * Returns: the number of buffers published since the creation of @publisher
+ *
+ * Since: 0.9.0
+ */
+
+guint64
+arv_stream_publisher_get_n_published_buffers (ArvStreamPublisher *publisher)
+{
+	guint64 n_published_buffers;
+
+	g_return_val_if_fail (ARV_IS_STREAM_PUBLISHER (publisher), 0);
+
+	g_mutex_lock (&publisher->priv->mutex);
+	n_published_buffers = publisher->priv->n_published_buffers;
+	g_mutex_unlock (&publisher->priv->mutex);
+
+	return n_published_buffers;
+}
+
+/**
+ * arv_stream_publisher_publish:
+ * @publisher: a #ArvStreamPublisher
+ * @buffer: (transfer full): a buffer popped from the stream
+ *
+ * Announces @buffer to the subscribers. The publisher takes ownership of @buffer, and gives it back to the stream
+ * when it is not published anymore. Buffers which are not successfully completed are given back to the stream
+ * without publication.
+ *
+ * Since: 0.9.0
+ */
+
+void
+arv_stream_publisher_publish (ArvStreamPublisher *publisher, ArvBuffer *buffer)
+{
+	ArvStreamPublisherPrivate *priv;
+	ArvSharedStreamDescriptor *descriptor;
+	guint32 sequence;
+	gint slot;
+	guint i;
+
+	g_return_if_fail (ARV_IS_STREAM_PUBLISHER (publisher));
+	g_return_if_fail (ARV_IS_BUFFER (buffer));
+
+	priv = publisher->priv;
+
+	slot = _get_slot (publisher, buffer);
+	if (slot < 0) {
+		arv_warning_stream ("[StreamPublisher::publish] Buffer not allocated by publisher '%s'", priv->name);
+		arv_stream_push_buffer (priv->stream, buffer);
+		return;
+	}
+
+	if (buffer->priv->status != ARV_BUFFER_STATUS_SUCCESS) {
+		arv_stream_push_buffer (priv->stream, buffer);
+		return;
+	}
+
+	g_mutex_lock (&priv->mutex);
+
+	priv->sequence = arv_shared_stream_next_sequence (priv->sequence);
+	sequence = priv->sequence;
+
+	descriptor = arv_shared_stream_get_descriptor (priv->header, sequence);
+
+	/* Invalidate the descriptor while it is written */
+	g_atomic_int_set (&descriptor->sequence, 0);
+
+	descriptor->slot = slot;
+	descriptor->status = buffer->priv->status;
+	descriptor->payload_type = buffer->priv->payload_type;
+	descriptor->received_size = buffer->priv->received_size;
+	descriptor->frame_id = buffer->priv->frame_id;
+	descriptor->timestamp_ns = buffer->priv->timestamp_ns;
+	descriptor->system_timestamp_ns = buffer->priv->system_timestamp_ns;
+	descriptor->has_chunks = buffer->priv->has_chunks;
+	descriptor->chunk_endianness = buffer->priv->chunk_endianness;
+	descriptor->has_gendc = buffer->priv->has_gendc;
+	descriptor->gendc_descriptor_size = buffer->priv->gendc_descriptor_size;
+	descriptor->gendc_data_size = buffer->priv->gendc_data_size;
+	descriptor->gendc_data_offset = buffer->priv->gendc_data_offset;
+	descriptor->n_parts = MIN (buffer->priv->n_parts, ARV_SHARED_STREAM_N_PARTS_MAX);
+	for (i = 0; i < descriptor->n_parts; i++)
+		descriptor->parts[i] = buffer->priv->parts[i];
+
+	if (buffer->priv->n_parts > ARV_SHARED_STREAM_N_PARTS_MAX)
+		arv_warning_stream ("[StreamPublisher::publish] Only %d of the %u buffer parts are published",
+				    ARV_SHARED_STREAM_N_PARTS_MAX, buffer->priv->n_parts);
+
+	g_atomic_int_set (arv_shared_stream_get_slot_sequence (priv->header, slot), sequence);
+	g_atomic_int_set (&descriptor->sequence, sequence);
+	g_atomic_int_set (&priv->header->write_sequence, sequence);
+
+	priv->slots[slot] = buffer;
+	g_queue_push_tail (&priv->published, GINT_TO_POINTER (slot));
+
+	while (g_queue_get_length (&priv->published) > priv->n_published_max)
+		_retire_slot (publisher, GPOINTER_TO_INT (g_queue_pop_head (&priv->published)));
+
+	_reclaim_retired_slots (publisher);
+
+	priv->n_published_buffers++;
+
+	_notify_subscribers (publisher, sequence);
+
+	g_mutex_unlock (&priv->mutex);
+}
+
+static void
+arv_stream_publisher_init (ArvStreamPublisher *publisher)
+{
+	publisher->priv = arv_stream_publisher_get_instance_private (publisher);
+
+	publisher->priv->fd = -1;
+	g_queue_init (&publisher->priv->published);
+	g_mutex_init (&publisher->priv->mutex);
+}
+
+static void
+arv_stream_publisher_finalize (GObject *object)
+{
+	ArvStreamPublisher *publisher = ARV_STREAM_PUBLISHER (object);
+	ArvStreamPublisherPrivate *priv = publisher->priv;
+	guint i;
+
+	if (priv->thread != NULL) {
+		g_cancellable_cancel (priv->cancellable);
+		g_thread_join (priv->thread);
+		priv->thread = NULL;
+	}
+	g_clear_object (&priv->cancellable);
+
+	for (i = 0; i < ARV_SHARED_STREAM_N_SUBSCRIBERS_MAX; i++)
+		g_clear_object (&priv->subscribers[i]);
+	g_clear_object (&priv->socket);
+
+	/* The buffers stay usable by the stream, as they keep the region mapped */
+	if (priv->slots != NULL) {
+		for (i = 0; i < priv->n_slots; i++)
+			if (priv->slots[i] != NULL)
+				arv_stream_push_buffer (priv->stream, priv->slots[i]);
+		g_free (priv->slots);
+	}
+	g_queue_clear (&priv->published);
+	g_slist_free (priv->retired);
+
+	g_clear_pointer (&priv->mapping, g_bytes_unref);
+	if (priv->fd >= 0)
+		close (priv->fd);
+
+	g_clear_object (&priv->stream);
+	g_clear_pointer (&priv->name, g_free);
+
+	g_mutex_clear (&priv->mutex);
+
+	G_OBJECT_CLASS (arv_stream_publisher_parent_class)->finalize (object);
+}
+
+static void
+arv_stream_publisher_class_init (ArvStreamPublisherClass *this_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
+
+	object_class->finalize = arv_stream_publisher_finalize;
+}
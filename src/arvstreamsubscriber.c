@@ -0,0 +1,511 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/**
+ * ArvStreamSubscriber:
+ *
+ * [class@ArvStreamSubscriber] receives the buffers of a [class@ArvStreamPublisher], usually running in another
+ * process, without copy.
+ *
+ * ```c
+ * subscriber = arv_stream_subscriber_new ("camera-1", &error);
+ * while (running) {
+ *	buffer = arv_stream_subscriber_timeout_pop_buffer (subscriber, 1000000);
+ *	if (buffer != NULL) {
+ *		process (arv_buffer_get_image_data (buffer, NULL));
+ *		g_object_unref (buffer);
+ *	}
+ * }
+ * ```
+ *
+ * The returned buffers point to the shared memory of the publisher, whose buffer data are mapped read-only: writing
+ * to their data crashes the subscriber. The control area of the shared memory, holding the buffer descriptors and
+ * reference counts, is writable by the subscribers, which must run as the same user as the publisher.
+ *
+ * The buffers hold a reference on the underlying publisher buffer, which is given back to the camera stream once all
+ * the subscribers have released it. Subscribers should then release the buffers as soon as possible, as a held
+ * buffer is not available for the acquisition anymore.
+ *
+ * A subscriber receives the buffers published after its creation, in order. Buffers not popped before the publisher
+ * reuses them are counted as missed. The user data of the returned buffers is used internally.
+ *
+ * A subscriber is not thread safe, but the buffers it returns can be used and released from any thread.
+ */
+
+#include <arvstreamsubscriber.h>
+#include <arvsharedstreamprivate.h>
+#include <arvdebugprivate.h>
+#include <gio/gunixconnection.h>
+#include <gio/gunixsocketaddress.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <errno.h>
+
+typedef struct {
+	void *control;
+	size_t control_size;
+	void *data;
+	size_t data_size;
+	GSocketConnection *connection;
+} ArvStreamSubscriberMapping;
+
+typedef struct {
+	GBytes *mapping;
+	gint *reference;
+} ArvStreamSubscriberLease;
+
+typedef struct {
+	char *name;
+
+	GBytes *mapping;
+	GSocket *socket;
+	ArvSharedStreamHeader *header;
+	const guint8 *data;
+	guint32 index;
+
+	guint32 next_sequence;
+	gboolean is_connected;
+
+	guint64 n_received_buffers;
+	guint64 n_missed_buffers;
+} ArvStreamSubscriberPrivate;
+
+struct _ArvStreamSubscriber {
+	GObject	object;
+
+	ArvStreamSubscriberPrivate *priv;
+};
+
+struct _ArvStreamSubscriberClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvStreamSubscriber, arv_stream_subscriber, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvStreamSubscriber))
+
+/* The connection is closed once the subscriber and all its buffers are released, which drops the subscriber
+ * references on the publisher side */
+
+static void
+_mapping_free (ArvStreamSubscriberMapping *mapping)
+{
+	if (mapping->data != NULL)
+		munmap (mapping->data, mapping->data_size);
+	if (mapping->control != NULL)
+		munmap (mapping->control, mapping->control_size);
+	g_clear_object (&mapping->connection);
+	g_free (mapping);
+}
+
+static void
+_lease_free (ArvStreamSubscriberLease *lease)
+{
+	g_atomic_int_dec_and_test (lease->reference);
+	g_bytes_unref (lease->mapping);
+	g_free (lease);
+}
+
+static gboolean
+_map_region (ArvStreamSubscriber *subscriber, int fd, GSocketConnection *connection, GError **error)
+{
+	ArvStreamSubscriberPrivate *priv = subscriber->priv;
+	ArvStreamSubscriberMapping *mapping;
+	ArvSharedStreamHeader header;
+	struct stat stat_buffer;
+	int errsv;
+
+	if (fstat (fd, &stat_buffer) != 0 ||
+	    pread (fd, &header, sizeof (header), 0) != sizeof (header)) {
+		errsv = errno;
+		g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+			     "Failed to read shared memory of stream '%s': %s", priv->name, g_strerror (errsv));
+		return FALSE;
+	}
+
+	if (header.magic != ARV_SHARED_STREAM_MAGIC ||
+	    header.version != ARV_SHARED_STREAM_VERSION ||
+	    header.descriptor_size != sizeof (ArvSharedStreamDescriptor) ||
+	    header.n_slots == 0 || header.ring_size == 0 ||
+	    header.size != (guint64) stat_buffer.st_size ||
+	    header.data_offset + header.n_slots * header.slot_size != header.size ||
+	    priv->index >= header.n_subscribers_max) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+			     "Invalid shared memory layout for stream '%s'", priv->name);
+		return FALSE;
+	}
+
+	mapping = g_new0 (ArvStreamSubscriberMapping, 1);
+	mapping->connection = g_object_ref (connection);
+	mapping->control_size = header.data_offset;
+	mapping->data_size = header.size - header.data_offset;
+
+	/* Only the control area, holding the reference counts, is writable */
+	mapping->control = mmap (NULL, mapping->control_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (mapping->control == MAP_FAILED)
+		mapping->control = NULL;
+	mapping->data = mmap (NULL, mapping->data_size, PROT_READ, MAP_SHARED, fd, header.data_offset);
+	if (mapping->data == MAP_FAILED)
+		mapping->data = NULL;
+
+	if (mapping->control == NULL || mapping->data == NULL) {
+		errsv = errno;
+		g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+			     "Failed to map shared memory of stream '%s': %s", priv->name, g_strerror (errsv));
+		_mapping_free (mapping);
+		return FALSE;
+	}
+
+	priv->mapping = g_bytes_new_with_free_func (mapping->data, mapping->data_size,
+						    (GDestroyNotify) _mapping_free, mapping);
+	priv->header = mapping->control;
+	priv->data = mapping->data;
+
+	return TRUE;
+}
+
+/**
+ * arv_stream_subscriber_new:
+ * @name: name of the publisher
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Connects to the [class@ArvStreamPublisher] named @name.
+ *
+ * Returns: (transfer full): a new #ArvStreamSubscriber, %NULL on error
+ *
+ * Since: 0.9.0
+ */
+
+ArvStreamSubscriber *
+arv_stream_subscriber_new (const char *name, GError **error)
+{
+	ArvStreamSubscriber *subscriber;
+	ArvStreamSubscriberPrivate *priv;
+	GSocketConnection *connection;
+	GSocketAddress *address;
+	GSocketClient *client;
+	GError *local_error = NULL;
+	char *socket_name;
+	gsize n_bytes;
+	int fd;
+
+	g_return_val_if_fail (name != NULL, NULL);
+
+	socket_name = g_strconcat (ARV_SHARED_STREAM_SOCKET_PREFIX, name, NULL);
+	address = g_unix_socket_address_new_with_type (socket_name, -1, G_UNIX_SOCKET_ADDRESS_ABSTRACT);
+	g_free (socket_name);
+
+	client = g_socket_client_new ();
+	connection = g_socket_client_connect (client, G_SOCKET_CONNECTABLE (address), NULL, error);
+	g_object_unref (client);
+	g_object_unref (address);
+
+	if (connection == NULL)
+		return NULL;
+
+	subscriber = g_object_new (ARV_TYPE_STREAM_SUBSCRIBER, NULL);
+	priv = subscriber->priv;
+	priv->name = g_strdup (name);
+
+	fd = g_unix_connection_receive_fd (G_UNIX_CONNECTION (connection), NULL, &local_error);
+	if (fd >= 0) {
+		g_input_stream_read_all (g_io_stream_get_input_stream (G_IO_STREAM (connection)),
+					 &priv->index, sizeof (priv->index), &n_bytes, NULL, &local_error);
+		if (local_error == NULL && n_bytes != sizeof (priv->index))
+			local_error = g_error_new (G_IO_ERROR, G_IO_ERROR_CLOSED,
+						   "Connection to stream '%s' closed", name);
+		if (local_error == NULL)
+			_map_region (subscriber, fd, connection, &local_error);
+		close (fd);
+	}
+
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		g_object_unref (connection);
+		g_object_unref (subscriber);
+		return NULL;
+	}
+
+	/* The connection is owned by the mapping */
+	priv->socket = g_socket_connection_get_socket (connection);
+	g_socket_set_blocking (priv->socket, FALSE);
+	g_object_unref (connection);
+
+	priv->is_connected = TRUE;
+	priv->next_sequence = arv_shared_stream_next_sequence (g_atomic_int_get (&priv->header->write_sequence));
+
+	arv_info_stream ("[StreamSubscriber::new] Connected to '%s' as subscriber %u", name, priv->index);
+
+	return subscriber;
+}
+
+static ArvBuffer *
+_acquire_buffer (ArvStreamSubscriber *subscriber, guint32 sequence)
+{
+	ArvStreamSubscriberPrivate *priv = subscriber->priv;
+	ArvSharedStreamDescriptor *shared_descriptor;
+	ArvSharedStreamDescriptor descriptor;
+	ArvStreamSubscriberLease *lease;
+	ArvBuffer *buffer;
+	gint *reference;
+	guint i;
+
+	shared_descriptor = arv_shared_stream_get_descriptor (priv->header, sequence);
+
+	if ((guint32) g_atomic_int_get (&shared_descriptor->sequence) != sequence)
+		return NULL;
+	descriptor = *shared_descriptor;
+	if ((guint32) g_atomic_int_get (&shared_descriptor->sequence) != sequence)
+		return NULL;
+
+	if (descriptor.slot >= priv->header->n_slots ||
+	    descriptor.n_parts > ARV_SHARED_STREAM_N_PARTS_MAX ||
+	    descriptor.received_size > priv->header->slot_size)
+		return NULL;
+
+	/* Take the reference before checking the slot is still published, see arvsharedstreamprivate.h */
+	reference = arv_shared_stream_get_reference (priv->header, priv->index, descriptor.slot);
+	g_atomic_int_inc (reference);
+	if ((guint32) g_atomic_int_get (arv_shared_stream_get_slot_sequence (priv->header, descriptor.slot)) !=
+	    sequence) {
+		g_atomic_int_dec_and_test (reference);
+		return NULL;
+	}
+
+	lease = g_new (ArvStreamSubscriberLease, 1);
+	lease->mapping = g_bytes_ref (priv->mapping);
+	lease->reference = reference;
+
+	buffer = arv_buffer_new_full (priv->header->slot_size,
+				      (void *) (priv->data + (size_t) descriptor.slot * priv->header->slot_size),
+				      lease, (GDestroyNotify) _lease_free);
+
+	buffer->priv->status = descriptor.status;
+	buffer->priv->payload_type = descriptor.payload_type;
+	buffer->priv->received_size = descriptor.received_size;
+	buffer->priv->frame_id = descriptor.frame_id;
+	buffer->priv->timestamp_ns = descriptor.timestamp_ns;
+	buffer->priv->system_timestamp_ns = descriptor.system_timestamp_ns;
+	buffer->priv->has_chunks = descriptor.has_chunks;
+	buffer->priv->chunk_endianness = descriptor.chunk_endianness;
+	buffer->priv->has_gendc = descriptor.has_gendc;
+	buffer->priv->gendc_descriptor_size = descriptor.gendc_descriptor_size;
+	buffer->priv->gendc_data_size = descriptor.gendc_data_size;
+	buffer->priv->gendc_data_offset = descriptor.gendc_data_offset;
+
+	arv_buffer_set_n_parts (buffer, descriptor.n_parts);
+	for (i = 0; i < descriptor.n_parts; i++)
+		buffer->priv->parts[i] = descriptor.parts[i];
+
+	return buffer;
+}
+
+/**
+ * arv_stream_subscriber_try_pop_buffer:
+ * @subscriber: a #ArvStreamSubscriber
+ *
+ * Returns the next published buffer, if any.
+ *
+ * Returns: (transfer full) (nullable): a read-only #ArvBuffer, %NULL if no new buffer was published
+ *
+ * Since: 0.9.0
+ */
+
+ArvBuffer *
+arv_stream_subscriber_try_pop_buffer (ArvStreamSubscriber *subscriber)
+{
+	ArvStreamSubscriberPrivate *priv;
+	ArvBuffer *buffer;
+	guint32 write_sequence;
+
+	g_return_val_if_fail (ARV_IS_STREAM_SUBSCRIBER (subscriber), NULL);
+
+	priv = subscriber->priv;
+
+	write_sequence = g_atomic_int_get (&priv->header->write_sequence);
+
+	/* Skip the descriptors already overwritten in the ring */
+	if ((gint32) (write_sequence - priv->next_sequence) >= (gint32) priv->header->ring_size) {
+		guint32 n_skipped = write_sequence - priv->next_sequence + 1 - priv->header->ring_size;
+
+		priv->n_missed_buffers += n_skipped;
+		priv->next_sequence += n_skipped;
+		if (priv->next_sequence == 0)
+			priv->next_sequence = 1;
+	}
+
+	while ((gint32) (write_sequence - priv->next_sequence) >= 0) {
+		guint32 sequence = priv->next_sequence;
+
+		priv->next_sequence = arv_shared_stream_next_sequence (sequence);
+
+		buffer = _acquire_buffer (subscriber, sequence);
+		if (buffer != NULL) {
+			priv->n_received_buffers++;
+			return buffer;
+		}
+
+		priv->n_missed_buffers++;
+	}
+
+	return NULL;
+}
+
+/* Waits for a publication notification. Returns FALSE if the publisher is gone. */
+
+static gboolean
+_wait_publication (ArvStreamSubscriber *subscriber, gint64 timeout_us)
+{
+	ArvStreamSubscriberPrivate *priv = subscriber->priv;
+	guint32 sequences[64];
+	gssize n_bytes;
+
+	if (!priv->is_connected)
+		return FALSE;
+
+	if (!g_socket_condition_timed_wait (priv->socket, G_IO_IN, timeout_us, NULL, NULL))
+		return TRUE;
+
+	/* Notifications only wake up the subscriber, the descriptor ring is the reference */
+	n_bytes = g_socket_receive (priv->socket, (char *) sequences, sizeof (sequences), NULL, NULL);
+	if (n_bytes == 0) {
+		arv_info_stream ("[StreamSubscriber::wait_publication] Publisher '%s' is gone", priv->name);
+		priv->is_connected = FALSE;
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/**
+ * arv_stream_subscriber_timeout_pop_buffer:
+ * @subscriber: a #ArvStreamSubscriber
+ * @timeout: timeout, in µs
+ *
+ * Returns the next published buffer, waiting for its publication for at most @timeout µs.
+ *
+ * Returns: (transfer full) (nullable): a read-only #ArvBuffer, %NULL on timeout or if the publisher is gone
+ *
+ * Since: 0.9.0
+ */
+
+ArvBuffer *
+arv_stream_subscriber_timeout_pop_buffer (ArvStreamSubscriber *subscriber, guint64 timeout)
+{
+	ArvBuffer *buffer;
+	gint64 end_time;
+
+	g_return_val_if_fail (ARV_IS_STREAM_SUBSCRIBER (subscriber), NULL);
+
+	end_time = g_get_monotonic_time () + timeout;
+
+	do {
+		gint64 now;
+
+		buffer = arv_stream_subscriber_try_pop_buffer (subscriber);
+		if (buffer != NULL)
+			return buffer;
+
+		now = g_get_monotonic_time ();
+		if (now >= end_time)
+			return NULL;
+
+		if (!_wait_publication (subscriber, end_time - now))
+			return arv_stream_subscriber_try_pop_buffer (subscriber);
+	} while (TRUE);
+}
+
+/**
+ * arv_stream_subscriber_is_connected:
+ * @subscriber: a #ArvStreamSubscriber
+ *
+ * Returns: %FALSE once the publisher is gone
+ *
+ * Since: 0.9.0
+ */
+
+gboolean
+arv_stream_subscriber_is_connected (ArvStreamSubscriber *subscriber)
+{
+	g_return_val_if_fail (ARV_IS_STREAM_SUBSCRIBER (subscriber), FALSE);
+
+	return subscriber->priv->is_connected;
+}
+
+/**
+ * arv_stream_subscriber_get_n_received_buffers:
+ * @subscriber: a #ArvStreamSubscriber
+ *
+ * Returns: the number of buffers returned by @subscriber
+ *
+ * Since: 0.9.0
+ */
+
+guint64
+arv_stream_subscriber_get_n_received_buffers (ArvStreamSubscriber *subscriber)
+{
+	g_return_val_if_fail (ARV_IS_STREAM_SUBSCRIBER (subscriber), 0);
+
+	return subscriber->priv->n_received_buffers;
+}
+
+/**
+ * arv_stream_subscriber_get_n_missed_buffers:
+ * @subscriber: a #ArvStreamSubscriber
+ *
+ * Returns: the number of buffers reused by the publisher before being popped by @subscriber
+ *
+ * Since: 0.9.0
+ */
+
+guint64
+arv_stream_subscriber_get_n_missed_buffers (ArvStreamSubscriber *subscriber)
+{
+	g_return_val_if_fail (ARV_IS_STREAM_SUBSCRIBER (subscriber), 0);
+
+	return subscriber->priv->n_missed_buffers;
+}
+
+static void
+arv_stream_subscriber_init (ArvStreamSubscriber *subscriber)
+{
+	subscriber->priv = arv_stream_subscriber_get_instance_private (subscriber);
+}
+
+static void
+arv_stream_subscriber_finalize (GObject *object)
+{
+	ArvStreamSubscriber *subscriber = ARV_STREAM_SUBSCRIBER (object);
+
+	/* The buffers still in use keep the mapping and the connection alive */
+	g_clear_pointer (&subscriber->priv->mapping, g_bytes_unref);
+	g_clear_pointer (&subscriber->priv->name, g_free);
+
+	G_OBJECT_CLASS (arv_stream_subscriber_parent_class)->finalize (object);
+}
+
+static void
+arv_stream_subscriber_class_init (ArvStreamSubscriberClass *this_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
+
+	object_class->finalize = arv_stream_subscriber_finalize;
+}
@@ -522,28 +522,31 @@ arv_open_device (const char *device_id, GError **error)
 {
 	unsigned int i;
 
-	g_mutex_lock (&arv_system_mutex);
-
 	for (i = 0; i < G_N_ELEMENTS (interfaces); i++) {
-		ArvInterface *interface;
+		ArvInterface *interface = NULL;
 		ArvDevice *device;
+		GError *local_error = NULL;
 
-		if (interfaces[i].is_available) {
-			GError *local_error = NULL;
+		/* The system lock is not held during the device instantiation, which allows concurrent device
+		 * openings. The interfaces protect their own device list. */
+		g_mutex_lock (&arv_system_mutex);
+		if (interfaces[i].is_available)
+			interface = g_object_ref (interfaces[i].get_interface_instance ());
+		g_mutex_unlock (&arv_system_mutex);
 
-			interface = interfaces[i].get_interface_instance ();
-			device = arv_interface_open_device (interface, device_id, &local_error);
-			if (ARV_IS_DEVICE (device) || local_error != NULL) {
-				if (local_error != NULL)
-					g_propagate_error (error, local_error);
-				g_mutex_unlock (&arv_system_mutex);
-				return device;
-			}
+		if (interface == NULL)
+			continue;
+
+		device = arv_interface_open_device (interface, device_id, &local_error);
+		g_object_unref (interface);
+
+		if (ARV_IS_DEVICE (device) || local_error != NULL) {
+			if (local_error != NULL)
+				g_propagate_error (error, local_error);
+			return device;
 		}
 	}
 
-	g_mutex_unlock (&arv_system_mutex);
-
 	if (device_id != NULL)
 		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_FOUND,
 			     "Device '%s' not found", device_id);
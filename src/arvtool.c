@@ -104,6 +104,7 @@ description_content[] =
 "  values:                           list all available feature values\n"
 "  description [<feature>] ...:      show the full feature description\n"
 "  control <feature>[=<value>] ...:  read/write device features\n"
+"  profile <feature>[=<value>] ...:  read/write device features and show the register accesses\n"
 "  network <setting>[=<value>]...:   read/write network settings\n"
 "\n"
 "If no command is given, this utility will list all the available devices.\n"
@@ -113,6 +114,7 @@ description_content[] =
 "Examples:\n"
 "\n"
 "arv-tool-" ARAVIS_API_VERSION " control Width=128 Height=128 Gain R[0x10000]=0x10\n"
+"arv-tool-" ARAVIS_API_VERSION " profile ExposureTime Width=128\n"
 "arv-tool-" ARAVIS_API_VERSION " features\n"
 "arv-tool-" ARAVIS_API_VERSION " description Width Height\n"
 "arv-tool-" ARAVIS_API_VERSION " network mode=PersistentIP\n"
@@ -448,6 +450,98 @@ arv_tool_control (int argc, char **argv, ArvDevice *device)
         }
 }
 
+static void
+arv_tool_print_profile_operation (ArvGcProfileOperation *operation)
+{
+        GHashTable *counts;
+        GPtrArray *nodes;
+        guint n_evaluations;
+        guint i;
+
+        counts = g_hash_table_new (g_str_hash, g_str_equal);
+        nodes = g_ptr_array_new ();
+
+        n_evaluations = g_strv_length (operation->evaluated_nodes);
+        for (i = 0; i < n_evaluations; i++) {
+                const char *name = operation->evaluated_nodes[i];
+                guint count = GPOINTER_TO_UINT (g_hash_table_lookup (counts, name));
+
+                if (count == 0)
+                        g_ptr_array_add (nodes, (gpointer) name);
+                g_hash_table_insert (counts, (gpointer) name, GUINT_TO_POINTER (count + 1));
+        }
+
+        printf ("%s %s: %u node evaluation(s), %u port read(s) (%" G_GUINT64_FORMAT " bytes), "
+                "%u port write(s) (%" G_GUINT64_FORMAT " bytes), "
+                "%u cache hit(s), %u cache miss(es), %.3f ms\n",
+                operation->feature, operation->is_write ? "write" : "read",
+                n_evaluations,
+                operation->n_port_reads, operation->n_bytes_read,
+                operation->n_port_writes, operation->n_bytes_written,
+                operation->n_cache_hits, operation->n_cache_misses,
+                operation->duration_us / 1000.0);
+
+        for (i = 0; i < nodes->len; i++) {
+                const char *name = g_ptr_array_index (nodes, i);
+
+                printf ("    %-40s x%u\n", name, GPOINTER_TO_UINT (g_hash_table_lookup (counts, name)));
+        }
+
+        g_ptr_array_unref (nodes);
+        g_hash_table_unref (counts);
+}
+
+static void
+arv_tool_profile (int argc, char **argv, ArvDevice *device)
+{
+        ArvGc *genicam;
+        int i;
+
+        genicam = arv_device_get_genicam (device);
+
+        for (i = 2; i < argc; i++) {
+                ArvGcNode *feature;
+                GPtrArray *profile;
+                GError *error = NULL;
+                char **tokens;
+                guint j;
+
+                tokens = g_strsplit (argv[i], "=", 2);
+                feature = arv_device_get_feature (device, tokens[0]);
+                if (!ARV_IS_GC_FEATURE_NODE (feature)) {
+                        printf ("Feature '%s' not found\n", tokens[0]);
+                        g_strfreev (tokens);
+                        continue;
+                }
+
+                arv_gc_start_profiling (genicam);
+
+                if (tokens[1] != NULL)
+                        arv_gc_feature_node_set_value_from_string (ARV_GC_FEATURE_NODE (feature), tokens[1], &error);
+                else if (ARV_IS_GC_COMMAND (feature))
+                        arv_gc_command_execute (ARV_GC_COMMAND (feature), &error);
+                else
+                        arv_gc_feature_node_get_value_as_string (ARV_GC_FEATURE_NODE (feature), &error);
+
+                profile = arv_gc_stop_profiling (genicam);
+
+                if (error != NULL) {
+                        printf ("%s %s error: %s\n", tokens[0],
+                                tokens[1] != NULL ? "write" : ARV_IS_GC_COMMAND (feature) ? "execute" : "read",
+                                error->message);
+                        g_clear_error (&error);
+                }
+
+                if (profile != NULL) {
+                        for (j = 0; j < profile->len; j++)
+                                arv_tool_print_profile_operation (g_ptr_array_index (profile, j));
+                        g_ptr_array_unref (profile);
+                }
+
+                g_strfreev (tokens);
+        }
+}
+
 static void
 arv_tool_show_network_mode (ArvGvDevice* gv_device, GError** error)
 {
@@ -690,6 +784,8 @@ arv_tool_execute_command (int argc, char **argv, ArvDevice *device,
                 }
 	} else if (g_strcmp0 (command, "control") == 0) {
                 arv_tool_control (argc, argv, device);
+        } else if (g_strcmp0 (command, "profile") == 0) {
+                arv_tool_profile (argc, argv, device);
         } else if (g_strcmp0 (command, "network") == 0) {
                 arv_tool_network (argc, argv, device);
 	} else {
@@ -0,0 +1,74 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_TRACE_PRIVATE_H
+#define ARV_TRACE_PRIVATE_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvparamsprivate.h>
+
+/*
+ * Static tracepoints, in the "aravis" provider. When aravis is built with USDT support, each tracepoint
+ * compiles to a single nop instruction plus an ELF note, which perf, bpftrace, systemtap or lttng can attach to
+ * at runtime. Otherwise they compile to nothing. The arguments are evaluated even when no tracer is attached,
+ * only pass values which are cheap to compute.
+ *
+ * Tracepoint list:
+ *
+ * gvsp_packet_received	(stream, frame_id, packet_id, packet_size)
+ * frame_start		(stream, frame_id, buffer)
+ * frame_completed	(stream, frame_id, buffer, status, duration_us)
+ * resend_request	(stream, frame_id, first_packet_id, last_packet_id)
+ * buffer_push		(stream, buffer)
+ * buffer_pop		(stream, buffer)
+ * gvcp_command		(command, packet_id, address, retry)
+ * gvcp_ack		(command, packet_id, status)
+ * register_cache_hit	(node_name)
+ * register_cache_miss	(node_name)
+ */
+
+#if ARAVIS_HAS_USDT
+
+#include <sys/sdt.h>
+
+#define ARV_TRACE(name)				DTRACE_PROBE (aravis, name)
+#define ARV_TRACE1(name,a)			DTRACE_PROBE1 (aravis, name, a)
+#define ARV_TRACE2(name,a,b)			DTRACE_PROBE2 (aravis, name, a, b)
+#define ARV_TRACE3(name,a,b,c)			DTRACE_PROBE3 (aravis, name, a, b, c)
+#define ARV_TRACE4(name,a,b,c,d)		DTRACE_PROBE4 (aravis, name, a, b, c, d)
+#define ARV_TRACE5(name,a,b,c,d,e)		DTRACE_PROBE5 (aravis, name, a, b, c, d, e)
+
+#else
+
+#define ARV_TRACE(name)
+#define ARV_TRACE1(name,a)
+#define ARV_TRACE2(name,a,b)
+#define ARV_TRACE3(name,a,b,c)
+#define ARV_TRACE4(name,a,b,c,d)
+#define ARV_TRACE5(name,a,b,c,d,e)
+
+#endif
+
+#endif
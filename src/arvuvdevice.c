@@ -30,6 +30,7 @@
 #include <arvuvinterfaceprivate.h>
 #include <arvuvcpprivate.h>
 #include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvdebug.h>
 #include <arvenumtypes.h>
 #include <libusb.h>
@@ -62,9 +63,6 @@ typedef struct {
 
 	ArvGc *genicam;
 
-	char *genicam_xml;
-	size_t genicam_xml_size;
-
 	guint16 packet_id;
 
 	guint timeout_ms;
@@ -131,6 +129,38 @@ arv_uv_device_is_connected (ArvUvDevice *uv_device)
         return !priv->disconnected;
 }
 
+/* Topology of the device, for the bandwidth sharing between the devices of a same host controller */
+
+guint8
+arv_uv_device_get_bus_number (ArvUvDevice *uv_device)
+{
+        ArvUvDevicePrivate *priv = arv_uv_device_get_instance_private (uv_device);
+
+        return libusb_get_bus_number (libusb_get_device (priv->usb_device));
+}
+
+/* Returns the port path of the device, in the bus-port.port... form used by sysfs */
+
+char *
+arv_uv_device_dup_port_path (ArvUvDevice *uv_device)
+{
+        ArvUvDevicePrivate *priv = arv_uv_device_get_instance_private (uv_device);
+        libusb_device *device = libusb_get_device (priv->usb_device);
+        guint8 ports[8];
+        GString *path;
+        int n_ports;
+        int i;
+
+        path = g_string_new ("");
+        g_string_append_printf (path, "%u", libusb_get_bus_number (device));
+
+        n_ports = libusb_get_port_numbers (device, ports, G_N_ELEMENTS (ports));
+        for (i = 0; i < n_ports; i++)
+                g_string_append_printf (path, "%c%u", i == 0 ? '-' : '.', ports[i]);
+
+        return g_string_free (path, FALSE);
+}
+
 void
 arv_uv_device_fill_bulk_transfer (struct libusb_transfer* transfer, ArvUvDevice *uv_device,
                                   ArvUvEndpointType endpoint_type, unsigned char endpoint_flags,
@@ -647,25 +677,22 @@ _bootstrap (ArvUvDevice *uv_device)
 
 				if (zip_files != NULL) {
 					const char *zip_filename;
+					char *xml;
+					size_t xml_size;
 
 					zip_filename = arv_zip_file_get_name (zip_files->data);
-                                        priv->genicam_xml = arv_zip_get_file (zip,
-                                                                              zip_filename,
-                                                                              &priv->genicam_xml_size);
+                                        xml = arv_zip_get_file (zip, zip_filename, &xml_size);
 
 					arv_info_device ("zip file =                 %s", zip_filename);
 
 #if 0
 					string = g_string_new ("");
-					arv_g_string_append_hex_dump (string, priv->genicam_xml,
-								      priv->genicam_xml_size);
+					arv_g_string_append_hex_dump (string, xml, xml_size);
 					arv_info_device ("GENICAM\n%s", string->str);
 					g_string_free (string, TRUE);
 #endif
 
-					priv->genicam = arv_gc_new (ARV_DEVICE (uv_device),
-								    priv->genicam_xml,
-								    priv->genicam_xml_size);
+					priv->genicam = arv_gc_new_take (ARV_DEVICE (uv_device), xml, xml_size);
 
                                         genicam_url = g_strdup_printf("local:///DeviceU3V.zip;%" G_GINT64_MODIFIER
                                                                       "x;%" G_GINT64_MODIFIER "x",
@@ -680,11 +707,7 @@ _bootstrap (ArvUvDevice *uv_device)
 			break;
 		case ARV_UVCP_SCHEMA_RAW:
 			{
-				priv->genicam_xml = data;
-				priv->genicam_xml_size = entry.size;
-				priv->genicam = arv_gc_new (ARV_DEVICE (uv_device),
-							    priv->genicam_xml,
-							    priv->genicam_xml_size);
+				priv->genicam = arv_gc_new_take (ARV_DEVICE (uv_device), data, entry.size);
                                 genicam_url = g_strdup_printf("local:///DeviceU3V.xml;%" G_GINT64_MODIFIER "x;%"
                                                               G_GINT64_MODIFIER "x",
                                                               entry.address, entry.size);
@@ -696,10 +719,6 @@ _bootstrap (ArvUvDevice *uv_device)
                         arv_warning_device ("Unknown USB3Vision manifest schema type (%d)", schema_type);
         }
 
-#if 0
-	arv_info_device("GENICAM\n:%s", priv->genicam_xml);
-#endif
-
 	return TRUE;
 }
 
@@ -716,10 +735,13 @@ arv_uv_device_get_genicam_xml (ArvDevice *device, size_t *size)
 {
 	ArvUvDevicePrivate *priv = arv_uv_device_get_instance_private (ARV_UV_DEVICE (device));
 
-	if (size != NULL)
-		*size = priv->genicam_xml_size;
+	if (priv->genicam == NULL) {
+		if (size != NULL)
+			*size = 0;
+		return NULL;
+	}
 
-	return priv->genicam_xml;
+	return arv_gc_get_xml (priv->genicam, size);
 }
 
 static void
@@ -1118,7 +1140,6 @@ arv_uv_device_finalize (GObject *object)
 	g_clear_pointer (&priv->product, g_free);
 	g_clear_pointer (&priv->serial_number, g_free);
         g_clear_pointer (&priv->guid, g_free);
-	g_clear_pointer (&priv->genicam_xml, g_free);
 	if (priv->usb_device != NULL) {
 		libusb_release_interface (priv->usb_device, priv->control_interface);
 		libusb_release_interface (priv->usb_device, priv->data_interface);
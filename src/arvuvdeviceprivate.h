@@ -54,6 +54,9 @@ void            arv_uv_device_usb_mem_free              (ArvUvDevice *uv_device,
 
 gboolean        arv_uv_device_is_connected              (ArvUvDevice *uv_device);
 
+guint8          arv_uv_device_get_bus_number            (ArvUvDevice *uv_device);
+char *          arv_uv_device_dup_port_path             (ArvUvDevice *uv_device);
+
 gboolean        arv_uv_device_reset_stream_endpoint     (ArvUvDevice *device);
 
 G_END_DECLS
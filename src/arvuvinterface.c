@@ -334,14 +334,13 @@ arv_uv_interface_update_device_list (ArvInterface *interface, GArray *device_ids
 	_discover (uv_interface, device_ids);
 }
 
-static ArvDevice *
-_open_device (ArvInterface *interface, const char *device_id, GError **error)
+/* Must be called with the device list lock held */
+
+static ArvUvInterfaceDeviceInfos *
+_lookup_device_infos (ArvUvInterface *uv_interface, const char *device_id)
 {
-	ArvUvInterface *uv_interface;
 	ArvUvInterfaceDeviceInfos *device_infos;
 
-	uv_interface = ARV_UV_INTERFACE (interface);
-
 	if (device_id == NULL) {
 		GList *device_list;
 
@@ -351,28 +350,34 @@ _open_device (ArvInterface *interface, const char *device_id, GError **error)
 	} else
 		device_infos = g_hash_table_lookup (uv_interface->priv->devices, device_id);
 
-	if (device_infos == NULL)
-		return NULL;
-
-	return arv_uv_device_new_from_guid (device_infos->guid, error);
+	return device_infos != NULL ? arv_uv_interface_device_infos_ref (device_infos) : NULL;
 }
 
 static ArvDevice *
 arv_uv_interface_open_device (ArvInterface *interface, const char *device_id, GError **error)
 {
+	ArvUvInterface *uv_interface = ARV_UV_INTERFACE (interface);
+	ArvUvInterfaceDeviceInfos *device_infos;
 	ArvDevice *device;
-	GError *local_error = NULL;
 
-	device = _open_device (interface, device_id, error);
-	if (ARV_IS_DEVICE (device) || local_error != NULL) {
-		if (local_error != NULL)
-			g_propagate_error (error, local_error);
-		return device;
+	arv_interface_lock_device_list (interface);
+
+	device_infos = _lookup_device_infos (uv_interface, device_id);
+	if (device_infos == NULL) {
+		_discover (uv_interface, NULL);
+		device_infos = _lookup_device_infos (uv_interface, device_id);
 	}
 
-	_discover (ARV_UV_INTERFACE (interface), NULL);
+	arv_interface_unlock_device_list (interface);
+
+	if (device_infos == NULL)
+		return NULL;
+
+	device = arv_uv_device_new_from_guid (device_infos->guid, error);
+
+	arv_uv_interface_device_infos_unref (device_infos);
 
-	return _open_device (interface, device_id, error);
+	return device;
 }
 
 static ArvInterface *arv_uv_interface = NULL;
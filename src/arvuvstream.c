@@ -57,7 +57,7 @@ typedef struct {
 
         guint64 n_transferred_bytes;
         guint64 n_ignored_bytes;
-} ArvStreamStatistics;
+} ArvUvStreamStatistics;
 
 typedef struct {
         ArvUvDevice *uv_device;
@@ -90,7 +90,7 @@ typedef struct {
 	GCond stream_event;
 
 	/* Statistics */
-	ArvStreamStatistics statistics;
+	ArvUvStreamStatistics statistics;
 
         gint n_buffer_in_use;
 } ArvUvStreamThreadData;
@@ -135,7 +135,7 @@ typedef struct {
 
         gboolean is_aborting;
 
-	ArvStreamStatistics *statistics;
+	ArvUvStreamStatistics *statistics;
 
         gint *n_buffer_in_use;
 } ArvUvStreamBufferContext;
@@ -221,7 +221,9 @@ void LIBUSB_CALL arv_uv_stream_leader_cb (struct libusb_transfer *transfer)
 
 	g_atomic_int_dec_and_test (&ctx->num_submitted);
 	g_atomic_int_add (ctx->total_submitted_bytes, -transfer->length);
+	arv_stream_begin_infos_update (ctx->stream);
 	ctx->statistics->n_transferred_bytes += transfer->length;
+	arv_stream_end_infos_update (ctx->stream);
 	arv_uv_stream_buffer_context_notify_transfer_completed (ctx);
 }
 
@@ -300,7 +302,9 @@ arv_uv_stream_payload_cb (struct libusb_transfer *transfer)
 
 	g_atomic_int_dec_and_test( &ctx->num_submitted );
 	g_atomic_int_add (ctx->total_submitted_bytes, -transfer->length);
+	arv_stream_begin_infos_update (ctx->stream);
 	ctx->statistics->n_transferred_bytes += transfer->length;
+	arv_stream_end_infos_update (ctx->stream);
 	arv_uv_stream_buffer_context_notify_transfer_completed (ctx);
 }
 
@@ -313,7 +317,9 @@ void LIBUSB_CALL arv_uv_stream_trailer_cb (struct libusb_transfer *transfer)
         if (ctx->buffer != NULL) {
                 if (ctx->is_aborting) {
                         ctx->buffer->priv->status = ARV_BUFFER_STATUS_ABORTED;
+                        arv_stream_begin_infos_update (ctx->stream);
                         ctx->statistics->n_aborted += 1;
+                        arv_stream_end_infos_update (ctx->stream);
                 } else {
                         switch (transfer->status) {
                                 case LIBUSB_TRANSFER_COMPLETED:
@@ -342,6 +348,7 @@ void LIBUSB_CALL arv_uv_stream_trailer_cb (struct libusb_transfer *transfer)
                                         break;
                         }
 
+                        arv_stream_begin_infos_update (ctx->stream);
                         switch (ctx->buffer->priv->status) {
                                 case ARV_BUFFER_STATUS_FILLING:
                                         ctx->buffer->priv->status = ARV_BUFFER_STATUS_SUCCESS;
@@ -353,6 +360,7 @@ void LIBUSB_CALL arv_uv_stream_trailer_cb (struct libusb_transfer *transfer)
                                         ctx->statistics->n_failures += 1;
                                         break;
                         }
+                        arv_stream_end_infos_update (ctx->stream);
                 }
 
                 arv_stream_push_output_buffer (ctx->stream, ctx->buffer);
@@ -366,7 +374,9 @@ void LIBUSB_CALL arv_uv_stream_trailer_cb (struct libusb_transfer *transfer)
 
 	g_atomic_int_dec_and_test( &ctx->num_submitted );
 	g_atomic_int_add (ctx->total_submitted_bytes, -transfer->length);
+	arv_stream_begin_infos_update (ctx->stream);
 	ctx->statistics->n_transferred_bytes += transfer->length;
+	arv_stream_end_infos_update (ctx->stream);
 	arv_uv_stream_buffer_context_notify_transfer_completed (ctx);
 }
 
@@ -565,6 +575,10 @@ arv_uv_stream_thread_async (void *data)
         g_cond_signal (&thread_data->thread_started_cond);
         g_mutex_unlock (&thread_data->thread_started_mutex);
 
+        /* The counters are also updated by the transfer callbacks, from the libusb event thread. All the updates are
+         * done under the stream info writer lock, and published immediately. */
+        arv_stream_publish_infos (thread_data->stream);
+
 	while (!g_atomic_int_get (&thread_data->cancel) &&
                arv_uv_device_is_connected (thread_data->uv_device)) {
 		ArvUvStreamBufferContext* ctx;
@@ -573,8 +587,11 @@ arv_uv_stream_thread_async (void *data)
                                                               ARV_UV_STREAM_POP_INPUT_BUFFER_TIMEOUT_MS * 1000);
 
 		if( buffer == NULL ) {
-                        if (thread_data->n_buffer_in_use == 0)
+                        if (thread_data->n_buffer_in_use == 0) {
+                                arv_stream_begin_infos_update (thread_data->stream);
                                 thread_data->statistics.n_underruns += 1;
+                                arv_stream_end_infos_update (thread_data->stream);
+                        }
                         /* NOTE: n_ignored_bytes is not accumulated because it doesn't submit next USB transfer if
                          * buffer is shortage. It means back pressure might be hanlded by USB slave side. */
 			continue;
@@ -636,6 +653,8 @@ arv_uv_stream_thread_sync (void *data)
 		size_t size;
 		transferred = 0;
 
+                arv_stream_publish_infos (thread_data->stream);
+
 		if (buffer == NULL)
 			size = ARV_UV_STREAM_MAXIMUM_TRANSFER_SIZE;
 		else {
@@ -828,6 +847,8 @@ arv_uv_stream_thread_sync (void *data)
                 g_atomic_int_dec_and_test(&thread_data->n_buffer_in_use);
 	}
 
+        arv_stream_publish_infos (thread_data->stream);
+
 	if (thread_data->callback != NULL)
 		thread_data->callback (thread_data->callback_data, ARV_STREAM_CALLBACK_TYPE_EXIT, NULL);
 
@@ -182,10 +182,11 @@ arv_v4l2_interface_update_device_list (ArvInterface *interface, GArray *device_i
 	_discover (v4l2_interface, device_ids);
 }
 
-static ArvDevice *
-_open_device (ArvInterface *interface, const char *device_id, GError **error)
+/* Must be called with the device list lock held */
+
+static ArvV4l2InterfaceDeviceInfos *
+_lookup_device_infos (ArvV4l2Interface *v4l2_interface, const char *device_id)
 {
-	ArvV4l2Interface *v4l2_interface = ARV_V4L2_INTERFACE (interface);
 	ArvV4l2InterfaceDeviceInfos *device_infos;
 
 	if (device_id == NULL) {
@@ -197,28 +198,34 @@ _open_device (ArvInterface *interface, const char *device_id, GError **error)
 	} else
 		device_infos = g_hash_table_lookup (v4l2_interface->devices, device_id);
 
-	if (device_infos != NULL)
-		return arv_v4l2_device_new (device_infos->device_file, error);
-
-	return NULL;
+	return device_infos != NULL ? arv_v4l2_interface_device_infos_ref (device_infos) : NULL;
 }
 
 static ArvDevice *
 arv_v4l2_interface_open_device (ArvInterface *interface, const char *device_id, GError **error)
 {
+	ArvV4l2Interface *v4l2_interface = ARV_V4L2_INTERFACE (interface);
+	ArvV4l2InterfaceDeviceInfos *device_infos;
 	ArvDevice *device;
-	GError *local_error = NULL;
 
-	device = _open_device (interface, device_id, error);
-	if (ARV_IS_DEVICE (device) || local_error != NULL) {
-		if (local_error != NULL)
-			g_propagate_error (error, local_error);
-		return device;
+	arv_interface_lock_device_list (interface);
+
+	device_infos = _lookup_device_infos (v4l2_interface, device_id);
+	if (device_infos == NULL) {
+		_discover (v4l2_interface, NULL);
+		device_infos = _lookup_device_infos (v4l2_interface, device_id);
 	}
 
-	_discover (ARV_V4L2_INTERFACE (interface), NULL);
+	arv_interface_unlock_device_list (interface);
+
+	if (device_infos == NULL)
+		return NULL;
+
+	device = arv_v4l2_device_new (device_infos->device_file, error);
+
+	arv_v4l2_interface_device_infos_unref (device_infos);
 
-	return _open_device (interface, device_id, error);
+	return device;
 }
 
 static ArvInterface *arv_v4l2_interface = NULL;
@@ -247,12 +247,21 @@ arv_zip_get_file (ArvZip *zip, const char *name, size_t *size)
 	if (offset < 0)
 		return NULL;
 
+	if ((size_t) offset + MIN (zip_file->compressed_size, zip_file->uncompressed_size) > zip->buffer_size) {
+		arv_info_misc ("[Zip::get_file] Truncated data for '%s'", name);
+		return NULL;
+	}
+
 	output_buffer = g_malloc (zip_file->uncompressed_size);
 	if (output_buffer == NULL)
 		return NULL;
 
         if (zip_file->compressed_size < zip_file->uncompressed_size) {
                 z_stream zs;
+                int result;
+
+                /* The output buffer is allocated using the uncompressed size from the central directory, the
+                 * data are inflated in a single pass, without intermediate buffer. */
                 zs.zalloc = NULL;
                 zs.zfree = NULL;
                 zs.opaque = NULL;
@@ -260,9 +269,18 @@ arv_zip_get_file (ArvZip *zip, const char *name, size_t *size)
                 zs.avail_in = zip_file->compressed_size;
                 zs.next_out = output_buffer;
                 zs.avail_out = zip_file->uncompressed_size;
-                inflateInit2 (&zs, -MAX_WBITS);
-                inflate (&zs, Z_FINISH);
+                if (inflateInit2 (&zs, -MAX_WBITS) != Z_OK) {
+                        g_free (output_buffer);
+                        return NULL;
+                }
+                result = inflate (&zs, Z_FINISH);
                 inflateEnd (&zs);
+
+                if (result != Z_STREAM_END) {
+                        arv_info_misc ("[Zip::get_file] Failed to inflate '%s' (%d)", name, result);
+                        g_free (output_buffer);
+                        return NULL;
+                }
         } else
 		memcpy (output_buffer, zip->buffer + offset, zip_file->uncompressed_size);
 
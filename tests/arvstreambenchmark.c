@@ -0,0 +1,549 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/* End to end stream benchmark
+ *
+ * Spins up one in-process ArvGvFakeCamera per interface address, opens each of them with ArvCamera and streams for a
+ * fixed duration with every requested receive method. The results are printed as JSON on the standard output.
+ *
+ * Each simulated camera needs its own address, as they all listen on the GVCP port. On Linux, loopback aliases can be
+ * added using "ip addr add 127.0.0.2/8 dev lo", or a veth pair can be used.
+ *
+ * The CPU time only accounts for the receiving threads, the stream threads and the buffer pop threads, as the
+ * simulated cameras run in the same process. It is read from /proc, and not reported on other systems.
+ */
+
+#include <arv.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#if ARAVIS_HAS_PACKET_SOCKET
+#include <sys/socket.h>
+#include <linux/if_ether.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define ARV_BENCHMARK_HAS_TSC 1
+#endif
+
+#define ARV_BENCHMARK_STREAM_THREAD_NAME	"arv_gv_stream"
+#define ARV_BENCHMARK_POP_THREAD_NAME		"benchmark"
+
+static char **arv_option_interfaces = NULL;
+static char *arv_option_methods = NULL;
+static char *arv_option_faults = NULL;
+static char *arv_option_output = NULL;
+static double arv_option_duration_s = 5.0;
+static double arv_option_warmup_s = 1.0;
+static double arv_option_frame_rate = 100.0;
+static double arv_option_cpu_frequency_mhz = 0.0;
+static int arv_option_width = 1024;
+static int arv_option_height = 1024;
+static int arv_option_packet_size = 0;
+static int arv_option_n_buffers = 16;
+static guint64 arv_option_bandwidth = 0;
+
+static const GOptionEntry arv_option_entries[] =
+{
+	{ "interface",		'i', 0, G_OPTION_ARG_STRING_ARRAY,	&arv_option_interfaces,
+		"Interface address of a simulated camera, may be repeated (default 127.0.0.1)", "<address>"},
+	{ "methods",		'm', 0, G_OPTION_ARG_STRING,		&arv_option_methods,
+		"Comma separated receive methods (default socket,packet-socket)", "<methods>"},
+	{ "duration",		'd', 0, G_OPTION_ARG_DOUBLE,		&arv_option_duration_s,
+		"Measurement duration per receive method", "<seconds>"},
+	{ "warmup",		0, 0, G_OPTION_ARG_DOUBLE,		&arv_option_warmup_s,
+		"Warm-up duration, not accounted", "<seconds>"},
+	{ "width",		'w', 0, G_OPTION_ARG_INT,		&arv_option_width,
+		"Image width", "<pixels>"},
+	{ "height",		'h', 0, G_OPTION_ARG_INT,		&arv_option_height,
+		"Image height", "<pixels>"},
+	{ "frequency",		'f', 0, G_OPTION_ARG_DOUBLE,		&arv_option_frame_rate,
+		"Acquisition frame rate", "<Hz>"},
+	{ "packet-size",	'p', 0, G_OPTION_ARG_INT,		&arv_option_packet_size,
+		"GVSP packet size (default: camera default)", "<bytes>"},
+	{ "n-buffers",		'n', 0, G_OPTION_ARG_INT,		&arv_option_n_buffers,
+		"Number of stream buffers per camera", "<n>"},
+	{ "bandwidth",		'b', 0, G_OPTION_ARG_INT64,		&arv_option_bandwidth,
+		"Per channel bandwidth limit of the simulated cameras, in bytes/s (0: unlimited)", "<bytes/s>"},
+	{ "faults",		0, 0, G_OPTION_ARG_STRING,		&arv_option_faults,
+		"Fault injection specification of the simulated cameras", "<spec>"},
+	{ "cpu-frequency",	0, 0, G_OPTION_ARG_DOUBLE,		&arv_option_cpu_frequency_mhz,
+		"CPU frequency used for the cycle count (default: calibrated TSC frequency)", "<MHz>"},
+	{ "output",		'o', 0, G_OPTION_ARG_FILENAME,		&arv_option_output,
+		"Write the JSON report to a file instead of the standard output", "<filename>"},
+	{ NULL }
+};
+
+static const struct {
+	const char *name;
+	ArvGvStreamOption options;
+} methods[] = {
+	{"socket",		ARV_GV_STREAM_OPTION_PACKET_SOCKET_DISABLED},
+	{"packet-socket",	ARV_GV_STREAM_OPTION_NONE}
+};
+
+static const char *info_names[] = {
+	"n_completed_buffers",
+	"n_failures",
+	"n_underruns",
+	"n_aborted",
+	"n_transferred_bytes",
+	"n_missing_packets",
+	"n_resend_requests",
+	"n_resent_packets"
+};
+
+enum {
+	INFO_COMPLETED_BUFFERS,
+	INFO_FAILURES,
+	INFO_UNDERRUNS,
+	INFO_ABORTED,
+	INFO_TRANSFERRED_BYTES,
+	INFO_MISSING_PACKETS,
+	INFO_RESEND_REQUESTS,
+	INFO_RESENT_PACKETS,
+	N_INFOS
+};
+
+typedef struct {
+	ArvGvFakeCamera *simulator;
+	ArvCamera *camera;
+	ArvStream *stream;
+	GThread *thread;
+	GArray *latencies;
+	guint64 infos[N_INFOS];
+} BenchmarkCamera;
+
+static gint cancel = FALSE;
+static gint measuring = FALSE;
+
+static void
+_get_infos (ArvStream *stream, guint64 *infos)
+{
+	unsigned int i;
+
+	for (i = 0; i < N_INFOS; i++)
+		infos[i] = arv_stream_get_info_uint64_by_name (stream, info_names[i]);
+}
+
+/* Returns the CPU time used by the receiving threads of the process, or a negative value if unavailable */
+
+static double
+_get_cpu_time_s (void)
+{
+	GDir *dir;
+	const char *task;
+	guint64 n_ticks = 0;
+	long ticks_per_s;
+
+	ticks_per_s = sysconf (_SC_CLK_TCK);
+	dir = g_dir_open ("/proc/self/task", 0, NULL);
+	if (dir == NULL || ticks_per_s <= 0) {
+		if (dir != NULL)
+			g_dir_close (dir);
+		return -1.0;
+	}
+
+	while ((task = g_dir_read_name (dir)) != NULL) {
+		char *path;
+		char *comm = NULL;
+		char *stat = NULL;
+
+		path = g_strdup_printf ("/proc/self/task/%s/comm", task);
+		g_file_get_contents (path, &comm, NULL, NULL);
+		g_free (path);
+
+		if (comm != NULL &&
+		    (g_strcmp0 (g_strchomp (comm), ARV_BENCHMARK_STREAM_THREAD_NAME) == 0 ||
+		     g_strcmp0 (comm, ARV_BENCHMARK_POP_THREAD_NAME) == 0)) {
+			path = g_strdup_printf ("/proc/self/task/%s/stat", task);
+			g_file_get_contents (path, &stat, NULL, NULL);
+			g_free (path);
+		}
+
+		if (stat != NULL) {
+			/* utime and stime are the 12th and 13th fields after the parenthesized thread name */
+			char *fields = strrchr (stat, ')');
+			char **tokens = fields != NULL ? g_strsplit (fields + 2, " ", 14) : NULL;
+
+			if (tokens != NULL && g_strv_length (tokens) >= 14)
+				n_ticks += g_ascii_strtoull (tokens[11], NULL, 10) +
+					g_ascii_strtoull (tokens[12], NULL, 10);
+
+			g_strfreev (tokens);
+		}
+
+		g_free (comm);
+		g_free (stat);
+	}
+
+	g_dir_close (dir);
+
+	return (double) n_ticks / ticks_per_s;
+}
+
+/* Same check as the GigE Vision stream, which falls back to the standard socket if packet sockets are unavailable */
+
+static gboolean
+_is_packet_socket_available (void)
+{
+#if ARAVIS_HAS_PACKET_SOCKET
+	int fd;
+
+	fd = socket (PF_PACKET, SOCK_RAW, g_htons (ETH_P_ALL));
+	if (fd < 0)
+		return FALSE;
+
+	close (fd);
+
+	return TRUE;
+#else
+	return FALSE;
+#endif
+}
+
+static double
+_get_cycle_frequency (void)
+{
+#ifdef ARV_BENCHMARK_HAS_TSC
+	guint64 start_tsc, end_tsc;
+	gint64 start_us, end_us;
+
+	start_us = g_get_monotonic_time ();
+	start_tsc = __rdtsc ();
+	g_usleep (100000);
+	end_tsc = __rdtsc ();
+	end_us = g_get_monotonic_time ();
+
+	return (double) (end_tsc - start_tsc) * 1e6 / (double) (end_us - start_us);
+#else
+	return 0.0;
+#endif
+}
+
+static int
+_compare_guint64 (gconstpointer a, gconstpointer b)
+{
+	guint64 value_a = *((guint64 *) a);
+	guint64 value_b = *((guint64 *) b);
+
+	return value_a < value_b ? -1 : value_a > value_b ? 1 : 0;
+}
+
+static double
+_get_percentile_us (GArray *sorted, double percentile)
+{
+	guint index;
+
+	if (sorted->len == 0)
+		return 0.0;
+
+	index = (guint) (percentile * sorted->len);
+	if (index >= sorted->len)
+		index = sorted->len - 1;
+
+	return g_array_index (sorted, guint64, index) / 1000.0;
+}
+
+static void *
+_pop_thread (void *data)
+{
+	BenchmarkCamera *bench_camera = data;
+	ArvBuffer *buffer;
+
+	while (!g_atomic_int_get (&cancel)) {
+		buffer = arv_stream_timeout_pop_buffer (bench_camera->stream, 100000);
+		if (buffer == NULL)
+			continue;
+
+		if (g_atomic_int_get (&measuring) &&
+		    arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS) {
+			guint64 now_ns = g_get_real_time () * 1000LL;
+			guint64 timestamp_ns = arv_buffer_get_timestamp (buffer);
+			guint64 latency_ns = now_ns > timestamp_ns ? now_ns - timestamp_ns : 0;
+
+			g_array_append_val (bench_camera->latencies, latency_ns);
+		}
+
+		arv_stream_push_buffer (bench_camera->stream, buffer);
+	}
+
+	return NULL;
+}
+
+static gboolean
+_run_method (BenchmarkCamera *bench_cameras, guint n_cameras, guint method, gboolean is_first,
+	     double cycle_frequency, GString *json)
+{
+	GArray *latencies;
+	guint64 totals[N_INFOS] = {0};
+	double cpu_start_s, cpu_s;
+	double n_frames;
+	gint64 start_us, elapsed_us;
+	guint i, j;
+
+	g_atomic_int_set (&cancel, FALSE);
+	g_atomic_int_set (&measuring, FALSE);
+
+	for (i = 0; i < n_cameras; i++) {
+		BenchmarkCamera *bench_camera = &bench_cameras[i];
+		GError *error = NULL;
+		size_t payload;
+
+		arv_camera_gv_set_stream_options (bench_camera->camera, methods[method].options);
+		bench_camera->stream = arv_camera_create_stream (bench_camera->camera, NULL, NULL, &error);
+		if (!ARV_IS_STREAM (bench_camera->stream)) {
+			fprintf (stderr, "Failed to create stream: %s\n", error != NULL ? error->message : "unknown error");
+			g_clear_error (&error);
+			return FALSE;
+		}
+
+		payload = arv_camera_get_payload (bench_camera->camera, NULL);
+		for (j = 0; j < (guint) arv_option_n_buffers; j++)
+			arv_stream_push_buffer (bench_camera->stream, arv_buffer_new (payload, NULL));
+
+		bench_camera->latencies = g_array_new (FALSE, FALSE, sizeof (guint64));
+		bench_camera->thread = g_thread_new (ARV_BENCHMARK_POP_THREAD_NAME, _pop_thread, bench_camera);
+
+		arv_camera_start_acquisition (bench_camera->camera, NULL);
+	}
+
+	g_usleep (arv_option_warmup_s * 1000000);
+
+	for (i = 0; i < n_cameras; i++)
+		_get_infos (bench_cameras[i].stream, bench_cameras[i].infos);
+	cpu_start_s = _get_cpu_time_s ();
+	start_us = g_get_monotonic_time ();
+	g_atomic_int_set (&measuring, TRUE);
+
+	g_usleep (arv_option_duration_s * 1000000);
+
+	g_atomic_int_set (&measuring, FALSE);
+	elapsed_us = g_get_monotonic_time () - start_us;
+	cpu_s = cpu_start_s >= 0.0 ? _get_cpu_time_s () - cpu_start_s : -1.0;
+
+	latencies = g_array_new (FALSE, FALSE, sizeof (guint64));
+
+	for (i = 0; i < n_cameras; i++) {
+		BenchmarkCamera *bench_camera = &bench_cameras[i];
+		guint64 infos[N_INFOS];
+
+		_get_infos (bench_camera->stream, infos);
+		for (j = 0; j < N_INFOS; j++)
+			totals[j] += infos[j] - bench_camera->infos[j];
+
+		arv_camera_stop_acquisition (bench_camera->camera, NULL);
+	}
+
+	g_atomic_int_set (&cancel, TRUE);
+
+	for (i = 0; i < n_cameras; i++) {
+		BenchmarkCamera *bench_camera = &bench_cameras[i];
+
+		g_thread_join (bench_camera->thread);
+		bench_camera->thread = NULL;
+		g_array_append_vals (latencies, bench_camera->latencies->data, bench_camera->latencies->len);
+		g_clear_pointer (&bench_camera->latencies, g_array_unref);
+		g_clear_object (&bench_camera->stream);
+	}
+
+	g_array_sort (latencies, _compare_guint64);
+
+	n_frames = totals[INFO_COMPLETED_BUFFERS] + totals[INFO_FAILURES] + totals[INFO_UNDERRUNS];
+
+	g_string_append_printf (json, "%s\n    {\n", is_first ? "" : ",");
+	g_string_append_printf (json, "      \"method\": \"%s\",\n", methods[method].name);
+	g_string_append_printf (json, "      \"duration_s\": %.3f,\n", elapsed_us / 1e6);
+	g_string_append_printf (json, "      \"n_transferred_bytes\": %" G_GUINT64_FORMAT ",\n",
+				totals[INFO_TRANSFERRED_BYTES]);
+	g_string_append_printf (json, "      \"gbit_per_s\": %.4f,\n",
+				totals[INFO_TRANSFERRED_BYTES] * 8.0 / (elapsed_us * 1e3));
+	if (cpu_s >= 0.0)
+		g_string_append_printf (json, "      \"cpu_s\": %.4f,\n", cpu_s);
+	else
+		g_string_append (json, "      \"cpu_s\": null,\n");
+	if (cpu_s >= 0.0 && cycle_frequency > 0.0 && totals[INFO_TRANSFERRED_BYTES] > 0)
+		g_string_append_printf (json, "      \"cycles_per_byte\": %.4f,\n",
+					cpu_s * cycle_frequency / totals[INFO_TRANSFERRED_BYTES]);
+	else
+		g_string_append (json, "      \"cycles_per_byte\": null,\n");
+	g_string_append_printf (json, "      \"n_completed_buffers\": %" G_GUINT64_FORMAT ",\n",
+				totals[INFO_COMPLETED_BUFFERS]);
+	g_string_append_printf (json, "      \"n_failures\": %" G_GUINT64_FORMAT ",\n", totals[INFO_FAILURES]);
+	g_string_append_printf (json, "      \"n_underruns\": %" G_GUINT64_FORMAT ",\n", totals[INFO_UNDERRUNS]);
+	g_string_append_printf (json, "      \"n_aborted\": %" G_GUINT64_FORMAT ",\n", totals[INFO_ABORTED]);
+	g_string_append_printf (json, "      \"completion_rate\": %.6f,\n",
+				n_frames > 0 ? totals[INFO_COMPLETED_BUFFERS] / n_frames : 0.0);
+	g_string_append_printf (json, "      \"n_missing_packets\": %" G_GUINT64_FORMAT ",\n",
+				totals[INFO_MISSING_PACKETS]);
+	g_string_append_printf (json, "      \"n_resend_requests\": %" G_GUINT64_FORMAT ",\n",
+				totals[INFO_RESEND_REQUESTS]);
+	g_string_append_printf (json, "      \"n_resent_packets\": %" G_GUINT64_FORMAT ",\n",
+				totals[INFO_RESENT_PACKETS]);
+	g_string_append_printf (json, "      \"latency_us\": {\"n_samples\": %u, "
+				"\"p50\": %.1f, \"p99\": %.1f, \"p999\": %.1f, \"max\": %.1f}\n",
+				latencies->len,
+				_get_percentile_us (latencies, 0.5),
+				_get_percentile_us (latencies, 0.99),
+				_get_percentile_us (latencies, 0.999),
+				_get_percentile_us (latencies, 1.0));
+	g_string_append (json, "    }");
+
+	g_array_unref (latencies);
+
+	return totals[INFO_COMPLETED_BUFFERS] > 0;
+}
+
+int
+main (int argc, char **argv)
+{
+	GOptionContext *context;
+	GError *error = NULL;
+	BenchmarkCamera *bench_cameras;
+	GString *json;
+	char **method_names;
+	const char *default_interfaces[] = {"127.0.0.1", NULL};
+	const char * const *interfaces;
+	double cycle_frequency;
+	guint n_cameras;
+	gboolean success = TRUE;
+	guint i, j;
+
+	context = g_option_context_new (NULL);
+	g_option_context_add_main_entries (context, arv_option_entries, NULL);
+	g_option_context_set_summary (context, "Loopback stream benchmark using simulated GigE Vision cameras.");
+
+	if (!g_option_context_parse (context, &argc, &argv, &error)) {
+		g_option_context_free (context);
+		g_print ("Option parsing failed: %s\n", error->message);
+		g_error_free (error);
+		return EXIT_FAILURE;
+	}
+
+	g_option_context_free (context);
+
+	interfaces = arv_option_interfaces != NULL ?
+		(const char * const *) arv_option_interfaces : default_interfaces;
+	n_cameras = g_strv_length ((char **) interfaces);
+	method_names = g_strsplit (arv_option_methods != NULL ? arv_option_methods : "socket,packet-socket", ",", -1);
+
+	cycle_frequency = arv_option_cpu_frequency_mhz > 0.0 ?
+		arv_option_cpu_frequency_mhz * 1e6 : _get_cycle_frequency ();
+
+	arv_set_fake_camera_genicam_filename (GENICAM_FILENAME);
+
+	bench_cameras = g_new0 (BenchmarkCamera, n_cameras);
+
+	for (i = 0; i < n_cameras; i++) {
+		char *serial_number = g_strdup_printf ("Bench%u", i);
+
+		bench_cameras[i].simulator = g_object_new (ARV_TYPE_GV_FAKE_CAMERA,
+							   "interface-name", interfaces[i],
+							   "serial-number", serial_number,
+							   "gvsp-bandwidth", arv_option_bandwidth * 8,
+							   "gvsp-faults", arv_option_faults,
+							   NULL);
+		g_free (serial_number);
+
+		if (!arv_gv_fake_camera_is_running (bench_cameras[i].simulator)) {
+			fprintf (stderr, "Failed to start a simulated camera on %s\n", interfaces[i]);
+			success = FALSE;
+			goto cleanup;
+		}
+
+		bench_cameras[i].camera = arv_camera_new (interfaces[i], &error);
+		if (!ARV_IS_CAMERA (bench_cameras[i].camera)) {
+			fprintf (stderr, "Failed to open the camera on %s: %s\n", interfaces[i],
+				 error != NULL ? error->message : "unknown error");
+			g_clear_error (&error);
+			success = FALSE;
+			goto cleanup;
+		}
+
+		arv_camera_set_region (bench_cameras[i].camera, 0, 0, arv_option_width, arv_option_height, NULL);
+		arv_camera_set_frame_rate (bench_cameras[i].camera, arv_option_frame_rate, NULL);
+		arv_camera_set_string (bench_cameras[i].camera, "TestPattern", "Static", NULL);
+		if (arv_option_packet_size > 0)
+			arv_camera_gv_set_packet_size (bench_cameras[i].camera, arv_option_packet_size, NULL);
+	}
+
+	json = g_string_new ("{\n");
+	g_string_append_printf (json, "  \"n_cameras\": %u,\n", n_cameras);
+	g_string_append_printf (json, "  \"width\": %d,\n", arv_option_width);
+	g_string_append_printf (json, "  \"height\": %d,\n", arv_option_height);
+	g_string_append_printf (json, "  \"frame_rate\": %.3f,\n", arv_option_frame_rate);
+	g_string_append_printf (json, "  \"cycle_frequency_mhz\": %.1f,\n", cycle_frequency / 1e6);
+	g_string_append (json, "  \"results\": [");
+
+	for (i = 0, j = 0; method_names[i] != NULL; i++) {
+		guint method;
+
+		for (method = 0; method < G_N_ELEMENTS (methods); method++)
+			if (g_strcmp0 (g_strstrip (method_names[i]), methods[method].name) == 0)
+				break;
+
+		if (method >= G_N_ELEMENTS (methods)) {
+			fprintf (stderr, "Unknown receive method '%s'\n", method_names[i]);
+			success = FALSE;
+			continue;
+		}
+
+		if (methods[method].options == ARV_GV_STREAM_OPTION_NONE && !_is_packet_socket_available ()) {
+			fprintf (stderr, "Packet socket receive method unavailable (not supported, or missing "
+				 "CAP_NET_RAW capability), skipped\n");
+			success = FALSE;
+			continue;
+		}
+
+		if (!_run_method (bench_cameras, n_cameras, method, j == 0, cycle_frequency, json)) {
+			fprintf (stderr, "No buffer completed with the %s receive method\n", methods[method].name);
+			success = FALSE;
+		}
+		j++;
+	}
+
+	g_string_append (json, "\n  ]\n}\n");
+
+	if (arv_option_output != NULL) {
+		if (!g_file_set_contents (arv_option_output, json->str, json->len, &error)) {
+			fprintf (stderr, "Failed to write %s: %s\n", arv_option_output, error->message);
+			g_clear_error (&error);
+			success = FALSE;
+		}
+	} else
+		printf ("%s", json->str);
+
+	g_string_free (json, TRUE);
+
+cleanup:
+	for (i = 0; i < n_cameras; i++) {
+		g_clear_object (&bench_cameras[i].camera);
+		g_clear_object (&bench_cameras[i].simulator);
+	}
+	g_free (bench_cameras);
+	g_strfreev (method_names);
+
+	arv_shutdown ();
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,35 @@
+import gi
+import os
+
+gi.require_version ('Aravis', '0.10')
+
+from gi.repository import Aravis
+
+Aravis.set_fake_camera_genicam_filename (os.getenv ('FAKE_GENICAM_PATH'))
+
+Aravis.enable_interface ("Fake")
+
+camera = Aravis.Camera.new ("Fake_1")
+
+assert camera is not None
+
+buffer = camera.acquisition (0)
+
+assert buffer is not None
+assert buffer.get_status () == Aravis.BufferStatus.SUCCESS
+
+refcount = buffer.__grefcount__
+
+# The GBytes wraps the buffer memory, holding a reference on the buffer instead of copying the data
+data_bytes = buffer.get_image_data_bytes ()
+
+assert buffer.__grefcount__ == refcount + 1
+
+data = buffer.get_image_data ()
+
+assert data_bytes.get_size () == len (data)
+assert data_bytes.get_data () == data
+
+del data_bytes
+
+assert buffer.__grefcount__ == refcount
@@ -113,6 +113,32 @@ allocate (void)
 	g_object_unref (buffer);
 }
 
+static void
+data_bytes_test (void)
+{
+	ArvBuffer *buffer;
+	GBytes *bytes;
+	const void *data;
+	size_t size;
+
+	buffer = arv_buffer_new_allocate (512);
+
+	bytes = arv_buffer_get_data_bytes (buffer);
+	g_assert (bytes != NULL);
+
+	data = arv_buffer_get_data (buffer, &size);
+	g_assert (g_bytes_get_data (bytes, NULL) == data);
+	g_assert_cmpint (g_bytes_get_size (bytes), ==, size);
+
+	/* The bytes keep the buffer memory alive */
+	g_object_add_weak_pointer (G_OBJECT (buffer), (gpointer *) &buffer);
+	g_object_unref (buffer);
+	g_assert (buffer != NULL);
+
+	g_bytes_unref (bytes);
+	g_assert (buffer == NULL);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -125,6 +151,7 @@ main (int argc, char *argv[])
 	g_test_add_func ("/buffer/full-buffer", full_buffer_test);
 	g_test_add_func ("/buffer/timestamp", timestamp);
 	g_test_add_func ("/buffer/allocate", allocate);
+	g_test_add_func ("/buffer/data-bytes", data_bytes_test);
 
 	result = g_test_run();
 
@@ -1,5 +1,7 @@
 #include <glib.h>
 #include <arv.h>
+#include <string.h>
+#include <unistd.h>
 
 static void
 discovery_test (void)
@@ -280,6 +282,75 @@ fake_device_test (void)
 	g_object_unref (device);
 }
 
+static void
+feature_handle_test (void)
+{
+	ArvDevice *device;
+	ArvFeatureHandle *handle;
+	GError *error = NULL;
+	gint64 minimum, maximum;
+	double dbl_value;
+
+	device = arv_fake_device_new ("TEST0", &error);
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+	g_assert (error == NULL);
+
+	handle = arv_feature_handle_new (device, "NotAFeature", &error);
+	g_assert (handle == NULL);
+	g_assert_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_FEATURE_NOT_FOUND);
+	g_clear_error (&error);
+
+	handle = arv_feature_handle_new (device, "GainRaw", &error);
+	g_assert (ARV_IS_FEATURE_HANDLE (handle));
+	g_assert (error == NULL);
+	g_assert_cmpstr (arv_feature_handle_get_name (handle), ==, "GainRaw");
+	g_assert (ARV_IS_GC_INTEGER (arv_feature_handle_get_node (handle)));
+
+	arv_feature_handle_set_integer (handle, 5, &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (arv_feature_handle_get_integer (handle, &error), ==, 5);
+	g_assert (error == NULL);
+	g_assert_cmpint (arv_device_get_integer_feature_value (device, "GainRaw", NULL), ==, 5);
+
+	arv_feature_handle_get_integer_bounds (handle, &minimum, &maximum, &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (minimum, ==, 0);
+	g_assert_cmpint (maximum, ==, 10);
+
+	dbl_value = arv_feature_handle_get_float (handle, &error);
+	g_assert_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_WRONG_FEATURE);
+	g_assert_cmpfloat (dbl_value, ==, 0.0);
+	g_clear_error (&error);
+
+	g_object_unref (handle);
+
+	handle = arv_feature_handle_new (device, "ExposureTimeAbs", &error);
+	g_assert (ARV_IS_FEATURE_HANDLE (handle));
+	g_assert (error == NULL);
+
+	dbl_value = arv_feature_handle_get_float (handle, &error);
+	g_assert (error == NULL);
+	g_assert_cmpfloat (dbl_value, ==, ARV_FAKE_CAMERA_EXPOSURE_TIME_US_DEFAULT);
+
+	arv_feature_handle_set_float (handle, 20.0, &error);
+	g_assert (error == NULL);
+	g_assert_cmpfloat (arv_feature_handle_get_float (handle, &error), ==, 20.0);
+	g_assert (error == NULL);
+
+	g_object_unref (handle);
+
+	handle = arv_feature_handle_new (device, "TestBoolean", &error);
+	g_assert (ARV_IS_FEATURE_HANDLE (handle));
+
+	arv_feature_handle_set_boolean (handle, TRUE, &error);
+	g_assert (error == NULL);
+	g_assert_true (arv_feature_handle_get_boolean (handle, &error));
+	g_assert (error == NULL);
+
+	g_object_unref (handle);
+	g_object_unref (device);
+}
+
 static void
 fake_device_error_test (void)
 {
@@ -411,6 +482,91 @@ fake_stream_test (void)
 	g_clear_object (&camera);
 }
 
+static void
+fill_pattern_test (void)
+{
+	ArvPixelFormat pixel_formats[] = {
+		ARV_PIXEL_FORMAT_MONO_8,
+		ARV_PIXEL_FORMAT_MONO_16,
+		ARV_PIXEL_FORMAT_BAYER_BG_8,
+		ARV_PIXEL_FORMAT_BAYER_GB_8,
+		ARV_PIXEL_FORMAT_BAYER_GR_8,
+		ARV_PIXEL_FORMAT_BAYER_RG_8,
+		ARV_PIXEL_FORMAT_RGB_8_PACKED
+	};
+	ArvDevice *device;
+	ArvFakeCamera *fake_camera;
+	ArvBuffer *buffer;
+	ArvBuffer *static_buffer;
+	GError *error = NULL;
+	const guint8 *data;
+	const guint8 *static_data;
+	size_t payload;
+	size_t size;
+	guint32 x, y;
+	guint i;
+
+	device = arv_fake_device_new ("TEST0", &error);
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+	g_assert (error == NULL);
+
+	fake_camera = arv_fake_device_get_fake_camera (ARV_FAKE_DEVICE (device));
+	g_assert (ARV_IS_FAKE_CAMERA (fake_camera));
+
+	/* Wider than the 8 bit ramp period */
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_WIDTH, 300);
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_HEIGHT, 20);
+
+	for (i = 0; i < G_N_ELEMENTS (pixel_formats); i++) {
+		arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT, pixel_formats[i]);
+
+		payload = arv_fake_camera_get_payload (fake_camera);
+		buffer = arv_buffer_new (payload, NULL);
+
+		arv_fake_camera_fill_buffer (fake_camera, buffer, NULL);
+		g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+
+		data = arv_buffer_get_data (buffer, &size);
+		g_assert_cmpint (size, ==, payload);
+
+		for (y = 0; y < 20; y++) {
+			for (x = 0; x < 300; x++) {
+				guint64 k = x + y + arv_buffer_get_frame_id (buffer);
+
+				if (pixel_formats[i] == ARV_PIXEL_FORMAT_MONO_8)
+					g_assert_cmpint (data[y * 300 + x], ==, k % 255);
+				else if (pixel_formats[i] == ARV_PIXEL_FORMAT_MONO_16)
+					g_assert_cmpint (((guint16 *) data)[y * 300 + x], ==, (256 * k) % 65535);
+			}
+		}
+
+		g_object_unref (buffer);
+	}
+
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT, ARV_PIXEL_FORMAT_MONO_8);
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_TEST_PATTERN,
+					ARV_FAKE_CAMERA_TEST_PATTERN_STATIC);
+
+	payload = arv_fake_camera_get_payload (fake_camera);
+	buffer = arv_buffer_new (payload, NULL);
+	static_buffer = arv_buffer_new (payload, NULL);
+
+	arv_fake_camera_fill_buffer (fake_camera, static_buffer, NULL);
+	arv_fake_camera_fill_buffer (fake_camera, buffer, NULL);
+
+	data = arv_buffer_get_data (buffer, &size);
+	static_data = arv_buffer_get_data (static_buffer, NULL);
+
+	g_assert_cmpint (arv_buffer_get_frame_id (buffer), !=, arv_buffer_get_frame_id (static_buffer));
+	g_assert_cmpint (GUINT32_FROM_BE (*((guint32 *) data)), ==, arv_buffer_get_frame_id (buffer));
+	g_assert (memcmp (data + 4, static_data + 4, size - 4) == 0);
+
+	g_object_unref (buffer);
+	g_object_unref (static_buffer);
+
+	g_object_unref (device);
+}
+
 static void
 camera_api_test (void)
 {
@@ -637,6 +793,31 @@ camera_device_test (void)
 
 }
 
+static void
+camera_new_multiple_test (void)
+{
+	const char *names[] = {"Fake_1", "Fake_1", "Fake_1", "Fake_1", NULL};
+	GPtrArray *cameras;
+	GError *error = NULL;
+	unsigned int i;
+
+	cameras = arv_camera_new_multiple (names, &error);
+	g_assert_no_error (error);
+	g_assert (cameras != NULL);
+	g_assert_cmpint (cameras->len, ==, 4);
+
+	for (i = 0; i < cameras->len; i++) {
+		ArvCamera *camera = g_ptr_array_index (cameras, i);
+
+		g_assert (ARV_IS_CAMERA (camera));
+		g_assert (ARV_IS_FAKE_DEVICE (arv_camera_get_device (camera)));
+		if (i > 0)
+			g_assert (camera != g_ptr_array_index (cameras, i - 1));
+	}
+
+	g_ptr_array_unref (cameras);
+}
+
 static void
 camera_trigger_selector_test (void)
 {
@@ -730,6 +911,91 @@ set_features_from_string_test (void)
 	g_object_unref (device);
 }
 
+#if ARAVIS_HAS_SHARED_MEMORY
+
+static void
+shared_stream_test (void)
+{
+	ArvCamera *camera;
+	ArvStream *stream;
+	ArvStreamPublisher *publisher;
+	ArvStreamSubscriber *subscriber;
+	ArvBuffer *buffer;
+	ArvBuffer *shared_buffer;
+	GError *error = NULL;
+	const void *data;
+	const void *shared_data;
+	size_t size;
+	size_t shared_size;
+	guint64 frame_id;
+	char *name;
+	gint payload;
+	int i;
+
+	camera = arv_camera_new ("Fake_1", &error);
+	g_assert (ARV_IS_CAMERA (camera));
+	g_assert (error == NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	payload = arv_camera_get_payload (camera, NULL);
+
+	name = g_strdup_printf ("fake-test-%d", getpid ());
+	publisher = arv_stream_publisher_new (stream, name, 4, payload, &error);
+	g_assert (ARV_IS_STREAM_PUBLISHER (publisher));
+	g_assert (error == NULL);
+
+	subscriber = arv_stream_subscriber_new (name, &error);
+	g_assert (ARV_IS_STREAM_SUBSCRIBER (subscriber));
+	g_assert (error == NULL);
+	g_assert (arv_stream_subscriber_is_connected (subscriber));
+
+	for (i = 0; i < 100 && arv_stream_publisher_get_n_subscribers (publisher) == 0; i++)
+		g_usleep (10000);
+	g_assert_cmpint (arv_stream_publisher_get_n_subscribers (publisher), ==, 1);
+
+	g_assert (arv_stream_subscriber_try_pop_buffer (subscriber) == NULL);
+
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_SINGLE_FRAME, NULL);
+	arv_camera_start_acquisition (camera, NULL);
+	buffer = arv_stream_pop_buffer (stream);
+	arv_camera_stop_acquisition (camera, NULL);
+
+	g_assert (ARV_IS_BUFFER (buffer));
+	g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+
+	frame_id = arv_buffer_get_frame_id (buffer);
+	data = arv_buffer_get_image_data (buffer, &size);
+
+	arv_stream_publisher_publish (publisher, buffer);
+	g_assert_cmpint (arv_stream_publisher_get_n_published_buffers (publisher), ==, 1);
+
+	shared_buffer = arv_stream_subscriber_timeout_pop_buffer (subscriber, 1000000);
+	g_assert (ARV_IS_BUFFER (shared_buffer));
+	g_assert_cmpint (arv_buffer_get_status (shared_buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+	g_assert_cmpint (arv_buffer_get_frame_id (shared_buffer), ==, frame_id);
+
+	/* Same memory, seen through the read-only mapping of the subscriber */
+	shared_data = arv_buffer_get_image_data (shared_buffer, &shared_size);
+	g_assert (shared_data != data);
+	g_assert_cmpint (shared_size, ==, size);
+	g_assert (memcmp (shared_data, data, size) == 0);
+
+	g_assert_cmpint (arv_stream_subscriber_get_n_received_buffers (subscriber), ==, 1);
+	g_assert_cmpint (arv_stream_subscriber_get_n_missed_buffers (subscriber), ==, 0);
+
+	g_clear_object (&shared_buffer);
+	g_clear_object (&subscriber);
+	g_clear_object (&publisher);
+	g_clear_object (&stream);
+	g_clear_object (&camera);
+	g_free (name);
+}
+
+#endif
+
 int
 main (int argc, char *argv[])
 {
@@ -748,11 +1014,17 @@ main (int argc, char *argv[])
 	g_test_add_func ("/fake/registers", registers_test);
 	g_test_add_func ("/fake/fake-device", fake_device_test);
 	g_test_add_func ("/fake/fake-device-error", fake_device_error_test);
+	g_test_add_func ("/fake/feature-handle", feature_handle_test);
 	g_test_add_func ("/fake/fake-stream", fake_stream_test);
+	g_test_add_func ("/fake/fill-pattern", fill_pattern_test);
 	g_test_add_func ("/fake/camera-api", camera_api_test);
 	g_test_add_func ("/fake/camera-device", camera_device_test);
+	g_test_add_func ("/fake/camera-new-multiple", camera_new_multiple_test);
 	g_test_add_func ("/fake/camera-trigger-selector", camera_trigger_selector_test);
 	g_test_add_func ("/fake/set-features-from-string", set_features_from_string_test);
+#if ARAVIS_HAS_SHARED_MEMORY
+	g_test_add_func ("/fake/shared-stream", shared_stream_test);
+#endif
 
 	result = g_test_run();
 
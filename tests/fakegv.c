@@ -1,6 +1,8 @@
 #include <glib.h>
 #include <arv.h>
+#include <string.h>
 
+static ArvGvFakeCamera *simulator = NULL;
 static ArvCamera *camera = NULL;
 
 static void
@@ -117,6 +119,204 @@ acquisition_test (void)
 	g_clear_object (&buffer);
 }
 
+static void
+resend_test (void)
+{
+	ArvStream *stream;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	size_t payload;
+	guint64 n_resend_requests;
+	guint64 n_resent_packets;
+	unsigned n_completed = 0;
+	unsigned i;
+	const char *ignore_buffer;
+
+	ignore_buffer = g_getenv("ARV_TEST_IGNORE_BUFFER");
+
+	g_object_set (simulator, "gvsp-faults", "seed=1,loss=0.01", NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	payload = arv_camera_get_payload (camera, NULL);
+
+	for (i = 0; i < 5; i++)
+		arv_stream_push_buffer (stream, arv_buffer_new (payload, NULL));
+
+	arv_camera_start_acquisition (camera, NULL);
+
+	for (i = 0; i < 10; i++) {
+		buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+		g_assert (ARV_IS_BUFFER (buffer));
+
+		if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS)
+			n_completed++;
+
+		arv_stream_push_buffer (stream, buffer);
+	}
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	n_resend_requests = arv_stream_get_info_uint64_by_name (stream, "n_resend_requests");
+	n_resent_packets = arv_stream_get_info_uint64_by_name (stream, "n_resent_packets");
+
+	g_clear_object (&stream);
+
+	g_object_set (simulator, "gvsp-faults", NULL, NULL);
+
+	g_assert_cmpint (n_resend_requests, >, 0);
+	g_assert_cmpint (n_resent_packets, >, 0);
+
+	if (ignore_buffer == NULL)
+		g_assert_cmpint (n_completed, >=, 8);
+}
+
+static void
+multipart_test (void)
+{
+	ArvStream *stream;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	size_t payload;
+	unsigned i;
+	const char *ignore_buffer;
+
+	ignore_buffer = g_getenv("ARV_TEST_IGNORE_BUFFER");
+
+	g_assert (arv_camera_gv_is_multipart_supported (camera, NULL));
+
+	arv_camera_gv_select_stream_channel (camera, 0, &error);
+	g_assert (error == NULL);
+	arv_camera_gv_set_multipart (camera, TRUE, &error);
+	g_assert (error == NULL);
+	arv_camera_set_boolean (camera, "ChunkModeActive", TRUE, &error);
+	g_assert (error == NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	payload = arv_camera_get_payload (camera, NULL);
+
+	for (i = 0; i < 5; i++)
+		arv_stream_push_buffer (stream, arv_buffer_new (payload, NULL));
+
+	arv_camera_start_acquisition (camera, NULL);
+
+	buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+	g_assert (ARV_IS_BUFFER (buffer));
+
+	if (ignore_buffer == NULL && arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS) {
+		const guint64 *chunk_frame_id;
+		const void *image_data;
+		GBytes *image_bytes;
+		size_t size;
+
+		g_assert_cmpint (arv_buffer_get_payload_type (buffer), ==, ARV_BUFFER_PAYLOAD_TYPE_MULTIPART);
+		g_assert_cmpint (arv_buffer_get_n_parts (buffer), ==, 3);
+
+		g_assert_cmpint (arv_buffer_get_part_data_type (buffer, 0), ==, ARV_BUFFER_PART_DATA_TYPE_2D_IMAGE);
+		g_assert_cmpint (arv_buffer_get_part_data_type (buffer, 1), ==, ARV_BUFFER_PART_DATA_TYPE_3D_IMAGE);
+		g_assert_cmpint (arv_buffer_get_part_data_type (buffer, 2), ==, ARV_BUFFER_PART_DATA_TYPE_CHUNK_DATA);
+		g_assert (arv_buffer_get_part_pixel_format (buffer, 1) == ARV_PIXEL_FORMAT_COORD3D_C_16);
+		g_assert_cmpint (arv_buffer_get_part_width (buffer, 1), ==, arv_buffer_get_part_width (buffer, 0));
+
+		g_assert (arv_buffer_has_chunks (buffer));
+		chunk_frame_id = arv_buffer_get_chunk_data (buffer, ARV_FAKE_CAMERA_CHUNK_ID_FRAME_ID, &size);
+		g_assert (chunk_frame_id != NULL);
+		g_assert_cmpint (size, ==, sizeof (guint64));
+		g_assert_cmpint (GUINT64_FROM_BE (*chunk_frame_id), ==, arv_buffer_get_frame_id (buffer));
+
+		/* The GBytes accessors wrap the buffer memory without a copy */
+		for (i = 0; i < arv_buffer_get_n_parts (buffer); i++) {
+			const void *part_data;
+			GBytes *bytes;
+
+			part_data = arv_buffer_get_part_data (buffer, i, &size);
+			bytes = arv_buffer_get_part_data_bytes (buffer, i);
+			g_assert (bytes != NULL);
+			g_assert (g_bytes_get_data (bytes, NULL) == part_data);
+			g_assert_cmpint (g_bytes_get_size (bytes), ==, size);
+			g_assert_cmpint (size, >, 0);
+			g_bytes_unref (bytes);
+		}
+
+		image_data = arv_buffer_get_image_data (buffer, &size);
+		image_bytes = arv_buffer_get_image_data_bytes (buffer);
+		g_assert (image_bytes != NULL);
+		g_assert (g_bytes_get_data (image_bytes, NULL) == image_data);
+		g_assert_cmpint (g_bytes_get_size (image_bytes), ==, size);
+
+		/* The bytes keep the buffer alive */
+		g_object_add_weak_pointer (G_OBJECT (buffer), (gpointer *) &buffer);
+		g_object_unref (buffer);
+		g_assert (buffer != NULL);
+		g_bytes_unref (image_bytes);
+		g_assert (buffer == NULL);
+	}
+
+	if (buffer != NULL)
+		arv_stream_push_buffer (stream, buffer);
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	g_clear_object (&stream);
+
+	arv_camera_set_boolean (camera, "ChunkModeActive", FALSE, NULL);
+	arv_camera_gv_set_multipart (camera, FALSE, NULL);
+}
+
+static void
+stream_channel_test (void)
+{
+	ArvStream *stream;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	size_t payload;
+	unsigned n_completed = 0;
+	unsigned i;
+	const char *ignore_buffer;
+
+	ignore_buffer = g_getenv("ARV_TEST_IGNORE_BUFFER");
+
+	g_assert_cmpint (arv_camera_gv_get_n_stream_channels (camera, NULL), ==, 2);
+
+	arv_camera_gv_select_stream_channel (camera, 1, &error);
+	g_assert (error == NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	payload = arv_camera_get_payload (camera, NULL);
+
+	for (i = 0; i < 5; i++)
+		arv_stream_push_buffer (stream, arv_buffer_new (payload, NULL));
+
+	arv_camera_start_acquisition (camera, NULL);
+
+	for (i = 0; i < 5; i++) {
+		buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+		g_assert (ARV_IS_BUFFER (buffer));
+
+		if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS)
+			n_completed++;
+
+		arv_stream_push_buffer (stream, buffer);
+	}
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	g_clear_object (&stream);
+
+	arv_camera_gv_select_stream_channel (camera, 0, NULL);
+
+	if (ignore_buffer == NULL)
+		g_assert_cmpint (n_completed, >=, 4);
+}
+
 static void
 new_buffer_cb (ArvStream *stream, unsigned *buffer_count)
 {
@@ -147,6 +347,9 @@ stream_test (void)
 	size_t payload;
 	unsigned buffer_count = 0;
 	unsigned i;
+	ArvStreamStatistics first, second;
+	guint64 n_completed_buffers;
+	char *metrics;
 
 	stream = arv_camera_create_stream (camera, NULL, NULL, &error);
 	g_assert (ARV_IS_STREAM (stream));
@@ -160,12 +363,34 @@ stream_test (void)
 	g_signal_connect (stream, "new-buffer", G_CALLBACK (new_buffer_cb), &buffer_count);
 	arv_stream_set_emit_signals (stream, TRUE);
 
+	arv_stream_get_statistics_snapshot (stream, NULL, &first);
+
 	arv_camera_start_acquisition (camera, NULL);
 
 	while (buffer_count < 10)
 		g_usleep (1000);
 
+	arv_stream_get_statistics_snapshot (stream, &first, &second);
+	g_assert_cmpint (second.time_us, >, first.time_us);
+	g_assert_cmpint (second.n_completed_buffers, >, first.n_completed_buffers);
+	g_assert_cmpint (second.n_received_packets, >, 0);
+	g_assert_cmpfloat (second.completed_buffer_rate, >, 0.0);
+	g_assert_cmpfloat (second.transferred_byte_rate, >, 0.0);
+
 	arv_camera_stop_acquisition (camera, NULL);
+
+	/* The stream thread publishes its statistics on exit */
+	arv_stream_get_statistics_snapshot (stream, NULL, &second);
+	arv_stream_get_statistics (stream, &n_completed_buffers, NULL, NULL);
+	g_assert_cmpint (second.n_completed_buffers, ==, n_completed_buffers);
+
+	metrics = arv_metrics_to_string ();
+	g_assert (strstr (metrics, "# TYPE aravis_stream_completed_buffers counter\n") != NULL);
+	g_assert (strstr (metrics, "aravis_stream_completed_buffers_total{device=\"127.0.0.1\"") != NULL);
+	g_assert (strstr (metrics, "aravis_device_gvcp_commands_total{device=\"127.0.0.1\"}") != NULL);
+	g_assert (g_str_has_suffix (metrics, "# EOF\n"));
+	g_free (metrics);
+
 	/* The following will block until the signal callback returns
 	 * which avoids a race and possible deadlock.
 	 */
@@ -237,17 +462,150 @@ dynamic_roi_test (void)
 	g_clear_object (&stream);
 }
 
+static void
+camera_group_test (void)
+{
+	ArvCameraGroup *group;
+	ArvStream *stream;
+	GError *error = NULL;
+	gint64 packet_delay;
+	gint64 frame_transmission_delay;
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	group = arv_camera_group_new (1000000000);
+	g_assert (ARV_IS_CAMERA_GROUP (group));
+
+	arv_camera_group_add_camera (group, camera, stream);
+	g_assert_cmpint (arv_camera_group_get_n_cameras (group), ==, 1);
+	g_assert (arv_camera_group_get_camera (group, 0) == camera);
+	g_assert_cmpfloat (arv_camera_group_get_link_usage (group), ==, 0.9);
+
+	arv_camera_group_balance (group, &error);
+	g_assert (error == NULL);
+
+	/* The camera is limited to 90% of the link */
+	arv_camera_group_get_delays (group, 0, &packet_delay, &frame_transmission_delay);
+	g_assert_cmpint (packet_delay, >, 0);
+	g_assert_cmpint (frame_transmission_delay, ==, 0);
+	g_assert_cmpint (arv_camera_gv_get_packet_delay (camera, NULL), ==, packet_delay);
+
+	/* No resend, nothing to do */
+	g_assert (!arv_camera_group_rebalance (group, &error));
+	g_assert (error == NULL);
+
+	arv_camera_gv_set_packet_delay (camera, 0, NULL);
+
+	g_object_unref (group);
+	g_object_unref (stream);
+}
+
+static void
+multicast_test (void)
+{
+	ArvDevice *device;
+	ArvCamera *monitor_camera;
+	ArvStream *stream;
+	ArvStream *monitor_stream;
+	ArvBuffer *buffer;
+	GInetAddress *group;
+	GError *error = NULL;
+	size_t payload;
+	guint64 n_resent_packets;
+	unsigned n_completed = 0;
+	unsigned n_monitor_completed = 0;
+	unsigned i;
+
+	/* Requires a multicast capable loopback interface, e.g.:
+	 * ip link set lo multicast on && ip route add 239.0.0.0/8 dev lo */
+	if (g_getenv ("ARV_TEST_MULTICAST") == NULL) {
+		g_test_skip ("Set ARV_TEST_MULTICAST to run the multicast test");
+		return;
+	}
+
+	device = arv_camera_get_device (camera);
+
+	group = g_inet_address_new_from_string ("239.192.0.1");
+	arv_gv_device_set_stream_multicast_address (ARV_GV_DEVICE (device), group, 0);
+	g_object_unref (group);
+
+	g_object_set (simulator, "gvsp-faults", "seed=1,loss=0.01", NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	/* A second instance doesn't get control access, and monitors the multicast stream */
+	monitor_camera = arv_camera_new ("Aravis-GVTest", &error);
+	g_assert (ARV_IS_CAMERA (monitor_camera));
+	g_assert (error == NULL);
+	g_assert (!arv_gv_device_is_controller (ARV_GV_DEVICE (arv_camera_get_device (monitor_camera))));
+
+	monitor_stream = arv_camera_create_stream (monitor_camera, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (monitor_stream));
+	g_assert (error == NULL);
+	g_assert_cmpint (arv_gv_stream_get_port (ARV_GV_STREAM (monitor_stream)), ==,
+			 arv_gv_stream_get_port (ARV_GV_STREAM (stream)));
+
+	payload = arv_camera_get_payload (camera, NULL);
+
+	for (i = 0; i < 5; i++) {
+		arv_stream_push_buffer (stream, arv_buffer_new (payload, NULL));
+		arv_stream_push_buffer (monitor_stream, arv_buffer_new (payload, NULL));
+	}
+
+	g_assert (arv_stream_start_acquisition (monitor_stream, NULL));
+	arv_camera_start_acquisition (camera, NULL);
+
+	for (i = 0; i < 10; i++) {
+		buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+		g_assert (ARV_IS_BUFFER (buffer));
+		if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS)
+			n_completed++;
+		arv_stream_push_buffer (stream, buffer);
+
+		buffer = arv_stream_timeout_pop_buffer (monitor_stream, 2000000);
+		g_assert (ARV_IS_BUFFER (buffer));
+		if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS)
+			n_monitor_completed++;
+		arv_stream_push_buffer (monitor_stream, buffer);
+	}
+
+	arv_camera_stop_acquisition (camera, NULL);
+	arv_stream_stop_acquisition (monitor_stream, NULL);
+
+	/* Missing packets are unicast to each requester */
+	n_resent_packets = arv_stream_get_info_uint64_by_name (monitor_stream, "n_resent_packets");
+
+	g_object_set (simulator, "gvsp-faults", NULL, NULL);
+
+	g_clear_object (&monitor_stream);
+	g_clear_object (&monitor_camera);
+	g_clear_object (&stream);
+
+	arv_gv_device_set_stream_multicast_address (ARV_GV_DEVICE (device), NULL, 0);
+
+	g_assert_cmpint (n_completed, >=, 8);
+	g_assert_cmpint (n_monitor_completed, >=, 8);
+	g_assert_cmpint (n_resent_packets, >, 0);
+}
+
 int
 main (int argc, char *argv[])
 {
-	ArvGvFakeCamera *simulator;
 	int result;
 
 	g_test_init (&argc, &argv, NULL);
 
 	arv_set_fake_camera_genicam_filename (GENICAM_FILENAME);
 
-	simulator = arv_gv_fake_camera_new ("127.0.0.1", "GVTest");
+	simulator = g_object_new (ARV_TYPE_GV_FAKE_CAMERA,
+				  "interface-name", "127.0.0.1",
+				  "serial-number", "GVTest",
+				  "gvsp-n-stream-channels", 2,
+				  NULL);
 	g_assert (ARV_IS_GV_FAKE_CAMERA (simulator));
 
 	camera = arv_camera_new ("Aravis-GVTest", NULL);
@@ -259,7 +617,12 @@ main (int argc, char *argv[])
 	g_test_add_func ("/fakegv/device_registers", register_test);
 	g_test_add_func ("/fakegv/acquisition", acquisition_test);
 	g_test_add_func ("/fakegv/stream", stream_test);
+	g_test_add_func ("/fakegv/resend", resend_test);
+	g_test_add_func ("/fakegv/multipart", multipart_test);
+	g_test_add_func ("/fakegv/stream_channel", stream_channel_test);
 	g_test_add_func ("/fakegv/dynamic_roi", dynamic_roi_test);
+	g_test_add_func ("/fakegv/camera-group", camera_group_test);
+	g_test_add_func ("/fakegv/multicast", multicast_test);
 
 	result = g_test_run();
 
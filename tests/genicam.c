@@ -479,6 +479,7 @@ enumeration_test (void)
 	gint64 v_int64;
 	gint64 *values;
 	guint n_values;
+	const char **strings;
 	const char *v_string;
         ArvGcAccessMode access_mode;
 
@@ -527,6 +528,39 @@ enumeration_test (void)
 	v_int64 = arv_gc_string_get_max_length (ARV_GC_STRING (node), NULL);
 	g_assert_cmpint (v_int64, ==, strlen ("EntryNotImplemented"));
 
+	arv_gc_string_set_value (ARV_GC_STRING (node), "NotAnEntry", &error);
+	g_assert_error (error, ARV_GC_ERROR, ARV_GC_ERROR_ENUM_ENTRY_NOT_FOUND);
+	g_clear_error (&error);
+
+	arv_gc_string_set_value (ARV_GC_STRING (node), "EntryNotAvailable", &error);
+	g_assert_error (error, ARV_GC_ERROR, ARV_GC_ERROR_OUT_OF_RANGE);
+	g_clear_error (&error);
+
+	/* Entry availability must follow its dependencies */
+	arv_gc_integer_set_value (ARV_GC_INTEGER (arv_gc_get_node (genicam, "NotAvailable")), 1, NULL);
+
+	strings = arv_gc_enumeration_dup_available_string_values (ARV_GC_ENUMERATION (node), &n_values, NULL);
+	g_assert_cmpint (n_values, ==, 4);
+	g_assert_cmpstr (strings[0], ==, "Entry0");
+	g_assert_cmpstr (strings[1], ==, "Entry1");
+	g_assert_cmpstr (strings[2], ==, "EntryNotAvailable");
+	g_assert_cmpstr (strings[3], ==, "EntryNotImplemented");
+	g_free (strings);
+
+	arv_gc_string_set_value (ARV_GC_STRING (node), "EntryNotAvailable", &error);
+	g_assert_no_error (error);
+
+	v_string = arv_gc_string_get_value (ARV_GC_STRING (node), NULL);
+	g_assert_cmpstr (v_string, ==, "EntryNotAvailable");
+
+	arv_gc_integer_set_value (ARV_GC_INTEGER (arv_gc_get_node (genicam, "NotAvailable")), 0, NULL);
+
+	values = arv_gc_enumeration_dup_available_int_values (ARV_GC_ENUMERATION (node), &n_values, NULL);
+	g_assert_cmpint (n_values, ==, 2);
+	g_assert_cmpint (values[0], ==, 0);
+	g_assert_cmpint (values[1], ==, 1);
+	g_free (values);
+
 	g_object_unref (device);
 }
 
@@ -580,6 +614,29 @@ swiss_knife_test (void)
 	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), NULL);
 	g_assert_cmpint (value, ==, 140);
 
+	/* Memoized result must follow the input changes */
+	arv_gc_integer_set_value (ARV_GC_INTEGER (arv_gc_get_node (genicam, "X")), 6, NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), NULL);
+	g_assert_cmpint (value, ==, 160);
+
+	/* Input register changed through an aliased register */
+	node = arv_gc_get_node (genicam, "IntSwissKnifeTestRegister");
+	g_assert (ARV_IS_GC_SWISS_KNIFE (node));
+
+	arv_gc_set_register_cache_policy (genicam, ARV_REGISTER_CACHE_POLICY_ENABLE);
+
+	arv_gc_integer_set_value (ARV_GC_INTEGER (arv_gc_get_node (genicam, "IntRegisterA")), 10, NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), NULL);
+	g_assert_cmpint (value, ==, 11);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), NULL);
+	g_assert_cmpint (value, ==, 11);
+
+	arv_gc_integer_set_value (ARV_GC_INTEGER (arv_gc_get_node (genicam, "IntRegisterA")), 20, NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), NULL);
+	g_assert_cmpint (value, ==, 21);
+
+	arv_gc_set_register_cache_policy (genicam, ARV_REGISTER_CACHE_POLICY_DEFAULT);
+
 	g_object_unref (device);
 }
 
@@ -1237,6 +1294,242 @@ chunk_data_test (void)
 	g_object_unref (device);
 }
 
+static void
+chunk_parser_nul_terminated_test (void)
+{
+	ArvDevice *device;
+	ArvChunkParser *parser;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	const char *genicam_xml;
+	char *xml;
+	size_t size;
+
+	device = arv_fake_device_new ("TEST0", &error);
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+	g_assert (error == NULL);
+
+	genicam_xml = arv_device_get_genicam_xml (device, &size);
+	g_assert (genicam_xml != NULL);
+
+	/* A size of -1 means NUL terminated data */
+	xml = g_strndup (genicam_xml, size);
+	parser = arv_chunk_parser_new (xml, -1);
+	g_free (xml);
+	g_assert (ARV_IS_CHUNK_PARSER (parser));
+
+	buffer = create_buffer_with_chunk_data ();
+	g_assert (ARV_IS_BUFFER (buffer));
+
+	g_assert_cmpint (arv_chunk_parser_get_integer_value (parser, buffer, "ChunkInt", &error), ==, 0x11223344);
+	g_assert (error == NULL);
+
+	g_object_unref (buffer);
+	g_object_unref (parser);
+	g_object_unref (device);
+}
+
+#define CHUNK_DATA_N_THREADS	4
+#define CHUNK_DATA_N_LOOPS	200
+
+typedef struct {
+	ArvChunkParser *parser;
+	ArvBuffer *buffer;
+	guint32 value;
+	gboolean success;
+} ChunkDataThreadData;
+
+static gpointer
+chunk_data_thread (gpointer user_data)
+{
+	ChunkDataThreadData *data = user_data;
+	int i;
+
+	data->success = TRUE;
+
+	for (i = 0; i < CHUNK_DATA_N_LOOPS; i++) {
+		GError *error = NULL;
+		const char *string_value;
+
+		if (arv_chunk_parser_get_integer_value (data->parser, data->buffer, "ChunkInt", &error) != data->value)
+			data->success = FALSE;
+		string_value = arv_chunk_parser_get_string_value (data->parser, data->buffer, "ChunkString", &error);
+		if (g_strcmp0 (string_value, "Hello") != 0)
+			data->success = FALSE;
+		if (error != NULL) {
+			data->success = FALSE;
+			g_clear_error (&error);
+		}
+	}
+
+	return NULL;
+}
+
+static void
+chunk_data_concurrent_test (void)
+{
+	ArvDevice *device;
+	ArvChunkParser *parser;
+	ChunkDataThreadData data[CHUNK_DATA_N_THREADS];
+	GThread *threads[CHUNK_DATA_N_THREADS];
+	GError *error = NULL;
+	int i;
+
+	device = arv_fake_device_new ("TEST0", &error);
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+	g_assert (error == NULL);
+
+	parser = arv_device_create_chunk_parser (device);
+	g_assert (ARV_IS_CHUNK_PARSER (parser));
+
+	/* Each thread parses its own buffer, with a different ChunkInt value */
+	for (i = 0; i < CHUNK_DATA_N_THREADS; i++) {
+		guint32 *int_value;
+		size_t size;
+
+		data[i].parser = parser;
+		data[i].buffer = create_buffer_with_chunk_data ();
+		data[i].value = 0x1000 + i;
+
+		int_value = (guint32 *) arv_buffer_get_chunk_data (data[i].buffer, 0x12345678, &size);
+		g_assert (int_value != NULL);
+		*int_value = GUINT32_TO_BE (data[i].value);
+	}
+
+	for (i = 0; i < CHUNK_DATA_N_THREADS; i++)
+		threads[i] = g_thread_new ("chunk_data", chunk_data_thread, &data[i]);
+
+	for (i = 0; i < CHUNK_DATA_N_THREADS; i++) {
+		g_thread_join (threads[i]);
+		g_assert (data[i].success);
+		g_object_unref (data[i].buffer);
+	}
+
+	g_object_unref (parser);
+	g_object_unref (device);
+}
+
+#define CONCURRENT_ACCESS_N_THREADS	4
+#define CONCURRENT_ACCESS_N_LOOPS	500
+
+typedef struct {
+	ArvGc *genicam;
+	gboolean success;
+} ConcurrentAccessThreadData;
+
+static gpointer
+concurrent_read_thread (gpointer user_data)
+{
+	ConcurrentAccessThreadData *data = user_data;
+	ArvGcNode *swiss_knife;
+	ArvGcNode *converter;
+	int i;
+
+	data->success = TRUE;
+
+	swiss_knife = arv_gc_get_node (data->genicam, "IntSwissKnifeTestSubAndConstant");
+	converter = arv_gc_get_node (data->genicam, "IntConverterTestSubAndConstant");
+
+	for (i = 0; i < CONCURRENT_ACCESS_N_LOOPS; i++) {
+		GError *error = NULL;
+		gint64 value;
+
+		if (arv_gc_integer_get_value (ARV_GC_INTEGER (swiss_knife), &error) != 140)
+			data->success = FALSE;
+		if (g_strcmp0 (arv_gc_feature_node_get_value_as_string (ARV_GC_FEATURE_NODE (swiss_knife), &error),
+			       "140") != 0)
+			data->success = FALSE;
+
+		value = arv_gc_integer_get_value (ARV_GC_INTEGER (converter), &error);
+		if (value != 1000 && value != 2000)
+			data->success = FALSE;
+
+		if (error != NULL) {
+			data->success = FALSE;
+			g_clear_error (&error);
+		}
+	}
+
+	return NULL;
+}
+
+static gpointer
+concurrent_write_thread (gpointer user_data)
+{
+	ConcurrentAccessThreadData *data = user_data;
+	ArvGcNode *converter;
+	int i;
+
+	data->success = TRUE;
+
+	converter = arv_gc_get_node (data->genicam, "IntConverterTestSubAndConstant");
+
+	for (i = 0; i < CONCURRENT_ACCESS_N_LOOPS; i++) {
+		GError *error = NULL;
+		gint64 value = (i % 2) == 0 ? 200 : 100;
+
+		/* Nested locking, the write must be seen by the read */
+		arv_gc_lock_write (data->genicam);
+		arv_gc_integer_set_value (ARV_GC_INTEGER (converter), value, &error);
+		if (arv_gc_integer_get_value (ARV_GC_INTEGER (converter), &error) != value * 10)
+			data->success = FALSE;
+		arv_gc_unlock (data->genicam);
+
+		if (error != NULL) {
+			data->success = FALSE;
+			g_clear_error (&error);
+		}
+	}
+
+	return NULL;
+}
+
+static void
+concurrent_access_test (void)
+{
+	ArvDevice *device;
+	ArvGc *genicam;
+	ArvGcNode *node;
+	ConcurrentAccessThreadData data[CONCURRENT_ACCESS_N_THREADS + 1];
+	GThread *threads[CONCURRENT_ACCESS_N_THREADS + 1];
+	GError *error = NULL;
+	int i;
+
+	device = arv_fake_device_new ("TEST0", &error);
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+	g_assert (error == NULL);
+
+	genicam = arv_device_get_genicam (device);
+	g_assert (ARV_IS_GC (genicam));
+
+	node = arv_gc_get_node (genicam, "IntConverterTestSubAndConstant");
+	g_assert (ARV_IS_GC_CONVERTER (node));
+	arv_gc_integer_set_value (ARV_GC_INTEGER (node), 100, NULL);
+
+	for (i = 0; i <= CONCURRENT_ACCESS_N_THREADS; i++) {
+		data[i].genicam = genicam;
+		threads[i] = g_thread_new ("concurrent_access",
+					   i < CONCURRENT_ACCESS_N_THREADS ? concurrent_read_thread : concurrent_write_thread,
+					   &data[i]);
+	}
+
+	for (i = 0; i <= CONCURRENT_ACCESS_N_THREADS; i++) {
+		g_thread_join (threads[i]);
+		g_assert (data[i].success);
+	}
+
+	/* A read lock can not be upgraded, the nested write must fail */
+	arv_gc_integer_set_value (ARV_GC_INTEGER (node), 100, NULL);
+	arv_gc_lock_read (genicam);
+	arv_gc_integer_set_value (ARV_GC_INTEGER (node), 200, &error);
+	g_assert_error (error, ARV_GC_ERROR, ARV_GC_ERROR_WRITE_IN_READ_LOCK);
+	g_clear_error (&error);
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (node), NULL), ==, 1000);
+	arv_gc_unlock (genicam);
+
+	g_object_unref (device);
+}
+
 static void
 visibility_test (void)
 {
@@ -1420,6 +1713,221 @@ access_mode_test (void)
 	g_object_unref (device);
 }
 
+static const char lazy_loading_xml[] =
+	"<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+	"<RegisterDescription ModelName=\"Lazy\" VendorName=\"Aravis\">\n"
+	"  <Integer Name=\"Width\">\n"
+	"    <pValue>WidthValue</pValue>\n"
+	"  </Integer>\n"
+	"  <Group Comment=\"Values\">\n"
+	"    <Integer Name=\"WidthValue\"><Value>1024</Value></Integer>\n"
+	"    <Enumeration Name=\"Mode\">\n"
+	"      <EnumEntry Name=\"Single\"><Value>1</Value></EnumEntry>\n"
+	"      <EnumEntry Name=\"Continuous\"><Value>2</Value></EnumEntry>\n"
+	"      <pValue>ModeValue</pValue>\n"
+	"    </Enumeration>\n"
+	"    <Integer Name=\"ModeValue\"><Value>2</Value></Integer>\n"
+	"    <Boolean Name=\"Empty\"/>\n"
+	"  </Group>\n"
+	"</RegisterDescription>\n";
+
+static void
+lazy_loading_test (void)
+{
+	ArvGc *genicam;
+	ArvGcNode *node;
+	GError *error = NULL;
+	gint64 value;
+	const char *string;
+
+	genicam = arv_gc_new (NULL, lazy_loading_xml, strlen (lazy_loading_xml));
+	g_assert (ARV_IS_GC (genicam));
+
+	node = arv_gc_get_node (genicam, "Width");
+	g_assert (ARV_IS_GC_INTEGER_NODE (node));
+
+	/* WidthValue is instantiated through the pValue link of Width */
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert_no_error (error);
+	g_assert_cmpint (value, ==, 1024);
+
+	node = arv_gc_get_node (genicam, "Mode");
+	g_assert (ARV_IS_GC_ENUMERATION (node));
+	string = arv_gc_enumeration_get_string_value (ARV_GC_ENUMERATION (node), &error);
+	g_assert_no_error (error);
+	g_assert_cmpstr (string, ==, "Continuous");
+
+	g_assert (ARV_IS_GC_BOOLEAN (arv_gc_get_node (genicam, "Empty")));
+	g_assert (arv_gc_get_node (genicam, "Single") == NULL);
+	g_assert (arv_gc_get_node (genicam, "Unknown") == NULL);
+
+	g_object_unref (genicam);
+}
+
+static const char property_node_cache_xml[] =
+	"<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+	"<RegisterDescription ModelName=\"Cache\" VendorName=\"Aravis\">\n"
+	"  <Integer Name=\"Height\">\n"
+	"    <pValue>HeightValue</pValue>\n"
+	"  </Integer>\n"
+	"  <Integer Name=\"Offset\">\n"
+	"    <Value>16</Value>\n"
+	"  </Integer>\n"
+	"</RegisterDescription>\n";
+
+static ArvGcPropertyNode *
+_get_property_node (ArvGc *genicam, const char *name, ArvGcPropertyNodeType type)
+{
+	ArvDomNode *iter;
+
+	for (iter = arv_dom_node_get_first_child (ARV_DOM_NODE (arv_gc_get_node (genicam, name)));
+	     iter != NULL;
+	     iter = arv_dom_node_get_next_sibling (iter))
+		if (ARV_IS_GC_PROPERTY_NODE (iter) &&
+		    arv_gc_property_node_get_node_type (ARV_GC_PROPERTY_NODE (iter)) == type)
+			return ARV_GC_PROPERTY_NODE (iter);
+
+	return NULL;
+}
+
+static ArvGcNode *
+_append_integer_node (ArvGc *genicam, const char *name)
+{
+	ArvDomElement *element;
+
+	element = arv_dom_document_create_element (ARV_DOM_DOCUMENT (genicam), "Integer");
+	arv_dom_node_append_child (ARV_DOM_NODE (arv_dom_document_get_document_element (ARV_DOM_DOCUMENT (genicam))),
+				   ARV_DOM_NODE (element));
+	/* Setting the name registers the node, as done by the parser */
+	arv_dom_element_set_attribute (element, "Name", name);
+
+	return ARV_GC_NODE (element);
+}
+
+static void
+property_node_cache_test (void)
+{
+	ArvGc *genicam;
+	ArvGcPropertyNode *property_node;
+	ArvGcNode *node;
+	ArvGcNode *replacement;
+	GError *error = NULL;
+
+	genicam = arv_gc_new (NULL, property_node_cache_xml, strlen (property_node_cache_xml));
+	g_assert (ARV_IS_GC (genicam));
+
+	/* The link to a missing node is cached until a new node is registered */
+	property_node = _get_property_node (genicam, "Height", ARV_GC_PROPERTY_NODE_TYPE_P_VALUE);
+	g_assert (ARV_IS_GC_PROPERTY_NODE (property_node));
+	g_assert (arv_gc_property_node_get_linked_node (property_node) == NULL);
+
+	node = _append_integer_node (genicam, "HeightValue");
+	g_assert (ARV_IS_GC_INTEGER_NODE (node));
+	g_assert (arv_gc_get_node (genicam, "HeightValue") == node);
+	g_assert (arv_gc_property_node_get_linked_node (property_node) == node);
+	g_assert (arv_gc_property_node_get_linked_node (property_node) == node);
+
+	replacement = _append_integer_node (genicam, "HeightValue");
+	g_assert (replacement != node);
+	g_assert (arv_gc_property_node_get_linked_node (property_node) == replacement);
+
+	/* The typed values follow the value data */
+	property_node = _get_property_node (genicam, "Offset", ARV_GC_PROPERTY_NODE_TYPE_VALUE);
+	g_assert (ARV_IS_GC_PROPERTY_NODE (property_node));
+	g_assert_cmpint (arv_gc_property_node_get_int64 (property_node, &error), ==, 16);
+	g_assert_no_error (error);
+	g_assert_cmpfloat (arv_gc_property_node_get_double (property_node, &error), ==, 16.0);
+	g_assert_no_error (error);
+
+	arv_gc_property_node_set_int64 (property_node, 42, &error);
+	g_assert_no_error (error);
+	g_assert_cmpint (arv_gc_property_node_get_int64 (property_node, &error), ==, 42);
+	g_assert_no_error (error);
+	g_assert_cmpfloat (arv_gc_property_node_get_double (property_node, &error), ==, 42.0);
+	g_assert_no_error (error);
+	g_assert_cmpstr (arv_gc_property_node_get_string (property_node, &error), ==, "42");
+	g_assert_no_error (error);
+
+	arv_gc_property_node_set_double (property_node, 2.5, &error);
+	g_assert_no_error (error);
+	g_assert_cmpfloat (arv_gc_property_node_get_double (property_node, &error), ==, 2.5);
+	g_assert_no_error (error);
+
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (arv_gc_get_node (genicam, "Offset")), &error), ==, 2);
+	g_assert_no_error (error);
+
+	g_object_unref (genicam);
+}
+
+static void
+profile_test (void)
+{
+	ArvDevice *device;
+	ArvGc *genicam;
+	ArvGcNode *node;
+	ArvGcProfileOperation *operation;
+	ArvGcProfileOperation *copy;
+	GPtrArray *profile;
+	GError *error = NULL;
+
+	device = arv_fake_device_new ("TEST0", &error);
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+	g_assert (error == NULL);
+
+	genicam = arv_device_get_genicam (device);
+	g_assert (ARV_IS_GC (genicam));
+
+	arv_gc_set_register_cache_policy (genicam, ARV_REGISTER_CACHE_POLICY_ENABLE);
+
+	/* Nothing is recorded outside of a profiling session */
+	g_assert (arv_gc_stop_profiling (genicam) == NULL);
+
+	arv_gc_start_profiling (genicam);
+
+	node = arv_gc_get_node (genicam, "P_RWInteger");
+	g_assert (ARV_IS_GC_INTEGER (node));
+	arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+
+	node = arv_gc_get_node (genicam, "IntRegisterA");
+	g_assert (ARV_IS_GC_INTEGER (node));
+	arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+
+	profile = arv_gc_stop_profiling (genicam);
+	g_assert (profile != NULL);
+	g_assert_cmpint (profile->len, ==, 2);
+
+	operation = g_ptr_array_index (profile, 0);
+	g_assert_cmpstr (operation->feature, ==, "P_RWInteger");
+	g_assert (!operation->is_write);
+	g_assert_cmpstr (operation->evaluated_nodes[0], ==, "P_RWInteger");
+	g_assert (g_strv_contains ((const char * const *) operation->evaluated_nodes, "RWInteger"));
+	g_assert_cmpint (operation->n_port_reads, ==, 0);
+
+	operation = g_ptr_array_index (profile, 1);
+	g_assert_cmpstr (operation->feature, ==, "IntRegisterA");
+	g_assert (!operation->is_write);
+	g_assert_cmpint (operation->n_port_reads, >=, 1);
+	g_assert_cmpint (operation->n_bytes_read, >=, 8);
+	g_assert_cmpint (operation->n_port_writes, ==, 0);
+	g_assert_cmpint (operation->n_cache_misses, >=, 1);
+	g_assert_cmpint (operation->duration_us, >=, 0);
+
+	copy = g_boxed_copy (ARV_TYPE_GC_PROFILE_OPERATION, operation);
+	g_assert (copy != operation);
+	g_assert_cmpstr (copy->feature, ==, operation->feature);
+	g_assert (copy->evaluated_nodes != operation->evaluated_nodes);
+	g_assert_cmpint (g_strv_length (copy->evaluated_nodes), ==, g_strv_length (operation->evaluated_nodes));
+	g_assert_cmpstr (copy->evaluated_nodes[0], ==, "IntRegisterA");
+	g_assert_cmpint (copy->n_port_reads, ==, operation->n_port_reads);
+	g_boxed_free (ARV_TYPE_GC_PROFILE_OPERATION, copy);
+
+	g_ptr_array_unref (profile);
+
+	g_object_unref (device);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1441,11 +1949,17 @@ main (int argc, char *argv[])
 	g_test_add_func ("/genicam/url", url_test);
 	g_test_add_func ("/genicam/mandatory", mandatory_test);
 	g_test_add_func ("/genicam/chunk-data", chunk_data_test);
+	g_test_add_func ("/genicam/chunk-parser-nul-terminated", chunk_parser_nul_terminated_test);
+	g_test_add_func ("/genicam/chunk-data-concurrent", chunk_data_concurrent_test);
 	g_test_add_func ("/genicam/indexed", indexed_test);
 	g_test_add_func ("/genicam/visibility", visibility_test);
 	g_test_add_func ("/genicam/category", category_test);
 	g_test_add_func ("/genicam/lock", lock_test);
 	g_test_add_func ("/genicam/access-mode", access_mode_test);
+	g_test_add_func ("/genicam/concurrent-access", concurrent_access_test);
+	g_test_add_func ("/genicam/lazy-loading", lazy_loading_test);
+	g_test_add_func ("/genicam/property-node-cache", property_node_cache_test);
+	g_test_add_func ("/genicam/profile", profile_test);
 
 	result = g_test_run();
 
@@ -3,6 +3,8 @@
 #include <arvstr.h>
 #include <string.h>
 #include "../src/arvmiscprivate.h"
+#include "../src/arvdebugprivate.h"
+#include "../src/arvcameragroupprivate.h"
 
 #if !ARAVIS_CHECK_VERSION (ARAVIS_MAJOR_VERSION, ARAVIS_MINOR_VERSION, ARAVIS_MICRO_VERSION)
 #error
@@ -269,6 +271,81 @@ match_test (void)
 	}
 }
 
+static void
+debug_ring_buffer_test (void)
+{
+	char *dump;
+	int i;
+
+	g_assert (arv_debug_enable ("misc:3"));
+	g_assert (arv_debug_enable_ring_buffer (10));
+
+	arv_debug (ARV_DEBUG_CATEGORY_MISC, "int %d uint %u size %" G_GSIZE_FORMAT " u64 %" G_GUINT64_FORMAT,
+		   -12, 34U, (gsize) 56, G_GUINT64_CONSTANT (78));
+	arv_debug (ARV_DEBUG_CATEGORY_MISC, "double %.2f string %s %-4s| char %c %%", 1.5, "foo", "ab", 'x');
+	arv_debug (ARV_DEBUG_CATEGORY_MISC, "star %*d|%.*s|", 4, 7, 2, "abcdef");
+
+	dump = arv_debug_dump_ring_buffer ();
+	g_assert (strstr (dump, "int -12 uint 34 size 56 u64 78\n") != NULL);
+	g_assert (strstr (dump, "double 1.50 string foo ab  | char x %\n") != NULL);
+	g_assert (strstr (dump, "star    7|ab|\n") != NULL);
+	g_free (dump);
+
+	/* Records are consumed by the dump */
+	dump = arv_debug_dump_ring_buffer ();
+	g_assert_cmpstr (dump, ==, "");
+	g_free (dump);
+
+	/* The ring size is rounded to 16 records */
+	for (i = 0; i < 20; i++)
+		arv_debug (ARV_DEBUG_CATEGORY_MISC, "record %d", i);
+	dump = arv_debug_dump_ring_buffer ();
+	g_assert (strstr (dump, "4 debug records lost") != NULL);
+	g_assert (strstr (dump, "record 3\n") == NULL);
+	g_assert (strstr (dump, "record 4\n") != NULL);
+	g_assert (strstr (dump, "record 19\n") != NULL);
+	g_free (dump);
+
+	g_assert (!arv_debug_enable_ring_buffer (32));
+	g_assert (arv_debug_enable_ring_buffer (0));
+	g_assert (arv_debug_enable ("misc:0"));
+}
+
+static void
+usb_bandwidth_allocation_test (void)
+{
+	/* Three cameras on controller 2, one on controller 3, with a mocked topology */
+	ArvCameraGroupUsbRequest requests[] = {
+		{"2", 100e6, 1000, 500000000, 0},
+		{"3", 50e6,  1000, 500000000, 0},
+		{"2", 200e6, 1000, 500000000, 0},
+		{"2", 100e6, 1000, 500000000, 0},
+	};
+
+	arv_camera_group_allocate_usb_bandwidth (requests, G_N_ELEMENTS (requests), 360e6);
+
+	/* Proportional to the demands */
+	g_assert_cmpint (requests[0].limit, ==, 90000000);
+	g_assert_cmpint (requests[2].limit, ==, 180000000);
+	g_assert_cmpint (requests[3].limit, ==, 90000000);
+	g_assert_cmpint (requests[0].limit + requests[2].limit + requests[3].limit, <=, 360000000);
+
+	/* Alone on its controller */
+	g_assert_cmpint (requests[1].limit, ==, 360000000);
+
+	/* Unknown demand, the controller is shared evenly */
+	requests[3].demand = 0.0;
+	arv_camera_group_allocate_usb_bandwidth (requests, G_N_ELEMENTS (requests), 360e6);
+	g_assert_cmpint (requests[0].limit, ==, 120000000);
+	g_assert_cmpint (requests[2].limit, ==, 120000000);
+	g_assert_cmpint (requests[3].limit, ==, 120000000);
+
+	/* Device bounds */
+	requests[1].max = 100000000;
+	arv_camera_group_allocate_usb_bandwidth (requests, G_N_ELEMENTS (requests), 360e6);
+	g_assert_cmpint (requests[1].limit, ==, 100000000);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -285,6 +362,8 @@ main (int argc, char *argv[])
 	g_test_add_func ("/gstreamer/caps-string", caps_string_test);
 	g_test_add_func ("/misc/globs", glob_test);
 	g_test_add_func ("/misc/matches", match_test);
+	g_test_add_func ("/misc/debug-ring-buffer", debug_ring_buffer_test);
+	g_test_add_func ("/misc/usb-bandwidth-allocation", usb_bandwidth_allocation_test);
 
 
 	result = g_test_run();